@@ -0,0 +1,40 @@
+#include "Alphabet.h"
+#include "BenchmarkData.h"
+#include "CaesarCipher.h"
+#include "VigenereCipher.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+const size_t CORPUS_BYTES = 1 << 20;
+
+void alphabetArgs(benchmark::internal::Benchmark* b) {
+    for (int i = 0; i < ALPHABET_COUNT; ++i) b->Arg(i);
+    b->ArgNames({"alphabet"});
+}
+
+template <typename Cipher>
+void BM_EncryptAlphabet(benchmark::State& state, const std::string& key) {
+    Alphabet alphabet = static_cast<Alphabet>(state.range(0));
+    const std::string& text = BenchmarkData::text(CORPUS_BYTES, 75);
+    Cipher cipher(alphabet);
+    cipher.setKey(key);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cipher.encrypt(text));
+    }
+    state.SetLabel(Alphabets::name(alphabet));
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+void BM_CaesarAlphabet(benchmark::State& state) {
+    BM_EncryptAlphabet<CaesarCipher>(state, "7");
+}
+
+void BM_VigenereAlphabet(benchmark::State& state) {
+    BM_EncryptAlphabet<VigenereCipher>(state, "SECRET");
+}
+
+} // namespace
+
+BENCHMARK(BM_CaesarAlphabet)->Apply(alphabetArgs);
+BENCHMARK(BM_VigenereAlphabet)->Apply(alphabetArgs);
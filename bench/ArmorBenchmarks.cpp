@@ -0,0 +1,110 @@
+#include "ArmoredCipher.h"
+#include "BenchmarkData.h"
+#include "TextArmor.h"
+#include "VigenereCipher.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+
+namespace {
+
+const size_t DATA_BYTES = 1 << 20;
+
+// Uniform random bytes, the shape of real ciphertext
+const std::string& binaryData() {
+    static std::string data;
+    if (data.empty()) {
+        std::mt19937 rng(42);
+        data.resize(DATA_BYTES);
+        for (char& c : data) c = static_cast<char>(rng());
+    }
+    return data;
+}
+
+const uint8_t* bytes(const std::string& data) {
+    return reinterpret_cast<const uint8_t*>(data.data());
+}
+
+typedef void (*EncodeKernel)(const uint8_t*, size_t, char*);
+
+template <Armor armor, EncodeKernel kernel>
+void BM_Encode(benchmark::State& state) {
+    const std::string& data = binaryData();
+    std::string text(TextArmor::encodedSize(armor, data.size()), '\0');
+    for (auto _ : state) {
+        kernel(bytes(data), data.size(), &text[0]);
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+bool hexDecodeDispatched(const std::string& text, std::string& data) {
+    return TextArmor::hexDecode(text.data(), text.size(), reinterpret_cast<uint8_t*>(&data[0]));
+}
+
+bool hexDecodeScalar(const std::string& text, std::string& data) {
+    return TextArmor::hexDecodeScalar(text.data(), text.size(), reinterpret_cast<uint8_t*>(&data[0]));
+}
+
+bool base64DecodeDispatched(const std::string& text, std::string& data) {
+    size_t size = 0;
+    return TextArmor::base64Decode(text.data(), text.size(), reinterpret_cast<uint8_t*>(&data[0]), size);
+}
+
+bool base64DecodeScalar(const std::string& text, std::string& data) {
+    size_t size = 0;
+    return TextArmor::base64DecodeScalar(text.data(), text.size(), reinterpret_cast<uint8_t*>(&data[0]), size);
+}
+
+// Bytes processed is the decoded size, so encode and decode rates compare directly
+template <Armor armor, bool (*kernel)(const std::string&, std::string&)>
+void BM_Decode(benchmark::State& state) {
+    const std::string& data = binaryData();
+    std::string text = TextArmor::encode(armor, data);
+    std::string decoded(data.size(), '\0');
+    for (auto _ : state) {
+        bool ok = kernel(text, decoded);
+        benchmark::DoNotOptimize(ok);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK_TEMPLATE(BM_Encode, Armor::HEX, TextArmor::hexEncode);
+BENCHMARK_TEMPLATE(BM_Encode, Armor::HEX, TextArmor::hexEncodeScalar);
+BENCHMARK_TEMPLATE(BM_Encode, Armor::BASE64, TextArmor::base64Encode);
+BENCHMARK_TEMPLATE(BM_Encode, Armor::BASE64, TextArmor::base64EncodeScalar);
+BENCHMARK_TEMPLATE(BM_Decode, Armor::HEX, hexDecodeDispatched);
+BENCHMARK_TEMPLATE(BM_Decode, Armor::HEX, hexDecodeScalar);
+BENCHMARK_TEMPLATE(BM_Decode, Armor::BASE64, base64DecodeDispatched);
+BENCHMARK_TEMPLATE(BM_Decode, Armor::BASE64, base64DecodeScalar);
+
+// Decoding text wrapped at 76 columns, as pasted from mail or PEM files
+void BM_DecodeWrapped(benchmark::State& state) {
+    std::string text = TextArmor::encode(Armor::BASE64, binaryData());
+    std::string wrapped;
+    for (size_t i = 0; i < text.size(); i += 76) wrapped.append(text, i, 76).append("\n");
+    std::string decoded;
+    for (auto _ : state) {
+        bool ok = TextArmor::decode(Armor::BASE64, wrapped, decoded);
+        benchmark::DoNotOptimize(ok);
+    }
+    state.SetBytesProcessed(state.iterations() * binaryData().size());
+}
+BENCHMARK(BM_DecodeWrapped);
+
+// The whole stage as the CLI uses it: Vigenère over all bytes, then Base64
+void BM_ArmoredVigenere(benchmark::State& state) {
+    ArmoredCipher cipher(std::make_unique<VigenereCipher>(Alphabet::BYTES), Armor::BASE64);
+    cipher.setKey(BenchmarkData::key(16));
+    const std::string& plaintext = BenchmarkData::text(DATA_BYTES, 80);
+    bool isEncryption = state.range(0) != 0;
+    std::string input = isEncryption ? plaintext : cipher.encrypt(plaintext);
+    for (auto _ : state) {
+        std::string output = isEncryption ? cipher.encrypt(input) : cipher.decrypt(input);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+BENCHMARK(BM_ArmoredVigenere)->Arg(1)->Arg(0)->ArgNames({"encrypt"});
+
+} // namespace
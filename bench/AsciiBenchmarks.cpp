@@ -0,0 +1,111 @@
+#include "Ascii.h"
+#include "BenchmarkData.h"
+#include "CaesarCipher.h"
+#include "CipherKernels.h"
+#include "MorseCodeCipher.h"
+#include "ROT13Cipher.h"
+#include "SubstitutionCipher.h"
+#include "VigenereCipher.h"
+#include <benchmark/benchmark.h>
+#include <cctype>
+#include <random>
+
+namespace {
+
+const size_t CORPUS_BYTES = 1 << 20;
+
+// BenchmarkData::text() with utf8Percent of the characters replaced by 2-4 byte UTF-8
+// sequences (Latin-1 accents, CJK, emoji), like the mixed logs the tool is used on
+const std::string& mixedText(int utf8Percent) {
+    static std::string cached;
+    static int cachedPercent = -1;
+    if (cachedPercent == utf8Percent) return cached;
+
+    static const char* const multibyte[] = {"\xC3\xA9", "\xC3\xBC", "\xE6\x97\xA5", "\xE2\x82\xAC", "\xF0\x9F\x98\x80"};
+    const std::string& ascii = BenchmarkData::text(CORPUS_BYTES, 80);
+    std::mt19937 rng(static_cast<unsigned int>(utf8Percent));
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<int> pick(0, 4);
+
+    cached.clear();
+    for (size_t i = 0; cached.size() < CORPUS_BYTES; ++i) {
+        if (percent(rng) < utf8Percent) {
+            cached += multibyte[pick(rng)];
+        } else {
+            cached += ascii[i % ascii.size()];
+        }
+    }
+    cachedPercent = utf8Percent;
+    return cached;
+}
+
+void utf8Args(benchmark::internal::Benchmark* b) {
+    for (int percent : {0, 10, 50}) b->Arg(percent);
+    b->ArgNames({"utf8%"});
+}
+
+// The <cctype> call every cipher used to make, for comparison
+void BM_CountLettersCctype(benchmark::State& state) {
+    const std::string& text = mixedText(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        size_t letters = 0;
+        for (char c : text) letters += std::isalpha(static_cast<unsigned char>(c)) != 0;
+        benchmark::DoNotOptimize(letters);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+void BM_CountLettersTable(benchmark::State& state) {
+    const std::string& text = mixedText(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        size_t letters = 0;
+        for (char c : text) letters += Ascii::isAlpha(c);
+        benchmark::DoNotOptimize(letters);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+void BM_CountLettersKernel(benchmark::State& state) {
+    const std::string& text = mixedText(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CipherKernels::countLetters(text.data(), text.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+void BM_ValidateUtf8(benchmark::State& state) {
+    const std::string& text = mixedText(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Ascii::isValidUtf8(text.data(), text.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+template <typename Cipher> std::string mixedKey() { return ""; }
+template <> std::string mixedKey<CaesarCipher>() { return "7"; }
+template <> std::string mixedKey<VigenereCipher>() { return "SECRET"; }
+template <> std::string mixedKey<SubstitutionCipher>() { return "QWERTYUIOPASDFGHJKLZXCVBNM"; }
+template <> std::string mixedKey<MorseCodeCipher>() { return " "; }
+
+template <typename Cipher>
+void BM_EncryptMixedText(benchmark::State& state) {
+    const std::string& text = mixedText(static_cast<int>(state.range(0)));
+    Cipher cipher;
+    cipher.setKey(mixedKey<Cipher>());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cipher.encrypt(text));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_CountLettersCctype)->Apply(utf8Args);
+BENCHMARK(BM_CountLettersTable)->Apply(utf8Args);
+BENCHMARK(BM_CountLettersKernel)->Apply(utf8Args);
+BENCHMARK(BM_ValidateUtf8)->Apply(utf8Args);
+BENCHMARK_TEMPLATE(BM_EncryptMixedText, CaesarCipher)->Apply(utf8Args);
+BENCHMARK_TEMPLATE(BM_EncryptMixedText, VigenereCipher)->Apply(utf8Args);
+BENCHMARK_TEMPLATE(BM_EncryptMixedText, SubstitutionCipher)->Apply(utf8Args);
+BENCHMARK_TEMPLATE(BM_EncryptMixedText, ROT13Cipher)->Apply(utf8Args);
+BENCHMARK_TEMPLATE(BM_EncryptMixedText, MorseCodeCipher)->Apply(utf8Args);
@@ -0,0 +1,116 @@
+#include "AsyncCipher.h"
+#include "BenchmarkData.h"
+#include "IntegrityManifest.h"
+#include "VigenereCipher.h"
+#include "WorkStealingPool.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// The coroutine API needs C++20; with an older compiler only the rest of the suite is built
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const size_t MESSAGE_SIZE = 256;
+
+double microsecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+// Submission-to-completion latency percentiles over every request of the run
+void reportLatency(benchmark::State& state, std::vector<double>& latencies, size_t burst) {
+    std::sort(latencies.begin(), latencies.end());
+    state.counters["p50_us"] = latencies[latencies.size() / 2];
+    state.counters["p99_us"] = latencies[latencies.size() * 99 / 100];
+    state.SetItemsProcessed(state.iterations() * burst);
+}
+
+AsyncCipher::Task<double> timedEncrypt(CipherExecutor& executor, CipherAlgorithm& cipher, const std::string& message) {
+    Clock::time_point start = Clock::now();
+    std::string ciphertext = co_await AsyncCipher::encrypt(executor, cipher, message);
+    benchmark::DoNotOptimize(ciphertext);
+    co_return microsecondsSince(start);
+}
+
+// A burst of range(0) concurrent 256-byte encryptions awaited by coroutines
+void BM_AsyncEncryptBurst(benchmark::State& state) {
+    const size_t burst = static_cast<size_t>(state.range(0));
+    const std::string& message = BenchmarkData::text(MESSAGE_SIZE, 80);
+    VigenereCipher cipher;
+    cipher.setKey(BenchmarkData::key(16));
+    CipherExecutor executor;
+
+    std::vector<double> latencies;
+    for (auto _ : state) {
+        std::vector<AsyncCipher::Task<double>> tasks;
+        tasks.reserve(burst);
+        for (size_t i = 0; i < burst; ++i) tasks.push_back(timedEncrypt(executor, cipher, message));
+        std::vector<double> burstLatencies = AsyncCipher::syncWait(AsyncCipher::whenAll(std::move(tasks)));
+        latencies.insert(latencies.end(), burstLatencies.begin(), burstLatencies.end());
+    }
+    reportLatency(state, latencies, burst);
+    CipherExecutor::Stats stats = executor.stats();
+    state.counters["requests_per_batch"] = static_cast<double>(stats.requests) / std::max<uint64_t>(1, stats.batches);
+}
+
+// The same burst with the blocking API, one pool task per request
+void BM_BlockingEncryptBurst(benchmark::State& state) {
+    const size_t burst = static_cast<size_t>(state.range(0));
+    const std::string& message = BenchmarkData::text(MESSAGE_SIZE, 80);
+    VigenereCipher cipher;
+    cipher.setKey(BenchmarkData::key(16));
+    WorkStealingPool pool;
+
+    std::vector<double> latencies;
+    std::vector<double> burstLatencies(burst);
+    for (auto _ : state) {
+        for (size_t i = 0; i < burst; ++i) {
+            Clock::time_point start = Clock::now();
+            pool.submit([&, i, start]() {
+                benchmark::DoNotOptimize(cipher.encrypt(message));
+                burstLatencies[i] = microsecondsSince(start);
+            });
+        }
+        pool.wait();
+        latencies.insert(latencies.end(), burstLatencies.begin(), burstLatencies.end());
+    }
+    reportLatency(state, latencies, burst);
+}
+
+// processFile through the executor: chunks are encrypted while the rest is still read
+void BM_AsyncProcessFile(benchmark::State& state) {
+    const std::string input = BenchmarkData::tempPath("async_in.txt");
+    const std::string output = BenchmarkData::tempPath("async_out.txt");
+    BenchmarkData::writeFile(input, BenchmarkData::text(state.range(0), 80));
+    VigenereCipher cipher;
+    cipher.setKey(BenchmarkData::key(16));
+    CipherExecutor executor;
+
+    for (auto _ : state) {
+        auto run = [&]() -> AsyncCipher::Task<bool> {
+            co_return co_await AsyncCipher::processFile(executor, cipher, input, output, true);
+        };
+        if (!AsyncCipher::syncWait(run())) {
+            state.SkipWithError("processFile failed");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+    std::remove(IntegrityManifest::pathFor(output).c_str());
+}
+
+} // namespace
+
+BENCHMARK(BM_AsyncEncryptBurst)->Arg(100)->Arg(1000)->Arg(10000)->ArgName("requests")->UseRealTime();
+BENCHMARK(BM_BlockingEncryptBurst)->Arg(100)->Arg(1000)->Arg(10000)->ArgName("requests")->UseRealTime();
+BENCHMARK(BM_AsyncProcessFile)->Arg(1 << 20)->Arg(64 << 20)->ArgName("bytes")->UseRealTime();
+
+#endif // __cpp_impl_coroutine
@@ -0,0 +1,92 @@
+#include "BenchmarkData.h"
+#include "CaesarCipher.h"
+#include "MessageBatch.h"
+#include "SubstitutionCipher.h"
+#include "VigenereCipher.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+const size_t MESSAGES = 100000;
+
+// 20-200 byte messages cut from the benchmark text, each with its own key: a shift for
+// Caesar, 4-12 letters for Vigenère, a 10-26 letter keyword for substitution
+struct Workload {
+    std::vector<std::string> messages;
+    std::vector<std::string> keys;
+    MessageBatch batch;
+};
+
+const Workload& workload(MessageBatch::Cipher cipher) {
+    static std::unique_ptr<Workload> cached[3];
+    std::unique_ptr<Workload>& entry = cached[static_cast<int>(cipher)];
+    if (entry) return *entry;
+
+    entry.reset(new Workload);
+    const std::string& text = BenchmarkData::text(1 << 20, 80);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> length(20, 200);
+    std::uniform_int_distribution<size_t> start(0, text.size() - 200);
+    std::uniform_int_distribution<int> letter(0, 25);
+    for (size_t i = 0; i < MESSAGES; ++i) {
+        std::string key;
+        if (cipher == MessageBatch::Cipher::CAESAR) {
+            key = std::to_string(1 + letter(rng) % 25);
+        } else {
+            size_t keyLength = cipher == MessageBatch::Cipher::VIGENERE ? 4 + rng() % 9 : 10 + rng() % 17;
+            for (size_t k = 0; k < keyLength; ++k) key += static_cast<char>('A' + letter(rng));
+        }
+        entry->messages.push_back(text.substr(start(rng), length(rng)));
+        entry->keys.push_back(key);
+        entry->batch.add(entry->messages.back(), key);
+    }
+    return *entry;
+}
+
+std::unique_ptr<CipherAlgorithm> makeCipher(MessageBatch::Cipher cipher) {
+    switch (cipher) {
+        case MessageBatch::Cipher::VIGENERE: return std::unique_ptr<CipherAlgorithm>(new VigenereCipher());
+        case MessageBatch::Cipher::SUBSTITUTION: return std::unique_ptr<CipherAlgorithm>(new SubstitutionCipher());
+        default: return std::unique_ptr<CipherAlgorithm>(new CaesarCipher());
+    }
+}
+
+void reportMessages(benchmark::State& state, const Workload& work) {
+    state.SetItemsProcessed(state.iterations() * work.messages.size());
+    state.SetBytesProcessed(state.iterations() * work.batch.text().size());
+}
+
+// The loop the batch API replaces: setKey() and encrypt() per message
+void BM_BatchPerCall(benchmark::State& state) {
+    MessageBatch::Cipher cipher = static_cast<MessageBatch::Cipher>(state.range(0));
+    const Workload& work = workload(cipher);
+    std::unique_ptr<CipherAlgorithm> algorithm = makeCipher(cipher);
+    for (auto _ : state) {
+        for (size_t i = 0; i < work.messages.size(); ++i) {
+            algorithm->setKey(work.keys[i]);
+            benchmark::DoNotOptimize(algorithm->encrypt(work.messages[i]));
+        }
+    }
+    reportMessages(state, work);
+    state.SetLabel(MessageBatch::name(cipher));
+}
+
+template <void (MessageBatch::*process)(MessageBatch::Cipher, bool, std::string&) const>
+void BM_Batch(benchmark::State& state) {
+    MessageBatch::Cipher cipher = static_cast<MessageBatch::Cipher>(state.range(0));
+    const Workload& work = workload(cipher);
+    std::string output;
+    for (auto _ : state) {
+        (work.batch.*process)(cipher, true, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    reportMessages(state, work);
+    state.SetLabel(MessageBatch::name(cipher));
+}
+
+} // namespace
+
+// Argument: 0 Caesar, 1 Vigenère, 2 substitution
+BENCHMARK(BM_BatchPerCall)->DenseRange(0, 2)->ArgName("cipher")->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Batch, &MessageBatch::processScalar)->DenseRange(0, 2)->ArgName("cipher")->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Batch, &MessageBatch::process)->DenseRange(0, 2)->ArgName("cipher")->Unit(benchmark::kMillisecond);
@@ -0,0 +1,77 @@
+#ifndef BENCHMARKDATA_H
+#define BENCHMARKDATA_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#ifndef BENCH_CORPUS_DIR
+#define BENCH_CORPUS_DIR "bench"
+#endif
+
+namespace BenchmarkData {
+
+// Deterministic text where letterPercent of the bytes are letters (mixed case) and the
+// rest is digits, punctuation and spaces. The last generated text is cached because
+// Google Benchmark re-enters a benchmark several times while sizing its iterations.
+inline const std::string& text(size_t size, int letterPercent) {
+    static std::string cached;
+    static size_t cachedSize = 0;
+    static int cachedPercent = -1;
+    if (cachedSize == size && cachedPercent == letterPercent) return cached;
+
+    static const char others[] = "0123456789 .,;:!?-'\"()";
+    std::mt19937 rng(static_cast<unsigned int>(size * 131 + letterPercent));
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<int> letter(0, 25);
+    std::uniform_int_distribution<int> other(0, sizeof(others) - 2);
+
+    cached.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        if (percent(rng) < letterPercent) {
+            char base = (i & 7) == 0 ? 'A' : 'a';
+            cached[i] = static_cast<char>(base + letter(rng));
+        } else {
+            cached[i] = others[other(rng)];
+        }
+    }
+    cachedSize = size;
+    cachedPercent = letterPercent;
+    return cached;
+}
+
+inline std::string key(size_t length) {
+    static const char letters[] = "QWERTYUIOPASDFGHJKLZXCVBNM";
+    std::string result(length, 'A');
+    for (size_t i = 0; i < length; ++i) result[i] = letters[(i * 7) % 26];
+    return result;
+}
+
+inline std::string tempPath(const std::string& name) {
+    const char* dir = std::getenv("TMPDIR");
+    return std::string(dir ? dir : "/tmp") + "/et_bench_" + name;
+}
+
+inline void writeFile(const std::string& path, const std::string& contents) {
+    std::ofstream file(path, std::ios::binary);
+    file << contents;
+}
+
+// Swallows std::cout for functions that print their results
+class SilenceStdout {
+public:
+    SilenceStdout() : previous(std::cout.rdbuf(sink.rdbuf())) {}
+    ~SilenceStdout() { std::cout.rdbuf(previous); }
+
+private:
+    std::ostringstream sink;
+    std::streambuf* previous;
+};
+
+} // namespace BenchmarkData
+
+#endif // BENCHMARKDATA_H
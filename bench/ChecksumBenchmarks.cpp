@@ -0,0 +1,56 @@
+#include "BenchmarkData.h"
+#include "Checksum.h"
+#include "IntegrityManifest.h"
+#include "VigenereCipher.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+
+namespace {
+
+template <uint64_t (*hash)(const void*, size_t)>
+void BM_Checksum(benchmark::State& state) {
+    const std::string& data = BenchmarkData::text(static_cast<size_t>(state.range(0)), 80);
+    for (auto _ : state) benchmark::DoNotOptimize(hash(data.data(), data.size()));
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+uint64_t crc32c(const void* data, size_t size) {
+    return Checksum::crc32c(data, size);
+}
+
+uint64_t crc32cScalar(const void* data, size_t size) {
+    return Checksum::crc32cScalar(data, size);
+}
+
+BENCHMARK_TEMPLATE(BM_Checksum, crc32c)->Arg(4 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Checksum, crc32cScalar)->Arg(4 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Checksum, Checksum::xxh3)->Arg(4 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_Checksum, Checksum::xxh3Scalar)->Arg(4 << 10)->Arg(1 << 20);
+
+// verify on a 64 MB Vigenère file: pread, decrypt and digest per 1 MB chunk, nothing written
+void BM_Verify(benchmark::State& state) {
+    Digest digest = state.range(0) == 0 ? Digest::CRC32C : Digest::XXH3;
+    unsigned threads = static_cast<unsigned>(state.range(1));
+    std::string input = BenchmarkData::tempPath("verify_input");
+    std::string output = BenchmarkData::tempPath("verify_output");
+    BenchmarkData::writeFile(input, BenchmarkData::text(64 << 20, 80));
+
+    VigenereCipher cipher;
+    cipher.setKey(BenchmarkData::key(16));
+    cipher.processFile(input, output, true, digest);
+    bool ok = true;
+    for (auto _ : state) ok = IntegrityManifest::verify(cipher, output, threads).ok && ok;
+    if (!ok) state.SkipWithError("verify failed");
+    state.SetBytesProcessed(state.iterations() * (64 << 20));
+
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+    std::remove(IntegrityManifest::pathFor(output).c_str());
+}
+BENCHMARK(BM_Verify)
+    ->ArgsProduct({{0, 1}, {1, 2, 4}})
+    ->ArgNames({"xxh3", "threads"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
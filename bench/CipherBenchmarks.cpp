@@ -0,0 +1,92 @@
+#include "BenchmarkData.h"
+#include "CaesarCipher.h"
+#include "VigenereCipher.h"
+#include "SubstitutionCipher.h"
+#include "MorseCodeCipher.h"
+#include "ROT13Cipher.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+template <typename Cipher> std::string defaultKey() { return ""; }
+template <> std::string defaultKey<CaesarCipher>() { return "7"; }
+template <> std::string defaultKey<VigenereCipher>() { return "SECRET"; }
+template <> std::string defaultKey<SubstitutionCipher>() { return "QWERTYUIOPASDFGHJKLZXCVBNM"; }
+template <> std::string defaultKey<MorseCodeCipher>() { return " "; }
+
+// Morse output is ~5x its input, so its sweep stops before the largest sizes
+template <typename Cipher> int64_t maxSize() { return int64_t(1) << 30; }
+template <> int64_t maxSize<MorseCodeCipher>() { return int64_t(64) << 20; }
+
+// Arguments: {input bytes, percentage of letters}
+template <typename Cipher>
+void sizeAndDensityArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t size = 64; size <= maxSize<Cipher>(); size *= 16) b->Args({size, 80});
+    for (int density : {0, 25, 50, 75, 100}) b->Args({1 << 20, density});
+    b->ArgNames({"bytes", "letters%"});
+}
+
+template <typename Cipher>
+void BM_Encrypt(benchmark::State& state) {
+    const std::string& plaintext = BenchmarkData::text(state.range(0), static_cast<int>(state.range(1)));
+    Cipher cipher;
+    cipher.setKey(defaultKey<Cipher>());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cipher.encrypt(plaintext));
+    }
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+
+template <typename Cipher>
+void BM_Decrypt(benchmark::State& state) {
+    Cipher cipher;
+    cipher.setKey(defaultKey<Cipher>());
+    const std::string ciphertext =
+        cipher.encrypt(BenchmarkData::text(state.range(0), static_cast<int>(state.range(1))));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cipher.decrypt(ciphertext));
+    }
+    state.SetBytesProcessed(state.iterations() * ciphertext.size());
+}
+
+// Arguments: {input bytes, key length}
+template <typename Cipher>
+void BM_EncryptKeyLength(benchmark::State& state) {
+    const std::string& plaintext = BenchmarkData::text(state.range(0), 80);
+    Cipher cipher;
+    cipher.setKey(BenchmarkData::key(state.range(1)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cipher.encrypt(plaintext));
+    }
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+
+template <typename Cipher>
+void BM_SetKey(benchmark::State& state) {
+    Cipher cipher;
+    const std::string key = defaultKey<Cipher>();
+    for (auto _ : state) {
+        cipher.setKey(key);
+    }
+}
+
+} // namespace
+
+#define CIPHER_BENCHMARKS(Cipher)                                                                  \
+    BENCHMARK_TEMPLATE(BM_Encrypt, Cipher)->Apply(sizeAndDensityArgs<Cipher>)->UseRealTime();      \
+    BENCHMARK_TEMPLATE(BM_Decrypt, Cipher)->Apply(sizeAndDensityArgs<Cipher>)->UseRealTime();      \
+    BENCHMARK_TEMPLATE(BM_SetKey, Cipher)
+
+CIPHER_BENCHMARKS(CaesarCipher);
+CIPHER_BENCHMARKS(VigenereCipher);
+CIPHER_BENCHMARKS(SubstitutionCipher);
+CIPHER_BENCHMARKS(MorseCodeCipher);
+CIPHER_BENCHMARKS(ROT13Cipher);
+
+BENCHMARK_TEMPLATE(BM_EncryptKeyLength, VigenereCipher)
+    ->ArgsProduct({{1 << 20}, {1, 3, 16, 64, 256}})->ArgNames({"bytes", "keylen"});
+BENCHMARK_TEMPLATE(BM_EncryptKeyLength, SubstitutionCipher)
+    ->ArgsProduct({{1 << 20}, {1, 8, 26}})->ArgNames({"bytes", "keylen"});
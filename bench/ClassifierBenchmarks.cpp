@@ -0,0 +1,112 @@
+#include "BenchmarkData.h"
+#include "CaesarCipher.h"
+#include "CipherClassifier.h"
+#include "MorseCodeCipher.h"
+#include "SubstitutionCipher.h"
+#include "VigenereCipher.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+// Newline-separated records of about recordSize bytes: Vigenère corpus prose left as
+// plaintext or encrypted under a random Caesar, Vigenère, substitution or Morse key.
+// Empty if the corpus is missing.
+const std::string& records(size_t recordSize, size_t totalBytes) {
+    static std::string cached;
+    static size_t cachedRecordSize = 0, cachedTotal = 0;
+    if (cachedRecordSize == recordSize && cachedTotal == totalBytes) return cached;
+    cached.clear();
+    cachedRecordSize = recordSize;
+    cachedTotal = totalBytes;
+
+    std::string prose;
+    std::ifstream file(BENCH_CORPUS_DIR "/vigenere_corpus.txt");
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line[0] != '#') prose += line.substr(line.find('|') + 1) + " ";
+    }
+    if (prose.size() <= recordSize) return cached;
+
+    std::mt19937 rng(99);
+    CaesarCipher caesar;
+    VigenereCipher vigenere;
+    SubstitutionCipher substitution;
+    MorseCodeCipher morse;
+    morse.setKey(" ");
+    std::string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    while (cached.size() < totalBytes) {
+        std::string plaintext = prose.substr(rng() % (prose.size() - recordSize), recordSize);
+        switch (rng() % 5) {
+            case 0:
+                cached += plaintext;
+                break;
+            case 1:
+                caesar.setKey(std::to_string(1 + rng() % 25));
+                cached += caesar.encrypt(plaintext);
+                break;
+            case 2:
+                vigenere.setKey(BenchmarkData::key(4 + rng() % 9));
+                cached += vigenere.encrypt(plaintext);
+                break;
+            case 3:
+                std::shuffle(alphabet.begin(), alphabet.end(), rng);
+                substitution.setKey(alphabet);
+                cached += substitution.encrypt(plaintext);
+                break;
+            default:
+                cached += morse.encrypt(plaintext.substr(0, recordSize / 4));
+                break;
+        }
+        cached += '\n';
+    }
+    return cached;
+}
+
+// classify() alone, one call per record
+void BM_Classify(benchmark::State& state) {
+    const std::string& text = records(static_cast<size_t>(state.range(0)), 16 << 20);
+    if (text.empty()) {
+        state.SkipWithError("vigenere_corpus.txt not found");
+        return;
+    }
+    std::vector<std::pair<size_t, size_t>> ranges;
+    for (size_t begin = 0; begin < text.size();) {
+        size_t end = text.find('\n', begin);
+        ranges.emplace_back(begin, end - begin);
+        begin = end + 1;
+    }
+    for (auto _ : state) {
+        for (const auto& range : ranges) {
+            benchmark::DoNotOptimize(CipherClassifier::classify(text.data() + range.first, range.second));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetItemsProcessed(state.iterations() * ranges.size());
+}
+BENCHMARK(BM_Classify)->Arg(64)->Arg(256)->Arg(4 << 10)->ArgName("record")->Unit(benchmark::kMillisecond);
+
+// classifyPath() on a 64 MB file of 256-byte records, JSON lines written to /dev/null
+void BM_ClassifyRecords(benchmark::State& state) {
+    const std::string& text = records(256, 64 << 20);
+    if (text.empty()) {
+        state.SkipWithError("vigenere_corpus.txt not found");
+        return;
+    }
+    std::string input = BenchmarkData::tempPath("classify_records");
+    BenchmarkData::writeFile(input, text);
+    std::ofstream sink("/dev/null");
+    CipherClassifier::Options options;
+    options.threads = static_cast<unsigned>(state.range(0));
+    bool ok = true;
+    for (auto _ : state) ok = CipherClassifier::classifyPath(input, sink, options).threads > 0 && ok;
+    if (!ok) state.SkipWithError("classifyPath failed");
+    state.SetBytesProcessed(state.iterations() * text.size());
+    std::remove(input.c_str());
+}
+BENCHMARK(BM_ClassifyRecords)->Arg(1)->Arg(2)->Arg(4)->ArgName("threads")->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,122 @@
+#include "BenchmarkData.h"
+#include "BlockCompression.h"
+#include "CompressedCipher.h"
+#include "VigenereCipher.h"
+#include <benchmark/benchmark.h>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+const size_t CORPUS_BYTES = 8 << 20;
+
+// Log-style lines (timestamp, level, component, prose from the Vigenère corpus), the
+// kind of archive the compression stage is meant for. Empty if the corpus is missing.
+const std::string& logText() {
+    static std::string text;
+    if (!text.empty()) return text;
+
+    std::vector<std::string> words;
+    std::ifstream file(BENCH_CORPUS_DIR "/vigenere_corpus.txt");
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream prose(line.substr(line.find('|') + 1));
+        std::string word;
+        while (prose >> word) words.push_back(word);
+    }
+    if (words.empty()) return text;
+
+    static const char* const levels[] = {"INFO", "INFO", "INFO", "DEBUG", "WARN", "ERROR"};
+    static const char* const components[] = {"vault", "pipe", "container", "scheduler", "io"};
+    std::mt19937 rng(2024);
+    uint64_t timestamp = 1700000000000ULL;
+    while (text.size() < CORPUS_BYTES) {
+        timestamp += rng() % 5000;
+        text += std::to_string(timestamp) + " " + levels[rng() % 6] + " [" + components[rng() % 5] + "] ";
+        size_t count = 6 + rng() % 14;
+        size_t first = rng() % words.size();
+        for (size_t i = 0; i < count; ++i) text += words[(first + i) % words.size()] + (i + 1 < count ? " " : "\n");
+    }
+    return text;
+}
+
+void BM_Compress(benchmark::State& state) {
+    const std::string& text = logText();
+    if (text.empty()) {
+        state.SkipWithError("vigenere_corpus.txt not found");
+        return;
+    }
+    size_t compressedSize = 0;
+    for (auto _ : state) {
+        std::string compressed = BlockCompression::compress(text);
+        compressedSize = compressed.size();
+        benchmark::DoNotOptimize(compressed.data());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.counters["ratio"] = static_cast<double>(text.size()) / compressedSize;
+}
+BENCHMARK(BM_Compress)->Unit(benchmark::kMillisecond);
+
+void BM_Decompress(benchmark::State& state) {
+    const std::string& text = logText();
+    if (text.empty()) {
+        state.SkipWithError("vigenere_corpus.txt not found");
+        return;
+    }
+    std::string compressed = BlockCompression::compress(text);
+    std::string restored;
+    for (auto _ : state) {
+        bool ok = BlockCompression::decompress(compressed, restored);
+        benchmark::DoNotOptimize(ok);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_Decompress)->Unit(benchmark::kMillisecond);
+
+// Random bytes: the compressor should give up quickly and store blocks as they are
+void BM_CompressIncompressible(benchmark::State& state) {
+    std::string data(CORPUS_BYTES, '\0');
+    std::mt19937 rng(1);
+    for (char& c : data) c = static_cast<char>(rng());
+    for (auto _ : state) {
+        std::string compressed = BlockCompression::compress(data);
+        benchmark::DoNotOptimize(compressed.data());
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_CompressIncompressible)->Unit(benchmark::kMillisecond);
+
+// The combined stage (compress then Vigenère over all bytes) against the cipher alone;
+// rates are in plaintext bytes, and the compressed form has less for the cipher to do
+void BM_VigenereWithCompression(benchmark::State& state) {
+    const std::string& text = logText();
+    if (text.empty()) {
+        state.SkipWithError("vigenere_corpus.txt not found");
+        return;
+    }
+    bool compressed = state.range(0) != 0;
+    bool isEncryption = state.range(1) != 0;
+    std::unique_ptr<CipherAlgorithm> cipher = std::make_unique<VigenereCipher>(Alphabet::BYTES);
+    if (compressed) cipher = std::make_unique<CompressedCipher>(std::move(cipher));
+    cipher->setKey(BenchmarkData::key(16));
+
+    std::string input = isEncryption ? text : cipher->encrypt(text);
+    size_t outputSize = 0;
+    for (auto _ : state) {
+        std::string output = isEncryption ? cipher->encrypt(input) : cipher->decrypt(input);
+        outputSize = output.size();
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.counters["ratio"] = static_cast<double>(text.size()) / (isEncryption ? outputSize : input.size());
+}
+BENCHMARK(BM_VigenereWithCompression)
+    ->ArgsProduct({{0, 1}, {1, 0}})
+    ->ArgNames({"lz", "encrypt"})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,67 @@
+#include "BenchmarkData.h"
+#include "ChunkedContainer.h"
+#include "VigenereCipher.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+
+namespace {
+
+const uint64_t RANGE_OFFSET_FRACTION = 2;  // Read from the middle of the file
+const uint64_t RANGE_LENGTH = 1 << 20;
+
+// Writes the Vigenère-encrypted file in both formats once per size
+void prepareFiles(size_t size, const std::string& plainFile, const std::string& container) {
+    static size_t preparedSize = 0;
+    if (preparedSize == size) return;
+
+    VigenereCipher cipher;
+    cipher.setKey("SECRETKEY");
+    BenchmarkData::writeFile(plainFile + ".in", BenchmarkData::text(size, 80));
+    cipher.processFile(plainFile + ".in", plainFile, true);
+    ChunkedContainer::encryptFile(cipher, plainFile + ".in", container);
+    std::remove((plainFile + ".in").c_str());
+    preparedSize = size;
+}
+
+// Container: reads and decrypts only the chunks covering the range, O(range)
+void BM_ContainerRangeDecrypt(benchmark::State& state) {
+    const std::string plainFile = BenchmarkData::tempPath("range_whole.txt");
+    const std::string container = BenchmarkData::tempPath("range.etc");
+    prepareFiles(state.range(0), plainFile, container);
+
+    VigenereCipher cipher;
+    cipher.setKey("SECRETKEY");
+    std::string plaintext;
+    for (auto _ : state) {
+        ChunkedContainer::decryptRange(cipher, container, state.range(0) / RANGE_OFFSET_FRACTION, RANGE_LENGTH, plaintext);
+        benchmark::DoNotOptimize(plaintext);
+    }
+    state.SetBytesProcessed(state.iterations() * RANGE_LENGTH);
+}
+
+// processFile output: the key position depends on every earlier letter, so the whole
+// file is decrypted to get at the range, O(file)
+void BM_WholeFileRangeDecrypt(benchmark::State& state) {
+    const std::string plainFile = BenchmarkData::tempPath("range_whole.txt");
+    const std::string container = BenchmarkData::tempPath("range.etc");
+    const std::string output = BenchmarkData::tempPath("range_out.txt");
+    prepareFiles(state.range(0), plainFile, container);
+
+    VigenereCipher cipher;
+    cipher.setKey("SECRETKEY");
+    for (auto _ : state) {
+        cipher.processFile(plainFile, output, false);
+        std::ifstream file(output, std::ios::binary);
+        file.seekg(state.range(0) / RANGE_OFFSET_FRACTION);
+        std::string plaintext(RANGE_LENGTH, '\0');
+        file.read(&plaintext[0], RANGE_LENGTH);
+        benchmark::DoNotOptimize(plaintext);
+    }
+    state.SetBytesProcessed(state.iterations() * RANGE_LENGTH);
+    std::remove(output.c_str());
+}
+
+} // namespace
+
+BENCHMARK(BM_ContainerRangeDecrypt)->RangeMultiplier(4)->Range(8 << 20, 128 << 20)->ArgName("file_bytes")->UseRealTime();
+BENCHMARK(BM_WholeFileRangeDecrypt)->RangeMultiplier(4)->Range(8 << 20, 128 << 20)->ArgName("file_bytes")->UseRealTime();
@@ -0,0 +1,107 @@
+#include "BenchmarkData.h"
+#include "CryptanalysisEngine.h"
+#include "CaesarCipher.h"
+#include "SubstitutionCipher.h"
+#include "VigenereCipher.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+struct CorpusEntry {
+    std::string key;
+    std::string plaintext;
+};
+
+// bench/vigenere_corpus.txt: one "KEY|plaintext" entry per line
+const std::vector<CorpusEntry>& vigenereCorpus() {
+    static const std::vector<CorpusEntry> entries = [] {
+        std::vector<CorpusEntry> result;
+        std::ifstream file(BENCH_CORPUS_DIR "/vigenere_corpus.txt");
+        std::string line;
+        while (std::getline(file, line)) {
+            size_t bar = line.find('|');
+            if (line.empty() || line[0] == '#' || bar == std::string::npos) continue;
+            result.push_back({line.substr(0, bar), line.substr(bar + 1)});
+        }
+        return result;
+    }();
+    return entries;
+}
+
+std::string corpusText(size_t size) {
+    std::string text;
+    while (text.size() < size) {
+        for (const auto& entry : vigenereCorpus()) text += entry.plaintext + "\n";
+        if (vigenereCorpus().empty()) break;
+    }
+    return text;
+}
+
+// Accuracy over the known-key corpus; "recovered" is the fraction decrypted exactly
+void BM_BreakVigenereCorpus(benchmark::State& state) {
+    const auto& corpus = vigenereCorpus();
+    if (corpus.empty()) {
+        state.SkipWithError("vigenere_corpus.txt not found");
+        return;
+    }
+
+    std::vector<std::string> ciphertexts;
+    VigenereCipher cipher;
+    for (const auto& entry : corpus) {
+        cipher.setKey(entry.key);
+        ciphertexts.push_back(cipher.encrypt(entry.plaintext));
+    }
+
+    size_t recovered = 0;
+    for (auto _ : state) {
+        recovered = 0;
+        for (size_t i = 0; i < corpus.size(); ++i) {
+            if (CryptanalysisEngine::breakVigenere(ciphertexts[i]).plaintext == corpus[i].plaintext) ++recovered;
+        }
+    }
+    state.counters["recovered"] = static_cast<double>(recovered) / corpus.size();
+}
+
+void BM_BreakVigenereLarge(benchmark::State& state) {
+    const std::string plaintext = corpusText(state.range(0));
+    VigenereCipher cipher;
+    cipher.setKey("BENCHMARKINGKEY");
+    const std::string ciphertext = cipher.encrypt(plaintext);
+
+    bool correct = false;
+    for (auto _ : state) {
+        correct = CryptanalysisEngine::breakVigenere(ciphertext).plaintext == plaintext;
+    }
+    state.SetBytesProcessed(state.iterations() * ciphertext.size());
+    state.counters["correct"] = correct;
+}
+
+void BM_BreakCaesar(benchmark::State& state) {
+    CaesarCipher cipher;
+    cipher.setKey("11");
+    const std::string ciphertext = cipher.encrypt(corpusText(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CryptanalysisEngine::breakCaesar(ciphertext));
+    }
+    state.SetBytesProcessed(state.iterations() * ciphertext.size());
+}
+
+void BM_BreakSubstitution(benchmark::State& state) {
+    SubstitutionCipher cipher;
+    cipher.setKey("ZEBRASCDFGHIJKLMNOPQTUVWXY");
+    const std::string ciphertext = cipher.encrypt(corpusText(2000).substr(0, 2000));
+
+    double keysPerSecond = 0.0;
+    for (auto _ : state) {
+        keysPerSecond = CryptanalysisEngine::breakSubstitution(ciphertext).keysPerSecond;
+    }
+    state.counters["keys/s"] = keysPerSecond;
+}
+
+} // namespace
+
+BENCHMARK(BM_BreakVigenereCorpus)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BreakVigenereLarge)->Arg(1 << 20)->Arg(8 << 20)->ArgName("bytes")->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_BreakCaesar)->Arg(1 << 10)->Arg(1 << 20)->ArgName("bytes");
+BENCHMARK(BM_BreakSubstitution)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,87 @@
+#include "BenchmarkData.h"
+#include "DirectoryProcessor.h"
+#include "VigenereCipher.h"
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <string>
+#include <sys/stat.h>
+
+namespace {
+
+enum TreeShape {
+    TINY_FILES,   // 20,000 files of 512 bytes in 100 directories
+    HUGE_FILES    // 2 files of 64 MB
+};
+
+std::string treePath(int shape) {
+    return BenchmarkData::tempPath(shape == TINY_FILES ? "tree_tiny" : "tree_huge");
+}
+
+void removeTree(const std::string& path) {
+    std::string command = "rm -rf '" + path + "'";
+    if (std::system(command.c_str()) != 0) std::cerr << "Unable to remove " << path << std::endl;
+}
+
+// Synthetic trees are built once and removed at exit
+struct TreeCache {
+    bool built[2] = {false, false};
+    ~TreeCache() {
+        for (int shape = 0; shape < 2; ++shape) {
+            if (built[shape]) removeTree(treePath(shape));
+        }
+    }
+};
+
+const std::string& prepareTree(int shape) {
+    static TreeCache cache;
+    static std::string paths[2] = {treePath(TINY_FILES), treePath(HUGE_FILES)};
+    if (cache.built[shape]) return paths[shape];
+
+    const std::string& root = paths[shape];
+    removeTree(root);
+    mkdir(root.c_str(), 0755);
+    if (shape == TINY_FILES) {
+        const std::string& contents = BenchmarkData::text(512, 80);
+        for (int directory = 0; directory < 100; ++directory) {
+            std::string path = root + "/d" + std::to_string(directory);
+            mkdir(path.c_str(), 0755);
+            for (int file = 0; file < 200; ++file) {
+                BenchmarkData::writeFile(path + "/f" + std::to_string(file) + ".txt", contents);
+            }
+        }
+    } else {
+        const std::string& contents = BenchmarkData::text(64 << 20, 80);
+        BenchmarkData::writeFile(root + "/a.txt", contents);
+        BenchmarkData::writeFile(root + "/b.txt", contents);
+    }
+    cache.built[shape] = true;
+    return root;
+}
+
+// Arg 0 is the tree shape, arg 1 the thread count
+void BM_DirectoryEncrypt(benchmark::State& state) {
+    const std::string& input = prepareTree(static_cast<int>(state.range(0)));
+    const std::string output = BenchmarkData::tempPath("tree_out");
+    VigenereCipher cipher;
+    cipher.setKey("SECRETKEY");
+
+    DirectoryProcessor::Options options;
+    options.threads = static_cast<unsigned>(state.range(1));
+    options.resume = false;
+    DirectoryProcessor::Report report;
+    for (auto _ : state) {
+        report = DirectoryProcessor::process(cipher, input, output, true, options);
+    }
+    state.SetBytesProcessed(state.iterations() * report.bytes);
+    state.counters["files"] = static_cast<double>(report.files);
+    state.counters["steals"] = static_cast<double>(report.steals);
+    removeTree(output);
+}
+
+} // namespace
+
+BENCHMARK(BM_DirectoryEncrypt)
+    ->ArgsProduct({{TINY_FILES, HUGE_FILES}, {1, 2, 4, 8}})
+    ->ArgNames({"shape", "threads"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,34 @@
+#include "BenchmarkData.h"
+#include "CaesarCipher.h"
+#include "VigenereCipher.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+
+namespace {
+
+// End to end: read the input file, encrypt, write the output file
+template <typename Cipher>
+void BM_ProcessFile(benchmark::State& state) {
+    const std::string input = BenchmarkData::tempPath("process_in.txt");
+    const std::string output = BenchmarkData::tempPath("process_out.txt");
+    BenchmarkData::writeFile(input, BenchmarkData::text(state.range(0), 80));
+
+    Cipher cipher;
+    for (auto _ : state) {
+        if (!cipher.processFile(input, output, true)) {
+            state.SkipWithError("processFile failed");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_ProcessFile, CaesarCipher)
+    ->RangeMultiplier(16)->Range(1 << 10, 256 << 20)->ArgName("bytes")->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ProcessFile, VigenereCipher)
+    ->RangeMultiplier(16)->Range(1 << 10, 256 << 20)->ArgName("bytes")->UseRealTime();
@@ -0,0 +1,34 @@
+#include "BenchmarkData.h"
+#include "CaesarCipher.h"
+#include "FixedKeyCiphers.h"
+#include "ROT13Cipher.h"
+#include "SubstitutionCipher.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// Runtime-keyed ciphers are set to the same key the fixed variant bakes in
+template <typename Cipher> std::string runtimeKey() { return ""; }
+template <> std::string runtimeKey<CaesarCipher>() { return "3"; }
+template <> std::string runtimeKey<SubstitutionCipher>() { return "QWERTYUIOPASDFGHJKLZXCVBNM"; }
+
+template <typename Cipher>
+void BM_FixedVsRuntime(benchmark::State& state) {
+    const std::string& plaintext = BenchmarkData::text(state.range(0), 80);
+    Cipher cipher;
+    cipher.setKey(runtimeKey<Cipher>());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cipher.encrypt(plaintext));
+    }
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_FixedVsRuntime, CaesarCipher)->Arg(64)->Arg(4096)->Arg(1 << 20)->ArgName("bytes");
+BENCHMARK_TEMPLATE(BM_FixedVsRuntime, Caesar3Cipher)->Arg(64)->Arg(4096)->Arg(1 << 20)->ArgName("bytes");
+BENCHMARK_TEMPLATE(BM_FixedVsRuntime, ROT13Cipher)->Arg(64)->Arg(4096)->Arg(1 << 20)->ArgName("bytes");
+BENCHMARK_TEMPLATE(BM_FixedVsRuntime, FixedROT13Cipher)->Arg(64)->Arg(4096)->Arg(1 << 20)->ArgName("bytes");
+BENCHMARK_TEMPLATE(BM_FixedVsRuntime, SubstitutionCipher)->Arg(64)->Arg(4096)->Arg(1 << 20)->ArgName("bytes");
+BENCHMARK_TEMPLATE(BM_FixedVsRuntime, QwertySubstitutionCipher)->Arg(64)->Arg(4096)->Arg(1 << 20)->ArgName("bytes");
@@ -0,0 +1,82 @@
+#include "BenchmarkData.h"
+#include "CaesarCipher.h"
+#include "VigenereCipher.h"
+#include "SubstitutionCipher.h"
+#include "MorseCodeCipher.h"
+#include "ROT13Cipher.h"
+#include "KeyScheduleCache.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct VaultEntry {
+    int algorithm;
+    std::string key;
+    std::string encryptedPassword;
+};
+
+// Same algorithm order as EncryptionApp
+std::vector<std::unique_ptr<CipherAlgorithm>> makeAlgorithms() {
+    std::vector<std::unique_ptr<CipherAlgorithm>> algorithms;
+    algorithms.push_back(std::make_unique<CaesarCipher>());
+    algorithms.push_back(std::make_unique<VigenereCipher>());
+    algorithms.push_back(std::make_unique<SubstitutionCipher>());
+    algorithms.push_back(std::make_unique<MorseCodeCipher>());
+    algorithms.push_back(std::make_unique<ROT13Cipher>());
+    return algorithms;
+}
+
+// Entries spread over the five algorithms and a handful of keys each, like a real vault
+std::vector<VaultEntry> makeVault(int64_t entries, int distinctKeys) {
+    static const char* const keyBase[] = {"7", "SECRET", "ZEBRASCDFGHIJKLMNOPQTUVWXY", " ", ""};
+    auto algorithms = makeAlgorithms();
+    std::vector<VaultEntry> vault;
+    for (int64_t i = 0; i < entries; ++i) {
+        int algorithm = static_cast<int>(i % 5);
+        std::string key = keyBase[algorithm];
+        int variant = static_cast<int>((i / 5) % distinctKeys);
+        if (algorithm == 0) key = std::to_string(1 + variant % 25);
+        else if (algorithm == 1 || algorithm == 2) key += static_cast<char>('A' + variant % 26);
+        else if (algorithm == 3 && variant) key = std::string(1, static_cast<char>('a' + variant % 26));
+
+        algorithms[algorithm]->setKey(key);
+        std::string password = "Xq3!kP8$mL2@nZ9#" + std::to_string(i);
+        vault.push_back({algorithm, key, algorithms[algorithm]->encrypt(password)});
+    }
+    return vault;
+}
+
+void BM_VaultDecryptAll(benchmark::State& state) {
+    const std::vector<VaultEntry> vault = makeVault(state.range(0), 8);
+    auto algorithms = makeAlgorithms();
+
+    for (auto _ : state) {
+        for (const auto& entry : vault) {
+            algorithms[entry.algorithm]->setKey(entry.key);
+            benchmark::DoNotOptimize(algorithms[entry.algorithm]->decrypt(entry.encryptedPassword));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * vault.size());
+}
+
+void BM_VaultDecryptAllCached(benchmark::State& state) {
+    const std::vector<VaultEntry> vault = makeVault(state.range(0), 8);
+    auto algorithms = makeAlgorithms();
+    KeyScheduleCache cache;
+
+    for (auto _ : state) {
+        for (const auto& entry : vault) {
+            algorithms[entry.algorithm]->setKeyCached(entry.key, cache);
+            benchmark::DoNotOptimize(algorithms[entry.algorithm]->decrypt(entry.encryptedPassword));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * vault.size());
+    state.counters["hit_rate"] = static_cast<double>(cache.hits()) / (cache.hits() + cache.misses());
+}
+
+} // namespace
+
+BENCHMARK(BM_VaultDecryptAll)->Arg(10000)->Arg(100000)->ArgName("entries")->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_VaultDecryptAllCached)->Arg(10000)->Arg(100000)->ArgName("entries")->Unit(benchmark::kMillisecond);
@@ -0,0 +1,51 @@
+#include "BenchmarkData.h"
+#include "CaesarCipher.h"
+#include "Metrics.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+// Exposes the uninstrumented kernel so the probe cost can be isolated
+class RawCaesarCipher : public CaesarCipher {
+public:
+    using CaesarCipher::processText;
+};
+
+// Arguments: {input bytes, mode}: 0 = probe compiled out of the call path,
+// 1 = compiled in but disabled, 2 = counters and histograms, 3 = plus trace spans
+void BM_MetricsOverhead(benchmark::State& state) {
+    const std::string& plaintext = BenchmarkData::text(state.range(0), 80);
+    const int mode = static_cast<int>(state.range(1));
+    RawCaesarCipher cipher;
+    cipher.setKey("3");
+
+    Metrics::setEnabled(mode >= 2);
+    Metrics::setTracing(mode == 3);
+    Metrics::reset();
+
+    if (mode == 0) {
+        for (auto _ : state) benchmark::DoNotOptimize(cipher.processText(plaintext, true));
+    } else {
+        for (auto _ : state) benchmark::DoNotOptimize(cipher.encrypt(plaintext));
+    }
+
+    Metrics::setEnabled(false);
+    Metrics::reset();
+    state.SetBytesProcessed(state.iterations() * plaintext.size());
+}
+
+void BM_LatencyHistogramRecord(benchmark::State& state) {
+    static Metrics::LatencyHistogram histogram;
+    uint64_t value = 1;
+    for (auto _ : state) {
+        histogram.record(value);
+        value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+        value >>= 40;
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_MetricsOverhead)
+    ->ArgsProduct({{64, 4096}, {0, 1, 2, 3}})->ArgNames({"bytes", "mode"});
+BENCHMARK(BM_LatencyHistogramRecord);
@@ -0,0 +1,74 @@
+#include "BenchmarkData.h"
+#include "MorseCodec.h"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+const size_t TEXT_BYTES = 1 << 20;
+
+typedef void (*DecodeKernel)(const char*, size_t, std::string&);
+
+// Bytes processed is always the plaintext size, so every format and direction compares
+// directly; encoded_ratio is the encoded size per plaintext byte
+void reportSizes(benchmark::State& state, size_t plaintextBytes, size_t encodedBytes) {
+    state.SetBytesProcessed(state.iterations() * plaintextBytes);
+    state.counters["encoded_ratio"] = static_cast<double>(encodedBytes) / plaintextBytes;
+}
+
+void BM_MorseEncodeText(benchmark::State& state) {
+    const std::string& plaintext = BenchmarkData::text(TEXT_BYTES, static_cast<int>(state.range(0)));
+    std::string morse;
+    for (auto _ : state) {
+        morse.clear();
+        MorseCodec::encodeText(plaintext.data(), plaintext.size(), " ", morse);
+        benchmark::DoNotOptimize(morse.data());
+    }
+    reportSizes(state, plaintext.size(), morse.size());
+}
+
+template <DecodeKernel kernel>
+void BM_MorseDecodeText(benchmark::State& state) {
+    const std::string& plaintext = BenchmarkData::text(TEXT_BYTES, static_cast<int>(state.range(0)));
+    std::string morse;
+    MorseCodec::encodeText(plaintext.data(), plaintext.size(), " ", morse);
+    std::string decoded;
+    for (auto _ : state) {
+        decoded.clear();
+        kernel(morse.data(), morse.size(), decoded);
+        benchmark::DoNotOptimize(decoded.data());
+    }
+    reportSizes(state, plaintext.size(), morse.size());
+}
+
+void BM_MorseEncodeBinary(benchmark::State& state) {
+    const std::string& plaintext = BenchmarkData::text(TEXT_BYTES, static_cast<int>(state.range(0)));
+    std::string packed;
+    for (auto _ : state) {
+        packed.clear();
+        MorseCodec::encodeBinary(plaintext.data(), plaintext.size(), packed);
+        benchmark::DoNotOptimize(packed.data());
+    }
+    reportSizes(state, plaintext.size(), packed.size());
+}
+
+void BM_MorseDecodeBinary(benchmark::State& state) {
+    const std::string& plaintext = BenchmarkData::text(TEXT_BYTES, static_cast<int>(state.range(0)));
+    std::string packed;
+    MorseCodec::encodeBinary(plaintext.data(), plaintext.size(), packed);
+    std::string decoded;
+    for (auto _ : state) {
+        decoded.clear();
+        bool ok = MorseCodec::decodeBinary(packed.data(), packed.size(), decoded);
+        benchmark::DoNotOptimize(ok);
+    }
+    reportSizes(state, plaintext.size(), packed.size());
+}
+
+} // namespace
+
+// Argument: percentage of letters; the rest is digits, spaces and punctuation (dropped)
+BENCHMARK(BM_MorseEncodeText)->Arg(80)->Arg(100)->ArgName("letters%");
+BENCHMARK_TEMPLATE(BM_MorseDecodeText, MorseCodec::decodeText)->Arg(80)->Arg(100)->ArgName("letters%");
+BENCHMARK_TEMPLATE(BM_MorseDecodeText, MorseCodec::decodeTextScalar)->Arg(80)->Arg(100)->ArgName("letters%");
+BENCHMARK(BM_MorseEncodeBinary)->Arg(80)->Arg(100)->ArgName("letters%");
+BENCHMARK(BM_MorseDecodeBinary)->Arg(80)->Arg(100)->ArgName("letters%");
@@ -0,0 +1,295 @@
+#include "BenchmarkData.h"
+#include "KeyDerivation.h"
+#include "PasswordManager.h"
+#include "PasswordStrengthAnalyzer.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+
+namespace {
+
+std::string serviceName(int64_t index) {
+    return "service-" + std::to_string(index);
+}
+
+// Writes a vault file in PasswordManager's on-disk format. With changes > 0, that many
+// evenly spread entries are edited, deleted or replaced by a new service in turn.
+std::string makeVault(int64_t entries, int64_t changes = 0) {
+    const std::string path = BenchmarkData::tempPath("vault_" + std::to_string(entries) +
+                                                     (changes ? "_" + std::to_string(changes) : "") + ".txt");
+    const int64_t stride = changes ? entries / changes : entries + 1;
+    std::ofstream file(path);
+    for (int64_t i = 0; i < entries; ++i) {
+        int64_t change = i % stride == 0 ? i / stride % 3 + 1 : 0;
+        if (change == 2) continue;
+        file << (change == 3 ? "new-" : "") << serviceName(i) << "\n"
+             << "user" << i % 977 << "@example.com\n"
+             << "Xq3!kP8$mL2@nZ9#" << i << (change == 1 ? "-edited" : "") << "\n"
+             << i % 5 << "\n"
+             << "KEY" << i % 13 << "\n";
+    }
+    return path;
+}
+
+void BM_VaultLoad(benchmark::State& state) {
+    const std::string path = makeVault(state.range(0));
+    PasswordManager manager(path);
+
+    for (auto _ : state) {
+        manager.loadFromFile(path);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["bytes_per_entry"] = static_cast<double>(manager.memoryUsage()) / state.range(0);
+}
+
+void BM_VaultSave(benchmark::State& state) {
+    const std::string path = makeVault(state.range(0));
+    const std::string output = BenchmarkData::tempPath("vault_save.txt");
+    PasswordManager manager(path);
+
+    for (auto _ : state) {
+        manager.saveToFile(output);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::remove(output.c_str());
+}
+
+void BM_VaultLookup(benchmark::State& state) {
+    const int64_t entries = state.range(0);
+    const std::string path = makeVault(entries);
+    PasswordManager manager(path);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> pick(0, entries - 1);
+    std::vector<std::string> queries;
+    for (int i = 0; i < 1024; ++i) queries.push_back(serviceName(pick(rng)));
+
+    std::string encryptedPassword, algorithm, key;
+    size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.getPassword(queries[next++ & 1023], encryptedPassword, algorithm, key));
+    }
+}
+
+// Type-ahead query of 7-10 characters against the service index
+void BM_VaultPrefixSearch(benchmark::State& state) {
+    const int64_t entries = state.range(0);
+    PasswordManager manager(makeVault(entries));
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> pick(0, entries - 1);
+    std::vector<std::string> queries;
+    manager.search(PasswordManager::SearchField::SERVICE, "");  // Builds the index
+    for (int i = 0; i < 1024; ++i) {
+        std::string name = serviceName(pick(rng));
+        queries.push_back(name.substr(0, std::min<size_t>(name.size(), 7 + i % 4)));
+    }
+
+    size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.search(PasswordManager::SearchField::SERVICE, queries[next++ & 1023]));
+    }
+}
+
+// A known service name with one character replaced, searched at distance range(1)
+void BM_VaultFuzzySearch(benchmark::State& state) {
+    const int64_t entries = state.range(0);
+    PasswordManager manager(makeVault(entries));
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> pick(0, entries - 1);
+    std::vector<std::string> queries;
+    manager.search(PasswordManager::SearchField::SERVICE, "");
+    for (int i = 0; i < 1024; ++i) {
+        std::string name = serviceName(pick(rng));
+        name[rng() % name.size()] = 'x';
+        queries.push_back(name);
+    }
+
+    int maxDistance = static_cast<int>(state.range(1));
+    size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            manager.fuzzySearch(PasswordManager::SearchField::SERVICE, queries[next++ & 1023], maxDistance));
+    }
+}
+
+// First search on a freshly loaded vault, which builds both indexes
+void BM_VaultIndexBuild(benchmark::State& state) {
+    const std::string path = makeVault(state.range(0));
+    PasswordManager manager(path);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        manager.loadFromFile(path);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(manager.search(PasswordManager::SearchField::SERVICE, "service-1"));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Replica sync with range(1) changes between the vaults. The replica is brought in line
+// with two sources in turn, so every iteration sends and removes the same records.
+void BM_VaultSync(benchmark::State& state) {
+    const int64_t entries = state.range(0);
+    const int64_t changes = state.range(1);
+    const std::string replicaPath = BenchmarkData::tempPath("vault_replica.txt");
+    {
+        std::ifstream base(makeVault(entries));
+        std::ofstream copy(replicaPath);
+        copy << base.rdbuf();
+    }
+    PasswordManager original(makeVault(entries));
+    PasswordManager changed(makeVault(entries, changes));
+    PasswordManager replica(replicaPath);  // Saved back to its own file
+    const PasswordManager* sources[2] = {&changed, &original};
+    sources[1]->syncTo(replica);  // Builds all three trees
+
+    PasswordManager::SyncReport report;
+    size_t next = 0;
+    for (auto _ : state) {
+        report = sources[next++ & 1]->syncTo(replica);
+    }
+    state.counters["nodes_compared"] = static_cast<double>(report.nodesCompared);
+    state.counters["records_sent"] = static_cast<double>(report.recordsSent);
+    state.counters["records_removed"] = static_cast<double>(report.recordsRemoved);
+}
+
+// Hashing every record into the shard trees, paid by the first diff or sync of a vault
+void BM_VaultShardBuild(benchmark::State& state) {
+    const std::string path = makeVault(state.range(0));
+    PasswordManager manager(path);
+    PasswordManager empty(BenchmarkData::tempPath("vault_empty.txt"));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        manager.loadFromFile(path);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(manager.diff(empty));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+KeyDerivation::Params kdfParams(benchmark::State& state) {
+    KeyDerivation::Params params;
+    params.memoryKiB = static_cast<uint32_t>(state.range(0)) * 1024;
+    params.passes = static_cast<uint32_t>(state.range(1));
+    params.lanes = static_cast<uint32_t>(state.range(2));
+    return params;
+}
+
+// Unlock time against the KDF cost; the whole of it is Argon2id plus one tag check
+void BM_VaultUnlock(benchmark::State& state) {
+    const std::string path = makeVault(1000);
+    const std::string output = BenchmarkData::tempPath("vault_protected.txt");
+    PasswordManager::lockSession();
+    {
+        PasswordManager manager(path);
+        manager.saveToFile(output);
+        PasswordManager protectedVault(output);
+        protectedVault.protect("correct horse battery staple", kdfParams(state));
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        PasswordManager::lockSession();
+        PasswordManager manager(output);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(manager.unlock("correct horse battery staple"));
+    }
+    PasswordManager::lockSession();
+    std::remove(output.c_str());
+}
+
+// Reopening a vault later in the same session picks up the cached key with no KDF run
+void BM_VaultLoadUnlocked(benchmark::State& state) {
+    const std::string path = makeVault(state.range(0));
+    const std::string output = BenchmarkData::tempPath("vault_protected.txt");
+    PasswordManager::lockSession();
+    {
+        PasswordManager manager(path);
+        manager.saveToFile(output);
+        PasswordManager protectedVault(output);
+        KeyDerivation::Params params;
+        params.memoryKiB = 8 * 1024;
+        params.passes = 1;
+        protectedVault.protect("correct horse battery staple", params);
+    }
+
+    for (auto _ : state) {
+        PasswordManager manager(output);
+        benchmark::DoNotOptimize(manager.isUnlocked());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    PasswordManager::lockSession();
+    std::remove(output.c_str());
+}
+
+// Lookup with the entry key unwrapped (ChaCha20-Poly1305 open) on every hit
+void BM_VaultLookupWrapped(benchmark::State& state) {
+    const int64_t entries = state.range(0);
+    const std::string output = BenchmarkData::tempPath("vault_protected.txt");
+    PasswordManager::lockSession();
+    {
+        PasswordManager manager(makeVault(entries));
+        manager.saveToFile(output);
+    }
+    PasswordManager manager(output);
+    KeyDerivation::Params params;
+    params.memoryKiB = 8 * 1024;
+    params.passes = 1;
+    manager.protect("correct horse battery staple", params);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int64_t> pick(0, entries - 1);
+    std::vector<std::string> queries;
+    for (int i = 0; i < 1024; ++i) queries.push_back(serviceName(pick(rng)));
+
+    std::string encryptedPassword, algorithm, key;
+    size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.getPassword(queries[next++ & 1023], encryptedPassword, algorithm, key));
+    }
+    PasswordManager::lockSession();
+    std::remove(output.c_str());
+}
+
+void BM_AnalyzeStrength(benchmark::State& state) {
+    const std::string password = PasswordStrengthAnalyzer::generateSecurePassword(static_cast<int>(state.range(0)));
+    BenchmarkData::SilenceStdout silence;
+
+    for (auto _ : state) {
+        PasswordStrengthAnalyzer::analyzeStrength(password);
+    }
+}
+
+void BM_GenerateSecurePassword(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PasswordStrengthAnalyzer::generateSecurePassword(static_cast<int>(state.range(0))));
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_VaultLoad)->RangeMultiplier(10)->Range(1000, 1000000)->ArgName("entries")->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_VaultSave)->RangeMultiplier(10)->Range(1000, 1000000)->ArgName("entries")->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_VaultLookup)->RangeMultiplier(10)->Range(1000, 1000000)->ArgName("entries");
+BENCHMARK(BM_VaultPrefixSearch)->RangeMultiplier(10)->Range(1000, 1000000)->ArgName("entries");
+BENCHMARK(BM_VaultFuzzySearch)
+    ->ArgsProduct({{1000, 100000, 1000000}, {1, 2, 3}})
+    ->ArgNames({"entries", "distance"})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_VaultIndexBuild)->RangeMultiplier(10)->Range(1000, 1000000)->ArgName("entries")->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_VaultSync)
+    ->ArgsProduct({{10000, 100000, 1000000}, {10, 1000}})
+    ->ArgNames({"entries", "changes"})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_VaultShardBuild)->RangeMultiplier(10)->Range(1000, 1000000)->ArgName("entries")->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_VaultUnlock)
+    ->ArgsProduct({{16, 64, 256}, {1, 3}, {1, 4}})
+    ->ArgNames({"MiB", "passes", "lanes"})
+    ->Unit(benchmark::kMillisecond)
+    ->Iterations(3);
+BENCHMARK(BM_VaultLoadUnlocked)->RangeMultiplier(10)->Range(1000, 100000)->ArgName("entries")->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_VaultLookupWrapped)->RangeMultiplier(10)->Range(1000, 100000)->ArgName("entries");
+BENCHMARK(BM_AnalyzeStrength)->Arg(8)->Arg(16)->Arg(50)->ArgName("length");
+BENCHMARK(BM_GenerateSecurePassword)->Arg(8)->Arg(16)->Arg(50)->ArgName("length");
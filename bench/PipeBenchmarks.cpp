@@ -0,0 +1,82 @@
+#include "BenchmarkData.h"
+#include "CaesarCipher.h"
+#include "PipeProcessor.h"
+#include "VigenereCipher.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+const size_t STREAM_BYTES = 256 << 20;
+const size_t PRODUCER_CHUNK = 4 << 20;
+
+enum PipeCipher {
+    CAESAR,
+    VIGENERE
+};
+
+// A producer thread feeds STREAM_BYTES into one pipe and a consumer thread drains the
+// other, standing in for the processes on either side of a shell pipeline.
+// Arg 0 selects the cipher, arg 1 turns vmsplice on or off
+void BM_PipeThroughput(benchmark::State& state) {
+    std::unique_ptr<CipherAlgorithm> cipher;
+    if (state.range(0) == CAESAR) {
+        cipher.reset(new CaesarCipher());
+        cipher->setKey("3");
+    } else {
+        cipher.reset(new VigenereCipher());
+        cipher->setKey("SECRETKEY");
+    }
+    const std::string& chunk = BenchmarkData::text(PRODUCER_CHUNK, 80);
+    PipeProcessor::Options options;
+    options.zeroCopy = state.range(1) != 0;
+
+    PipeProcessor::Report report;
+    for (auto _ : state) {
+        int input[2], output[2];
+        if (pipe(input) != 0 || pipe(output) != 0) {
+            state.SkipWithError("pipe() failed");
+            break;
+        }
+        std::thread producer([&]() {
+            for (size_t sent = 0; sent < STREAM_BYTES; sent += chunk.size()) {
+                const char* data = chunk.data();
+                size_t left = chunk.size();
+                while (left > 0) {
+                    ssize_t n = write(input[1], data, left);
+                    if (n <= 0) break;
+                    data += n;
+                    left -= static_cast<size_t>(n);
+                }
+            }
+            close(input[1]);
+        });
+        std::thread consumer([&]() {
+            std::vector<char> sink(1 << 20);
+            while (read(output[0], sink.data(), sink.size()) > 0) {}
+        });
+
+        report = PipeProcessor::run(*cipher, true, input[0], output[1], options);
+        close(output[1]);
+        producer.join();
+        consumer.join();
+        close(input[0]);
+        close(output[0]);
+    }
+    state.SetBytesProcessed(state.iterations() * report.bytesIn);
+    state.counters["read_busy"] = report.readBusy;
+    state.counters["cipher_busy"] = report.cipherBusy;
+    state.counters["write_busy"] = report.writeBusy;
+    state.SetLabel(report.mode);
+}
+
+} // namespace
+
+BENCHMARK(BM_PipeThroughput)
+    ->ArgsProduct({{CAESAR, VIGENERE}, {0, 1}})
+    ->ArgNames({"cipher", "zero_copy"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
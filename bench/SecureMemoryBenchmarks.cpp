@@ -0,0 +1,63 @@
+#include "SecureMemory.h"
+#include "VigenereCipher.h"
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// Allocate, fill and free 64 buffers per iteration, like a burst of key and password
+// copies; every thread works at once to load the pool's locks
+template <typename Allocator>
+void BM_AllocateRelease(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    Allocator allocator;
+    std::vector<char*> buffers(64);
+    for (auto _ : state) {
+        for (char*& buffer : buffers) {
+            buffer = allocator.allocate(size);
+            std::memset(buffer, 0x5A, size);
+        }
+        benchmark::ClobberMemory();
+        for (char* buffer : buffers) allocator.deallocate(buffer, size);
+    }
+    state.SetItemsProcessed(state.iterations() * buffers.size());
+}
+
+// A Vigenère-sized key schedule (struct plus key stream), built and dropped
+template <typename Allocator>
+void BM_ScheduleLifetime(benchmark::State& state) {
+    struct Schedule {
+        std::vector<uint8_t, typename std::allocator_traits<Allocator>::template rebind_alloc<uint8_t>> stream;
+    };
+    using ScheduleAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Schedule>;
+    const size_t keyLength = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        auto schedule = std::allocate_shared<Schedule>(ScheduleAllocator());
+        schedule->stream.assign(keyLength + 64, 7);
+        benchmark::DoNotOptimize(schedule->stream.data());
+    }
+}
+
+// End to end: parse a key into a schedule (always secure now)
+void BM_VigenereSetKey(benchmark::State& state) {
+    VigenereCipher cipher;
+    std::string key(static_cast<size_t>(state.range(0)), 'K');
+    for (auto _ : state) {
+        cipher.setKey(key);
+    }
+}
+
+void sizeArgs(benchmark::internal::Benchmark* b) {
+    for (int size : {32, 256, 4096, 65536}) b->Arg(size);
+    b->ArgNames({"bytes"});
+    b->ThreadRange(1, 4);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_AllocateRelease, std::allocator<char>)->Apply(sizeArgs);
+BENCHMARK_TEMPLATE(BM_AllocateRelease, SecureAllocator<char>)->Apply(sizeArgs);
+BENCHMARK_TEMPLATE(BM_ScheduleLifetime, std::allocator<char>)->Arg(8)->Arg(256)->ArgName("key");
+BENCHMARK_TEMPLATE(BM_ScheduleLifetime, SecureAllocator<char>)->Arg(8)->Arg(256)->ArgName("key");
+BENCHMARK(BM_VigenereSetKey)->Arg(8)->Arg(256)->ArgName("key");
@@ -0,0 +1,52 @@
+#ifndef AEADCIPHER_H
+#define AEADCIPHER_H
+
+#include "CipherAlgorithm.h"
+#include "SecureMemory.h"
+#include <array>
+#include <cstdint>
+#include <iostream>
+
+// ChaCha20-Poly1305 with chunked framing. Output is a 24-byte header followed by
+// independently sealed chunks (ciphertext + 16-byte tag). Each chunk's nonce and
+// associated data bind it to its index and to whether it is the last one, so chunks
+// can be sealed/opened in parallel or streamed, but not reordered, dropped or truncated.
+class AeadCipher : public CipherAlgorithm {
+private:
+    struct Schedule : KeySchedule {
+        std::array<uint8_t, 32> key;
+    };
+
+    std::shared_ptr<const Schedule> schedule;  // No usable default; encrypt fails until a key is set
+    size_t chunkSize = DEFAULT_CHUNK_SIZE;
+
+protected:
+    std::string processText(const std::string& text, bool isEncryption) override;
+    bool processChecked(const std::string& text, bool isEncryption, std::string& result) override;
+
+public:
+    static const size_t HEADER_SIZE = 24;
+    static const size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+    // Headers naming a larger chunk are rejected, so a crafted header cannot force a
+    // huge buffer; setChunkSize() clamps to it
+    static const size_t MAX_CHUNK_SIZE = 64 * 1024 * 1024;
+
+    void setChunkSize(size_t size);
+    size_t getChunkSize() const { return chunkSize; }
+
+    // Chunk-at-a-time versions for data that should not be held in memory at once
+    bool encryptStream(std::istream& input, std::ostream& output);
+    bool decryptStream(std::istream& input, std::ostream& output);
+
+    static std::string generateKey();  // 64 random hex digits
+
+    bool isAuthenticated() const override;
+    uint64_t keyFingerprint() override;  // Encryption is randomized, so the probe would differ every time
+    std::shared_ptr<const KeySchedule> compileKey(const std::string& key) const override;
+    void applySchedule(const std::shared_ptr<const KeySchedule>& schedule) override;
+    const char* getName() const override;
+    std::string getDescription() const override;
+    std::string getKeyInstructions() const override;
+};
+
+#endif // AEADCIPHER_H
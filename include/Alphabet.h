@@ -0,0 +1,32 @@
+#ifndef ALPHABET_H
+#define ALPHABET_H
+
+#include <string>
+
+// Character sets the Caesar and Vigenère engines rotate within. Characters outside the
+// alphabet pass through unchanged and do not advance a Vigenère key.
+//   LETTERS       A-Z and a-z separately, case preserved (26; the classic ciphers)
+//   ALPHANUMERIC  0-9A-Za-z as one ring (62)
+//   PRINTABLE     space through '~' (95)
+//   BYTES         every byte value, modulo 256; the output is binary
+enum class Alphabet {
+    LETTERS,
+    ALPHANUMERIC,
+    PRINTABLE,
+    BYTES
+};
+
+const int ALPHABET_COUNT = 4;
+
+namespace Alphabets {
+
+int size(Alphabet alphabet);
+const char* name(Alphabet alphabet);               // "letters", "alnum", "printable", "bytes"
+bool parse(const std::string& name, Alphabet& alphabet);
+
+// Position of c in the alphabet (case-insensitive for LETTERS), or -1
+int indexOf(Alphabet alphabet, char c);
+
+} // namespace Alphabets
+
+#endif // ALPHABET_H
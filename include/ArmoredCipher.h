@@ -0,0 +1,42 @@
+#ifndef ARMOREDCIPHER_H
+#define ARMOREDCIPHER_H
+
+#include "CipherAlgorithm.h"
+#include "TextArmor.h"
+
+// Wraps another cipher so its ciphertext is written as hex or Base64 text and read
+// back from it. The key, schedule and stream state are the inner cipher's; the name is
+// the inner name with "+hex" or "+base64" appended.
+class ArmoredCipher : public CipherAlgorithm {
+private:
+    std::unique_ptr<CipherAlgorithm> inner;
+    Armor armor;
+    const char* name;
+
+    std::string armored(const std::string& ciphertext) const;
+    bool unarmored(const std::string& text, std::string& ciphertext) const;
+
+protected:
+    std::string processText(const std::string& text, bool isEncryption) override;
+    bool processChecked(const std::string& text, bool isEncryption, std::string& result) override;
+    std::string processTextAt(const std::string& text, bool isEncryption, uint64_t state) override;
+
+public:
+    ArmoredCipher(std::unique_ptr<CipherAlgorithm> inner, Armor armor);
+
+    CipherAlgorithm& getInner() { return *inner; }
+    Armor getArmor() const { return armor; }
+
+    uint64_t advanceState(const std::string& plaintext, uint64_t state) const override;
+    bool hasStreamState() const override;
+    bool isLossless() const override;
+    bool isAuthenticated() const override;
+    uint64_t keyFingerprint() override;
+    std::shared_ptr<const KeySchedule> compileKey(const std::string& key) const override;
+    void applySchedule(const std::shared_ptr<const KeySchedule>& schedule) override;
+    const char* getName() const override;
+    std::string getDescription() const override;
+    std::string getKeyInstructions() const override;
+};
+
+#endif // ARMOREDCIPHER_H
@@ -0,0 +1,40 @@
+#ifndef ASCII_H
+#define ASCII_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Locale-independent character classification for the ciphers. Unlike <cctype> it is
+// defined for every char value: bytes 0x80-0xFF (UTF-8 lead and continuation bytes)
+// belong to no class, so letter-only cipher loops leave multibyte text untouched.
+namespace Ascii {
+
+enum Class : uint8_t {
+    UPPER = 1,
+    LOWER = 2,
+    DIGIT = 4,
+    SPACE = 8,
+    PUNCT = 16
+};
+
+extern const uint8_t CLASSES[256];
+
+inline uint8_t classOf(char c) { return CLASSES[static_cast<unsigned char>(c)]; }
+inline bool isAlpha(char c) { return (classOf(c) & (UPPER | LOWER)) != 0; }
+inline bool isUpper(char c) { return (classOf(c) & UPPER) != 0; }
+inline bool isLower(char c) { return (classOf(c) & LOWER) != 0; }
+inline bool isDigit(char c) { return (classOf(c) & DIGIT) != 0; }
+inline bool isSpace(char c) { return (classOf(c) & SPACE) != 0; }
+inline char toUpper(char c) { return isLower(c) ? static_cast<char>(c - 0x20) : c; }
+inline char toLower(char c) { return isUpper(c) ? static_cast<char>(c + 0x20) : c; }
+
+// Length of the well-formed multibyte UTF-8 sequence starting at data (2-4), or 0 when
+// data starts with an ASCII byte or with bytes that are not valid UTF-8
+size_t utf8SequenceLength(const char* data, size_t size);
+
+// Runs of ASCII are skipped a vector at a time; only multibyte sequences are decoded
+bool isValidUtf8(const char* data, size_t size);
+
+} // namespace Ascii
+
+#endif // ASCII_H
@@ -0,0 +1,227 @@
+#ifndef ASYNCCIPHER_H
+#define ASYNCCIPHER_H
+
+#include "CipherExecutor.h"
+
+// C++20 coroutine front end for CipherExecutor. The library itself builds as C++14, so
+// this part only exists for code compiled with coroutine support:
+//
+//   AsyncCipher::Task<std::string> seal(CipherExecutor& executor, CipherAlgorithm& cipher,
+//                                       std::string message) {
+//       std::string ciphertext = co_await AsyncCipher::encrypt(executor, cipher, std::move(message));
+//       co_return ciphertext;
+//   }
+//
+// Task<T> is lazy: it starts when awaited. Awaiting an encryption suspends the caller
+// without holding a thread, and the caller resumes on the executor thread that finished
+// the work. whenAll() runs many tasks at once and syncWait() blocks a thread that is not
+// a coroutine until a task is done.
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace AsyncCipher {
+
+template <typename T>
+class Task {
+public:
+    struct promise_type {
+        std::optional<T> value;
+        std::coroutine_handle<> continuation;
+
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        // Hands control straight to the awaiting coroutine instead of nesting a resume()
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                std::coroutine_handle<> next = handle.promise().continuation;
+                return next ? next : std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_value(T result) { value = std::move(result); }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+    ~Task() {
+        if (handle) handle.destroy();
+    }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+    T await_resume() { return std::move(*handle.promise().value); }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Awaits one executor request; the result is filled in before the coroutine resumes
+class TextRequest {
+public:
+    TextRequest(CipherExecutor& executor, CipherAlgorithm& cipher, bool isEncryption, std::string text)
+        : executor(executor), cipher(cipher), isEncryption(isEncryption), text(std::move(text)) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> awaiting) {
+        executor.submit(cipher, isEncryption, std::move(text), [this, awaiting](std::string output) {
+            result = std::move(output);
+            awaiting.resume();
+        });
+    }
+    std::string await_resume() { return std::move(result); }
+
+private:
+    CipherExecutor& executor;
+    CipherAlgorithm& cipher;
+    bool isEncryption;
+    std::string text;
+    std::string result;
+};
+
+class FileRequest {
+public:
+    FileRequest(CipherExecutor& executor, CipherAlgorithm& cipher, std::string inputFilename,
+                std::string outputFilename, bool isEncryption, Digest digest)
+        : executor(executor), cipher(cipher), inputFilename(std::move(inputFilename)),
+          outputFilename(std::move(outputFilename)), isEncryption(isEncryption), digest(digest) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> awaiting) {
+        executor.submitFile(cipher, inputFilename, outputFilename, isEncryption, [this, awaiting](bool ok) {
+            result = ok;
+            awaiting.resume();
+        }, digest);
+    }
+    bool await_resume() const noexcept { return result; }
+
+private:
+    CipherExecutor& executor;
+    CipherAlgorithm& cipher;
+    std::string inputFilename;
+    std::string outputFilename;
+    bool isEncryption;
+    Digest digest;
+    bool result = false;
+};
+
+inline TextRequest encrypt(CipherExecutor& executor, CipherAlgorithm& cipher, std::string plaintext) {
+    return TextRequest(executor, cipher, true, std::move(plaintext));
+}
+
+inline TextRequest decrypt(CipherExecutor& executor, CipherAlgorithm& cipher, std::string ciphertext) {
+    return TextRequest(executor, cipher, false, std::move(ciphertext));
+}
+
+// Same result and checksum file as CipherAlgorithm::processFile()
+inline FileRequest processFile(CipherExecutor& executor, CipherAlgorithm& cipher, std::string inputFilename,
+                               std::string outputFilename, bool isEncryption, Digest digest = Digest::CRC32C) {
+    return FileRequest(executor, cipher, std::move(inputFilename), std::move(outputFilename), isEncryption, digest);
+}
+
+namespace detail {
+
+// Starts as soon as it is called and frees itself when it returns
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+template <typename T>
+struct Join {
+    std::vector<std::optional<T>> results;
+    std::atomic<size_t> remaining;
+    std::coroutine_handle<> parent;
+};
+
+template <typename T>
+Detached runJoined(Task<T>& task, Join<T>& join, size_t index) {
+    join.results[index] = co_await task;
+    if (join.remaining.fetch_sub(1) == 1) join.parent.resume();
+}
+
+template <typename T>
+class JoinAll {
+public:
+    explicit JoinAll(std::vector<Task<T>>& tasks) : tasks(tasks) {}
+
+    bool await_ready() const noexcept { return tasks.empty(); }
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        join.results.resize(tasks.size());
+        join.remaining = tasks.size() + 1;  // One more for this call, so none can finish the join early
+        join.parent = awaiting;
+        for (size_t i = 0; i < tasks.size(); ++i) runJoined(tasks[i], join, i);
+        return join.remaining.fetch_sub(1) != 1;
+    }
+    std::vector<T> await_resume() {
+        std::vector<T> values;
+        values.reserve(join.results.size());
+        for (std::optional<T>& result : join.results) values.push_back(std::move(*result));
+        return values;
+    }
+
+private:
+    std::vector<Task<T>>& tasks;
+    Join<T> join;
+};
+
+template <typename T>
+Detached signalWhenDone(Task<T>& task, std::optional<T>& result, std::mutex& mutex, std::condition_variable& done) {
+    T value = co_await task;
+    std::lock_guard<std::mutex> lock(mutex);
+    result = std::move(value);
+    done.notify_one();
+}
+
+} // namespace detail
+
+// Runs every task concurrently; results come back in the order of tasks
+template <typename T>
+Task<std::vector<T>> whenAll(std::vector<Task<T>> tasks) {
+    co_return co_await detail::JoinAll<T>(tasks);
+}
+
+template <typename T>
+T syncWait(Task<T> task) {
+    std::optional<T> result;
+    std::mutex mutex;
+    std::condition_variable done;
+    detail::signalWhenDone(task, result, mutex, done);
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&result]() { return result.has_value(); });
+    return std::move(*result);
+}
+
+} // namespace AsyncCipher
+
+#endif // __cpp_impl_coroutine
+
+#endif // ASYNCCIPHER_H
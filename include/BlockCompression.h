@@ -0,0 +1,45 @@
+#ifndef BLOCKCOMPRESSION_H
+#define BLOCKCOMPRESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Fast LZ77 compression for the data in front of a cipher. Input is cut into blocks of
+// up to 64 KB that are compressed independently (LZ4 block format, matches never reach
+// into another block), so blocks can be produced and consumed by separate threads or one
+// at a time from a stream. Each block is framed by an 8-byte header: the raw size and the
+// stored size as little-endian 32-bit values, with the top bit of the stored size set
+// when compression did not help and the bytes are stored as they are.
+namespace BlockCompression {
+
+const size_t BLOCK_SIZE = 64 * 1024;
+const size_t HEADER_SIZE = 8;
+
+// Appends one framed block; size is at most BLOCK_SIZE
+void compressBlock(const char* data, size_t size, std::string& out);
+
+// Whole buffers. Both split the work across threads for inputs of several MB.
+std::string compress(const std::string& data);
+bool decompress(const std::string& data, std::string& out);  // False on malformed input
+
+// Raw LZ4 block payloads, without the framing. compressPayload() needs room for
+// maxPayloadSize(size) bytes; decompressPayload() succeeds only when the payload
+// expands to exactly rawSize bytes.
+size_t maxPayloadSize(size_t size);
+size_t compressPayload(const uint8_t* data, size_t size, uint8_t* out);
+bool decompressPayload(const uint8_t* payload, size_t size, uint8_t* out, size_t rawSize);
+
+// Decompresses a framed stream fed in arbitrary pieces
+class Decoder {
+public:
+    bool update(const char* data, size_t size, std::string& out);
+    bool finish();  // False if the stream ended inside a block
+
+private:
+    std::string pending;
+};
+
+} // namespace BlockCompression
+
+#endif // BLOCKCOMPRESSION_H
@@ -1,17 +1,32 @@
 #ifndef CAESARCIPHER_H
 #define CAESARCIPHER_H
 
+#include "Alphabet.h"
 #include "CipherAlgorithm.h"
+#include "SecureMemory.h"
 
 class CaesarCipher : public CipherAlgorithm {
 private:
-    int shift = 3;  // Default shift value
+    struct Schedule : KeySchedule {
+        int shift;  // As entered; reduced modulo the alphabet size when applied
+        explicit Schedule(int shift) : shift(shift) {}
+    };
+    
+    std::shared_ptr<const Schedule> schedule = makeSecureShared<Schedule>(3);  // Default shift value
+    Alphabet alphabet;
 
 protected:
     std::string processText(const std::string& text, bool isEncryption) override;
 
 public:
-    void setKey(const std::string& key) override;
+    explicit CaesarCipher(Alphabet alphabet = Alphabet::LETTERS);
+    void setAlphabet(Alphabet newAlphabet) { alphabet = newAlphabet; }
+    Alphabet getAlphabet() const { return alphabet; }
+    
+    std::shared_ptr<const KeySchedule> compileKey(const std::string& key) const override;
+    void applySchedule(const std::shared_ptr<const KeySchedule>& schedule) override;
+    bool preservesLength() const override;
+    const char* getName() const override;
     std::string getDescription() const override;
     std::string getKeyInstructions() const override;
 };
@@ -0,0 +1,63 @@
+#ifndef CHACHA20POLY1305_H
+#define CHACHA20POLY1305_H
+
+#include <cstddef>
+#include <cstdint>
+
+// RFC 8439 ChaCha20 and Poly1305. Besides the portable code there are AVX2 (eight
+// ChaCha20 blocks, four Poly1305 blocks at a time) and AVX-512 (sixteen ChaCha20
+// blocks) kernels; the fastest one the CPU supports is picked at runtime unless overridden.
+namespace ChaCha20Poly1305 {
+
+const size_t KEY_SIZE = 32;
+const size_t NONCE_SIZE = 12;
+const size_t TAG_SIZE = 16;
+
+enum Implementation {
+    AUTO,
+    PORTABLE,
+    AVX2,
+    AVX512
+};
+
+// Forces an implementation; one the CPU lacks falls back to the next slower one
+void setImplementation(Implementation implementation);
+const char* implementationName();
+
+// XORs the ChaCha20 keystream starting at block `counter` into `in`
+void chacha20Xor(const uint8_t key[KEY_SIZE], const uint8_t nonce[NONCE_SIZE], uint32_t counter,
+                 const uint8_t* in, uint8_t* out, size_t size);
+
+class Poly1305 {
+public:
+    explicit Poly1305(const uint8_t key[32]);
+    // With a given kernel instead of the process-wide choice (for checking each one)
+    Poly1305(const uint8_t key[32], Implementation implementation);
+    void update(const uint8_t* data, size_t size);
+    void padToBlock();  // Zero-pads the input so far to a 16-byte boundary
+    void finish(uint8_t tag[TAG_SIZE]);
+
+private:
+    void blocks(const uint8_t* data, size_t size, uint64_t highBit);
+
+    Implementation implementation;
+    uint64_t r[3];
+    uint64_t h[3];
+    uint64_t pad[2];
+    uint8_t buffer[16];
+    size_t leftover;
+};
+
+// AEAD_CHACHA20_POLY1305; `out` may alias `in`
+void seal(const uint8_t key[KEY_SIZE], const uint8_t nonce[NONCE_SIZE], const uint8_t* aad, size_t aadSize,
+          const uint8_t* in, size_t size, uint8_t* out, uint8_t tag[TAG_SIZE]);
+bool open(const uint8_t key[KEY_SIZE], const uint8_t nonce[NONCE_SIZE], const uint8_t* aad, size_t aadSize,
+          const uint8_t* in, size_t size, const uint8_t tag[TAG_SIZE], uint8_t* out);
+
+// Checks every implementation available on this CPU against the RFC 8439 vectors.
+// Kernels are called directly, so it is safe while other threads seal and open.
+bool selfTest();
+
+} // namespace ChaCha20Poly1305
+
+#endif // CHACHA20POLY1305_H
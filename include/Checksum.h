@@ -0,0 +1,32 @@
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Fast non-cryptographic digests for catching corruption and wrong keys. CRC32C uses the
+// SSE4.2 crc32 instruction and XXH3 (64-bit, seed 0) uses AVX2 when the CPU has them
+// (picked at runtime); both fall back to portable code that gives the same values.
+enum class Digest {
+    CRC32C,
+    XXH3
+};
+
+namespace Checksum {
+
+const char* name(Digest digest);  // "crc32c", "xxh3"
+bool parse(const std::string& name, Digest& digest);
+
+uint64_t compute(Digest digest, const void* data, size_t size);
+
+uint32_t crc32c(const void* data, size_t size);
+uint64_t xxh3(const void* data, size_t size);
+
+// Portable versions of the same; the fallback path and the benchmark reference
+uint32_t crc32cScalar(const void* data, size_t size);
+uint64_t xxh3Scalar(const void* data, size_t size);
+
+} // namespace Checksum
+
+#endif // CHECKSUM_H
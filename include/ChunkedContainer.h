@@ -0,0 +1,44 @@
+#ifndef CHUNKEDCONTAINER_H
+#define CHUNKEDCONTAINER_H
+
+#include "CipherAlgorithm.h"
+#include <cstdint>
+#include <string>
+
+// Seekable encrypted file format. The plaintext is cut into fixed-size chunks that are
+// encrypted independently from the cipher's stream state at the chunk start; an index
+// at the end of the file records each chunk's location and that state, so any byte
+// range is decrypted by reading only the chunks that cover it.
+//
+//   header   "ETC1" | version | name length | algorithm name | chunk size (u32)
+//   chunks   encrypted chunk payloads, back to back
+//   index    chunk count (u64) | plaintext size (u64) | per chunk: offset, size, state (u64 each)
+//   trailer  index offset (u64) | "ETCX"
+//
+// All integers are little-endian. The key is never stored. Under an authenticated cipher
+// each chunk's plaintext is prefixed with its index (u64), a last-chunk flag (u8) and the
+// header, which decryption checks, and empty input is stored as one empty chunk.
+class ChunkedContainer {
+public:
+    static const size_t DEFAULT_CHUNK_SIZE = 1 << 20;
+
+    struct Info {
+        std::string algorithm;
+        uint32_t chunkSize;
+        uint64_t chunkCount;
+        uint64_t plaintextSize;
+    };
+
+    static bool encryptFile(CipherAlgorithm& cipher, const std::string& inputFilename,
+                            const std::string& containerFilename, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+    static bool decryptFile(CipherAlgorithm& cipher, const std::string& containerFilename,
+                            const std::string& outputFilename);
+
+    // Plaintext bytes [offset, offset + length), clamped to the end of the data
+    static bool decryptRange(CipherAlgorithm& cipher, const std::string& containerFilename,
+                             uint64_t offset, uint64_t length, std::string& plaintext);
+
+    static bool readInfo(const std::string& containerFilename, Info& info);
+};
+
+#endif // CHUNKEDCONTAINER_H
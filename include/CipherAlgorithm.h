@@ -1,20 +1,70 @@
 #ifndef CIPHERALGORITHM_H
 #define CIPHERALGORITHM_H
 
+#include "Checksum.h"
 #include <string>
 #include <fstream>
+#include <memory>
+#include <cstdint>
+
+class KeyScheduleCache;
+
+// A parsed and validated key in the form a cipher's inner loop consumes. Schedules are
+// immutable once built, so one instance can be shared by any number of ciphers/threads.
+class KeySchedule {
+public:
+    virtual ~KeySchedule() = default;
+};
 
 class CipherAlgorithm {
 protected:
     virtual std::string processText(const std::string& text, bool isEncryption) = 0;
+    // Processes text that starts at a saved stream position; only ciphers whose output
+    // depends on earlier input (Vigenère's key position) need to override it
+    virtual std::string processTextAt(const std::string& text, bool isEncryption, uint64_t state);
+    // processText() with a way to fail: false when the input or key is rejected (the reason
+    // is printed). Only ciphers that can reject whole-text input need to override it
+    virtual bool processChecked(const std::string& text, bool isEncryption, std::string& result);
+    // Stable storage for names built at run time (getName() results must outlive the cipher)
+    static const char* internName(const std::string& name);
 public:
     virtual ~CipherAlgorithm() = default;
     
     std::string encrypt(const std::string& plaintext);
     std::string decrypt(const std::string& ciphertext);
+    // As above, but false (and an empty result) when the cipher rejects the input, e.g.
+    // ciphertext whose authentication tag does not check out
+    bool tryEncrypt(const std::string& plaintext, std::string& ciphertext);
+    bool tryDecrypt(const std::string& ciphertext, std::string& plaintext);
+    // Encryption also writes per-chunk plaintext checksums next to the output (see
+    // IntegrityManifest); decryption checks them when present and fails on a mismatch.
+    // Ciphers the manifest does not apply to (IntegrityManifest::appliesTo) skip both.
+    // When the cipher rejects the input the output file is not created.
     bool processFile(const std::string& inputFilename, const std::string& outputFilename, bool isEncryption);
+    bool processFile(const std::string& inputFilename, const std::string& outputFilename, bool isEncryption,
+                     Digest digest);
+    
+    // Chunk-wise processing: `state` is 0 at the start of a stream, and advanceState()
+    // gives the state after a piece of plaintext (its ciphertext must give the same), so a
+    // chunk can be handled without the data before it
+    std::string encryptAt(const std::string& plaintext, uint64_t state);
+    std::string decryptAt(const std::string& ciphertext, uint64_t state);
+    virtual uint64_t advanceState(const std::string& plaintext, uint64_t state) const;
+    virtual bool hasStreamState() const;   // False when advanceState() never changes the state
+    virtual bool preservesLength() const;  // Output byte i depends only on input byte i and the state
+    virtual bool isLossless() const;       // decrypt(encrypt(x)) == x for every x (Morse is not)
+    virtual bool isAuthenticated() const;  // Ciphertext carries a tag that decryption checks
+    // Identifies the current key without revealing it, so saved state can tell whether it
+    // was made with the same key. The default hashes the ciphertext of a fixed probe text.
+    virtual uint64_t keyFingerprint();
+    
+    void setKey(const std::string& key);
+    void setKeyCached(const std::string& key, KeyScheduleCache& cache);
     
-    virtual void setKey(const std::string& key) = 0;
+    // Returns nullptr when the key is rejected, in which case the current key stays in use
+    virtual std::shared_ptr<const KeySchedule> compileKey(const std::string& key) const = 0;
+    virtual void applySchedule(const std::shared_ptr<const KeySchedule>& schedule) = 0;
+    virtual const char* getName() const = 0;  // Short identifier used in metrics
     virtual std::string getDescription() const = 0;
     virtual std::string getKeyInstructions() const = 0;
 };
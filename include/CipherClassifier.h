@@ -0,0 +1,72 @@
+#ifndef CIPHERCLASSIFIER_H
+#define CIPHERCLASSIFIER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// Guesses which of the tool's ciphers produced a text. Morse is recognized by its shape:
+// runs of '.', '-' and '/' split by one repeated separator. Everything else is judged on
+// its letters, counted in one vectorized pass. The index of coincidence tells one-alphabet
+// text (plaintext, Caesar, substitution) from Vigenère. Chi-squared against English then
+// picks the plaintext or the Caesar shift. Vigenère's period is where the
+// letter-to-letter coincidence rate peaks.
+//
+// classifyPath() labels every line of a file, or every file under a directory, on a
+// work-stealing pool and writes one JSON object per input, in input order.
+class CipherClassifier {
+public:
+    enum class Label {
+        PLAINTEXT,
+        CAESAR,        // Includes ROT13 (shift 13)
+        SUBSTITUTION,
+        VIGENERE,
+        MORSE,
+        UNKNOWN        // Too short, not mostly letters or of randomly mixed case (binary,
+                       // armored or AEAD output)
+    };
+
+    struct Result {
+        Label label = Label::UNKNOWN;
+        double confidence = 0.0;          // 0-1; grows with the margin and the number of letters
+        int shift = 0;                    // Caesar key (13 is ROT13)
+        size_t period = 0;                // Estimated Vigenère key length
+        double indexOfCoincidence = 0.0;  // ~0.066 for English, ~0.038 for random letters
+        double periodicIc = 0.0;          // Average column IC at period (Vigenère only)
+        uint64_t bytes = 0;
+        uint64_t letters = 0;
+    };
+
+    struct Options {
+        unsigned threads = 0;              // 0 = one per hardware thread
+        size_t blockSize = 8 << 20;        // Bytes of a records file read per round
+    };
+
+    struct Report {
+        uint64_t records = 0;
+        uint64_t bytes = 0;
+        uint64_t failed = 0;               // Unreadable files
+        uint64_t counts[6] = {};           // Records per Label
+        unsigned threads = 0;
+        double seconds = 0.0;
+    };
+
+    static Result classify(const char* text, size_t size);
+    static Result classify(const std::string& text) { return classify(text.data(), text.size()); }
+
+    // A directory is walked recursively and every regular file is one record. Any other
+    // path is read as newline-separated records ("\r\n" is accepted). threads == 0 in the
+    // report means nothing was read; the reason is already printed.
+    static Report classifyPath(const std::string& path, std::ostream& out);
+    static Report classifyPath(const std::string& path, std::ostream& out, const Options& options);
+
+    // {"file":...,"line":N,"label":...} without a newline; line 0 is left out. A file
+    // name that is not valid UTF-8 shows each bad byte as U+FFFD, and "file_hex" holds
+    // its raw bytes.
+    static void appendJson(std::string& out, const std::string& file, uint64_t line, const Result& result);
+
+    static const char* name(Label label);  // "plaintext", "caesar", "substitution", ...
+};
+
+#endif // CIPHERCLASSIFIER_H
@@ -0,0 +1,99 @@
+#ifndef CIPHEREXECUTOR_H
+#define CIPHEREXECUTOR_H
+
+#include "CipherAlgorithm.h"
+#include "Checksum.h"
+#include "WorkStealingPool.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Runs encryptions for callers that must not block, with completion callbacks. The
+// coroutine front end in AsyncCipher.h is built on it.
+//
+// Text requests go into one queue, and a bounded number of drain tasks (one per worker
+// at most) empty it on a work-stealing pool. A drain takes a batch of queued requests
+// per lock, up to batchBytes of text, so a burst of small messages costs a few wakeups
+// instead of one per request. Files are read in chunks by a separate I/O thread. For
+// length-preserving ciphers, each chunk is encrypted on the pool as soon as it has been
+// read, so reading overlaps with the cipher.
+class CipherExecutor {
+public:
+    struct Options {
+        unsigned threads = 0;            // 0 = one per hardware thread
+        size_t batchBytes = 64 << 10;    // Most text one drain takes from the queue at once
+        size_t fileChunkSize = 1 << 20;  // Files are read and encrypted in pieces of this size
+    };
+
+    struct Stats {
+        uint64_t requests = 0;
+        uint64_t batches = 0;
+        uint64_t files = 0;
+    };
+
+    using TextCallback = std::function<void(std::string)>;
+    using FileCallback = std::function<void(bool)>;
+
+    CipherExecutor();
+    explicit CipherExecutor(const Options& options);
+    ~CipherExecutor();  // Finishes everything already submitted
+    CipherExecutor(const CipherExecutor&) = delete;
+    CipherExecutor& operator=(const CipherExecutor&) = delete;
+
+    // The cipher must keep its key and outlive the request. done runs on one of the
+    // executor's threads and must not block for long.
+    void submit(CipherAlgorithm& cipher, bool isEncryption, std::string text, TextCallback done);
+    // Writes the same output and checksum file as CipherAlgorithm::processFile()
+    void submitFile(CipherAlgorithm& cipher, const std::string& inputFilename, const std::string& outputFilename,
+                    bool isEncryption, FileCallback done, Digest digest = Digest::CRC32C);
+
+    unsigned size() const { return pool.size(); }
+    Stats stats() const;
+
+private:
+    struct Request {
+        CipherAlgorithm* cipher;
+        bool isEncryption;
+        std::string text;
+        TextCallback done;
+    };
+
+    struct FileJob;
+
+    Options options;
+    std::mutex queueMutex;
+    std::deque<Request> queue;
+    unsigned drains = 0;  // Drain tasks scheduled or running
+
+    std::mutex ioMutex;
+    std::condition_variable ioReady;
+    std::deque<std::function<void()>> ioQueue;
+    bool stopping = false;
+    std::thread ioThread;
+
+    std::atomic<size_t> outstanding{0};  // Submitted requests and files not yet completed
+    std::mutex idleMutex;
+    std::condition_variable idle;
+
+    std::atomic<uint64_t> requestCount{0};
+    std::atomic<uint64_t> batchCount{0};
+    std::atomic<uint64_t> fileCount{0};
+
+    // Last, so its workers stop before anything they use is destroyed
+    WorkStealingPool pool;
+
+    void drain();
+    void runOnIoThread(std::function<void()> job);
+    void ioLoop();
+    void readFile(const std::shared_ptr<FileJob>& job);
+    void finishFile(const std::shared_ptr<FileJob>& job);
+    void complete(size_t count = 1);
+};
+
+#endif // CIPHEREXECUTOR_H
@@ -0,0 +1,43 @@
+#ifndef CIPHERKERNELS_H
+#define CIPHERKERNELS_H
+
+#include "Alphabet.h"
+#include <cstddef>
+#include <cstdint>
+
+// Hot loops shared by the cipher classes. On GCC/x86-64 each kernel is compiled for
+// the SSE2 baseline plus AVX2 and AVX-512, and the best clone is picked at load time.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && !defined(ET_NO_MULTIVERSIONING)
+#define CIPHER_KERNEL __attribute__((target_clones("default", "arch=x86-64-v3", "arch=x86-64-v4")))
+#else
+#define CIPHER_KERNEL
+#endif
+
+namespace CipherKernels {
+
+// Rotates A-Z and a-z by shift (0-25) positions, preserving case; other bytes are untouched
+void shiftLetters(char* data, size_t size, int shift);
+
+// Vigenère step: the n-th letter is rotated by keyStream[(start + n) % keyLength].
+// keyStream holds keyLength shifts (0-25) followed by its first 64 entries again.
+// Returns the number of letters. Uses AVX-512 VBMI2 when the CPU has it.
+size_t shiftLettersByKey(char* data, size_t size, const uint8_t* keyStream, size_t keyLength, size_t start);
+
+// Number of A-Z/a-z bytes
+size_t countLetters(const char* data, size_t size);
+
+// The three functions above for any alphabet; shifts are 0 to Alphabets::size() - 1
+void shiftAlphabet(Alphabet alphabet, char* data, size_t size, int shift);
+size_t shiftAlphabetByKey(Alphabet alphabet, char* data, size_t size, const uint8_t* keyStream, size_t keyLength,
+                          size_t start);
+size_t countAlphabet(Alphabet alphabet, const char* data, size_t size);
+
+// Index of the first byte >= 0x80, or size when the text is pure ASCII
+size_t asciiPrefixLength(const char* data, size_t size);
+
+// Name of the instruction set the running CPU will use for the kernels above
+const char* activeIsa();
+
+} // namespace CipherKernels
+
+#endif // CIPHERKERNELS_H
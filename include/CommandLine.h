@@ -0,0 +1,12 @@
+#ifndef COMMANDLINE_H
+#define COMMANDLINE_H
+
+// Non-interactive subcommands, used when the tool is started with arguments. Keys are
+// taken from the ET_KEY environment variable, or else read from the first line of
+// standard input, so they never appear in the process list.
+class CommandLine {
+public:
+    static int run(int argc, char* argv[]);
+};
+
+#endif // COMMANDLINE_H
@@ -0,0 +1,34 @@
+#ifndef COMPRESSEDCIPHER_H
+#define COMPRESSEDCIPHER_H
+
+#include "BlockCompression.h"
+#include "CipherAlgorithm.h"
+
+// Wraps another cipher so plaintext is compressed (BlockCompression) before it is
+// encrypted and decompressed after decryption. The key and schedule are the inner
+// cipher's; the name is the inner name with "+lz" appended.
+class CompressedCipher : public CipherAlgorithm {
+private:
+    std::unique_ptr<CipherAlgorithm> inner;
+    const char* name;
+
+protected:
+    std::string processText(const std::string& text, bool isEncryption) override;
+    bool processChecked(const std::string& text, bool isEncryption, std::string& result) override;
+
+public:
+    explicit CompressedCipher(std::unique_ptr<CipherAlgorithm> inner);
+
+    CipherAlgorithm& getInner() { return *inner; }
+
+    std::shared_ptr<const KeySchedule> compileKey(const std::string& key) const override;
+    void applySchedule(const std::shared_ptr<const KeySchedule>& schedule) override;
+    bool isLossless() const override;
+    bool isAuthenticated() const override;
+    uint64_t keyFingerprint() override;
+    const char* getName() const override;
+    std::string getDescription() const override;
+    std::string getKeyInstructions() const override;
+};
+
+#endif // COMPRESSEDCIPHER_H
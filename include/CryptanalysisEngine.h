@@ -0,0 +1,64 @@
+#ifndef CRYPTANALYSISENGINE_H
+#define CRYPTANALYSISENGINE_H
+
+#include <string>
+#include <vector>
+#include <array>
+#include <cstdint>
+
+class CryptanalysisEngine {
+public:
+    struct CaesarResult {
+        int shift;              // Key to pass to CaesarCipher::setKey (13 means ROT13)
+        double chiSquared;
+        std::string plaintext;
+    };
+
+    struct SubstitutionResult {
+        std::string key;        // 26-letter alphabet usable with SubstitutionCipher::setKey
+        double score;           // Quadgram log-probability, higher is better
+        std::string plaintext;
+    };
+
+    struct SubstitutionReport {
+        std::vector<SubstitutionResult> bestKeys;  // Sorted best first
+        unsigned long long keysTried = 0;
+        double seconds = 0.0;
+        double keysPerSecond = 0.0;
+        unsigned int threadsUsed = 0;
+    };
+
+    struct PeriodCandidate {
+        size_t period;
+        double indexOfCoincidence;  // Average over the period's columns; ~0.066 for English
+        unsigned int kasiskiVotes;  // Repeated-trigram distances divisible by the period
+    };
+
+    struct VigenereResult {
+        std::string key;            // Usable with VigenereCipher::setKey
+        std::string plaintext;
+        std::vector<PeriodCandidate> periods;  // Every period examined, by period
+        double seconds = 0.0;
+    };
+
+    // Counts A-Z (case-insensitive) into 26 buckets, vectorized where available
+    static std::array<uint64_t, 26> letterHistogram(const std::string& text);
+    static double chiSquared(const std::array<uint64_t, 26>& counts, int shift);
+
+    static CaesarResult breakCaesar(const std::string& ciphertext);
+    static std::vector<CaesarResult> rankCaesarShifts(const std::string& ciphertext);
+
+    // restarts == 0 uses at least 16 restarts, four per hardware thread. Restart i climbs
+    // from a start drawn from seed and i alone, so a fixed seed repeats the same search
+    // on any thread count; seed == 0 picks a random one
+    static SubstitutionReport breakSubstitution(const std::string& ciphertext, unsigned int restarts = 0,
+                                                size_t keepBest = 3, unsigned int seed = 0);
+
+    static std::vector<PeriodCandidate> estimateVigenerePeriods(const std::string& ciphertext, size_t maxPeriod = 40);
+    static VigenereResult breakVigenere(const std::string& ciphertext, size_t maxPeriod = 40);
+
+    // Average quadgram log-probability per letter of already-decrypted text
+    static double englishScore(const std::string& text);
+};
+
+#endif // CRYPTANALYSISENGINE_H
@@ -0,0 +1,47 @@
+#ifndef DIRECTORYPROCESSOR_H
+#define DIRECTORYPROCESSOR_H
+
+#include "CipherAlgorithm.h"
+#include <cstdint>
+#include <string>
+
+// Encrypts or decrypts a directory tree into a mirror tree. Directories are walked
+// concurrently and every file is a task on a work-stealing pool; files above the chunk
+// size (for ciphers that preserve length) are split further into chunk tasks, so one
+// huge file keeps every thread busy. Each file's output matches processFile()'s, but
+// no integrity manifest (.sum) is written or checked.
+//
+// Permissions and access/modification times are copied. Outputs are written under a
+// temporary name and renamed once complete, so after an interruption a rerun skips
+// every output that already carries its input's modification time. The output root's
+// .etresume file records the cipher, direction and key fingerprint the tree was written
+// with; a run with different ones rewrites everything.
+class DirectoryProcessor {
+public:
+    struct Options {
+        unsigned threads = 0;          // 0 = one per hardware thread
+        size_t chunkSize = 4 << 20;    // Files larger than this become several tasks
+        bool resume = true;            // Skip outputs completed by an earlier run
+    };
+
+    struct Report {
+        uint64_t files = 0;            // Processed by this run
+        uint64_t skipped = 0;          // Already complete
+        uint64_t failed = 0;
+        uint64_t directories = 0;
+        uint64_t bytes = 0;
+        uint64_t chunkTasks = 0;
+        uint64_t steals = 0;
+        unsigned threads = 0;
+        double seconds = 0.0;
+    };
+
+    static Report process(CipherAlgorithm& cipher, const std::string& inputDirectory,
+                          const std::string& outputDirectory, bool isEncryption);
+    static Report process(CipherAlgorithm& cipher, const std::string& inputDirectory,
+                          const std::string& outputDirectory, bool isEncryption, const Options& options);
+
+    static bool isDirectory(const std::string& path);
+};
+
+#endif // DIRECTORYPROCESSOR_H
@@ -5,23 +5,27 @@
 #include <memory>
 #include "CipherAlgorithm.h"
 #include "PasswordManager.h"
+#include "KeyScheduleCache.h"
 
 class EncryptionApp {
 private:
     std::vector<std::unique_ptr<CipherAlgorithm>> algorithms;
     PasswordManager passwordManager;
+    KeyScheduleCache keyCache;
     
     void displayMenu();
     int selectAlgorithm();
     void processMessage(bool isEncryption);
     void processFile(bool isEncryption);
     void displayPasswordMenu();
+    bool unlockVault();
 
 public:
     EncryptionApp();
     void passwordManagerMenu();
     void analyzePasswordStrength();
     void generateSecurePassword();
+    void breakCipher();
     void run();
 };
 
@@ -0,0 +1,18 @@
+#ifndef ENGLISHSTATISTICS_H
+#define ENGLISHSTATISTICS_H
+
+#include <cstddef>
+
+struct QuadgramCount {
+    char gram[5];
+    unsigned int count;
+};
+
+// Relative frequency of A-Z in English text (sums to ~1.0)
+extern const double ENGLISH_LETTER_FREQUENCIES[26];
+
+extern const QuadgramCount ENGLISH_QUADGRAMS[];
+extern const size_t ENGLISH_QUADGRAM_COUNT;
+extern const unsigned long ENGLISH_QUADGRAM_TOTAL;
+
+#endif // ENGLISHSTATISTICS_H
@@ -0,0 +1,141 @@
+#ifndef FIXEDKEYCIPHERS_H
+#define FIXEDKEYCIPHERS_H
+
+#include "CipherAlgorithm.h"
+#include "CipherKernels.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Cipher variants whose key is a template argument. Tables are built by constexpr
+// functions, so the inner loops see only constants: no key loads, no validation, and
+// the Caesar loop vectorizes (with the same ISA clones as CipherKernels) with the
+// shift folded in. They still plug into CipherAlgorithm; setKey() is accepted and
+// ignored, like ROT13.
+namespace FixedKey {
+
+struct ByteTable {
+    char bytes[256];
+};
+
+// Branch-free rotate of A-Z/a-z by a compile-time shift, case preserved
+template <int Shift>
+CIPHER_KERNEL void shiftLetters(char* data, size_t size) {
+    static_assert(Shift >= 0 && Shift < 26, "shift must be in 0-25");
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        uint8_t c = bytes[i];
+        uint8_t index = static_cast<uint8_t>((c | 0x20) - 'a');
+        uint8_t shifted = static_cast<uint8_t>(index + Shift);
+        shifted = shifted >= 26 ? static_cast<uint8_t>(shifted - 26) : shifted;
+        uint8_t rotated = static_cast<uint8_t>((shifted + 'a') ^ ((c & 0x20) ^ 0x20));
+        bytes[i] = index < 26 ? rotated : c;
+    }
+}
+
+// Alphabet policies provide letter(i): the ciphertext letter for plaintext 'A' + i
+struct QwertyAlphabet {
+    static constexpr const char* name() { return "substitution-qwerty"; }
+    static constexpr char letter(int i) { return "QWERTYUIOPASDFGHJKLZXCVBNM"[i]; }
+};
+
+template <typename Alphabet>
+constexpr bool isPermutation() {
+    bool seen[26] = {};
+    for (int i = 0; i < 26; ++i) {
+        char c = Alphabet::letter(i);
+        if (c < 'A' || c > 'Z' || seen[c - 'A']) return false;
+        seen[c - 'A'] = true;
+    }
+    return true;
+}
+
+template <typename Alphabet>
+constexpr ByteTable substitutionTable(bool isEncryption) {
+    ByteTable table{};
+    for (int i = 0; i < 256; ++i) table.bytes[i] = static_cast<char>(i);
+    for (int i = 0; i < 26; ++i) {
+        char plain = static_cast<char>('A' + i);
+        char cipher = Alphabet::letter(i);
+        char from = isEncryption ? plain : cipher;
+        char to = isEncryption ? cipher : plain;
+        table.bytes[static_cast<unsigned char>(from)] = to;
+        table.bytes[static_cast<unsigned char>(from | 0x20)] = static_cast<char>(to | 0x20);
+    }
+    return table;
+}
+
+template <typename Alphabet>
+struct SubstitutionTables {
+    static_assert(isPermutation<Alphabet>(), "alphabet must be a permutation of A-Z");
+    static constexpr ByteTable encryption = substitutionTable<Alphabet>(true);
+    static constexpr ByteTable decryption = substitutionTable<Alphabet>(false);
+};
+
+template <typename Alphabet>
+constexpr ByteTable SubstitutionTables<Alphabet>::encryption;
+template <typename Alphabet>
+constexpr ByteTable SubstitutionTables<Alphabet>::decryption;
+
+} // namespace FixedKey
+
+template <int Shift>
+class FixedCaesarCipher : public CipherAlgorithm {
+protected:
+    std::string processText(const std::string& text, bool isEncryption) override {
+        std::string result = text;
+        if (isEncryption) {
+            FixedKey::shiftLetters<Shift>(&result[0], result.size());
+        } else {
+            FixedKey::shiftLetters<(26 - Shift) % 26>(&result[0], result.size());
+        }
+        return result;
+    }
+
+public:
+    std::shared_ptr<const KeySchedule> compileKey(const std::string&) const override { return nullptr; }
+    void applySchedule(const std::shared_ptr<const KeySchedule>&) override {}
+    bool preservesLength() const override { return true; }
+    const char* getName() const override {
+        static const char* const name = internName("caesar-fixed-" + std::to_string(Shift));  // e.g. "caesar-fixed-3"
+        return name;
+    }
+    std::string getDescription() const override {
+        return "\033[1;34mCaesar Cipher (shift " + std::to_string(Shift) + "):\033[0m A Caesar cipher with its shift fixed at compile time.";
+    }
+    std::string getKeyInstructions() const override {
+        return "\033[1;34mThis cipher's shift is fixed. Press Enter to continue.\033[0m ";
+    }
+};
+
+template <typename Alphabet>
+class FixedSubstitutionCipher : public CipherAlgorithm {
+protected:
+    std::string processText(const std::string& text, bool isEncryption) override {
+        std::string result = text;
+        const char* table = isEncryption ? FixedKey::SubstitutionTables<Alphabet>::encryption.bytes
+                                         : FixedKey::SubstitutionTables<Alphabet>::decryption.bytes;
+        for (char& c : result) {
+            c = table[static_cast<unsigned char>(c)];
+        }
+        return result;
+    }
+
+public:
+    std::shared_ptr<const KeySchedule> compileKey(const std::string&) const override { return nullptr; }
+    void applySchedule(const std::shared_ptr<const KeySchedule>&) override {}
+    bool preservesLength() const override { return true; }
+    const char* getName() const override { return Alphabet::name(); }
+    std::string getDescription() const override {
+        return "\033[1;34mSubstitution Cipher (fixed alphabet):\033[0m A substitution cipher with its alphabet fixed at compile time.";
+    }
+    std::string getKeyInstructions() const override {
+        return "\033[1;34mThis cipher's alphabet is fixed. Press Enter to continue.\033[0m ";
+    }
+};
+
+using Caesar3Cipher = FixedCaesarCipher<3>;
+using FixedROT13Cipher = FixedCaesarCipher<13>;
+using QwertySubstitutionCipher = FixedSubstitutionCipher<FixedKey::QwertyAlphabet>;
+
+#endif // FIXEDKEYCIPHERS_H
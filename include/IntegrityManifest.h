@@ -0,0 +1,51 @@
+#ifndef INTEGRITYMANIFEST_H
+#define INTEGRITYMANIFEST_H
+
+#include "CipherAlgorithm.h"
+#include "Checksum.h"
+#include <cstdint>
+#include <string>
+
+// Per-chunk digests of an encrypted file's plaintext, kept next to it as "<file>.sum".
+// Decryption compares against them, so a wrong key or a damaged file is reported instead
+// of producing garbage, and verify() checks a file on all cores without writing the
+// plaintext anywhere. Each chunk also records the cipher's stream state at its start, so
+// chunks of length-preserving ciphers are decrypted independently.
+//
+//   header   "ETS1" | version | digest | name length | algorithm name | chunk size (u32)
+//            | chunk count (u64) | plaintext size (u64) | encrypted file size (u64)
+//   entries  per chunk: stream state (u64), digest (u64)
+//
+// All integers are little-endian. CRC32C digests use the low 32 bits.
+class IntegrityManifest {
+public:
+    static const size_t DEFAULT_CHUNK_SIZE = 1 << 20;
+
+    struct Report {
+        bool ok = false;               // The manifest was read and every chunk matched
+        uint64_t chunks = 0;
+        uint64_t badChunks = 0;
+        uint64_t firstBadOffset = 0;   // Plaintext offset of the first mismatching chunk
+        uint64_t bytes = 0;
+        unsigned threads = 0;
+        double seconds = 0.0;
+    };
+
+    static std::string pathFor(const std::string& filename);
+
+    // False for lossy ciphers, whose decrypted text never matches the plaintext digests,
+    // and for authenticated ones, whose tags already catch a wrong key or a damaged file
+    // (decryption then fails through CipherAlgorithm::tryDecrypt)
+    static bool appliesTo(const CipherAlgorithm& cipher);
+
+    // Records digests of plaintext, which cipher has encrypted into filename
+    static bool write(const CipherAlgorithm& cipher, const std::string& plaintext, const std::string& filename,
+                      uint64_t encryptedSize, Digest digest, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    // Compares plaintext decrypted from filename with its manifest; true when there is none
+    static bool check(const CipherAlgorithm& cipher, const std::string& plaintext, const std::string& filename);
+
+    static Report verify(CipherAlgorithm& cipher, const std::string& filename, unsigned threads = 0);
+};
+
+#endif // INTEGRITYMANIFEST_H
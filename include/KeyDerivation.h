@@ -0,0 +1,44 @@
+#ifndef KEYDERIVATION_H
+#define KEYDERIVATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Argon2id (RFC 9106, version 0x13): a password hash that needs memoryKiB of RAM, so
+// guessing master passwords costs as much memory as time. Memory is split into lanes.
+// The lanes fill each quarter of a pass in parallel, one thread per lane up to the core
+// count, and synchronize between quarters. BLAKE2b (RFC 7693) is included for it.
+namespace KeyDerivation {
+
+struct Params {
+    uint32_t memoryKiB = 64 * 1024;
+    uint32_t passes = 3;
+    uint32_t lanes = 4;
+};
+
+const size_t SALT_SIZE = 16;
+const uint32_t MAX_LANES = (1u << 24) - 1;
+
+// At least 8 KiB per lane, one pass, 4 output bytes and 8 salt bytes
+bool validParams(const Params& params);
+
+// False when the parameters are out of range or the memory cannot be allocated.
+// threads = 0 uses one per lane, capped at the hardware thread count.
+bool argon2id(const std::string& password, const uint8_t* salt, size_t saltSize, const Params& params,
+              uint8_t* out, size_t outSize, unsigned threads = 0);
+// With the optional secret value K and associated data X of RFC 9106
+bool argon2id(const std::string& password, const uint8_t* salt, size_t saltSize, const uint8_t* secret,
+              size_t secretSize, const uint8_t* associated, size_t associatedSize, const Params& params,
+              uint8_t* out, size_t outSize, unsigned threads = 0);
+
+// Unkeyed BLAKE2b with a 1-64 byte digest
+void blake2b(const void* data, size_t size, uint8_t* out, size_t outSize);
+
+// Checks both functions against the RFC 7693 and RFC 9106 test vectors. The vault runs
+// it once per process before it derives its first key.
+bool selfTest();
+
+} // namespace KeyDerivation
+
+#endif // KEYDERIVATION_H
@@ -0,0 +1,45 @@
+#ifndef KEYSCHEDULECACHE_H
+#define KEYSCHEDULECACHE_H
+
+#include "CipherAlgorithm.h"
+#include "SecureMemory.h"
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Thread-safe LRU cache of compiled key schedules keyed by (algorithm name, key), so
+// repeated keys skip parsing and table building. Rejected keys are cached as nullptr.
+// Cache keys contain the cipher key, so the list and index nodes holding them (short
+// strings are stored inline) are allocated from secure memory like the schedules.
+class KeyScheduleCache {
+public:
+    explicit KeyScheduleCache(size_t capacity = 256);
+
+    std::shared_ptr<const KeySchedule> get(const CipherAlgorithm& algorithm, const std::string& key);
+    void clear();
+
+    size_t size() const;
+    unsigned long long hits() const;
+    unsigned long long misses() const;
+
+private:
+    struct Entry {
+        SecureString cacheKey;
+        std::shared_ptr<const KeySchedule> schedule;
+    };
+
+    size_t capacity;
+    using EntryList = std::list<Entry, SecureAllocator<Entry>>;
+    using Index = std::unordered_map<SecureString, EntryList::iterator, SecureStringHash, std::equal_to<SecureString>,
+                                     SecureAllocator<std::pair<const SecureString, EntryList::iterator>>>;
+
+    EntryList entries;  // Most recently used first
+    Index index;
+    unsigned long long hitCount = 0;
+    unsigned long long missCount = 0;
+    mutable std::mutex mutex;
+};
+
+#endif // KEYSCHEDULECACHE_H
@@ -0,0 +1,70 @@
+#ifndef MESSAGEBATCH_H
+#define MESSAGEBATCH_H
+
+#include "SecureMemory.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Many short messages, each with its own key, encrypted by one call instead of a setKey()
+// and encrypt() per message. Messages are stored back to back in one buffer and keys in
+// another (secure memory), each with an offset table.
+//
+// Vigenère's key position depends on the letters before it, so process() vectorizes it
+// across messages. Messages are sorted by length and taken 32 at a time, and each group
+// is transposed so that byte j of every message sits in one 32-byte row. Each vector
+// lane then carries one message with its own key and key position. Keys longer than 16
+// characters, messages of 256 bytes or more and leftover groups of fewer than 8 use the
+// per-message kernel instead.
+//
+// A Caesar or substitution key is a fixed map of 26 letters. With AVX2 it is applied to
+// each message 32 bytes at a time by two vpshufb lookups. The last block overlaps the
+// one before it, so short messages have no scalar tail. That beats the transposed layout,
+// whose two transposes alone cost more than this whole pass.
+class MessageBatch {
+public:
+    enum class Cipher {
+        CAESAR,
+        VIGENERE,
+        SUBSTITUTION
+    };
+
+    MessageBatch();
+    void reserve(size_t messages, size_t textBytes);
+    void add(const char* message, size_t size, const char* key, size_t keySize);
+    void add(const std::string& message, const std::string& key) {
+        add(message.data(), message.size(), key.data(), key.size());
+    }
+    void clear();
+
+    size_t size() const { return offsets.size() - 1; }
+    const std::string& text() const { return messages; }
+    // Message i is text()[messageOffsets()[i], messageOffsets()[i + 1]); size() + 1 entries
+    const std::vector<size_t>& messageOffsets() const { return offsets; }
+
+    // Writes every result into output at its message's offsets, since these ciphers keep
+    // the length. Keys are read as the letter-alphabet CaesarCipher, VigenereCipher and
+    // SubstitutionCipher read them. A key those would reject uses the cipher's default
+    // key ("3", "KEY", "QWERTYUIOPASDFGHJKLZXCVBNM"), and no error is printed.
+    void process(Cipher cipher, bool isEncryption, std::string& output) const;
+    // One message at a time with the same kernels as the cipher classes; the reference
+    // for process() and the path it uses for the cases above
+    void processScalar(Cipher cipher, bool isEncryption, std::string& output) const;
+
+    static const char* name(Cipher cipher);  // "caesar", "vigenere", "substitution"
+    static bool parse(const std::string& name, Cipher& cipher);
+
+private:
+    std::string messages;
+    std::vector<size_t> offsets;
+    SecureString keys;
+    std::vector<size_t> keyOffsets;
+
+    void processMessage(Cipher cipher, bool isEncryption, size_t index, std::string& output,
+                        SecureVector<uint8_t>& scratch) const;
+    void processGroup(bool isEncryption, const size_t* group, size_t lanes, std::string& output,
+                      SecureVector<uint8_t>& keyRows, std::vector<uint8_t>& rows) const;
+};
+
+#endif // MESSAGEBATCH_H
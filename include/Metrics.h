@@ -0,0 +1,106 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Build with -DET_ENABLE_METRICS=0 to compile every probe out entirely. When compiled
+// in, probes cost one relaxed atomic load until Metrics::setEnabled(true) is called.
+#ifndef ET_ENABLE_METRICS
+#define ET_ENABLE_METRICS 1
+#endif
+
+class Metrics {
+public:
+    enum Operation {
+        ENCRYPT,
+        DECRYPT,
+        PROCESS_FILE,
+        VAULT_LOAD,
+        VAULT_SAVE,
+        VAULT_LOOKUP,
+        VAULT_SYNC,
+        VAULT_UNLOCK,
+        ANALYZE_STRENGTH,
+        GENERATE_PASSWORD,
+        OPERATION_COUNT
+    };
+
+    // Log-linear latency histogram: exact below 32 ns, then 16 buckets per power of
+    // two (~6% relative error) up to the full 64-bit range
+    class LatencyHistogram {
+    public:
+        static const int BUCKET_COUNT = 32 + 59 * 16;
+
+        void record(uint64_t nanoseconds);
+        void clear();
+        uint64_t count() const;
+        uint64_t sum() const { return total.load(std::memory_order_relaxed); }
+        uint64_t bucketCount(int bucket) const { return buckets[bucket].load(std::memory_order_relaxed); }
+        uint64_t percentile(double fraction) const;  // Upper bound of the bucket holding it
+
+        static int bucketFor(uint64_t nanoseconds);
+        static uint64_t bucketUpperBound(int bucket);
+
+    private:
+        std::atomic<uint64_t> buckets[BUCKET_COUNT] = {};
+        std::atomic<uint64_t> total{0};
+    };
+
+    struct Series {
+        Operation operation;
+        const char* label;  // Algorithm name or component; must have static storage
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> bytes{0};   // Entries rather than bytes for the vault
+        LatencyHistogram latency;
+    };
+
+    class ScopedOperation {
+    public:
+        ScopedOperation(Operation operation, const char* label, uint64_t bytes = 0);
+        ~ScopedOperation();
+        ScopedOperation(const ScopedOperation&) = delete;
+        ScopedOperation& operator=(const ScopedOperation&) = delete;
+
+        void setBytes(uint64_t newBytes) { bytes = newBytes; }
+
+    private:
+        Series* series;
+        uint64_t bytes;
+        uint64_t start;
+    };
+
+    static bool enabled() { return enabledFlag.load(std::memory_order_relaxed); }
+    static void setEnabled(bool on);
+    static void setTracing(bool on);  // Scoped spans for the Chrome trace; implies enabled
+    static void reset();
+
+    static Series* series(Operation operation, const char* label);
+    static const char* operationName(Operation operation);
+
+    static bool writePrometheus(const std::string& filename);
+    static bool writeChromeTrace(const std::string& filename);
+
+    // ET_METRICS_FILE / ET_TRACE_FILE enable collection and name the files written by
+    // writeConfiguredOutputs()
+    static void configureFromEnvironment();
+    static void writeConfiguredOutputs();
+
+private:
+    static std::atomic<bool> enabledFlag;
+    static std::atomic<bool> tracingFlag;
+
+    static uint64_t now();
+    static void recordSpan(Operation operation, const char* label, uint64_t start, uint64_t duration);
+};
+
+#if ET_ENABLE_METRICS
+#define ET_METRICS_SCOPE(name, operation, label, bytes) Metrics::ScopedOperation name(operation, label, bytes)
+#define ET_METRICS_SET_BYTES(name, bytes) name.setBytes(bytes)
+#else
+#define ET_METRICS_SCOPE(name, operation, label, bytes) do {} while (0)
+#define ET_METRICS_SET_BYTES(name, bytes) do {} while (0)
+#endif
+
+#endif // METRICS_H
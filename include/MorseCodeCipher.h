@@ -2,23 +2,29 @@
 #define MORSECODECIPHER_H
 
 #include "CipherAlgorithm.h"
-#include <map>
+#include "MorseCodec.h"
 #include <string>
 
 class MorseCodeCipher : public CipherAlgorithm {
 private:
-    std::map<char, std::string> charToMorse;
-    std::map<std::string, char> morseToChar;
-    std::string separator = " ";
+    MorseFormat format;
 
-    void initializeReverseMap();
+    struct Schedule : KeySchedule {
+        std::string separator;
+        explicit Schedule(const std::string& separator) : separator(separator) {}
+    };
+    
+    std::shared_ptr<const Schedule> schedule = std::make_shared<Schedule>(" ");
 
 protected:
     std::string processText(const std::string& text, bool isEncryption) override;
 
 public:
-    MorseCodeCipher();
-    void setKey(const std::string& key) override;
+    explicit MorseCodeCipher(MorseFormat format = MorseFormat::TEXT);
+    std::shared_ptr<const KeySchedule> compileKey(const std::string& key) const override;
+    void applySchedule(const std::shared_ptr<const KeySchedule>& schedule) override;
+    bool isLossless() const override;  // Case, newlines and characters without a code are lost
+    const char* getName() const override;
     std::string getDescription() const override;
     std::string getKeyInstructions() const override;
 };
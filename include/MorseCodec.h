@@ -0,0 +1,43 @@
+#ifndef MORSECODEC_H
+#define MORSECODEC_H
+
+#include <cstddef>
+#include <string>
+
+// International Morse code for letters and digits (case-insensitive; decoding gives
+// uppercase), with a space as the word break. A multibyte UTF-8 character has no code
+// and passes through as its own symbol. Other characters are dropped.
+//
+// Text format: symbols joined by a separator, a word break written as "/". Decoding
+// splits on ' ' and '/', whatever the separator was. A token that is neither a code nor
+// one whole UTF-8 character is dropped. The tokenizer uses AVX2 when the CPU has it
+// (picked at runtime). It finds separators with vector compares and looks up each code
+// in a 64-entry table.
+//
+// Binary format: a bit stream, least significant bit first. Each symbol starts with a
+// 3-bit length prefix:
+//   1-5  a code of that many elements follows, first element first (dot 0, dash 1)
+//   0    word break
+//   6    a UTF-8 character follows, 8 bits per byte
+//   7    end of stream; the rest of the last byte is zero
+// Text averages about 6.5 bits per character, against 4-5 bytes in the text format.
+// Input with no symbols encodes to an empty string.
+enum class MorseFormat {
+    TEXT,
+    BINARY
+};
+
+namespace MorseCodec {
+
+void encodeText(const char* text, size_t size, const std::string& separator, std::string& morse);
+void decodeText(const char* morse, size_t size, std::string& text);
+// Portable decoder; the fallback path and the benchmark reference
+void decodeTextScalar(const char* morse, size_t size, std::string& text);
+
+void encodeBinary(const char* text, size_t size, std::string& packed);
+// False on a truncated stream, an unassigned code or a malformed UTF-8 character
+bool decodeBinary(const char* packed, size_t size, std::string& text);
+
+} // namespace MorseCodec
+
+#endif // MORSECODEC_H
@@ -0,0 +1,66 @@
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Byte-wise trie from names to record ids, updated on every insert and remove. Children
+// are kept in sorted sibling lists, so prefix results come out in lexicographic order.
+// Nodes are 16 bytes in one vector and removed branches are recycled.
+//
+// Fuzzy queries walk the trie with Myers' bit-parallel edit distance (Hyyrö's form for
+// whole-string distance), carrying one 64-bit column per depth. A branch is abandoned
+// as soon as every cell of its column exceeds the allowed distance.
+class NameIndex {
+public:
+    struct Match {
+        uint32_t id;
+        int distance;
+    };
+
+    static const size_t MAX_FUZZY_LENGTH = 64;  // Query bytes that fit one machine word
+
+    NameIndex();
+
+    void insert(const char* name, size_t length, uint32_t id);
+    void insert(const std::string& name, uint32_t id) { insert(name.data(), name.size(), id); }
+    void remove(const char* name, size_t length, uint32_t id);
+    void remove(const std::string& name, uint32_t id) { remove(name.data(), name.size(), id); }
+    void renumberAfterErase(uint32_t erasedId);  // Ids above erasedId move down by one
+    void clear();
+
+    // Up to limit ids whose name starts with prefix, in name order
+    std::vector<uint32_t> prefixMatches(const std::string& prefix, size_t limit) const;
+    // Up to limit ids whose name is within maxDistance edits of query, closest first. For
+    // an empty query that is every name of at most maxDistance bytes
+    std::vector<Match> fuzzyMatches(const std::string& query, int maxDistance, size_t limit) const;
+
+    size_t memoryUsage() const;
+
+private:
+    struct Node {
+        uint32_t firstChild;
+        uint32_t nextSibling;  // Also links the free list
+        uint32_t postings;     // Head of this name's id list
+        uint8_t label;
+    };
+
+    struct Posting {
+        uint32_t id;
+        uint32_t next;  // Also links the free list
+    };
+
+    std::vector<Node> nodes;  // nodes[0] is the root
+    std::vector<Posting> postings;
+    uint32_t freeNodes;
+    uint32_t freePostings;
+
+    uint32_t findChild(uint32_t node, uint8_t label) const;
+    uint32_t addChild(uint32_t node, uint8_t label);
+    void unlinkChild(uint32_t parent, uint32_t child);
+    uint32_t allocateNode(uint8_t label);
+    uint32_t allocatePosting(uint32_t id, uint32_t next);
+};
+
+#endif // NAMEINDEX_H
@@ -1,32 +1,120 @@
 #ifndef PASSWORDMANAGER_H
 #define PASSWORDMANAGER_H
 
+#include "KeyDerivation.h"
+#include "NameIndex.h"
+#include "StringArena.h"
+#include "VaultShards.h"
 #include <string>
 #include <vector>
 #include <map>
 #include <algorithm>
 #include <fstream>
 #include <iomanip>
+#include <memory>
+#include <mutex>
 
 class PasswordManager {
-private:
-    struct StoredPassword {
+public:
+    enum class SearchField { SERVICE, USERNAME };
+    
+    struct SearchResult {
         std::string service;
         std::string username;
-        std::string encryptedPassword;
-        std::string algorithm;
-        std::string key;
+        int distance;  // Edits from the query; 0 for prefix matches
+    };
+    
+    // A READ_ONLY vault is never written back to its file, not even on destruction
+    enum class Access { READ_WRITE, READ_ONLY };
+    
+    enum class Change { ADDED, REMOVED, CHANGED };
+    
+    struct Difference {
+        Change change;  // Relative to this vault: ADDED means only the other one has it
+        std::string service;
+    };
+    
+    struct SyncReport {
+        uint64_t nodesCompared = 0;     // Merkle node pairs looked at, roots included
+        uint64_t bucketsDiffering = 0;
+        uint64_t recordsSent = 0;       // Added to the replica or overwritten in it
+        uint64_t recordsRemoved = 0;
+    };
+
+private:
+    // 40 bytes of offsets into the arena; algorithm ids and keys are interned
+    struct StoredPassword {
+        StringArena::Ref service;
+        StringArena::Ref username;
+        StringArena::Ref encryptedPassword;
+        StringArena::Ref algorithm;
+        StringArena::Ref key;
     };
     
     std::vector<StoredPassword> passwords;
+    StringArena arena;
+    size_t deletedBytes = 0;  // Arena bytes no longer referenced, reclaimed by compact()
+    // Both map names to positions in passwords. Built by the first search, then kept up
+    // to date on every add and delete, so loading a vault never pays for them.
+    mutable NameIndex serviceIndex;
+    mutable NameIndex usernameIndex;
+    mutable bool indexed = false;
+    // Built by the first diff or sync and kept up to date like the indexes
+    mutable VaultShards shards;
+    // A vault path that is a directory (or ends in '/') holds one file per shard. Saving
+    // back to the directory it was loaded from rewrites only the shards marked here.
+    std::string cleanDirectory;
+    uint64_t dirtyShards = 0;
+    std::string databaseFile;
+    Access access;
+    bool found = false;  // The last load read an existing vault
+    // Master password: kdfHeader is the "$argon2id$..." line with the KDF parameters,
+    // salt and a check value, empty when the vault has none. vaultKey, in locked memory,
+    // is set once the vault is unlocked and seals every entry key.
+    struct VaultKey;
+    std::string kdfHeader;
+    bool headerDirty = false;  // A directory vault's master.txt needs rewriting
+    std::shared_ptr<const VaultKey> vaultKey;
     
-    void saveToFile(const std::string& filename);
-    void loadFromFile(const std::string& filename);
+    // fields/lengths in file order: service, username, encrypted password, algorithm, key
+    bool store(const char* const fields[], const size_t lengths[]);
+    bool replace(uint32_t id, const char* const fields[], const size_t lengths[]);  // Same service
+    void swapRemove(uint32_t id);
+    void fieldsOf(const StoredPassword& entry, const char* fields[], size_t lengths[]) const;
+    void writeRecord(std::ostream& file, const StoredPassword& entry) const;
+    void parseRecords(const char* cursor, const char* end);
+    void saveShards(const std::string& directory);
+    void markDirty(const StoredPassword& entry);
+    void compact();
+    void buildIndexes() const;
+    void buildShards() const;
+    static bool wrapKey(const VaultKey& vault, const std::string& service, const std::string& key,
+                        std::string& wrapped);
+    static bool unwrapKey(const VaultKey& vault, const std::string& service, const char* wrapped, size_t length,
+                          std::string& key);
+    bool requireUnlocked() const;
+    
+    // Vault keys unlocked by this process, by header
+    static std::map<std::string, std::shared_ptr<const VaultKey>> sessionKeys;
+    static std::mutex sessionMutex;
+    // Ids of the records in bucket that the other vault does not hold an identical copy of
+    void unmatchedInBucket(const PasswordManager& other, uint32_t bucket, std::vector<uint32_t>& mine,
+                           std::vector<uint32_t>& theirs) const;
 
 public:
-    PasswordManager();
+    explicit PasswordManager(const std::string& databaseFile = "password_database.txt",
+                             Access access = Access::READ_WRITE);
     ~PasswordManager();
     
+    void saveToFile(const std::string& filename);
+    void loadFromFile(const std::string& filename);
+    bool exists() const { return found; }  // False when the vault was missing or unreadable
+    size_t size() const { return passwords.size(); }
+    size_t memoryUsage() const {
+        return passwords.capacity() * sizeof(StoredPassword) + arena.memoryUsage() + serviceIndex.memoryUsage() +
+               usernameIndex.memoryUsage() + shards.memoryUsage();
+    }
+    
     void addPassword(const std::string& service, const std::string& username, 
                     const std::string& encryptedPassword, const std::string& algorithm, 
                     const std::string& key);
@@ -34,6 +122,34 @@ public:
     bool getPassword(const std::string& service, std::string& encryptedPassword, 
                      std::string& algorithm, std::string& key);
     void deletePassword(const std::string& service);
+    
+    // Type-ahead: entries whose service or username starts with prefix, in name order
+    std::vector<SearchResult> search(SearchField field, const std::string& prefix, size_t limit = 20) const;
+    // Typo-tolerant: entries within maxDistance edits of query (at most 64 bytes), closest first
+    std::vector<SearchResult> fuzzySearch(SearchField field, const std::string& query, int maxDistance,
+                                          size_t limit = 20) const;
+    void displaySearchResults(const std::vector<SearchResult>& results) const;
+    
+    // With a master password, each entry key is stored sealed (ChaCha20-Poly1305) under a
+    // vault key that Argon2id derives from the password. Unlocking pays the KDF cost once
+    // per process: the key is kept for the session, and later loads of the same vault
+    // pick it up without asking again. A locked vault still lists, searches and syncs,
+    // but cannot store or retrieve passwords.
+    bool isProtected() const { return !kdfHeader.empty(); }
+    bool isUnlocked() const { return vaultKey != nullptr; }
+    bool unlock(const std::string& masterPassword);
+    // Sets or changes the master password and reseals every key; a protected vault has to
+    // be unlocked first
+    bool protect(const std::string& masterPassword, const KeyDerivation::Params& params = KeyDerivation::Params());
+    static void lockSession();  // Forgets every vault key this process has unlocked
+    
+    // Replica sync: both vaults are compared shard by shard down their Merkle trees and
+    // only the buckets whose hashes differ are opened, so the cost follows the number of
+    // changed records rather than the vault size. diff lists the differing services;
+    // syncTo makes replica hold exactly this vault's records (its record order is not
+    // kept) and master password, and leaves saving to the replica's owner.
+    std::vector<Difference> diff(const PasswordManager& other) const;
+    SyncReport syncTo(PasswordManager& replica) const;
 };
 
 #endif // PASSWORDMANAGER_H
\ No newline at end of file
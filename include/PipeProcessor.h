@@ -0,0 +1,44 @@
+#ifndef PIPEPROCESSOR_H
+#define PIPEPROCESSOR_H
+
+#include "CipherAlgorithm.h"
+#include <cstdint>
+
+// Streams one file descriptor through a cipher into another, for use as a filter in
+// shell pipelines. Reading, the cipher and writing are separate threads that pass
+// fixed buffers around through lock-free single-producer/single-consumer rings, so the
+// slowest stage sets the pace and the other two overlap with it.
+//
+// Output is copied with write(). With zeroCopy and a pipe as output, finished buffers
+// are instead gifted to the pipe with vmsplice() and the buffer gets fresh pages, so
+// nothing the consumer can still see is ever written again. Ciphers whose output length differs from the input (Morse,
+// chacha20-poly1305) cannot be cut into independent blocks and read the whole input first;
+// compressed (+lz) and hex/Base64-armored forms of the others stream block by block on a
+// single thread.
+class PipeProcessor {
+public:
+    struct Options {
+        size_t blockSize = 256 << 10;
+        size_t blocks = 16;              // Buffers shared by the three stages
+        bool zeroCopy = false;           // vmsplice() into an output pipe
+    };
+
+    struct Report {
+        bool ok = true;
+        uint64_t bytesIn = 0;
+        uint64_t bytesOut = 0;
+        double seconds = 0.0;
+        // Fraction of the run each stage spent not waiting on its neighbours; reading
+        // and writing include time blocked on the producer and consumer processes
+        double readBusy = 0.0;
+        double cipherBusy = 0.0;
+        double writeBusy = 0.0;
+        const char* mode = "";           // "vmsplice", "write", "staged" or "buffered"
+    };
+
+    static Report run(CipherAlgorithm& cipher, bool isEncryption, int inputFd, int outputFd);
+    static Report run(CipherAlgorithm& cipher, bool isEncryption, int inputFd, int outputFd,
+                      const Options& options);
+};
+
+#endif // PIPEPROCESSOR_H
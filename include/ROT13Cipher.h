@@ -8,7 +8,10 @@ public:
     ROT13Cipher(); // Default constructor
     ROT13Cipher(const std::string& info); // Overloaded constructor
     std::string processText(const std::string& text, bool isEncryption) override;
-    void setKey(const std::string& key) override;
+    std::shared_ptr<const KeySchedule> compileKey(const std::string& key) const override;
+    void applySchedule(const std::shared_ptr<const KeySchedule>& schedule) override;
+    bool preservesLength() const override;
+    const char* getName() const override;
     std::string getDescription() const override;
     std::string getKeyInstructions() const override;
     friend std::ostream& operator<<(std::ostream& os, const ROT13Cipher& cipher);
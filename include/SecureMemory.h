@@ -0,0 +1,73 @@
+#ifndef SECUREMEMORY_H
+#define SECUREMEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Memory for keys and other secrets. Blocks come from pooled 64 KB slabs that are
+// mlock()ed (never swapped), left out of core dumps and bracketed by PROT_NONE guard
+// pages; blocks of a page or more also get a guard page each. A block is zeroed when it
+// is released and goes back to a per-thread free list for its size class, so after
+// warm-up allocation costs no system calls and usually no lock. Requests above 64 KB get
+// their own guarded mapping.
+namespace SecureMemory {
+
+struct Stats {
+    size_t slabBytes;      // Mapped for the pool, guard pages excluded
+    size_t lockedBytes;    // Of which mlock() succeeded
+};
+
+void* allocate(size_t bytes);
+void release(void* pointer, size_t bytes);  // Zeroes the bytes first
+
+// Zeroes memory in a way the compiler cannot drop as a dead store
+void wipe(void* pointer, size_t bytes);
+void wipe(std::string& text);  // Whole capacity, then clears
+
+Stats stats();
+
+} // namespace SecureMemory
+
+template <typename T>
+class SecureAllocator {
+public:
+    using value_type = T;
+
+    SecureAllocator() noexcept {}
+    template <typename U> SecureAllocator(const SecureAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        if (count > SIZE_MAX / sizeof(T)) throw std::bad_alloc();
+        return static_cast<T*>(SecureMemory::allocate(count * sizeof(T)));
+    }
+    void deallocate(T* pointer, size_t count) noexcept { SecureMemory::release(pointer, count * sizeof(T)); }
+};
+
+template <typename T, typename U>
+bool operator==(const SecureAllocator<T>&, const SecureAllocator<U>&) { return true; }
+template <typename T, typename U>
+bool operator!=(const SecureAllocator<T>&, const SecureAllocator<U>&) { return false; }
+
+template <typename T> using SecureVector = std::vector<T, SecureAllocator<T>>;
+
+// Strings of 15 bytes or fewer are stored inside the string object itself (the
+// small-string buffer), so reserve() at least SECURE_STRING_MINIMUM before filling one
+using SecureString = std::basic_string<char, std::char_traits<char>, SecureAllocator<char>>;
+const size_t SECURE_STRING_MINIMUM = 32;
+
+struct SecureStringHash {
+    size_t operator()(const SecureString& text) const;
+};
+
+// Builds a key schedule (or any shared object) inside secure memory
+template <typename T, typename... Args>
+std::shared_ptr<T> makeSecureShared(Args&&... args) {
+    return std::allocate_shared<T>(SecureAllocator<T>(), std::forward<Args>(args)...);
+}
+
+#endif // SECUREMEMORY_H
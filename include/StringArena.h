@@ -0,0 +1,51 @@
+#ifndef STRINGARENA_H
+#define STRINGARENA_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Append-only storage for many small strings in one contiguous buffer. A string is
+// addressed by a Ref (offset and length, 8 bytes) instead of owning a heap block, and
+// intern() stores each distinct value once. Offsets are 32-bit, so an arena holds up
+// to 4 GB; canHold() tells whether another string still fits. A buffer the arena grows
+// out of, and the contents on clear(), are zeroed (SecureMemory::wipe) first, so vault
+// keys do not linger in freed memory.
+class StringArena {
+public:
+    struct Ref {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    Ref append(const char* data, size_t length);
+    Ref append(const std::string& text) { return append(text.data(), text.size()); }
+    Ref intern(const char* data, size_t length);   // Returns the existing copy when there is one
+    Ref intern(const std::string& text) { return intern(text.data(), text.size()); }
+
+    const char* data(Ref ref) const { return storage.data() + ref.offset; }
+    std::string get(Ref ref) const { return std::string(data(ref), ref.length); }
+    bool equals(Ref ref, const std::string& text) const {
+        return ref.length == text.size() && std::memcmp(data(ref), text.data(), text.size()) == 0;
+    }
+
+    bool canHold(size_t bytes) const { return bytes <= UINT32_MAX - storage.size(); }
+    void reserve(size_t bytes);
+    void clear();
+    void swap(StringArena& other);
+
+    size_t bytes() const { return storage.size(); }
+    size_t memoryUsage() const;  // Buffer and intern table capacity
+
+private:
+    std::vector<char> storage;
+    std::vector<Ref> internSlots;  // Open addressing; length UINT32_MAX marks an empty slot
+    size_t internCount = 0;
+
+    static uint64_t hash(const char* data, size_t length);
+    void grow(size_t bytes);
+    void growInternTable();
+};
+
+#endif // STRINGARENA_H
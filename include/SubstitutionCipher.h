@@ -2,22 +2,31 @@
 #define SUBSTITUTIONCIPHER_H
 
 #include "CipherAlgorithm.h"
-#include <map>
+#include "SecureMemory.h"
+#include <array>
 #include <string>
 
 class SubstitutionCipher : public CipherAlgorithm {
 private:
-    std::map<char, char> encryptionMap;
-    std::map<char, char> decryptionMap;
+    // Byte-indexed translation tables; non-letters map to themselves
+    struct Schedule : KeySchedule {
+        std::array<char, 256> encryptionMap;
+        std::array<char, 256> decryptionMap;
+    };
     
-    void generateMaps(const std::string& key);
+    std::shared_ptr<const Schedule> schedule;
+    
+    static std::shared_ptr<const Schedule> generateMaps(const std::string& key);
 
 protected:
     std::string processText(const std::string& text, bool isEncryption) override;
 
 public:
     SubstitutionCipher();
-    void setKey(const std::string& key) override;
+    std::shared_ptr<const KeySchedule> compileKey(const std::string& key) const override;
+    void applySchedule(const std::shared_ptr<const KeySchedule>& schedule) override;
+    bool preservesLength() const override;
+    const char* getName() const override;
     std::string getDescription() const override;
     std::string getKeyInstructions() const override;
 };
@@ -0,0 +1,69 @@
+#ifndef TEXTARMOR_H
+#define TEXTARMOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Text encodings for binary ciphertext, so it survives newline-delimited files, terminals
+// and copy/paste. Hex is lowercase on output and either case on input; Base64 is the
+// standard RFC 4648 alphabet with '=' padding and no line breaks. The kernels use AVX2
+// when the CPU has it (picked at runtime) and a table-driven scalar loop otherwise.
+enum class Armor {
+    NONE,
+    HEX,
+    BASE64
+};
+
+namespace TextArmor {
+
+const char* name(Armor armor);  // "", "hex", "base64"
+bool parse(const std::string& name, Armor& armor);
+
+size_t encodedSize(Armor armor, size_t bytes);
+std::string encode(Armor armor, const std::string& data);
+// False on characters outside the alphabet, a bad length or misplaced padding. Line
+// breaks and spaces are skipped, so wrapped or hand-edited text still decodes.
+bool decode(Armor armor, const std::string& text, std::string& data);
+
+// Raw kernels. Decoders take text without whitespace: hex of even length, Base64 a
+// multiple of 4 characters.
+void hexEncode(const uint8_t* data, size_t size, char* text);
+bool hexDecode(const char* text, size_t size, uint8_t* data);
+void base64Encode(const uint8_t* data, size_t size, char* text);
+bool base64Decode(const char* text, size_t size, uint8_t* data, size_t& dataSize);
+
+// Portable versions of the same; the fallback path and the benchmark reference
+void hexEncodeScalar(const uint8_t* data, size_t size, char* text);
+bool hexDecodeScalar(const char* text, size_t size, uint8_t* data);
+void base64EncodeScalar(const uint8_t* data, size_t size, char* text);
+bool base64DecodeScalar(const char* text, size_t size, uint8_t* data, size_t& dataSize);
+
+// Streaming stages: feed any split of the input, output appears as soon as whole groups
+// (3 bytes / 4 characters for Base64, 2 characters for hex decoding) are available
+class Encoder {
+public:
+    explicit Encoder(Armor armor) : armor(armor) {}
+    void update(const char* data, size_t size, std::string& text);
+    void finish(std::string& text);
+
+private:
+    Armor armor;
+    std::string pending;  // Up to 2 bytes waiting for a full Base64 group
+};
+
+class Decoder {
+public:
+    explicit Decoder(Armor armor) : armor(armor) {}
+    bool update(const char* text, size_t size, std::string& data);
+    bool finish(std::string& data);  // False if the input ended mid-group
+
+private:
+    Armor armor;
+    std::string pending;  // Characters of an incomplete group, whitespace removed
+    bool padded = false;  // A '=' group was seen; nothing may follow it
+};
+
+} // namespace TextArmor
+
+#endif // TEXTARMOR_H
@@ -0,0 +1,74 @@
+#ifndef VAULTSHARDS_H
+#define VAULTSHARDS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Hash partitioning of vault records with a Merkle tree per shard. A record's service name
+// picks one of 64 shards and one of 4096 buckets inside it (the top 18 bits of its XXH3),
+// so every replica files a record in the same place. A bucket's hash is the sum of its
+// record digests, which makes it independent of insertion order; the levels above hash
+// their 16 children. Two replicas are compared top-down and only subtrees whose hashes
+// differ are visited, so a diff costs about one tree path per changed bucket.
+//
+// Ids are positions in the vault's record vector; the per-record digest, bucket and
+// bucket chain link are kept alongside them.
+class VaultShards {
+public:
+    static const uint32_t SHARD_COUNT = 64;
+    static const uint32_t FANOUT = 16;
+    static const int DEPTH = 3;                     // Levels below a shard root
+    static const uint32_t BUCKETS_PER_SHARD = 4096;  // FANOUT^DEPTH
+    static const uint32_t BUCKET_COUNT = SHARD_COUNT * BUCKETS_PER_SHARD;
+    static const uint32_t NONE = UINT32_MAX;
+
+    static uint32_t bucketFor(const char* service, size_t length);
+    static uint32_t shardOf(uint32_t bucket) { return bucket / BUCKETS_PER_SHARD; }
+    // Digest of a whole record, fields in file order
+    static uint64_t recordDigest(const char* const fields[], const size_t lengths[], int count);
+
+    bool built() const { return !bucketSums.empty(); }
+    // Replaces the contents with records 0..n-1
+    void assign(const std::vector<uint32_t>& buckets, const std::vector<uint64_t>& digests);
+    void clear();
+
+    void append(uint32_t bucket, uint64_t digest);  // Takes the next id
+    void replace(uint32_t id, uint64_t digest);      // Same bucket, new contents
+    void erase(uint32_t id);                         // Ids above id move down by one
+    void swapRemove(uint32_t id);                    // The last id takes id's place
+
+    size_t size() const { return digests.size(); }
+    uint32_t bucketOf(uint32_t id) const { return buckets[id]; }
+    uint64_t digestOf(uint32_t id) const { return digests[id]; }
+    uint32_t firstIn(uint32_t bucket) const { return heads[bucket]; }
+    uint32_t nextInBucket(uint32_t id) const { return links[id]; }
+
+    uint64_t root() const;
+    uint64_t shardRoot(uint32_t shard) const { return inner[shard * INNER_PER_SHARD]; }
+
+    // Buckets whose hashes differ between the two trees; nodesCompared counts every
+    // node pair looked at, the roots included
+    static std::vector<uint32_t> differingBuckets(const VaultShards& a, const VaultShards& b,
+                                                  uint64_t& nodesCompared);
+
+    size_t memoryUsage() const;
+
+private:
+    static const uint32_t INNER_PER_SHARD = 1 + FANOUT + FANOUT * FANOUT;
+
+    std::vector<uint64_t> bucketSums;  // BUCKET_COUNT leaves
+    std::vector<uint64_t> inner;       // Per shard: root, then each level left to right
+    std::vector<uint64_t> digests;
+    std::vector<uint32_t> buckets;
+    std::vector<uint32_t> links;  // Next id in the same bucket
+    std::vector<uint32_t> heads;  // First id of each bucket
+
+    const uint64_t* level(uint32_t shard, int depth) const;
+    void rehashPath(uint32_t bucket);
+    void rehashAll();
+    void unlink(uint32_t id);
+    void rebuildChains();
+};
+
+#endif // VAULTSHARDS_H
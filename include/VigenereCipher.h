@@ -1,19 +1,42 @@
 #ifndef VIGENERECIPHER_H
 #define VIGENERECIPHER_H
 
+#include "Alphabet.h"
 #include "CipherAlgorithm.h"
+#include "SecureMemory.h"
+#include <cstdint>
+#include <vector>
 
 class VigenereCipher : public CipherAlgorithm {
 private:
-    std::string key = "KEY";  // Default key
+    struct Schedule : KeySchedule {
+        // Per alphabet: the shift for each key character, then the first 64 again (see
+        // shiftLettersByKey). Built for every alphabet so setAlphabet() keeps the key.
+        SecureVector<uint8_t> encryptionStreams[ALPHABET_COUNT];
+        SecureVector<uint8_t> decryptionStreams[ALPHABET_COUNT];
+        size_t keyLength = 0;
+    };
+
+    std::shared_ptr<const Schedule> schedule;
+    Alphabet alphabet;
 
 protected:
     std::string processText(const std::string& text, bool isEncryption) override;
+    std::string processTextAt(const std::string& text, bool isEncryption, uint64_t state) override;
 
 public:
-    void setKey(const std::string& newKey) override;
+    explicit VigenereCipher(Alphabet alphabet = Alphabet::LETTERS);
+    void setAlphabet(Alphabet newAlphabet) { alphabet = newAlphabet; }
+    Alphabet getAlphabet() const { return alphabet; }
+    
+    uint64_t advanceState(const std::string& plaintext, uint64_t state) const override;  // Alphabet characters seen
+    std::shared_ptr<const KeySchedule> compileKey(const std::string& key) const override;
+    void applySchedule(const std::shared_ptr<const KeySchedule>& schedule) override;
+    bool hasStreamState() const override;
+    bool preservesLength() const override;
+    const char* getName() const override;
     std::string getDescription() const override;
     std::string getKeyInstructions() const override;
 };
 
-#endif // VIGENERECIPHER_H
\ No newline at end of file
+#endif // VIGENERECIPHER_H
@@ -0,0 +1,56 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Thread pool with one task deque per worker. A worker runs its own newest task first
+// (tasks spawned by a task stay hot in cache) and, when its deque is empty, steals the
+// oldest task from another worker, so a burst of subtasks from one big job spreads
+// across all threads.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(unsigned threadCount = 0);  // 0 = one per hardware thread
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Called from a worker, the task goes to that worker's deque; otherwise round-robin
+    void submit(std::function<void()> task);
+
+    // Blocks until every submitted task, including tasks submitted by tasks, has run
+    void wait();
+
+    unsigned size() const { return static_cast<unsigned>(workers.size()); }  // Complete before any thread starts
+    uint64_t steals() const { return stealCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> pending{0};  // Submitted and not yet finished
+    std::atomic<size_t> queued{0};   // Sitting in some deque
+    std::atomic<unsigned> sleepers{0};  // Workers blocked on workAvailable
+    std::atomic<unsigned> nextWorker{0};
+    std::atomic<uint64_t> stealCount{0};
+    bool stopping = false;
+    std::mutex sleepMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+
+    bool takeTask(unsigned self, std::function<void()>& task);
+    void workerLoop(unsigned index);
+};
+
+#endif // WORKSTEALINGPOOL_H
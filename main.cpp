@@ -1,9 +1,23 @@
 #include "include/EncryptionApp.h"
 #include "include/ROT13Cipher.h"
+#include "include/Metrics.h"
+#include "include/CommandLine.h"
 
-int main() {
-    EncryptionApp app;
-    app.run();
+int main(int argc, char* argv[]) {
+    Metrics::configureFromEnvironment();
+    
+    if (argc > 1) {
+        int status = CommandLine::run(argc, argv);
+        Metrics::writeConfiguredOutputs();
+        return status;
+    }
+    
+    {
+        EncryptionApp app;
+        app.run();
+    }  // The vault is saved when the app goes out of scope
+    
+    Metrics::writeConfiguredOutputs();
 
     ROT13Cipher* cipher = new ROT13Cipher();
     std::string result = cipher->processText("Hello", true);
@@ -0,0 +1,319 @@
+#include "AeadCipher.h"
+#include "ChaCha20Poly1305.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const char MAGIC[4] = {'E', 'T', 'A', '1'};
+const uint8_t FORMAT_VERSION = 1;
+const uint8_t ALGORITHM_CHACHA20_POLY1305 = 1;
+const size_t TAG_SIZE = ChaCha20Poly1305::TAG_SIZE;
+const size_t PARALLEL_THRESHOLD = 4 * 1024 * 1024;  // Below this, thread startup outweighs the work
+
+struct Header {
+    uint8_t bytes[AeadCipher::HEADER_SIZE];
+
+    const uint8_t* nonce() const { return bytes + 12; }
+};
+
+void store32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+uint32_t load32(const uint8_t* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(p[i]) << (8 * i);
+    return v;
+}
+
+void fillRandom(uint8_t* out, size_t size) {
+    static thread_local std::random_device device;  // Opening the entropy source dominates small messages
+    for (size_t i = 0; i < size; i += 4) {
+        uint32_t word = device();
+        for (size_t j = i; j < size && j < i + 4; ++j) out[j] = static_cast<uint8_t>(word >> (8 * (j - i)));
+    }
+}
+
+Header makeHeader(size_t chunkSize) {
+    Header header;
+    std::memcpy(header.bytes, MAGIC, sizeof(MAGIC));
+    header.bytes[4] = FORMAT_VERSION;
+    header.bytes[5] = ALGORITHM_CHACHA20_POLY1305;
+    header.bytes[6] = header.bytes[7] = 0;
+    store32(header.bytes + 8, static_cast<uint32_t>(chunkSize));
+    fillRandom(header.bytes + 12, ChaCha20Poly1305::NONCE_SIZE);
+    return header;
+}
+
+bool parseHeader(const uint8_t* data, Header& header, size_t& chunkSize) {
+    std::memcpy(header.bytes, data, AeadCipher::HEADER_SIZE);
+    chunkSize = load32(header.bytes + 8);
+    return std::memcmp(header.bytes, MAGIC, sizeof(MAGIC)) == 0 && header.bytes[4] == FORMAT_VERSION &&
+           header.bytes[5] == ALGORITHM_CHACHA20_POLY1305 && chunkSize > 0 &&
+           chunkSize <= AeadCipher::MAX_CHUNK_SIZE;
+}
+
+// Per-chunk nonce and associated data: the header nonce with the chunk index XORed into
+// its last eight bytes, and header || index || final flag
+struct ChunkContext {
+    uint8_t nonce[ChaCha20Poly1305::NONCE_SIZE];
+    uint8_t aad[AeadCipher::HEADER_SIZE + 9];
+
+    ChunkContext(const Header& header, uint64_t index, bool final) {
+        std::memcpy(nonce, header.nonce(), sizeof(nonce));
+        std::memcpy(aad, header.bytes, AeadCipher::HEADER_SIZE);
+        for (int i = 0; i < 8; ++i) {
+            nonce[4 + i] ^= static_cast<uint8_t>(index >> (8 * i));
+            aad[AeadCipher::HEADER_SIZE + i] = static_cast<uint8_t>(index >> (8 * i));
+        }
+        aad[AeadCipher::HEADER_SIZE + 8] = final ? 1 : 0;
+    }
+};
+
+void sealChunk(const uint8_t* key, const Header& header, uint64_t index, bool final,
+               const uint8_t* in, size_t size, uint8_t* out) {
+    ChunkContext context(header, index, final);
+    ChaCha20Poly1305::seal(key, context.nonce, context.aad, sizeof(context.aad), in, size, out, out + size);
+}
+
+bool openChunk(const uint8_t* key, const Header& header, uint64_t index, bool final,
+               const uint8_t* in, size_t size, uint8_t* out) {
+    ChunkContext context(header, index, final);
+    return ChaCha20Poly1305::open(key, context.nonce, context.aad, sizeof(context.aad), in, size, in + size, out);
+}
+
+// Runs work(first, last) over chunk ranges, one contiguous range per hardware thread
+template <typename Work>
+void forEachChunkRange(size_t chunkCount, size_t totalBytes, Work work) {
+    unsigned threads = totalBytes < PARALLEL_THRESHOLD ? 1 : std::max(1u, std::thread::hardware_concurrency());
+    if (threads == 1 || chunkCount == 1) {
+        work(0, chunkCount);
+        return;
+    }
+
+    size_t workers = std::min<size_t>(threads, chunkCount);
+    std::vector<std::thread> pool;
+    for (size_t w = 0; w < workers; ++w) {
+        size_t first = chunkCount * w / workers;
+        size_t last = chunkCount * (w + 1) / workers;
+        pool.emplace_back([&work, first, last]() { work(first, last); });
+    }
+    for (auto& thread : pool) thread.join();
+}
+
+void reportAuthenticationFailure() {
+    std::cerr << "Error: Authentication failed. The data was modified or the key is wrong." << std::endl;
+}
+
+// The RFC 8439 vectors are checked once, before the first key is accepted
+bool kernelsVerified() {
+    static const bool verified = ChaCha20Poly1305::selfTest();
+    return verified;
+}
+
+} // namespace
+
+void AeadCipher::setChunkSize(size_t size) {
+    if (size > MAX_CHUNK_SIZE) size = MAX_CHUNK_SIZE;
+    chunkSize = std::max<size_t>(1, size);
+}
+
+std::string AeadCipher::processText(const std::string& text, bool isEncryption) {
+    std::string result;
+    processChecked(text, isEncryption, result);
+    return result;
+}
+
+bool AeadCipher::processChecked(const std::string& text, bool isEncryption, std::string& result) {
+    if (!schedule) {
+        std::cerr << "Error: No key set for " << getName() << "." << std::endl;
+        return false;
+    }
+    const uint8_t* key = schedule->key.data();
+    const uint8_t* input = reinterpret_cast<const uint8_t*>(text.data());
+
+    if (isEncryption) {
+        size_t chunkCount = text.empty() ? 1 : (text.size() + chunkSize - 1) / chunkSize;
+        Header header = makeHeader(chunkSize);
+
+        result.assign(HEADER_SIZE + text.size() + chunkCount * TAG_SIZE, '\0');
+        uint8_t* output = reinterpret_cast<uint8_t*>(&result[0]);
+        std::memcpy(output, header.bytes, HEADER_SIZE);
+
+        size_t size = text.size(), chunk = chunkSize;
+        forEachChunkRange(chunkCount, size, [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                size_t offset = i * chunk;
+                size_t length = std::min(chunk, size - offset);
+                sealChunk(key, header, i, i + 1 == chunkCount, input + offset, length,
+                          output + HEADER_SIZE + offset + i * TAG_SIZE);
+            }
+        });
+        return true;
+    }
+
+    Header header;
+    size_t chunk;
+    if (text.size() < HEADER_SIZE + TAG_SIZE || !parseHeader(input, header, chunk)) {
+        std::cerr << "Error: Input is not " << getName() << " data." << std::endl;
+        return false;
+    }
+
+    // All chunks but the last are full; the last record holds at least a tag
+    size_t body = text.size() - HEADER_SIZE;
+    size_t record = chunk + TAG_SIZE;
+    size_t chunkCount = (body + record - 1) / record;
+    size_t lastRecord = body - (chunkCount - 1) * record;
+    if (lastRecord < TAG_SIZE) {
+        reportAuthenticationFailure();
+        return false;
+    }
+    size_t size = body - chunkCount * TAG_SIZE;
+
+    result.assign(size, '\0');
+    uint8_t* output = reinterpret_cast<uint8_t*>(&result[0]);
+    std::atomic<bool> authentic(true);
+    forEachChunkRange(chunkCount, size, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last && authentic.load(std::memory_order_relaxed); ++i) {
+            size_t offset = i * chunk;
+            size_t length = std::min(chunk, size - offset);
+            if (!openChunk(key, header, i, i + 1 == chunkCount, input + HEADER_SIZE + offset + i * TAG_SIZE,
+                           length, output + offset)) {
+                authentic = false;
+            }
+        }
+    });
+
+    if (!authentic) {
+        reportAuthenticationFailure();
+        result.clear();
+        return false;
+    }
+    return true;
+}
+
+bool AeadCipher::encryptStream(std::istream& input, std::ostream& output) {
+    if (!schedule) {
+        std::cerr << "Error: No key set for " << getName() << "." << std::endl;
+        return false;
+    }
+    Header header = makeHeader(chunkSize);
+    output.write(reinterpret_cast<const char*>(header.bytes), HEADER_SIZE);
+
+    std::vector<uint8_t> buffer(chunkSize + TAG_SIZE);
+    uint64_t index = 0;
+    bool final = false;
+    while (!final) {
+        input.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(chunkSize));
+        size_t length = static_cast<size_t>(input.gcount());
+        final = input.peek() == std::char_traits<char>::eof();
+        if (input.bad()) return false;
+
+        sealChunk(schedule->key.data(), header, index++, final, buffer.data(), length, buffer.data());
+        output.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(length + TAG_SIZE));
+    }
+    return static_cast<bool>(output);
+}
+
+bool AeadCipher::decryptStream(std::istream& input, std::ostream& output) {
+    if (!schedule) {
+        std::cerr << "Error: No key set for " << getName() << "." << std::endl;
+        return false;
+    }
+
+    uint8_t headerBytes[HEADER_SIZE];
+    Header header;
+    size_t chunk;
+    input.read(reinterpret_cast<char*>(headerBytes), HEADER_SIZE);
+    if (static_cast<size_t>(input.gcount()) != HEADER_SIZE || !parseHeader(headerBytes, header, chunk)) {
+        std::cerr << "Error: Input is not " << getName() << " data." << std::endl;
+        return false;
+    }
+
+    // Each chunk is released only after its tag checks out; a stream cut short at a chunk
+    // boundary is caught at the end because its last chunk was not sealed as final
+    std::vector<uint8_t> buffer(chunk + TAG_SIZE);
+    uint64_t index = 0;
+    bool final = false;
+    while (!final) {
+        input.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        size_t length = static_cast<size_t>(input.gcount());
+        final = input.peek() == std::char_traits<char>::eof();
+        if (length < TAG_SIZE || (!final && length != buffer.size()) ||
+            !openChunk(schedule->key.data(), header, index++, final, buffer.data(), length - TAG_SIZE, buffer.data())) {
+            reportAuthenticationFailure();
+            return false;
+        }
+        output.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(length - TAG_SIZE));
+    }
+    return static_cast<bool>(output);
+}
+
+std::string AeadCipher::generateKey() {
+    static const char digits[] = "0123456789abcdef";
+    uint8_t bytes[ChaCha20Poly1305::KEY_SIZE];
+    fillRandom(bytes, sizeof(bytes));
+
+    std::string key;
+    for (uint8_t byte : bytes) {
+        key += digits[byte >> 4];
+        key += digits[byte & 0x0f];
+    }
+    return key;
+}
+
+bool AeadCipher::isAuthenticated() const {
+    return true;
+}
+
+// Keystream under a fixed nonce; like any ChaCha20 output it says nothing about the key
+uint64_t AeadCipher::keyFingerprint() {
+    if (!schedule) return 0;
+    static const uint8_t nonce[ChaCha20Poly1305::NONCE_SIZE] = {'k', 'e', 'y', ' ', 'p', 'r', 'i', 'n', 't', 0, 0, 0};
+    uint8_t zeros[8] = {};
+    uint8_t keystream[8];
+    ChaCha20Poly1305::chacha20Xor(schedule->key.data(), nonce, 0, zeros, keystream, sizeof(keystream));
+    uint64_t fingerprint = 0;
+    for (int i = 0; i < 8; ++i) fingerprint |= static_cast<uint64_t>(keystream[i]) << (8 * i);
+    return fingerprint;
+}
+
+std::shared_ptr<const KeySchedule> AeadCipher::compileKey(const std::string& key) const {
+    if (!kernelsVerified()) {
+        std::cerr << "Error: ChaCha20-Poly1305 failed its self-test on this CPU." << std::endl;
+        return nullptr;
+    }
+    if (key.size() != 2 * ChaCha20Poly1305::KEY_SIZE ||
+        !std::all_of(key.begin(), key.end(), [](char c) { return std::isxdigit(static_cast<unsigned char>(c)); })) {
+        std::cerr << "Invalid key. Enter exactly 64 hexadecimal digits." << std::endl;
+        return nullptr;
+    }
+
+    auto schedule = makeSecureShared<Schedule>();
+    for (size_t i = 0; i < schedule->key.size(); ++i) {
+        schedule->key[i] = static_cast<uint8_t>(std::stoul(key.substr(2 * i, 2), nullptr, 16));
+    }
+    return schedule;
+}
+
+void AeadCipher::applySchedule(const std::shared_ptr<const KeySchedule>& newSchedule) {
+    if (newSchedule) schedule = std::static_pointer_cast<const Schedule>(newSchedule);
+}
+
+const char* AeadCipher::getName() const {
+    return "chacha20-poly1305";
+}
+
+std::string AeadCipher::getDescription() const {
+    return "\033[1;34mChaCha20-Poly1305:\033[0m Modern authenticated encryption; any change to the ciphertext is detected on decryption.";
+}
+
+std::string AeadCipher::getKeyInstructions() const {
+    return "\033[1;32mEnter a 256-bit key as 64 hexadecimal digits\033[0m (keep it secret; it cannot be recovered).";
+}
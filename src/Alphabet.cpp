@@ -0,0 +1,51 @@
+#include "Alphabet.h"
+#include "Ascii.h"
+
+namespace Alphabets {
+
+int size(Alphabet alphabet) {
+    switch (alphabet) {
+        case Alphabet::ALPHANUMERIC: return 62;
+        case Alphabet::PRINTABLE: return 95;
+        case Alphabet::BYTES: return 256;
+        default: return 26;
+    }
+}
+
+const char* name(Alphabet alphabet) {
+    switch (alphabet) {
+        case Alphabet::ALPHANUMERIC: return "alnum";
+        case Alphabet::PRINTABLE: return "printable";
+        case Alphabet::BYTES: return "bytes";
+        default: return "letters";
+    }
+}
+
+bool parse(const std::string& text, Alphabet& alphabet) {
+    for (int i = 0; i < ALPHABET_COUNT; ++i) {
+        if (text == name(static_cast<Alphabet>(i))) {
+            alphabet = static_cast<Alphabet>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+int indexOf(Alphabet alphabet, char c) {
+    unsigned char byte = static_cast<unsigned char>(c);
+    switch (alphabet) {
+        case Alphabet::LETTERS:
+            return Ascii::isAlpha(c) ? Ascii::toUpper(c) - 'A' : -1;
+        case Alphabet::ALPHANUMERIC:
+            if (Ascii::isDigit(c)) return c - '0';
+            if (Ascii::isUpper(c)) return c - 'A' + 10;
+            if (Ascii::isLower(c)) return c - 'a' + 36;
+            return -1;
+        case Alphabet::PRINTABLE:
+            return byte >= 0x20 && byte < 0x7F ? byte - 0x20 : -1;
+        default:
+            return byte;
+    }
+}
+
+} // namespace Alphabets
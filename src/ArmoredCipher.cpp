@@ -0,0 +1,79 @@
+#include "ArmoredCipher.h"
+#include <iostream>
+#include <utility>
+
+ArmoredCipher::ArmoredCipher(std::unique_ptr<CipherAlgorithm> inner, Armor armor)
+    : inner(std::move(inner)), armor(armor),
+      name(internName(std::string(this->inner->getName()) + "+" + TextArmor::name(armor))) {}
+
+std::string ArmoredCipher::armored(const std::string& ciphertext) const {
+    return TextArmor::encode(armor, ciphertext);
+}
+
+bool ArmoredCipher::unarmored(const std::string& text, std::string& ciphertext) const {
+    if (TextArmor::decode(armor, text, ciphertext)) return true;
+    std::cerr << "Error: Input is not valid " << TextArmor::name(armor) << " text." << std::endl;
+    return false;
+}
+
+std::string ArmoredCipher::processText(const std::string& text, bool isEncryption) {
+    std::string result;
+    processChecked(text, isEncryption, result);
+    return result;
+}
+
+bool ArmoredCipher::processChecked(const std::string& text, bool isEncryption, std::string& result) {
+    std::string ciphertext;
+    if (isEncryption) {
+        if (!inner->tryEncrypt(text, ciphertext)) return false;
+        result = armored(ciphertext);
+        return true;
+    }
+    return unarmored(text, ciphertext) && inner->tryDecrypt(ciphertext, result);
+}
+
+std::string ArmoredCipher::processTextAt(const std::string& text, bool isEncryption, uint64_t state) {
+    if (isEncryption) return armored(inner->encryptAt(text, state));
+    std::string ciphertext;
+    return unarmored(text, ciphertext) ? inner->decryptAt(ciphertext, state) : "";
+}
+
+uint64_t ArmoredCipher::advanceState(const std::string& plaintext, uint64_t state) const {
+    return inner->advanceState(plaintext, state);
+}
+
+bool ArmoredCipher::hasStreamState() const {
+    return inner->hasStreamState();
+}
+
+bool ArmoredCipher::isLossless() const {
+    return inner->isLossless();
+}
+
+bool ArmoredCipher::isAuthenticated() const {
+    return inner->isAuthenticated();
+}
+
+uint64_t ArmoredCipher::keyFingerprint() {
+    return inner->keyFingerprint();
+}
+
+std::shared_ptr<const KeySchedule> ArmoredCipher::compileKey(const std::string& key) const {
+    return inner->compileKey(key);
+}
+
+void ArmoredCipher::applySchedule(const std::shared_ptr<const KeySchedule>& schedule) {
+    inner->applySchedule(schedule);
+}
+
+const char* ArmoredCipher::getName() const {
+    return name;
+}
+
+std::string ArmoredCipher::getDescription() const {
+    return inner->getDescription() + " Output is " + TextArmor::name(armor) + " text.";
+}
+
+std::string ArmoredCipher::getKeyInstructions() const {
+    return inner->getKeyInstructions();
+}
@@ -0,0 +1,166 @@
+#include "Ascii.h"
+#include "CipherKernels.h"
+#include <algorithm>
+
+namespace Ascii {
+
+namespace {
+
+const uint8_t U = UPPER;
+const uint8_t L = LOWER;
+const uint8_t D = DIGIT;
+const uint8_t S = SPACE;
+const uint8_t P = PUNCT;
+
+bool isContinuation(char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+// States are named by what must follow: e.g. AFTER_E0 needs A0-BF (no overlong
+// forms), AFTER_ED needs 80-9F (no surrogates), AFTER_F4 needs 80-8F (<= U+10FFFF).
+// rows[b] packs the successor of every state on byte b into 6-bit fields, with a state
+// stored as the bit offset of its field, so a step is one shift and one mask and the
+// loop-carried dependency never waits on a table load.
+struct Utf8Automaton {
+    enum State : uint8_t { ACCEPT, REJECT, NEED_1, NEED_2, NEED_3, AFTER_E0, AFTER_ED, AFTER_F0, AFTER_F4, STATE_COUNT };
+    enum ByteClass : uint8_t {
+        ASCII, CONT_80_8F, CONT_90_9F, CONT_A0_BF, INVALID, LEAD_2, LEAD_E0, LEAD_3, LEAD_ED, LEAD_F0, LEAD_4,
+        LEAD_F4, CLASS_COUNT
+    };
+
+    static const unsigned FIELD_BITS = 6;
+    static const uint64_t FIELD_MASK = 63;
+
+    uint64_t rows[256];
+
+    Utf8Automaton() {
+        uint8_t classes[256];
+        for (int b = 0; b < 256; ++b) {
+            ByteClass c = b < 0x80 ? ASCII : b < 0x90 ? CONT_80_8F : b < 0xA0 ? CONT_90_9F : b < 0xC0 ? CONT_A0_BF
+                        : b < 0xC2 ? INVALID : b < 0xE0 ? LEAD_2 : b == 0xE0 ? LEAD_E0 : b == 0xED ? LEAD_ED
+                        : b < 0xF0 ? LEAD_3 : b == 0xF0 ? LEAD_F0 : b < 0xF4 ? LEAD_4 : b == 0xF4 ? LEAD_F4 : INVALID;
+            classes[b] = c;
+        }
+        for (uint8_t& state : next) state = REJECT;
+        set(ACCEPT, ASCII, ACCEPT);
+        set(ACCEPT, LEAD_2, NEED_1);
+        set(ACCEPT, LEAD_3, NEED_2);
+        set(ACCEPT, LEAD_4, NEED_3);
+        set(ACCEPT, LEAD_E0, AFTER_E0);
+        set(ACCEPT, LEAD_ED, AFTER_ED);
+        set(ACCEPT, LEAD_F0, AFTER_F0);
+        set(ACCEPT, LEAD_F4, AFTER_F4);
+        for (ByteClass c : {CONT_80_8F, CONT_90_9F, CONT_A0_BF}) {
+            set(NEED_1, c, ACCEPT);
+            set(NEED_2, c, NEED_1);
+            set(NEED_3, c, NEED_2);
+        }
+        set(AFTER_E0, CONT_A0_BF, NEED_1);
+        set(AFTER_ED, CONT_80_8F, NEED_1);
+        set(AFTER_ED, CONT_90_9F, NEED_1);
+        set(AFTER_F0, CONT_90_9F, NEED_2);
+        set(AFTER_F0, CONT_A0_BF, NEED_2);
+        set(AFTER_F4, CONT_80_8F, NEED_2);
+
+        for (int b = 0; b < 256; ++b) {
+            rows[b] = 0;
+            for (int state = 0; state < STATE_COUNT; ++state) {
+                uint64_t successor = next[state * CLASS_COUNT + classes[b]];
+                rows[b] |= (successor * FIELD_BITS) << (state * FIELD_BITS);
+            }
+        }
+    }
+
+    static uint8_t encoded(State state) { return static_cast<uint8_t>(state * FIELD_BITS); }
+
+private:
+    uint8_t next[STATE_COUNT * CLASS_COUNT];
+
+    void set(State from, ByteClass byteClass, State to) { next[from * CLASS_COUNT + byteClass] = to; }
+};
+
+const Utf8Automaton& utf8Automaton() {
+    static const Utf8Automaton automaton;
+    return automaton;
+}
+
+} // namespace
+
+const uint8_t CLASSES[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, S, S, S, S, S, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    S, P, P, P, P, P, P, P, P, P, P, P, P, P, P, P,
+    D, D, D, D, D, D, D, D, D, D, P, P, P, P, P, P,
+    P, U, U, U, U, U, U, U, U, U, U, U, U, U, U, U,
+    U, U, U, U, U, U, U, U, U, U, U, P, P, P, P, P,
+    P, L, L, L, L, L, L, L, L, L, L, L, L, L, L, L,
+    L, L, L, L, L, L, L, L, L, L, L, P, P, P, P, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+// RFC 3629: no overlong forms, no surrogates (U+D800-DFFF), nothing above U+10FFFF
+size_t utf8SequenceLength(const char* data, size_t size) {
+    if (size < 2) return 0;
+    unsigned char lead = static_cast<unsigned char>(data[0]);
+    unsigned char second = static_cast<unsigned char>(data[1]);
+
+    size_t length;
+    unsigned char low = 0x80, high = 0xBF;  // Allowed range of the second byte
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        if (lead == 0xE0) low = 0xA0;
+        if (lead == 0xED) high = 0x9F;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        if (lead == 0xF0) low = 0x90;
+        if (lead == 0xF4) high = 0x8F;
+    } else {
+        return 0;
+    }
+
+    if (size < length || second < low || second > high) return 0;
+    for (size_t i = 2; i < length; ++i) {
+        if (!isContinuation(data[i])) return 0;
+    }
+    return length;
+}
+
+// Non-ASCII stretches go through a table-driven DFA a window at a time: REJECT is a
+// sink, so the state only needs checking once per window and the inner loop has no
+// data-dependent branches. ASCII runs between characters are skipped, by the vector
+// kernel once they are longer than SHORT_RUN.
+bool isValidUtf8(const char* data, size_t size) {
+    const size_t SHORT_RUN = 16;
+    const size_t WINDOW = 64;
+    const Utf8Automaton& automaton = utf8Automaton();
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    const uint64_t accept = Utf8Automaton::encoded(Utf8Automaton::ACCEPT);
+    const uint64_t reject = Utf8Automaton::encoded(Utf8Automaton::REJECT);
+    uint64_t state = accept;
+    size_t i = 0;
+    while (i < size) {
+        if (state == accept && bytes[i] < 0x80) {
+            size_t runEnd = std::min(size, i + SHORT_RUN);
+            while (i < runEnd && bytes[i] < 0x80) ++i;
+            if (i == runEnd) i += CipherKernels::asciiPrefixLength(data + i, size - i);
+            continue;
+        }
+        size_t windowEnd = std::min(size, i + WINDOW);
+        for (; i < windowEnd; ++i) {
+            state = (automaton.rows[bytes[i]] >> state) & Utf8Automaton::FIELD_MASK;
+        }
+        if (state == reject) return false;
+    }
+    return state == accept;
+}
+
+} // namespace Ascii
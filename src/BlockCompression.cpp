@@ -0,0 +1,343 @@
+#include "BlockCompression.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const size_t MIN_MATCH = 4;
+const size_t LAST_LITERALS = 5;     // The format ends every block with at least this many literals
+const size_t MATCH_FIND_LIMIT = 12; // No match may start in the last 12 bytes
+const int HASH_BITS = 13;
+const int SKIP_STRENGTH = 6;        // Search step grows by one every 64 misses
+const uint32_t STORED_FLAG = 0x80000000u;
+const size_t PARALLEL_THRESHOLD = 4 * 1024 * 1024;  // Below this, thread startup outweighs the work
+
+uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint64_t read64(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+void store32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+uint32_t load32(const uint8_t* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(p[i]) << (8 * i);
+    return v;
+}
+
+uint32_t hashOf(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Bytes in common at a and b, comparing 8 at a time, not going past limit
+size_t commonLength(const uint8_t* a, const uint8_t* b, const uint8_t* limit) {
+    const uint8_t* start = a;
+    while (a + 8 <= limit) {
+        uint64_t difference = read64(a) ^ read64(b);
+        if (difference) return a - start + (__builtin_ctzll(difference) >> 3);
+        a += 8;
+        b += 8;
+    }
+    while (a < limit && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return a - start;
+}
+
+uint8_t* writeLength(uint8_t* out, size_t length) {
+    for (; length >= 255; length -= 255) *out++ = 255;
+    *out++ = static_cast<uint8_t>(length);
+    return out;
+}
+
+// One sequence: token, literal run, then the match (omitted for the block's last run)
+uint8_t* writeSequence(uint8_t* out, const uint8_t* literals, size_t literalLength, size_t offset,
+                       size_t matchLength) {
+    uint8_t* token = out++;
+    *token = static_cast<uint8_t>(std::min<size_t>(literalLength, 15) << 4);
+    if (literalLength >= 15) out = writeLength(out, literalLength - 15);
+    std::memcpy(out, literals, literalLength);
+    out += literalLength;
+    if (matchLength == 0) return out;
+
+    out[0] = static_cast<uint8_t>(offset);
+    out[1] = static_cast<uint8_t>(offset >> 8);
+    out += 2;
+    size_t code = matchLength - MIN_MATCH;
+    *token |= static_cast<uint8_t>(std::min<size_t>(code, 15));
+    if (code >= 15) out = writeLength(out, code - 15);
+    return out;
+}
+
+bool readLength(const uint8_t*& in, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+    do {
+        if (in >= end) return false;
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+// A frame's position in a buffer of framed blocks
+struct Frame {
+    size_t input;
+    size_t rawSize;
+    size_t storedSize;
+    bool stored;
+    size_t output;
+};
+
+// Reads the header at offset; false when it is truncated or its sizes are impossible
+bool readHeader(const uint8_t* data, size_t size, size_t offset, Frame& frame) {
+    if (size - offset < BlockCompression::HEADER_SIZE) return false;
+    frame.rawSize = load32(data + offset);
+    uint32_t stored = load32(data + offset + 4);
+    frame.stored = (stored & STORED_FLAG) != 0;
+    frame.storedSize = stored & ~STORED_FLAG;
+    frame.input = offset + BlockCompression::HEADER_SIZE;
+    if (frame.rawSize == 0 || frame.rawSize > BlockCompression::BLOCK_SIZE) return false;
+    return frame.stored ? frame.storedSize == frame.rawSize
+                        : frame.storedSize <= BlockCompression::maxPayloadSize(frame.rawSize);
+}
+
+bool payloadPresent(size_t size, const Frame& frame) {
+    return frame.storedSize <= size - frame.input;
+}
+
+bool expandFrame(const uint8_t* data, const Frame& frame, uint8_t* out) {
+    if (frame.stored) {
+        std::memcpy(out, data + frame.input, frame.rawSize);
+        return true;
+    }
+    return BlockCompression::decompressPayload(data + frame.input, frame.storedSize, out, frame.rawSize);
+}
+
+size_t workersFor(size_t blockCount, size_t totalBytes) {
+    if (totalBytes < PARALLEL_THRESHOLD) return 1;
+    return std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), blockCount));
+}
+
+// Runs work(worker, first, last) over block ranges, one contiguous range per worker
+template <typename Work>
+void forEachBlockRange(size_t blockCount, size_t workers, Work work) {
+    if (workers <= 1) {
+        work(0, 0, blockCount);
+        return;
+    }
+    std::vector<std::thread> pool;
+    for (size_t w = 0; w < workers; ++w) {
+        size_t first = blockCount * w / workers;
+        size_t last = blockCount * (w + 1) / workers;
+        pool.emplace_back([&work, w, first, last]() { work(w, first, last); });
+    }
+    for (auto& thread : pool) thread.join();
+}
+
+} // namespace
+
+namespace BlockCompression {
+
+size_t maxPayloadSize(size_t size) {
+    return size + size / 255 + 16;
+}
+
+// Greedy parsing with a single-entry hash table of 4-byte sequences, as in LZ4's fast
+// mode: on incompressible stretches the search step grows, so such data costs little
+size_t compressPayload(const uint8_t* data, size_t size, uint8_t* out) {
+    uint8_t* start = out;
+    size_t anchor = 0;
+    if (size > MATCH_FIND_LIMIT) {
+        uint16_t table[1 << HASH_BITS];  // Positions in the block, which is at most 64 KB
+        std::memset(table, 0, sizeof(table));
+        const size_t matchLimit = size - LAST_LITERALS;
+        const size_t findLimit = size - MATCH_FIND_LIMIT;
+
+        size_t position = 1;
+        while (true) {
+            size_t candidate;
+            size_t next = position;
+            unsigned attempts = 1u << SKIP_STRENGTH;
+            do {
+                position = next;
+                next = position + (attempts++ >> SKIP_STRENGTH);
+                if (next > findLimit) goto lastLiterals;
+                uint32_t sequence = read32(data + position);
+                uint16_t& slot = table[hashOf(sequence)];
+                candidate = slot;
+                slot = static_cast<uint16_t>(position);
+            } while (candidate >= position || read32(data + candidate) != read32(data + position));
+
+            while (position > anchor && candidate > 0 && data[position - 1] == data[candidate - 1]) {
+                --position;
+                --candidate;
+            }
+            size_t length = MIN_MATCH + commonLength(data + position + MIN_MATCH, data + candidate + MIN_MATCH,
+                                                     data + matchLimit);
+            out = writeSequence(out, data + anchor, position - anchor, position - candidate, length);
+            position += length;
+            anchor = position;
+            if (position > findLimit) break;
+            table[hashOf(read32(data + position - 2))] = static_cast<uint16_t>(position - 2);
+        }
+    }
+lastLiterals:
+    out = writeSequence(out, data + anchor, size - anchor, 0, 0);
+    return out - start;
+}
+
+bool decompressPayload(const uint8_t* payload, size_t size, uint8_t* out, size_t rawSize) {
+    const uint8_t* in = payload;
+    const uint8_t* end = payload + size;
+    size_t written = 0;
+    while (in < end) {
+        uint8_t token = *in++;
+        size_t literalLength = token >> 4;
+        if (literalLength < 15 && end - in >= 16 && rawSize - written >= 16) {
+            // Short run with room on both sides: one fixed 16-byte copy, the excess is
+            // overwritten by what follows
+            std::memcpy(out + written, in, 16);
+        } else {
+            if (literalLength == 15 && !readLength(in, end, literalLength)) return false;
+            if (literalLength > static_cast<size_t>(end - in) || literalLength > rawSize - written) return false;
+            std::memcpy(out + written, in, literalLength);
+        }
+        in += literalLength;
+        written += literalLength;
+        if (in == end) break;  // The last sequence has no match
+
+        if (end - in < 2) return false;
+        size_t offset = in[0] | static_cast<size_t>(in[1]) << 8;
+        in += 2;
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(in, end, matchLength)) return false;
+        matchLength += MIN_MATCH;
+        if (offset == 0 || offset > written || matchLength > rawSize - written) return false;
+
+        // Overlapping copies repeat the last offset bytes, so chunks are only as wide as
+        // the offset. Chunks may run past the match but never past this block: other
+        // threads may be filling the next one.
+        uint8_t* target = out + written;
+        const uint8_t* source = target - offset;
+        size_t room = rawSize - written;
+        size_t i = 0;
+        if (offset >= 16 && (matchLength + 15) / 16 * 16 <= room) {
+            for (; i < matchLength; i += 16) std::memcpy(target + i, source + i, 16);
+        } else if (offset >= 8) {
+            for (; i + 8 <= matchLength; i += 8) std::memcpy(target + i, source + i, 8);
+            for (; i < matchLength; ++i) target[i] = source[i];
+        } else {
+            for (; i < matchLength; ++i) target[i] = source[i];
+        }
+        written += matchLength;
+    }
+    return written == rawSize;
+}
+
+void compressBlock(const char* data, size_t size, std::string& out) {
+    size_t start = out.size();
+    out.resize(start + HEADER_SIZE + maxPayloadSize(size));
+    uint8_t* header = reinterpret_cast<uint8_t*>(&out[start]);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    size_t stored = compressPayload(bytes, size, header + HEADER_SIZE);
+    uint32_t storedField = static_cast<uint32_t>(stored);
+    if (stored >= size) {
+        std::memcpy(header + HEADER_SIZE, bytes, size);
+        stored = size;
+        storedField = static_cast<uint32_t>(size) | STORED_FLAG;
+    }
+    store32(header, static_cast<uint32_t>(size));
+    store32(header + 4, storedField);
+    out.resize(start + HEADER_SIZE + stored);
+}
+
+std::string compress(const std::string& data) {
+    size_t blockCount = (data.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    size_t workers = workersFor(blockCount, data.size());
+
+    // Each worker fills one buffer, reserved so that no block makes it reallocate
+    std::vector<std::string> parts(workers);
+    forEachBlockRange(blockCount, workers, [&](size_t worker, size_t first, size_t last) {
+        size_t begin = first * BLOCK_SIZE;
+        size_t bytes = std::min(last * BLOCK_SIZE, data.size()) - begin;
+        std::string& out = parts[worker];
+        out.reserve(bytes + bytes / 255 + (last - first) * (HEADER_SIZE + 16));
+        for (size_t offset = begin; offset < begin + bytes; offset += BLOCK_SIZE) {
+            compressBlock(data.data() + offset, std::min(BLOCK_SIZE, data.size() - offset), out);
+        }
+    });
+    if (workers == 1) return std::move(parts[0]);
+
+    size_t total = 0;
+    for (const std::string& part : parts) total += part.size();
+    std::string result;
+    result.reserve(total);
+    for (const std::string& part : parts) result += part;
+    return result;
+}
+
+bool decompress(const std::string& data, std::string& out) {
+    out.clear();
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.data());
+
+    // Headers first, so every block knows where its output goes
+    std::vector<Frame> frames;
+    size_t outputSize = 0;
+    for (size_t offset = 0; offset < data.size();) {
+        Frame frame;
+        if (!readHeader(bytes, data.size(), offset, frame) || !payloadPresent(data.size(), frame)) return false;
+        frame.output = outputSize;
+        outputSize += frame.rawSize;
+        offset = frame.input + frame.storedSize;
+        frames.push_back(frame);
+    }
+
+    out.resize(outputSize);
+    uint8_t* target = reinterpret_cast<uint8_t*>(&out[0]);
+    std::atomic<bool> ok{true};
+    forEachBlockRange(frames.size(), workersFor(frames.size(), outputSize), [&](size_t, size_t first, size_t last) {
+        for (size_t i = first; i < last && ok; ++i) {
+            if (!expandFrame(bytes, frames[i], target + frames[i].output)) ok = false;
+        }
+    });
+    if (!ok) out.clear();
+    return ok;
+}
+
+bool Decoder::update(const char* data, size_t size, std::string& out) {
+    pending.append(data, size);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(pending.data());
+    size_t offset = 0;
+    while (pending.size() - offset >= HEADER_SIZE) {
+        Frame frame;
+        if (!readHeader(bytes, pending.size(), offset, frame)) return false;
+        if (!payloadPresent(pending.size(), frame)) break;  // Rest of the block is still to come
+        size_t start = out.size();
+        out.resize(start + frame.rawSize);
+        if (!expandFrame(bytes, frame, reinterpret_cast<uint8_t*>(&out[start]))) return false;
+        offset = frame.input + frame.storedSize;
+    }
+    pending.erase(0, offset);
+    return true;
+}
+
+bool Decoder::finish() {
+    bool ok = pending.empty();
+    pending.clear();
+    return ok;
+}
+
+} // namespace BlockCompression
@@ -1,38 +1,55 @@
 #include "CaesarCipher.h"
+#include "CipherKernels.h"
 #include <iostream>
 #include <string>
-#include <cctype>
+
+CaesarCipher::CaesarCipher(Alphabet alphabet) : alphabet(alphabet) {
+}
 
 std::string CaesarCipher::processText(const std::string& text, bool isEncryption) {
     std::string result = text;
-    int actualShift = isEncryption ? shift : -shift;
+    int size = Alphabets::size(alphabet);
+    int shift = (schedule->shift % size + size) % size;
+    int actualShift = isEncryption ? shift : (size - shift) % size;
     
-    for (char& c : result) {
-        if (std::isalpha(c)) {
-            char base = std::isupper(c) ? 'A' : 'a';
-            c = static_cast<char>(base + (c - base + actualShift + 26) % 26);
-        }
-    }
+    CipherKernels::shiftAlphabet(alphabet, &result[0], result.size(), actualShift);
     
     return result;
 }
 
-void CaesarCipher::setKey(const std::string& key) {
+std::shared_ptr<const KeySchedule> CaesarCipher::compileKey(const std::string& key) const {
+    int shift;
     try {
-        shift = std::stoi(key) % 26;
-        if (shift < 0) shift += 26;  // Ensure positive shift
+        shift = std::stoi(key);
     } catch (const std::exception& e) {
         std::cerr << "Invalid key. Using default shift (3)." << std::endl;
         shift = 3;
     }
+    return makeSecureShared<Schedule>(shift);
+}
+
+void CaesarCipher::applySchedule(const std::shared_ptr<const KeySchedule>& newSchedule) {
+    if (newSchedule) schedule = std::static_pointer_cast<const Schedule>(newSchedule);
 }
 
 #include <iostream>
 
+bool CaesarCipher::preservesLength() const {
+    return true;
+}
+
+const char* CaesarCipher::getName() const {
+    static const char* const NAMES[ALPHABET_COUNT] = {"caesar", "caesar-alnum", "caesar-printable", "caesar-bytes"};
+    return NAMES[static_cast<int>(alphabet)];
+}
+
 std::string CaesarCipher::getDescription() const {
-    return "\033[1;34mCaesar Cipher:\033[0m A simple substitution cipher where each letter is shifted by a fixed number of positions in the alphabet.";
+    std::string description = "\033[1;34mCaesar Cipher:\033[0m A simple substitution cipher where each letter is shifted by a fixed number of positions in the alphabet.";
+    if (alphabet != Alphabet::LETTERS) description += std::string(" (alphabet: ") + Alphabets::name(alphabet) + ")";
+    return description;
 }
 
 std::string CaesarCipher::getKeyInstructions() const {
-    return "\033[1;32mEnter a number between 1 and 25\033[0m to specify the shift value.";
+    return "\033[1;32mEnter a number between 1 and " + std::to_string(Alphabets::size(alphabet) - 1) +
+           "\033[0m to specify the shift value.";
 }
\ No newline at end of file
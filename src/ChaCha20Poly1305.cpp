@@ -0,0 +1,710 @@
+#include "ChaCha20Poly1305.h"
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define CHACHA_HAVE_X86_KERNELS 1
+#endif
+
+namespace ChaCha20Poly1305 {
+
+namespace {
+
+std::atomic<int> forcedImplementation(AUTO);
+const size_t POLY_AVX2_MIN_BYTES = 256;  // Below this, computing r^2..r^4 costs more than it saves
+
+uint32_t load32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+           static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+uint64_t load64(const uint8_t* p) {
+    return static_cast<uint64_t>(load32(p)) | static_cast<uint64_t>(load32(p + 4)) << 32;
+}
+
+void store32(uint8_t* p, uint32_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+    p[2] = static_cast<uint8_t>(v >> 16);
+    p[3] = static_cast<uint8_t>(v >> 24);
+}
+
+void store64(uint8_t* p, uint64_t v) {
+    store32(p, static_cast<uint32_t>(v));
+    store32(p + 4, static_cast<uint32_t>(v >> 32));
+}
+
+uint32_t rotl(uint32_t v, int n) {
+    return (v << n) | (v >> (32 - n));
+}
+
+#define QUARTER_ROUND(a, b, c, d)           \
+    a += b; d ^= a; d = rotl(d, 16);        \
+    c += d; b ^= c; b = rotl(b, 12);        \
+    a += b; d ^= a; d = rotl(d, 8);         \
+    c += d; b ^= c; b = rotl(b, 7)
+
+void initialState(uint32_t state[16], const uint8_t key[KEY_SIZE], const uint8_t nonce[NONCE_SIZE], uint32_t counter) {
+    state[0] = 0x61707865;
+    state[1] = 0x3320646e;
+    state[2] = 0x79622d32;
+    state[3] = 0x6b206574;
+    for (int i = 0; i < 8; ++i) state[4 + i] = load32(key + 4 * i);
+    state[12] = counter;
+    for (int i = 0; i < 3; ++i) state[13 + i] = load32(nonce + 4 * i);
+}
+
+void block(const uint32_t state[16], uint8_t out[64]) {
+    uint32_t x[16];
+    std::memcpy(x, state, sizeof(x));
+    for (int round = 0; round < 10; ++round) {
+        QUARTER_ROUND(x[0], x[4], x[8], x[12]);
+        QUARTER_ROUND(x[1], x[5], x[9], x[13]);
+        QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+        QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+        QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+        QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+        QUARTER_ROUND(x[2], x[7], x[8], x[13]);
+        QUARTER_ROUND(x[3], x[4], x[9], x[14]);
+    }
+    for (int i = 0; i < 16; ++i) store32(out + 4 * i, x[i] + state[i]);
+}
+
+void xorPortable(uint32_t state[16], const uint8_t* in, uint8_t* out, size_t size) {
+    uint8_t keystream[64];
+    while (size > 0) {
+        block(state, keystream);
+        ++state[12];
+        size_t n = size < 64 ? size : 64;
+        for (size_t i = 0; i < n; ++i) out[i] = in[i] ^ keystream[i];
+        in += n;
+        out += n;
+        size -= n;
+    }
+}
+
+#ifdef CHACHA_HAVE_X86_KERNELS
+
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+AVX2_TARGET inline __m256i rotl16(__m256i v) {
+    const __m256i mask = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                          2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    return _mm256_shuffle_epi8(v, mask);
+}
+
+AVX2_TARGET inline __m256i rotl8(__m256i v) {
+    const __m256i mask = _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14,
+                                          3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14);
+    return _mm256_shuffle_epi8(v, mask);
+}
+
+#define AVX2_QUARTER_ROUND(a, b, c, d)                                                              \
+    a = _mm256_add_epi32(a, b); d = rotl16(_mm256_xor_si256(d, a));                                 \
+    c = _mm256_add_epi32(c, d); b = _mm256_xor_si256(b, c);                                         \
+    b = _mm256_or_si256(_mm256_slli_epi32(b, 12), _mm256_srli_epi32(b, 20));                        \
+    a = _mm256_add_epi32(a, b); d = rotl8(_mm256_xor_si256(d, a));                                  \
+    c = _mm256_add_epi32(c, d); b = _mm256_xor_si256(b, c);                                         \
+    b = _mm256_or_si256(_mm256_slli_epi32(b, 7), _mm256_srli_epi32(b, 25))
+
+// Eight blocks per iteration: vector i holds state word i of all eight blocks
+AVX2_TARGET void xorAvx2(uint32_t state[16], const uint8_t* in, uint8_t* out, size_t size) {
+    const __m256i laneOffsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    while (size >= 512) {
+        __m256i original[16], x[16];
+        for (int i = 0; i < 16; ++i) original[i] = _mm256_set1_epi32(static_cast<int>(state[i]));
+        original[12] = _mm256_add_epi32(original[12], laneOffsets);
+        for (int i = 0; i < 16; ++i) x[i] = original[i];
+
+        for (int round = 0; round < 10; ++round) {
+            AVX2_QUARTER_ROUND(x[0], x[4], x[8], x[12]);
+            AVX2_QUARTER_ROUND(x[1], x[5], x[9], x[13]);
+            AVX2_QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+            AVX2_QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+            AVX2_QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+            AVX2_QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+            AVX2_QUARTER_ROUND(x[2], x[7], x[8], x[13]);
+            AVX2_QUARTER_ROUND(x[3], x[4], x[9], x[14]);
+        }
+        for (int i = 0; i < 16; ++i) x[i] = _mm256_add_epi32(x[i], original[i]);
+
+        // Transpose each group of four words so 128-bit halves hold one block's words;
+        // low halves belong to blocks 0-3, high halves to blocks 4-7
+        __m256i rows[4][4];
+        for (int group = 0; group < 4; ++group) {
+            __m256i* w = &x[group * 4];
+            __m256i t0 = _mm256_unpacklo_epi32(w[0], w[1]);
+            __m256i t1 = _mm256_unpackhi_epi32(w[0], w[1]);
+            __m256i t2 = _mm256_unpacklo_epi32(w[2], w[3]);
+            __m256i t3 = _mm256_unpackhi_epi32(w[2], w[3]);
+            rows[group][0] = _mm256_unpacklo_epi64(t0, t2);
+            rows[group][1] = _mm256_unpackhi_epi64(t0, t2);
+            rows[group][2] = _mm256_unpacklo_epi64(t1, t3);
+            rows[group][3] = _mm256_unpackhi_epi64(t1, t3);
+        }
+
+        for (int k = 0; k < 4; ++k) {
+            __m256i blockLow[2] = {
+                _mm256_permute2x128_si256(rows[0][k], rows[1][k], 0x20),
+                _mm256_permute2x128_si256(rows[2][k], rows[3][k], 0x20)
+            };
+            __m256i blockHigh[2] = {
+                _mm256_permute2x128_si256(rows[0][k], rows[1][k], 0x31),
+                _mm256_permute2x128_si256(rows[2][k], rows[3][k], 0x31)
+            };
+            for (int half = 0; half < 2; ++half) {
+                size_t low = k * 64 + half * 32;
+                size_t high = (k + 4) * 64 + half * 32;
+                __m256i inLow = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + low));
+                __m256i inHigh = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + high));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + low), _mm256_xor_si256(inLow, blockLow[half]));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + high), _mm256_xor_si256(inHigh, blockHigh[half]));
+            }
+        }
+
+        state[12] += 8;
+        in += 512;
+        out += 512;
+        size -= 512;
+    }
+    xorPortable(state, in, out, size);
+}
+
+// Poly1305 over four interleaved streams of blocks in radix 2^26: lane j accumulates
+// blocks j, j+4, ... multiplied by r^4, and the lanes are folded back together with
+// r^4, r^3, r^2 and r at the end. The accumulator enters and leaves in Poly1305's
+// radix 2^44 form.
+const uint64_t MASK26 = 0x3ffffff, MASK44 = 0xfffffffffffULL, MASK42 = 0x3ffffffffffULL;
+
+void multiplyMod(const uint64_t a[3], const uint64_t b[3], uint64_t out[3]) {
+    typedef unsigned __int128 uint128;
+    uint64_t s1 = b[1] * 20, s2 = b[2] * 20;
+    uint128 d0 = (uint128)a[0] * b[0] + (uint128)a[1] * s2 + (uint128)a[2] * s1;
+    uint128 d1 = (uint128)a[0] * b[1] + (uint128)a[1] * b[0] + (uint128)a[2] * s2;
+    uint128 d2 = (uint128)a[0] * b[2] + (uint128)a[1] * b[1] + (uint128)a[2] * b[0];
+
+    uint64_t c = static_cast<uint64_t>(d0 >> 44); out[0] = static_cast<uint64_t>(d0) & MASK44;
+    d1 += c; c = static_cast<uint64_t>(d1 >> 44); out[1] = static_cast<uint64_t>(d1) & MASK44;
+    d2 += c; c = static_cast<uint64_t>(d2 >> 42); out[2] = static_cast<uint64_t>(d2) & MASK42;
+    out[0] += c * 5; c = out[0] >> 44; out[0] &= MASK44;
+    out[1] += c; c = out[1] >> 44; out[1] &= MASK44;
+    out[2] += c;
+}
+
+// Expects limbs 0 and 1 below 2^44
+void toRadix26(const uint64_t h[3], uint64_t limbs[5]) {
+    limbs[0] = h[0] & MASK26;
+    limbs[1] = ((h[0] >> 26) | (h[1] << 18)) & MASK26;
+    limbs[2] = (h[1] >> 8) & MASK26;
+    limbs[3] = ((h[1] >> 34) | (h[2] << 10)) & MASK26;
+    limbs[4] = h[2] >> 16;
+}
+
+AVX2_TARGET inline void loadMessage(const uint8_t* p, __m256i m[5]) {
+    const __m256i mask = _mm256_set1_epi64x(MASK26);
+    __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+    __m256i low = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(first, second), 0xD8);
+    __m256i high = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(first, second), 0xD8);
+
+    m[0] = _mm256_and_si256(low, mask);
+    m[1] = _mm256_and_si256(_mm256_srli_epi64(low, 26), mask);
+    m[2] = _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(low, 52), _mm256_slli_epi64(high, 12)), mask);
+    m[3] = _mm256_and_si256(_mm256_srli_epi64(high, 14), mask);
+    m[4] = _mm256_or_si256(_mm256_srli_epi64(high, 40), _mm256_set1_epi64x(1 << 24));
+}
+
+// d = a * r per lane, where s holds 5 * r for the wrapped-around terms
+AVX2_TARGET inline void multiplyLanes(const __m256i a[5], const __m256i r[5], const __m256i s[5], __m256i d[5]) {
+#define MUL(x, y) _mm256_mul_epu32(x, y)
+    d[0] = _mm256_add_epi64(_mm256_add_epi64(MUL(a[0], r[0]), MUL(a[1], s[4])),
+                            _mm256_add_epi64(_mm256_add_epi64(MUL(a[2], s[3]), MUL(a[3], s[2])), MUL(a[4], s[1])));
+    d[1] = _mm256_add_epi64(_mm256_add_epi64(MUL(a[0], r[1]), MUL(a[1], r[0])),
+                            _mm256_add_epi64(_mm256_add_epi64(MUL(a[2], s[4]), MUL(a[3], s[3])), MUL(a[4], s[2])));
+    d[2] = _mm256_add_epi64(_mm256_add_epi64(MUL(a[0], r[2]), MUL(a[1], r[1])),
+                            _mm256_add_epi64(_mm256_add_epi64(MUL(a[2], r[0]), MUL(a[3], s[4])), MUL(a[4], s[3])));
+    d[3] = _mm256_add_epi64(_mm256_add_epi64(MUL(a[0], r[3]), MUL(a[1], r[2])),
+                            _mm256_add_epi64(_mm256_add_epi64(MUL(a[2], r[1]), MUL(a[3], r[0])), MUL(a[4], s[4])));
+    d[4] = _mm256_add_epi64(_mm256_add_epi64(MUL(a[0], r[4]), MUL(a[1], r[3])),
+                            _mm256_add_epi64(_mm256_add_epi64(MUL(a[2], r[2]), MUL(a[3], r[1])), MUL(a[4], r[0])));
+#undef MUL
+}
+
+// blockCount must be a positive multiple of four
+AVX2_TARGET void polyBlocksAvx2(uint64_t h[3], const uint64_t r[3], const uint8_t* data, size_t blockCount) {
+    uint64_t powers[4][3];  // r^4, r^3, r^2, r
+    std::memcpy(powers[3], r, sizeof(powers[3]));
+    multiplyMod(r, r, powers[2]);
+    multiplyMod(powers[2], r, powers[1]);
+    multiplyMod(powers[2], powers[2], powers[0]);
+    uint64_t limbs[4][5];
+    for (int i = 0; i < 4; ++i) toRadix26(powers[i], limbs[i]);
+
+    uint64_t start[3] = {h[0], h[1], h[2]};
+    start[2] += start[1] >> 44;
+    start[1] &= MASK44;
+    uint64_t startLimbs[5];
+    toRadix26(start, startLimbs);
+
+    const __m256i mask = _mm256_set1_epi64x(MASK26);
+    const __m256i five = _mm256_set1_epi64x(5);
+    __m256i r4[5], s4[5], a[5], m[5], d[5];
+    for (int k = 0; k < 5; ++k) {
+        r4[k] = _mm256_set1_epi64x(static_cast<long long>(limbs[0][k]));
+        s4[k] = _mm256_mul_epu32(r4[k], five);
+    }
+
+    loadMessage(data, a);
+    for (int k = 0; k < 5; ++k) {
+        a[k] = _mm256_add_epi64(a[k], _mm256_set_epi64x(0, 0, 0, static_cast<long long>(startLimbs[k])));
+    }
+
+    for (size_t block = 4; block < blockCount; block += 4) {
+        multiplyLanes(a, r4, s4, d);
+
+        __m256i c = _mm256_srli_epi64(d[0], 26); d[0] = _mm256_and_si256(d[0], mask); d[1] = _mm256_add_epi64(d[1], c);
+        c = _mm256_srli_epi64(d[1], 26); d[1] = _mm256_and_si256(d[1], mask); d[2] = _mm256_add_epi64(d[2], c);
+        c = _mm256_srli_epi64(d[2], 26); d[2] = _mm256_and_si256(d[2], mask); d[3] = _mm256_add_epi64(d[3], c);
+        c = _mm256_srli_epi64(d[3], 26); d[3] = _mm256_and_si256(d[3], mask); d[4] = _mm256_add_epi64(d[4], c);
+        c = _mm256_srli_epi64(d[4], 26); d[4] = _mm256_and_si256(d[4], mask);
+        d[0] = _mm256_add_epi64(d[0], _mm256_add_epi64(c, _mm256_slli_epi64(c, 2)));
+        c = _mm256_srli_epi64(d[0], 26); d[0] = _mm256_and_si256(d[0], mask); d[1] = _mm256_add_epi64(d[1], c);
+
+        loadMessage(data + block * 16, m);
+        for (int k = 0; k < 5; ++k) a[k] = _mm256_add_epi64(d[k], m[k]);
+    }
+
+    __m256i rFinal[5], sFinal[5];
+    for (int k = 0; k < 5; ++k) {
+        rFinal[k] = _mm256_set_epi64x(static_cast<long long>(limbs[3][k]), static_cast<long long>(limbs[2][k]),
+                                      static_cast<long long>(limbs[1][k]), static_cast<long long>(limbs[0][k]));
+        sFinal[k] = _mm256_mul_epu32(rFinal[k], five);
+    }
+    multiplyLanes(a, rFinal, sFinal, d);
+
+    uint64_t sum[5];
+    for (int k = 0; k < 5; ++k) {
+        alignas(32) uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), d[k]);
+        sum[k] = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+    uint64_t c;
+    c = sum[0] >> 26; sum[0] &= MASK26; sum[1] += c;
+    c = sum[1] >> 26; sum[1] &= MASK26; sum[2] += c;
+    c = sum[2] >> 26; sum[2] &= MASK26; sum[3] += c;
+    c = sum[3] >> 26; sum[3] &= MASK26; sum[4] += c;
+    c = sum[4] >> 26; sum[4] &= MASK26; sum[0] += c * 5;
+    c = sum[0] >> 26; sum[0] &= MASK26; sum[1] += c;
+
+    h[0] = sum[0] + ((sum[1] & 0x3ffff) << 26);
+    h[1] = (sum[1] >> 18) + (sum[2] << 8) + ((sum[3] & 0x3ff) << 34);
+    h[2] = (sum[3] >> 10) + (sum[4] << 16) + (h[1] >> 44);
+    h[1] &= MASK44;
+}
+
+#define AVX512_TARGET __attribute__((target("avx512f")))
+
+#define AVX512_QUARTER_ROUND(a, b, c, d)                                                 \
+    a = _mm512_add_epi32(a, b); d = _mm512_rol_epi32(_mm512_xor_si512(d, a), 16);       \
+    c = _mm512_add_epi32(c, d); b = _mm512_rol_epi32(_mm512_xor_si512(b, c), 12);       \
+    a = _mm512_add_epi32(a, b); d = _mm512_rol_epi32(_mm512_xor_si512(d, a), 8);        \
+    c = _mm512_add_epi32(c, d); b = _mm512_rol_epi32(_mm512_xor_si512(b, c), 7)
+
+// GCC 12 reports the deliberately undefined source operand that avx512fintrin.h passes
+// to the unmasked intrinsics below (_mm512_undefined_epi32) as maybe-uninitialized
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+// Sixteen blocks per iteration, same layout as the AVX2 kernel; the remainder goes to it
+AVX512_TARGET void xorAvx512(uint32_t state[16], const uint8_t* in, uint8_t* out, size_t size) {
+    const __m512i laneOffsets = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    while (size >= 1024) {
+        __m512i original[16], x[16];
+        for (int i = 0; i < 16; ++i) original[i] = _mm512_set1_epi32(static_cast<int>(state[i]));
+        original[12] = _mm512_add_epi32(original[12], laneOffsets);
+        for (int i = 0; i < 16; ++i) x[i] = original[i];
+
+        for (int round = 0; round < 10; ++round) {
+            AVX512_QUARTER_ROUND(x[0], x[4], x[8], x[12]);
+            AVX512_QUARTER_ROUND(x[1], x[5], x[9], x[13]);
+            AVX512_QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+            AVX512_QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+            AVX512_QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+            AVX512_QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+            AVX512_QUARTER_ROUND(x[2], x[7], x[8], x[13]);
+            AVX512_QUARTER_ROUND(x[3], x[4], x[9], x[14]);
+        }
+        for (int i = 0; i < 16; ++i) x[i] = _mm512_add_epi32(x[i], original[i]);
+
+        // After the in-lane 4x4 transpose, 128-bit lane L of rows[group][k] holds words
+        // 4*group..4*group+3 of block k + 4L; a 4x4 transpose of lanes then gathers blocks
+        __m512i rows[4][4];
+        for (int group = 0; group < 4; ++group) {
+            __m512i* w = &x[group * 4];
+            __m512i t0 = _mm512_unpacklo_epi32(w[0], w[1]);
+            __m512i t1 = _mm512_unpackhi_epi32(w[0], w[1]);
+            __m512i t2 = _mm512_unpacklo_epi32(w[2], w[3]);
+            __m512i t3 = _mm512_unpackhi_epi32(w[2], w[3]);
+            rows[group][0] = _mm512_unpacklo_epi64(t0, t2);
+            rows[group][1] = _mm512_unpackhi_epi64(t0, t2);
+            rows[group][2] = _mm512_unpacklo_epi64(t1, t3);
+            rows[group][3] = _mm512_unpackhi_epi64(t1, t3);
+        }
+
+        for (int k = 0; k < 4; ++k) {
+            __m512i t0 = _mm512_shuffle_i32x4(rows[0][k], rows[1][k], 0x44);
+            __m512i t1 = _mm512_shuffle_i32x4(rows[0][k], rows[1][k], 0xEE);
+            __m512i t2 = _mm512_shuffle_i32x4(rows[2][k], rows[3][k], 0x44);
+            __m512i t3 = _mm512_shuffle_i32x4(rows[2][k], rows[3][k], 0xEE);
+            __m512i blocks[4] = {
+                _mm512_shuffle_i32x4(t0, t2, 0x88),
+                _mm512_shuffle_i32x4(t0, t2, 0xDD),
+                _mm512_shuffle_i32x4(t1, t3, 0x88),
+                _mm512_shuffle_i32x4(t1, t3, 0xDD)
+            };
+            for (int lane = 0; lane < 4; ++lane) {
+                size_t offset = (k + 4 * lane) * 64;
+                __m512i data = _mm512_loadu_si512(in + offset);
+                _mm512_storeu_si512(out + offset, _mm512_xor_si512(data, blocks[lane]));
+            }
+        }
+
+        state[12] += 16;
+        in += 1024;
+        out += 1024;
+        size -= 1024;
+    }
+    xorAvx2(state, in, out, size);
+}
+
+#pragma GCC diagnostic pop
+
+bool cpuHasAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+bool cpuHasAvx512() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f");
+}
+
+#endif
+
+// The implementation that runs when `requested` is asked for on this CPU
+Implementation resolve(int requested) {
+#ifdef CHACHA_HAVE_X86_KERNELS
+    static const bool hasAvx2 = cpuHasAvx2();
+    static const bool hasAvx512 = cpuHasAvx512();
+    if (hasAvx512 && (requested == AUTO || requested == AVX512)) return AVX512;
+    if (hasAvx2 && requested != PORTABLE) return AVX2;
+#endif
+    (void)requested;
+    return PORTABLE;
+}
+
+Implementation activeImplementation() {
+    return resolve(forcedImplementation.load(std::memory_order_relaxed));
+}
+
+void xorKeystream(Implementation implementation, const uint8_t key[KEY_SIZE], const uint8_t nonce[NONCE_SIZE],
+                  uint32_t counter, const uint8_t* in, uint8_t* out, size_t size) {
+    uint32_t state[16];
+    initialState(state, key, nonce, counter);
+#ifdef CHACHA_HAVE_X86_KERNELS
+    switch (implementation) {
+        case AVX512: xorAvx512(state, in, out, size); return;
+        case AVX2: xorAvx2(state, in, out, size); return;
+        default: break;
+    }
+#endif
+    (void)implementation;
+    xorPortable(state, in, out, size);
+}
+
+std::vector<uint8_t> fromHex(const std::string& hex) {
+    std::vector<uint8_t> bytes;
+    for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+        bytes.push_back(static_cast<uint8_t>(std::stoul(hex.substr(i, 2), nullptr, 16)));
+    }
+    return bytes;
+}
+
+} // namespace
+
+void setImplementation(Implementation implementation) {
+    forcedImplementation.store(implementation, std::memory_order_relaxed);
+}
+
+const char* implementationName() {
+    switch (activeImplementation()) {
+        case AVX512: return "avx512";
+        case AVX2: return "avx2";
+        default: return "portable";
+    }
+}
+
+void chacha20Xor(const uint8_t key[KEY_SIZE], const uint8_t nonce[NONCE_SIZE], uint32_t counter,
+                 const uint8_t* in, uint8_t* out, size_t size) {
+    xorKeystream(activeImplementation(), key, nonce, counter, in, out, size);
+}
+
+Poly1305::Poly1305(const uint8_t key[32]) : Poly1305(key, static_cast<Implementation>(forcedImplementation.load())) {}
+
+Poly1305::Poly1305(const uint8_t key[32], Implementation requested) : implementation(resolve(requested)), leftover(0) {
+    uint64_t t0 = load64(key);
+    uint64_t t1 = load64(key + 8);
+
+    // Clamped r in 44/44/42-bit limbs
+    r[0] = t0 & 0xffc0fffffffULL;
+    r[1] = ((t0 >> 44) | (t1 << 20)) & 0xfffffc0ffffULL;
+    r[2] = (t1 >> 24) & 0x00ffffffc0fULL;
+    h[0] = h[1] = h[2] = 0;
+    pad[0] = load64(key + 16);
+    pad[1] = load64(key + 24);
+}
+
+void Poly1305::blocks(const uint8_t* data, size_t size, uint64_t highBit) {
+    typedef unsigned __int128 uint128;
+    const uint64_t mask44 = 0xfffffffffffULL, mask42 = 0x3ffffffffffULL;
+#ifdef CHACHA_HAVE_X86_KERNELS
+    if (highBit && size >= POLY_AVX2_MIN_BYTES && implementation != PORTABLE) {
+        size_t vectorBytes = size & ~static_cast<size_t>(63);
+        polyBlocksAvx2(h, r, data, vectorBytes / 16);
+        data += vectorBytes;
+        size -= vectorBytes;
+    }
+#endif
+    // Locals matter: byte loads from `data` may alias the members, forcing reloads
+    const uint64_t r0 = r[0], r1 = r[1], r2 = r[2];
+    const uint64_t s1 = r1 * (5 << 2), s2 = r2 * (5 << 2);
+    uint64_t h0 = h[0], h1 = h[1], h2 = h[2];
+
+    while (size >= 16) {
+        uint64_t t0 = load64(data);
+        uint64_t t1 = load64(data + 8);
+        h0 += t0 & mask44;
+        h1 += ((t0 >> 44) | (t1 << 20)) & mask44;
+        h2 += ((t1 >> 24) & mask42) | highBit;
+
+        uint128 d0 = (uint128)h0 * r0 + (uint128)h1 * s2 + (uint128)h2 * s1;
+        uint128 d1 = (uint128)h0 * r1 + (uint128)h1 * r0 + (uint128)h2 * s2;
+        uint128 d2 = (uint128)h0 * r2 + (uint128)h1 * r1 + (uint128)h2 * r0;
+
+        uint64_t c = static_cast<uint64_t>(d0 >> 44); h0 = static_cast<uint64_t>(d0) & mask44;
+        d1 += c; c = static_cast<uint64_t>(d1 >> 44); h1 = static_cast<uint64_t>(d1) & mask44;
+        d2 += c; c = static_cast<uint64_t>(d2 >> 42); h2 = static_cast<uint64_t>(d2) & mask42;
+        h0 += c * 5; c = h0 >> 44; h0 &= mask44;
+        h1 += c;
+
+        data += 16;
+        size -= 16;
+    }
+    h[0] = h0; h[1] = h1; h[2] = h2;
+}
+
+void Poly1305::update(const uint8_t* data, size_t size) {
+    if (leftover) {
+        size_t want = 16 - leftover;
+        if (want > size) want = size;
+        std::memcpy(buffer + leftover, data, want);
+        leftover += want;
+        data += want;
+        size -= want;
+        if (leftover < 16) return;
+        blocks(buffer, 16, 1ULL << 40);
+        leftover = 0;
+    }
+
+    size_t whole = size & ~static_cast<size_t>(15);
+    blocks(data, whole, 1ULL << 40);
+    data += whole;
+    size -= whole;
+
+    if (size) {
+        std::memcpy(buffer, data, size);
+        leftover = size;
+    }
+}
+
+void Poly1305::padToBlock() {
+    if (leftover) {
+        std::memset(buffer + leftover, 0, 16 - leftover);
+        blocks(buffer, 16, 1ULL << 40);
+        leftover = 0;
+    }
+}
+
+void Poly1305::finish(uint8_t tag[TAG_SIZE]) {
+    const uint64_t mask44 = 0xfffffffffffULL, mask42 = 0x3ffffffffffULL;
+    if (leftover) {
+        buffer[leftover] = 1;
+        std::memset(buffer + leftover + 1, 0, 15 - leftover);
+        blocks(buffer, 16, 0);
+    }
+
+    uint64_t h0 = h[0], h1 = h[1], h2 = h[2], c;
+    c = h1 >> 44; h1 &= mask44; h2 += c;
+    c = h2 >> 42; h2 &= mask42; h0 += c * 5;
+    c = h0 >> 44; h0 &= mask44; h1 += c;
+    c = h1 >> 44; h1 &= mask44; h2 += c;
+    c = h2 >> 42; h2 &= mask42; h0 += c * 5;
+    c = h0 >> 44; h0 &= mask44; h1 += c;
+
+    // Constant-time select of h or h - (2^130 - 5)
+    uint64_t g0 = h0 + 5; c = g0 >> 44; g0 &= mask44;
+    uint64_t g1 = h1 + c; c = g1 >> 44; g1 &= mask44;
+    uint64_t g2 = h2 + c - (1ULL << 42);
+    c = (g2 >> 63) - 1;
+    g0 &= c; g1 &= c; g2 &= c;
+    c = ~c;
+    h0 = (h0 & c) | g0; h1 = (h1 & c) | g1; h2 = (h2 & c) | g2;
+
+    uint64_t t0 = pad[0], t1 = pad[1];
+    h0 += t0 & mask44; c = h0 >> 44; h0 &= mask44;
+    h1 += (((t0 >> 44) | (t1 << 20)) & mask44) + c; c = h1 >> 44; h1 &= mask44;
+    h2 += ((t1 >> 24) & mask42) + c; h2 &= mask42;
+
+    store64(tag, h0 | (h1 << 44));
+    store64(tag + 8, (h1 >> 20) | (h2 << 24));
+}
+
+namespace {
+
+void computeTag(Implementation implementation, const uint8_t key[KEY_SIZE], const uint8_t nonce[NONCE_SIZE],
+                const uint8_t* aad, size_t aadSize, const uint8_t* ciphertext, size_t size, uint8_t tag[TAG_SIZE]) {
+    uint8_t polyKey[64] = {};
+    xorKeystream(implementation, key, nonce, 0, polyKey, polyKey, sizeof(polyKey));
+
+    Poly1305 mac(polyKey, implementation);
+    mac.update(aad, aadSize);
+    mac.padToBlock();
+    mac.update(ciphertext, size);
+    mac.padToBlock();
+    uint8_t lengths[16];
+    store64(lengths, aadSize);
+    store64(lengths + 8, size);
+    mac.update(lengths, sizeof(lengths));
+    mac.finish(tag);
+}
+
+void sealWith(Implementation implementation, const uint8_t key[KEY_SIZE], const uint8_t nonce[NONCE_SIZE],
+              const uint8_t* aad, size_t aadSize, const uint8_t* in, size_t size, uint8_t* out, uint8_t tag[TAG_SIZE]) {
+    xorKeystream(implementation, key, nonce, 1, in, out, size);
+    computeTag(implementation, key, nonce, aad, aadSize, out, size, tag);
+}
+
+bool openWith(Implementation implementation, const uint8_t key[KEY_SIZE], const uint8_t nonce[NONCE_SIZE],
+              const uint8_t* aad, size_t aadSize, const uint8_t* in, size_t size, const uint8_t tag[TAG_SIZE],
+              uint8_t* out) {
+    uint8_t expected[TAG_SIZE];
+    computeTag(implementation, key, nonce, aad, aadSize, in, size, expected);
+
+    uint8_t difference = 0;
+    for (size_t i = 0; i < TAG_SIZE; ++i) difference |= expected[i] ^ tag[i];
+    if (difference != 0) return false;
+
+    xorKeystream(implementation, key, nonce, 1, in, out, size);
+    return true;
+}
+
+} // namespace
+
+void seal(const uint8_t key[KEY_SIZE], const uint8_t nonce[NONCE_SIZE], const uint8_t* aad, size_t aadSize,
+          const uint8_t* in, size_t size, uint8_t* out, uint8_t tag[TAG_SIZE]) {
+    sealWith(activeImplementation(), key, nonce, aad, aadSize, in, size, out, tag);
+}
+
+bool open(const uint8_t key[KEY_SIZE], const uint8_t nonce[NONCE_SIZE], const uint8_t* aad, size_t aadSize,
+          const uint8_t* in, size_t size, const uint8_t tag[TAG_SIZE], uint8_t* out) {
+    return openWith(activeImplementation(), key, nonce, aad, aadSize, in, size, tag, out);
+}
+
+bool selfTest() {
+    // RFC 8439 section 2.8.2
+    const std::vector<uint8_t> key = fromHex("808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f");
+    const std::vector<uint8_t> nonce = fromHex("070000004041424344454647");
+    const std::vector<uint8_t> aad = fromHex("50515253c0c1c2c3c4c5c6c7");
+    const std::string plaintext = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip "
+                                  "for the future, sunscreen would be it.";
+    const std::vector<uint8_t> expectedCiphertext = fromHex(
+        "d31a8d34648e60db7b86afbc53ef7ec2a4aded51296e08fea9e2b5a736ee62d63dbea45e8ca9671282fafb69da92728b"
+        "1a71de0a9e060b2905d6a5b67ecd3b3692ddbd7f2d778b8c9803aee328091b58fab324e4fad675945585808b4831d7bc"
+        "3ff4def08e4b7a9de576d26586cec64b6116");
+    const std::vector<uint8_t> expectedTag = fromHex("1ae10b594f09e26a7e902ecbd0600691");
+
+    // RFC 8439 section 2.5.2
+    const std::vector<uint8_t> polyKey = fromHex("85d6be7857556d337f4452fe42d506a80103808afb0db2fd4abff6af4149f51b");
+    const std::string polyMessage = "Cryptographic Forum Research Group";
+    const std::vector<uint8_t> polyTag = fromHex("a8061dc1305136c6c22b8baf0c0127a9");
+
+    // RFC 8439 section 2.4.2, long enough to run the eight-block kernel too
+    const std::vector<uint8_t> streamKey = fromHex("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+    const std::vector<uint8_t> streamNonce = fromHex("000000000000004a00000000");
+    const std::vector<uint8_t> streamPrefix = fromHex("6e2e359a2568f98041ba0728dd0d6981e97e7aec1d4360c20a27afccfd9fae0b");
+
+    // Each kernel is called directly; the process-wide choice is never touched, so
+    // seal/open may run on other threads meanwhile
+    bool ok = true;
+    for (Implementation implementation : {PORTABLE, AVX2, AVX512}) {
+        if (resolve(implementation) != implementation) continue;  // Not on this CPU
+
+        std::vector<uint8_t> ciphertext(plaintext.size());
+        uint8_t tag[TAG_SIZE];
+        sealWith(implementation, key.data(), nonce.data(), aad.data(), aad.size(),
+                 reinterpret_cast<const uint8_t*>(plaintext.data()), plaintext.size(), ciphertext.data(), tag);
+        ok = ok && ciphertext == expectedCiphertext && std::memcmp(tag, expectedTag.data(), TAG_SIZE) == 0;
+
+        std::vector<uint8_t> decrypted(ciphertext.size());
+        ok = ok && openWith(implementation, key.data(), nonce.data(), aad.data(), aad.size(), ciphertext.data(),
+                            ciphertext.size(), tag, decrypted.data());
+        ok = ok && std::string(decrypted.begin(), decrypted.end()) == plaintext;
+        tag[0] ^= 1;
+        ok = ok && !openWith(implementation, key.data(), nonce.data(), aad.data(), aad.size(), ciphertext.data(),
+                             ciphertext.size(), tag, decrypted.data());
+
+        // The keystream for a long run must match block-by-block portable output
+        std::vector<uint8_t> zeros(4096 + 37, 0), stream(zeros.size()), reference(zeros.size());
+        xorKeystream(implementation, streamKey.data(), streamNonce.data(), 1, zeros.data(), stream.data(), zeros.size());
+        uint32_t state[16];
+        initialState(state, streamKey.data(), streamNonce.data(), 1);
+        xorPortable(state, zeros.data(), reference.data(), zeros.size());
+        ok = ok && stream == reference;
+
+        const std::string sunscreen = plaintext;
+        std::vector<uint8_t> streamCipher(sunscreen.size());
+        xorKeystream(implementation, streamKey.data(), streamNonce.data(), 1,
+                     reinterpret_cast<const uint8_t*>(sunscreen.data()), streamCipher.data(), sunscreen.size());
+        ok = ok && std::memcmp(streamCipher.data(), streamPrefix.data(), streamPrefix.size()) == 0;
+    }
+
+    Poly1305 mac(polyKey.data(), PORTABLE);
+    mac.update(reinterpret_cast<const uint8_t*>(polyMessage.data()), polyMessage.size());
+    uint8_t tag[TAG_SIZE];
+    mac.finish(tag);
+    ok = ok && std::memcmp(tag, polyTag.data(), TAG_SIZE) == 0;
+
+    // The vectorized Poly1305 only runs on longer inputs, so compare it with the scalar
+    // one there, starting from a partly filled accumulator
+    std::vector<uint8_t> message(4096 + 77);
+    for (size_t i = 0; i < message.size(); ++i) message[i] = static_cast<uint8_t>(i * 167 + 13);
+    for (size_t size : {255, 256, 257, 1000, 4096 + 77}) {
+        uint8_t tags[2][TAG_SIZE];
+        for (int pass = 0; pass < 2; ++pass) {
+            Poly1305 check(polyKey.data(), pass == 0 ? PORTABLE : AVX2);
+            check.update(message.data(), 20);
+            check.update(message.data() + 20, size - 20);
+            check.finish(tags[pass]);
+        }
+        ok = ok && std::memcmp(tags[0], tags[1], TAG_SIZE) == 0;
+    }
+
+    return ok;
+}
+
+} // namespace ChaCha20Poly1305
@@ -0,0 +1,318 @@
+#include "Checksum.h"
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(ET_NO_MULTIVERSIONING)
+#include <immintrin.h>
+#define CHECKSUM_HAVE_X86_KERNELS 1
+#define SSE42_TARGET __attribute__((target("sse4.2")))
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+namespace {
+
+const uint32_t CRC32C_POLYNOMIAL = 0x82F63B78;  // Castagnoli, bit-reflected
+
+const uint64_t PRIME32_1 = 0x9E3779B1U;
+const uint64_t PRIME32_2 = 0x85EBCA77U;
+const uint64_t PRIME32_3 = 0xC2B2AE3DU;
+const uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+const uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+const uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+const uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+const uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+const uint64_t PRIME_MX1 = 0x165667919E3779F9ULL;
+const uint64_t PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+const size_t STRIPE_LENGTH = 64;
+const size_t SECRET_SIZE = 192;
+const size_t STRIPES_PER_BLOCK = (SECRET_SIZE - STRIPE_LENGTH) / 8;  // The secret advances 8 bytes per stripe
+const size_t BLOCK_LENGTH = STRIPE_LENGTH * STRIPES_PER_BLOCK;
+
+// XXH3's default secret
+const uint8_t SECRET[SECRET_SIZE] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint64_t read64(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// Slicing-by-8: table[k][b] is the CRC of byte b followed by k zero bytes
+struct CrcTables {
+    uint32_t table[8][256];
+
+    CrcTables() {
+        for (uint32_t b = 0; b < 256; ++b) {
+            uint32_t crc = b;
+            for (int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ (CRC32C_POLYNOMIAL & (0u - (crc & 1)));
+            table[0][b] = crc;
+        }
+        for (int k = 1; k < 8; ++k) {
+            for (int b = 0; b < 256; ++b) table[k][b] = (table[k - 1][b] >> 8) ^ table[0][table[k - 1][b] & 0xFF];
+        }
+    }
+};
+
+const CrcTables& crcTables() {
+    static const CrcTables instance;
+    return instance;
+}
+
+uint64_t multiplyFold(uint64_t a, uint64_t b) {
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+}
+
+uint64_t xxh64Avalanche(uint64_t h) {
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    return h ^ (h >> 32);
+}
+
+uint64_t xxh3Avalanche(uint64_t h) {
+    h ^= h >> 37;
+    h *= PRIME_MX1;
+    return h ^ (h >> 32);
+}
+
+uint64_t mix16(const uint8_t* input, const uint8_t* secret) {
+    return multiplyFold(read64(input) ^ read64(secret), read64(input + 8) ^ read64(secret + 8));
+}
+
+// Inputs up to 240 bytes never reach the stripe loop
+uint64_t hashShort(const uint8_t* input, size_t size) {
+    if (size == 0) return xxh64Avalanche(read64(SECRET + 56) ^ read64(SECRET + 64));
+    if (size <= 3) {
+        uint32_t combined = static_cast<uint32_t>(input[0]) << 16 | static_cast<uint32_t>(input[size >> 1]) << 24 |
+                            input[size - 1] | static_cast<uint32_t>(size) << 8;
+        return xxh64Avalanche(combined ^ static_cast<uint64_t>(read32(SECRET) ^ read32(SECRET + 4)));
+    }
+    if (size <= 8) {
+        uint64_t keyed = (read32(input + size - 4) + (static_cast<uint64_t>(read32(input)) << 32)) ^
+                         (read64(SECRET + 8) ^ read64(SECRET + 16));
+        keyed ^= rotateLeft(keyed, 49) ^ rotateLeft(keyed, 24);
+        keyed *= PRIME_MX2;
+        keyed ^= (keyed >> 35) + size;
+        keyed *= PRIME_MX2;
+        return keyed ^ (keyed >> 28);
+    }
+    if (size <= 16) {
+        uint64_t low = read64(input) ^ (read64(SECRET + 24) ^ read64(SECRET + 32));
+        uint64_t high = read64(input + size - 8) ^ (read64(SECRET + 40) ^ read64(SECRET + 48));
+        return xxh3Avalanche(size + __builtin_bswap64(low) + high + multiplyFold(low, high));
+    }
+    uint64_t acc = size * PRIME64_1;
+    if (size <= 128) {
+        if (size > 32) {
+            if (size > 64) {
+                if (size > 96) {
+                    acc += mix16(input + 48, SECRET + 96);
+                    acc += mix16(input + size - 64, SECRET + 112);
+                }
+                acc += mix16(input + 32, SECRET + 64);
+                acc += mix16(input + size - 48, SECRET + 80);
+            }
+            acc += mix16(input + 16, SECRET + 32);
+            acc += mix16(input + size - 32, SECRET + 48);
+        }
+        acc += mix16(input, SECRET);
+        acc += mix16(input + size - 16, SECRET + 16);
+        return xxh3Avalanche(acc);
+    }
+    for (size_t i = 0; i < 8; ++i) acc += mix16(input + 16 * i, SECRET + 16 * i);
+    acc = xxh3Avalanche(acc);
+    for (size_t i = 8; i < size / 16; ++i) acc += mix16(input + 16 * i, SECRET + 16 * (i - 8) + 3);
+    acc += mix16(input + size - 16, SECRET + 136 - 17);
+    return xxh3Avalanche(acc);
+}
+
+typedef void (*AccumulateKernel)(uint64_t* acc, const uint8_t* input, const uint8_t* secret, size_t stripes);
+typedef void (*ScrambleKernel)(uint64_t* acc, const uint8_t* secret);
+
+void accumulateScalar(uint64_t* acc, const uint8_t* input, const uint8_t* secret, size_t stripes) {
+    for (size_t stripe = 0; stripe < stripes; ++stripe) {
+        const uint8_t* data = input + stripe * STRIPE_LENGTH;
+        const uint8_t* key = secret + stripe * 8;
+        for (int i = 0; i < 8; ++i) {
+            uint64_t value = read64(data + 8 * i);
+            uint64_t keyed = value ^ read64(key + 8 * i);
+            acc[i ^ 1] += value;
+            acc[i] += (keyed & 0xFFFFFFFFULL) * (keyed >> 32);
+        }
+    }
+}
+
+void scrambleScalar(uint64_t* acc, const uint8_t* secret) {
+    for (int i = 0; i < 8; ++i) {
+        uint64_t value = acc[i];
+        value ^= value >> 47;
+        value ^= read64(secret + 8 * i);
+        acc[i] = value * PRIME32_1;
+    }
+}
+
+// 64-byte stripes into eight 64-bit lanes, scrambled after every 1 KB block
+uint64_t hashLong(const uint8_t* input, size_t size, AccumulateKernel accumulate, ScrambleKernel scramble) {
+    uint64_t acc[8] = {PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3, PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1};
+    size_t blocks = (size - 1) / BLOCK_LENGTH;
+    for (size_t block = 0; block < blocks; ++block) {
+        accumulate(acc, input + block * BLOCK_LENGTH, SECRET, STRIPES_PER_BLOCK);
+        scramble(acc, SECRET + SECRET_SIZE - STRIPE_LENGTH);
+    }
+    size_t stripes = ((size - 1) - BLOCK_LENGTH * blocks) / STRIPE_LENGTH;
+    accumulate(acc, input + blocks * BLOCK_LENGTH, SECRET, stripes);
+    accumulate(acc, input + size - STRIPE_LENGTH, SECRET + SECRET_SIZE - STRIPE_LENGTH - 7, 1);
+
+    uint64_t result = size * PRIME64_1;
+    for (int i = 0; i < 4; ++i) {
+        result += multiplyFold(acc[2 * i] ^ read64(SECRET + 11 + 16 * i), acc[2 * i + 1] ^ read64(SECRET + 19 + 16 * i));
+    }
+    return xxh3Avalanche(result);
+}
+
+#ifdef CHECKSUM_HAVE_X86_KERNELS
+
+bool cpuHasSse42() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+}
+
+bool cpuHasAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+SSE42_TARGET uint32_t crc32cHardware(const uint8_t* data, size_t size) {
+    uint64_t crc = 0xFFFFFFFFu;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) crc = _mm_crc32_u64(crc, read64(data + i));
+    uint32_t crc32 = static_cast<uint32_t>(crc);
+    for (; i < size; ++i) crc32 = _mm_crc32_u8(crc32, data[i]);
+    return ~crc32;
+}
+
+AVX2_TARGET void accumulateAvx2(uint64_t* acc, const uint8_t* input, const uint8_t* secret, size_t stripes) {
+    __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc));
+    __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + 4));
+    for (size_t stripe = 0; stripe < stripes; ++stripe) {
+        const uint8_t* data = input + stripe * STRIPE_LENGTH;
+        const uint8_t* key = secret + stripe * 8;
+        for (int half = 0; half < 2; ++half) {
+            __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32 * half));
+            __m256i keyed = _mm256_xor_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key + 32 * half)));
+            // Low 32 bits times high 32 bits of each lane, plus the neighbouring lane's input
+            __m256i product = _mm256_mul_epu32(keyed, _mm256_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+            __m256i swapped = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+            __m256i& lanes = half == 0 ? low : high;
+            lanes = _mm256_add_epi64(lanes, _mm256_add_epi64(product, swapped));
+        }
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc), low);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4), high);
+}
+
+AVX2_TARGET void scrambleAvx2(uint64_t* acc, const uint8_t* secret) {
+    const __m256i prime = _mm256_set1_epi32(static_cast<int>(PRIME32_1));
+    for (int half = 0; half < 2; ++half) {
+        __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + 4 * half));
+        value = _mm256_xor_si256(value, _mm256_srli_epi64(value, 47));
+        value = _mm256_xor_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret + 32 * half)));
+        // 64x32-bit multiply from two 32x32 halves
+        __m256i lowProduct = _mm256_mul_epu32(value, prime);
+        __m256i highProduct = _mm256_mul_epu32(_mm256_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+        value = _mm256_add_epi64(lowProduct, _mm256_slli_epi64(highProduct, 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4 * half), value);
+    }
+}
+
+#endif
+
+} // namespace
+
+namespace Checksum {
+
+const char* name(Digest digest) {
+    return digest == Digest::XXH3 ? "xxh3" : "crc32c";
+}
+
+bool parse(const std::string& text, Digest& digest) {
+    if (text == "crc32c") {
+        digest = Digest::CRC32C;
+    } else if (text == "xxh3") {
+        digest = Digest::XXH3;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+uint64_t compute(Digest digest, const void* data, size_t size) {
+    return digest == Digest::XXH3 ? xxh3(data, size) : crc32c(data, size);
+}
+
+uint32_t crc32cScalar(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    const CrcTables& tables = crcTables();
+    uint32_t crc = 0xFFFFFFFFu;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint32_t low = read32(bytes + i) ^ crc;
+        uint32_t high = read32(bytes + i + 4);
+        crc = tables.table[7][low & 0xFF] ^ tables.table[6][(low >> 8) & 0xFF] ^ tables.table[5][(low >> 16) & 0xFF] ^
+              tables.table[4][low >> 24] ^ tables.table[3][high & 0xFF] ^ tables.table[2][(high >> 8) & 0xFF] ^
+              tables.table[1][(high >> 16) & 0xFF] ^ tables.table[0][high >> 24];
+    }
+    for (; i < size; ++i) crc = (crc >> 8) ^ tables.table[0][(crc ^ bytes[i]) & 0xFF];
+    return ~crc;
+}
+
+uint32_t crc32c(const void* data, size_t size) {
+#ifdef CHECKSUM_HAVE_X86_KERNELS
+    static const bool hasSse42 = cpuHasSse42();
+    if (hasSse42) return crc32cHardware(static_cast<const uint8_t*>(data), size);
+#endif
+    return crc32cScalar(data, size);
+}
+
+uint64_t xxh3Scalar(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    if (size <= 240) return hashShort(bytes, size);
+    return hashLong(bytes, size, accumulateScalar, scrambleScalar);
+}
+
+uint64_t xxh3(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    if (size <= 240) return hashShort(bytes, size);
+#ifdef CHECKSUM_HAVE_X86_KERNELS
+    static const bool hasAvx2 = cpuHasAvx2();
+    if (hasAvx2) return hashLong(bytes, size, accumulateAvx2, scrambleAvx2);
+#endif
+    return hashLong(bytes, size, accumulateScalar, scrambleScalar);
+}
+
+} // namespace Checksum
@@ -0,0 +1,335 @@
+#include "ChunkedContainer.h"
+#include "Metrics.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const char HEADER_MAGIC[4] = {'E', 'T', 'C', '1'};
+const char TRAILER_MAGIC[4] = {'E', 'T', 'C', 'X'};
+const uint8_t FORMAT_VERSION = 1;
+const size_t ENTRY_SIZE = 24;
+const size_t TRAILER_SIZE = 12;
+
+struct IndexEntry {
+    uint64_t offset;
+    uint64_t size;
+    uint64_t state;
+};
+
+void put64(std::string& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) out += static_cast<char>(v >> (8 * i));
+}
+
+uint64_t getLittleEndian(const char* p, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    return v;
+}
+
+uint64_t get64(const char* p) {
+    return getLittleEndian(p, 8);
+}
+
+// An authenticated cipher seals each chunk as a message of its own, so nothing in its tag
+// ties the chunk to its place. Each chunk's plaintext therefore starts with its index,
+// whether it is the last chunk, and the container header; a chunk swapped with another,
+// taken from a different container or left last after the real end was cut off (with
+// the index rewritten to match) fails the check. Other ciphers carry no tags to check
+// it with, so their chunks hold only the plaintext.
+std::string chunkBinding(const std::string& header, uint64_t index, bool last) {
+    std::string binding;
+    put64(binding, index);
+    binding += static_cast<char>(last);
+    binding += header;
+    return binding;
+}
+
+// Header, trailer and index location of an open container; entries are read on demand
+class Reader {
+public:
+    bool open(const std::string& filename) {
+        file.open(filename, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Error: Unable to open input file: " << filename << std::endl;
+            return false;
+        }
+
+        char header[6];
+        char trailer[TRAILER_SIZE];
+        char sizes[16];
+        file.read(header, sizeof(header));
+        size_t nameLength = static_cast<unsigned char>(header[5]);
+        info.algorithm.resize(nameLength);
+        char chunkSize[4];
+        if (file) file.read(&info.algorithm[0], static_cast<std::streamsize>(nameLength));
+        if (file) file.read(chunkSize, sizeof(chunkSize));
+        file.seekg(0, std::ios::end);
+        uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+        file.seekg(-static_cast<std::streamoff>(TRAILER_SIZE), std::ios::end);
+        if (file) file.read(trailer, sizeof(trailer));
+        indexOffset = get64(trailer);
+        if (file) file.seekg(static_cast<std::streamoff>(indexOffset));
+        if (file) file.read(sizes, sizeof(sizes));
+
+        info.chunkSize = static_cast<uint32_t>(getLittleEndian(chunkSize, 4));
+        headerSize = sizeof(header) + nameLength + sizeof(chunkSize);
+        headerBytes = std::string(header, sizeof(header)) + info.algorithm + std::string(chunkSize, sizeof(chunkSize));
+        if (!file || std::memcmp(header, HEADER_MAGIC, 4) != 0 || header[4] != FORMAT_VERSION ||
+            std::memcmp(trailer + 8, TRAILER_MAGIC, 4) != 0 || info.chunkSize == 0) {
+            std::cerr << "Error: " << filename << " is not an encrypted container." << std::endl;
+            return false;
+        }
+        info.chunkCount = get64(sizes);
+        info.plaintextSize = get64(sizes + 8);
+        // Empty input has no chunks, or a single empty one under an authenticated cipher
+        uint64_t chunkCount = info.plaintextSize / info.chunkSize + (info.plaintextSize % info.chunkSize != 0);
+        if (info.chunkCount > fileSize / ENTRY_SIZE || indexOffset < headerSize || indexOffset > fileSize ||
+            indexOffset + 16 + info.chunkCount * ENTRY_SIZE + TRAILER_SIZE != fileSize ||
+            (info.chunkCount != chunkCount && (chunkCount != 0 || info.chunkCount != 1))) {
+            std::cerr << "Error: " << filename << " has a damaged chunk index." << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool matches(const CipherAlgorithm& cipher) const {
+        if (info.algorithm != cipher.getName()) {
+            std::cerr << "Error: Container was encrypted with " << info.algorithm << ", not "
+                      << cipher.getName() << "." << std::endl;
+            return false;
+        }
+        // Authenticated containers always end in a chunk sealed as the last one
+        if (cipher.isAuthenticated() && info.chunkCount == 0) {
+            std::cerr << "Error: Container has no chunks; it was truncated." << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool readEntries(uint64_t first, uint64_t count, std::vector<IndexEntry>& entries) {
+        std::vector<char> raw(count * ENTRY_SIZE);
+        file.seekg(static_cast<std::streamoff>(indexOffset + 16 + first * ENTRY_SIZE));
+        file.read(raw.data(), static_cast<std::streamsize>(raw.size()));
+        if (!file) return false;
+
+        entries.resize(count);
+        for (uint64_t i = 0; i < count; ++i) {
+            const char* p = &raw[i * ENTRY_SIZE];
+            entries[i] = {get64(p), get64(p + 8), get64(p + 16)};
+        }
+        return true;
+    }
+
+    // Entries come from the file, so a chunk must lie between the header and the index
+    // before anything is allocated for it
+    bool readChunk(const IndexEntry& entry, std::string& payload) {
+        if (entry.offset < headerSize || entry.offset > indexOffset || entry.size > indexOffset - entry.offset) {
+            return false;
+        }
+        payload.resize(entry.size);
+        file.seekg(static_cast<std::streamoff>(entry.offset));
+        file.read(&payload[0], static_cast<std::streamsize>(entry.size));
+        return static_cast<bool>(file);
+    }
+
+    // Plaintext bytes chunk `index` must decrypt to
+    uint64_t chunkLength(uint64_t index) const {
+        uint64_t start = index * info.chunkSize;
+        return std::min<uint64_t>(info.chunkSize, info.plaintextSize - start);
+    }
+
+    ChunkedContainer::Info info;
+    std::string headerBytes;
+
+private:
+    std::ifstream file;
+    uint64_t headerSize = 0;
+    uint64_t indexOffset = 0;
+};
+
+// A chunk that fails authentication (AEAD) comes back empty. A lossless cipher must give
+// back exactly the chunk's plaintext length; a lossy one (Morse) only something.
+bool decryptChunk(CipherAlgorithm& cipher, const Reader& reader, uint64_t index, const IndexEntry& entry,
+                  const std::string& payload, std::string& chunk) {
+    uint64_t expected = reader.chunkLength(index);
+    chunk = cipher.decryptAt(payload, entry.state);
+    if (cipher.isAuthenticated()) {
+        std::string binding = chunkBinding(reader.headerBytes, index, index + 1 == reader.info.chunkCount);
+        if (chunk.compare(0, binding.size(), binding) != 0) return false;
+        chunk.erase(0, binding.size());
+    }
+    return cipher.isLossless() ? chunk.size() == expected : !chunk.empty() || payload.empty();
+}
+
+void reportDamagedChunk(const std::string& filename, uint64_t index) {
+    std::cerr << "Error: Chunk " << index << " of " << filename
+              << " did not decrypt (the data was modified or the key is wrong)." << std::endl;
+}
+
+} // namespace
+
+bool ChunkedContainer::encryptFile(CipherAlgorithm& cipher, const std::string& inputFilename,
+                                   const std::string& containerFilename, size_t chunkSize) {
+    ET_METRICS_SCOPE(scope, Metrics::PROCESS_FILE, cipher.getName(), 0);
+    std::ifstream input(inputFilename, std::ios::binary);
+    if (!input.is_open()) {
+        std::cerr << "Error: Unable to open input file: " << inputFilename << std::endl;
+        return false;
+    }
+    std::ofstream output(containerFilename, std::ios::binary);
+    if (!output.is_open()) {
+        std::cerr << "Error: Unable to open output file: " << containerFilename << std::endl;
+        return false;
+    }
+    chunkSize = std::max<size_t>(1, std::min<size_t>(chunkSize, 0xffffffffu));
+
+    std::string name = cipher.getName();
+    std::string header(HEADER_MAGIC, 4);
+    header += static_cast<char>(FORMAT_VERSION);
+    header += static_cast<char>(name.size());
+    header += name;
+    for (int i = 0; i < 4; ++i) header += static_cast<char>(chunkSize >> (8 * i));
+    output << header;
+
+    std::vector<IndexEntry> entries;
+    std::string chunk(chunkSize, '\0');
+    uint64_t offset = header.size(), plaintextSize = 0, state = 0;
+    bool authenticated = cipher.isAuthenticated();
+    // Empty input still gets a chunk under an authenticated cipher, so that a container
+    // with every chunk cut off cannot pass for one
+    while (input.read(&chunk[0], static_cast<std::streamsize>(chunkSize)) || input.gcount() > 0 ||
+           (authenticated && entries.empty())) {
+        chunk.resize(static_cast<size_t>(input.gcount()));
+        bool last = input.peek() == std::char_traits<char>::eof();
+        std::string payload = authenticated
+            ? cipher.encryptAt(chunkBinding(header, entries.size(), last) + chunk, state)
+            : cipher.encryptAt(chunk, state);
+        if (payload.empty()) {
+            std::cerr << "Error: Unable to encrypt " << inputFilename << std::endl;
+            output.close();
+            std::remove(containerFilename.c_str());
+            return false;
+        }
+        output << payload;
+
+        entries.push_back({offset, payload.size(), state});
+        offset += payload.size();
+        plaintextSize += chunk.size();
+        state = cipher.advanceState(chunk, state);
+        chunk.resize(chunkSize);
+    }
+    ET_METRICS_SET_BYTES(scope, plaintextSize);
+
+    std::string index;
+    put64(index, entries.size());
+    put64(index, plaintextSize);
+    for (const IndexEntry& entry : entries) {
+        put64(index, entry.offset);
+        put64(index, entry.size);
+        put64(index, entry.state);
+    }
+    put64(index, offset);
+    index.append(TRAILER_MAGIC, 4);
+    output << index;
+
+    if (!output) {
+        std::cerr << "Error: Unable to write output file: " << containerFilename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ChunkedContainer::decryptFile(CipherAlgorithm& cipher, const std::string& containerFilename,
+                                   const std::string& outputFilename) {
+    ET_METRICS_SCOPE(scope, Metrics::PROCESS_FILE, cipher.getName(), 0);
+    Reader reader;
+    std::vector<IndexEntry> entries;
+    if (!reader.open(containerFilename) || !reader.matches(cipher)) return false;
+    if (!reader.readEntries(0, reader.info.chunkCount, entries)) {
+        std::cerr << "Error: " << containerFilename << " has a damaged chunk index." << std::endl;
+        return false;
+    }
+    ET_METRICS_SET_BYTES(scope, reader.info.plaintextSize);
+
+    std::ofstream output(outputFilename, std::ios::binary);
+    if (!output.is_open()) {
+        std::cerr << "Error: Unable to open output file: " << outputFilename << std::endl;
+        return false;
+    }
+
+    // Nothing partial is left behind when a chunk fails
+    auto fail = [&]() {
+        output.close();
+        std::remove(outputFilename.c_str());
+        return false;
+    };
+    std::string payload, chunk;
+    for (uint64_t i = 0; i < entries.size(); ++i) {
+        if (!reader.readChunk(entries[i], payload)) {
+            std::cerr << "Error: " << containerFilename << " has a damaged chunk index or is truncated." << std::endl;
+            return fail();
+        }
+        if (!decryptChunk(cipher, reader, i, entries[i], payload, chunk)) {
+            reportDamagedChunk(containerFilename, i);
+            return fail();
+        }
+        output << chunk;
+    }
+    if (!output) {
+        std::cerr << "Error: Unable to write output file: " << outputFilename << std::endl;
+        return fail();
+    }
+    return true;
+}
+
+bool ChunkedContainer::decryptRange(CipherAlgorithm& cipher, const std::string& containerFilename,
+                                    uint64_t offset, uint64_t length, std::string& plaintext) {
+    plaintext.clear();
+    Reader reader;
+    if (!reader.open(containerFilename) || !reader.matches(cipher)) return false;
+
+    const Info& info = reader.info;
+    uint64_t end = std::min(info.plaintextSize, offset + std::min(length, info.plaintextSize));
+    if (offset >= end) return true;
+
+    uint64_t first = offset / info.chunkSize;
+    uint64_t last = (end - 1) / info.chunkSize;
+    std::vector<IndexEntry> entries;
+    if (!reader.readEntries(first, last - first + 1, entries)) {
+        std::cerr << "Error: " << containerFilename << " has a damaged chunk index." << std::endl;
+        return false;
+    }
+
+    std::string payload, chunk;
+    for (uint64_t i = first; i <= last; ++i) {
+        const IndexEntry& entry = entries[i - first];
+        if (!reader.readChunk(entry, payload)) {
+            std::cerr << "Error: " << containerFilename << " has a damaged chunk index or is truncated." << std::endl;
+            plaintext.clear();
+            return false;
+        }
+        if (!decryptChunk(cipher, reader, i, entry, payload, chunk)) {
+            reportDamagedChunk(containerFilename, i);
+            plaintext.clear();
+            return false;
+        }
+
+        uint64_t chunkStart = i * info.chunkSize;
+        size_t from = static_cast<size_t>(std::max(offset, chunkStart) - chunkStart);
+        size_t to = static_cast<size_t>(std::min(end - chunkStart, static_cast<uint64_t>(chunk.size())));
+        if (from < to) plaintext.append(chunk, from, to - from);
+    }
+    return true;
+}
+
+bool ChunkedContainer::readInfo(const std::string& containerFilename, Info& info) {
+    Reader reader;
+    if (!reader.open(containerFilename)) return false;
+    info = reader.info;
+    return true;
+}
@@ -1,15 +1,105 @@
 #include "CipherAlgorithm.h"
+#include "IntegrityManifest.h"
+#include "KeyScheduleCache.h"
+#include "Metrics.h"
 #include <iostream>
+#include <mutex>
+#include <set>
 
 std::string CipherAlgorithm::encrypt(const std::string& plaintext) {
-    return processText(plaintext, true);
+    std::string ciphertext;
+    tryEncrypt(plaintext, ciphertext);
+    return ciphertext;
 }
 
 std::string CipherAlgorithm::decrypt(const std::string& ciphertext) {
-    return processText(ciphertext, false);
+    std::string plaintext;
+    tryDecrypt(ciphertext, plaintext);
+    return plaintext;
+}
+
+bool CipherAlgorithm::tryEncrypt(const std::string& plaintext, std::string& ciphertext) {
+    ET_METRICS_SCOPE(scope, Metrics::ENCRYPT, getName(), plaintext.size());
+    if (processChecked(plaintext, true, ciphertext)) return true;
+    ciphertext.clear();
+    return false;
+}
+
+bool CipherAlgorithm::tryDecrypt(const std::string& ciphertext, std::string& plaintext) {
+    ET_METRICS_SCOPE(scope, Metrics::DECRYPT, getName(), ciphertext.size());
+    if (processChecked(ciphertext, false, plaintext)) return true;
+    plaintext.clear();
+    return false;
+}
+
+bool CipherAlgorithm::processChecked(const std::string& text, bool isEncryption, std::string& result) {
+    result = processText(text, isEncryption);
+    return true;
+}
+
+std::string CipherAlgorithm::encryptAt(const std::string& plaintext, uint64_t state) {
+    ET_METRICS_SCOPE(scope, Metrics::ENCRYPT, getName(), plaintext.size());
+    return processTextAt(plaintext, true, state);
+}
+
+std::string CipherAlgorithm::decryptAt(const std::string& ciphertext, uint64_t state) {
+    ET_METRICS_SCOPE(scope, Metrics::DECRYPT, getName(), ciphertext.size());
+    return processTextAt(ciphertext, false, state);
+}
+
+std::string CipherAlgorithm::processTextAt(const std::string& text, bool isEncryption, uint64_t) {
+    return processText(text, isEncryption);
+}
+
+// Metrics keep the name pointer, so the set is never destroyed
+const char* CipherAlgorithm::internName(const std::string& name) {
+    static std::mutex mutex;
+    static std::set<std::string>* names = new std::set<std::string>;
+    std::lock_guard<std::mutex> lock(mutex);
+    return names->insert(name).first->c_str();
+}
+
+uint64_t CipherAlgorithm::advanceState(const std::string&, uint64_t state) const {
+    return state;
+}
+
+bool CipherAlgorithm::hasStreamState() const {
+    return false;
+}
+
+bool CipherAlgorithm::preservesLength() const {
+    return false;
+}
+
+bool CipherAlgorithm::isLossless() const {
+    return true;
+}
+
+bool CipherAlgorithm::isAuthenticated() const {
+    return false;
+}
+
+uint64_t CipherAlgorithm::keyFingerprint() {
+    static const std::string probe = "The quick brown fox jumps over the lazy dog. 0123456789";
+    std::string ciphertext = processText(probe, true);
+    return Checksum::xxh3(ciphertext.data(), ciphertext.size());
+}
+
+void CipherAlgorithm::setKey(const std::string& key) {
+    applySchedule(compileKey(key));
+}
+
+void CipherAlgorithm::setKeyCached(const std::string& key, KeyScheduleCache& cache) {
+    applySchedule(cache.get(*this, key));
 }
 
 bool CipherAlgorithm::processFile(const std::string& inputFilename, const std::string& outputFilename, bool isEncryption) {
+    return processFile(inputFilename, outputFilename, isEncryption, Digest::CRC32C);
+}
+
+bool CipherAlgorithm::processFile(const std::string& inputFilename, const std::string& outputFilename, bool isEncryption,
+                                  Digest digest) {
+    ET_METRICS_SCOPE(scope, Metrics::PROCESS_FILE, getName(), 0);
     std::ifstream inputFile(inputFilename);
     if (!inputFile.is_open()) {
         std::cerr << "Error: Unable to open input file: " << inputFilename << std::endl;
@@ -19,8 +109,12 @@ bool CipherAlgorithm::processFile(const std::string& inputFilename, const std::s
     std::string fileContent((std::istreambuf_iterator<char>(inputFile)),
                            std::istreambuf_iterator<char>());
     inputFile.close();
+    ET_METRICS_SET_BYTES(scope, fileContent.size());
     
-    std::string result = isEncryption ? encrypt(fileContent) : decrypt(fileContent);
+    std::string result;
+    if (!(isEncryption ? tryEncrypt(fileContent, result) : tryDecrypt(fileContent, result))) return false;
+    bool manifest = IntegrityManifest::appliesTo(*this);
+    if (manifest && !isEncryption && !IntegrityManifest::check(*this, result, inputFilename)) return false;
     
     std::ofstream outputFile(outputFilename);
     if (!outputFile.is_open()) {
@@ -31,5 +125,5 @@ bool CipherAlgorithm::processFile(const std::string& inputFilename, const std::s
     outputFile << result;
     outputFile.close();
     
-    return true;
+    return !manifest || !isEncryption || IntegrityManifest::write(*this, fileContent, outputFilename, result.size(), digest);
 }
\ No newline at end of file
@@ -0,0 +1,715 @@
+#include "CipherClassifier.h"
+#include "Ascii.h"
+#include "EnglishStatistics.h"
+#include "TextArmor.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Period detection reads only a prefix; the histogram always covers the whole text
+const size_t SAMPLE_LETTERS = 4096;
+
+// Coincidences are counted at letter distances 1 to MAX_DISTANCE, the longest period found
+const size_t MAX_DISTANCE = 32;
+const size_t SAMPLE_PADDING = MAX_DISTANCE + 16;
+
+const size_t MIN_LETTERS = 12;
+const double MIN_LETTER_SHARE = 0.6;   // Of the bytes that are not whitespace
+// The letter ciphers keep case, and text is mostly one case. Base64 armor is about
+// half uppercase, half lowercase.
+const double MAX_MIXED_CASE = 0.35;    // Share of letters in the less common case
+
+// The thresholds below were fitted on English encrypted under random keys, 30 bytes to
+// 8 KB per record. Margins are in units where 1 is about 97% accurate.
+//
+// English has an IC of ~0.066, random letters ~0.038. One standard deviation of the IC
+// is about IC_SPREAD / sqrt(letters).
+const double MONO_IC = 0.056;
+const double IC_SPREAD = 0.11;
+// One alphabet reaches a period z-score of ~4.5 by chance, rarely 8. Each unit of z
+// above 4.5 counts as 1/6 of a unit of IC margin.
+const double NEUTRAL_PERIOD_Z = 4.5;
+const double PERIOD_Z_PER_IC = 6.0;
+const double CERTAIN_PERIOD_Z = 8.0;
+// Shifted English stays under ENGLISH_CHI + CHI_NOISE / letters chi-squared per letter
+// at its shift; substituted text is usually above 1. Both margins are log ratios.
+const double ENGLISH_CHI = 0.6;
+const double CHI_NOISE = 20.0;
+const double CHI_SPREAD = 0.5;
+const double SHIFT_SPREAD = 0.6;
+// A good fit to English at some shift counts against Vigenère at this weight
+const double FIT_WEIGHT = 0.5;
+
+const size_t MAX_MORSE_TOKEN = 5;          // The longest code; "/" stands alone
+const double MORSE_REGULARITY = 0.95;      // Share of gaps equal to the separator
+
+// Records of a file are grouped into tasks of about this many bytes
+const size_t TASK_BYTES = 256 << 10;
+// Directory files are classified and written this many at a time
+const size_t FILE_WINDOW = 4096;
+
+struct Statistics {
+    uint64_t letters = 0;
+    uint64_t upper = 0;
+    uint64_t whitespace = 0;
+    uint64_t morse = 0;                   // '.', '-' and '/'
+    uint64_t histogram[26] = {};
+    size_t sampleSize = 0;
+    uint8_t sample[SAMPLE_LETTERS + SAMPLE_PADDING];  // Letter indices 0-25, then padding
+};
+
+inline bool isWhitespace(unsigned char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+inline bool isMorseSymbol(unsigned char c) { return c == '.' || c == '-' || c == '/'; }
+
+// One pass: byte classes, the letter histogram and the first SAMPLE_LETTERS letters
+void gatherStatistics(const char* text, size_t size, Statistics& stats) {
+    uint32_t tables[4][26] = {};  // Interleaved so neighbouring letters rarely hit the same counter
+    uint64_t letters = 0, upper = 0, whitespace = 0, morse = 0;
+    uint8_t* sample = stats.sample;
+    size_t sampleSize = 0;        // Kept local: the byte stores below could alias stats
+#ifdef __SSE2__
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i a = _mm_set1_epi8('a');
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    const __m128i lastLetter = _mm_set1_epi8(25);
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i lastControlSpace = _mm_set1_epi8('\r' - '\t');
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i dot = _mm_set1_epi8('.');
+    const __m128i dash = _mm_set1_epi8('-');
+    const __m128i slash = _mm_set1_epi8('/');
+    alignas(16) uint8_t indices[16];
+    alignas(16) char tail[16];
+    for (size_t i = 0; i < size;) {
+        // Byte counters take 255 blocks before they could wrap
+        size_t blocks = std::min<size_t>((size - i + 15) / 16, 255);
+        __m128i letterCount = zero, upperCount = zero, whitespaceCount = zero, morseCount = zero;
+        for (size_t b = 0; b < blocks; ++b, i += 16) {
+            const char* block = text + i;
+            if (size - i < 16) {  // Zero bytes are in none of the classes
+                std::memset(tail, 0, sizeof(tail));
+                std::memcpy(tail, block, size - i);
+                block = tail;
+            }
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+            __m128i index = _mm_sub_epi8(_mm_or_si128(v, caseBit), a);
+            __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(index, lastLetter), index);
+            __m128i control = _mm_sub_epi8(v, tab);
+            __m128i isWhite = _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(control, lastControlSpace), control),
+                                           _mm_cmpeq_epi8(v, space));
+            __m128i isMorse = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, dot), _mm_cmpeq_epi8(v, dash)),
+                                           _mm_cmpeq_epi8(v, slash));
+            letterCount = _mm_sub_epi8(letterCount, isLetter);
+            upperCount = _mm_sub_epi8(upperCount, _mm_andnot_si128(_mm_cmpeq_epi8(_mm_and_si128(v, caseBit), caseBit),
+                                                                   isLetter));
+            whitespaceCount = _mm_sub_epi8(whitespaceCount, isWhite);
+            morseCount = _mm_sub_epi8(morseCount, isMorse);
+
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(isLetter));
+            if (!mask) continue;
+            _mm_store_si128(reinterpret_cast<__m128i*>(indices), index);
+            while (mask) {
+                unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+                mask &= mask - 1;
+                uint8_t letter = indices[bit];
+                ++tables[bit & 3][letter];
+                sample[sampleSize] = letter;
+                sampleSize += sampleSize < SAMPLE_LETTERS;
+            }
+        }
+        __m128i sums[4] = {_mm_sad_epu8(letterCount, zero), _mm_sad_epu8(upperCount, zero),
+                           _mm_sad_epu8(whitespaceCount, zero), _mm_sad_epu8(morseCount, zero)};
+        uint64_t* targets[4] = {&letters, &upper, &whitespace, &morse};
+        for (int k = 0; k < 4; ++k) {
+            *targets[k] += static_cast<uint64_t>(_mm_cvtsi128_si32(sums[k])) +
+                           static_cast<uint64_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums[k], 8)));
+        }
+    }
+#else
+    for (size_t i = 0; i < size; ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        unsigned index = static_cast<unsigned>((c | 0x20) - 'a');
+        whitespace += isWhitespace(c);
+        morse += isMorseSymbol(c);
+        if (index < 26) {
+            ++letters;
+            upper += !(c & 0x20);
+            ++tables[i & 3][index];
+            sample[sampleSize] = static_cast<uint8_t>(index);
+            sampleSize += sampleSize < SAMPLE_LETTERS;
+        }
+    }
+#endif
+    for (int letter = 0; letter < 26; ++letter) {
+        stats.histogram[letter] = uint64_t(tables[0][letter]) + tables[1][letter] + tables[2][letter] + tables[3][letter];
+    }
+    // Distinct values that match neither a letter nor each other
+    for (size_t k = 0; k < SAMPLE_PADDING; ++k) sample[sampleSize + k] = static_cast<uint8_t>(26 + k);
+    stats.sampleSize = sampleSize;
+    stats.letters = letters;
+    stats.upper = upper;
+    stats.whitespace = whitespace;
+    stats.morse = morse;
+}
+
+// coincidences[d] = positions i with sample[i] == sample[i + d], for d = 1 to maxDistance.
+// Past its end the sample is padded with values that never match, so the last block of
+// each distance is read whole instead of finished one byte at a time.
+void countCoincidences(const uint8_t* sample, size_t size, size_t maxDistance, uint32_t* coincidences) {
+    for (size_t d = 1; d <= maxDistance; ++d) {
+        size_t pairs = size > d ? size - d : 0;
+        uint32_t count = 0;
+#ifdef __SSE2__
+        const __m128i zero = _mm_setzero_si128();
+        for (size_t i = 0; i < pairs;) {
+            size_t end = std::min(pairs, i + 255 * 16);  // Byte counters take 255 blocks
+            __m128i matches = zero;
+            for (; i < end; i += 16) {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sample + i));
+                __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sample + i + d));
+                matches = _mm_sub_epi8(matches, _mm_cmpeq_epi8(x, y));
+            }
+            __m128i sum = _mm_sad_epu8(matches, zero);
+            count += static_cast<uint32_t>(_mm_cvtsi128_si32(sum) + _mm_cvtsi128_si32(_mm_srli_si128(sum, 8)));
+        }
+#else
+        for (size_t i = 0; i < pairs; ++i) count += sample[i] == sample[i + d];
+#endif
+        coincidences[d] = count;
+    }
+}
+
+double indexOfCoincidence(const uint64_t* counts, uint64_t total) {
+    if (total < 2) return 0.0;
+    uint64_t sum = 0;
+    for (int letter = 0; letter < 26; ++letter) sum += counts[letter] * (counts[letter] - (counts[letter] > 0));
+    return double(sum) / (double(total) * double(total - 1));
+}
+
+double periodicIc(const uint8_t* sample, size_t size, size_t period) {
+    uint64_t counts[MAX_DISTANCE][26];
+    std::memset(counts, 0, period * sizeof(counts[0]));
+    for (size_t i = 0, column = 0; i < size; ++i) {
+        ++counts[column][sample[i]];
+        if (++column == period) column = 0;
+    }
+    double sum = 0.0;
+    for (size_t column = 0; column < period; ++column) {
+        uint64_t total = size / period + (column < size % period);
+        sum += indexOfCoincidence(counts[column], total);
+    }
+    return sum / double(period);
+}
+
+// Chi-squared per letter against English for each Caesar key. With shares q = count / n,
+// Σ(o-e)²/e / n = Σq²/f - 1, so every shift is one pass of multiply-adds over the
+// squared shares; in float, with the shifts in the inner loop, that pass vectorizes.
+void chiSquaredByShift(const uint64_t* counts, uint64_t total, double* chi) {
+    static const std::vector<float> inverseFrequency = [] {
+        std::vector<float> inverse(26);
+        for (int letter = 0; letter < 26; ++letter) inverse[letter] = float(1.0 / ENGLISH_LETTER_FREQUENCIES[letter]);
+        return inverse;
+    }();
+    float squares[52];
+    for (int letter = 0; letter < 26; ++letter) {
+        float share = float(double(counts[letter]) / double(total));
+        squares[letter] = squares[letter + 26] = share * share;
+    }
+    float sums[26] = {};
+    for (int plain = 0; plain < 26; ++plain) {
+        for (int shift = 0; shift < 26; ++shift) sums[shift] += squares[plain + shift] * inverseFrequency[plain];
+    }
+    for (int shift = 0; shift < 26; ++shift) chi[shift] = double(sums[shift]) - 1.0;
+}
+
+// Logistic squash of a margin; 0.5 at the decision boundary, ~0.97 at 1
+double certainty(double margin) {
+    return 1.0 / (1.0 + std::exp(-3.5 * margin));
+}
+
+// Tokens of '.', '-' and '/' separated by one repeated string, as MorseCodec writes them.
+// The first gap is taken as the separator; returns the share of gaps that match it.
+double morseRegularity(const char* text, size_t size, size_t& tokens) {
+    while (size > 0 && isWhitespace(static_cast<unsigned char>(text[size - 1]))) --size;
+    tokens = 0;
+    size_t gaps = 0, regular = 0;
+    const char* separator = nullptr;
+    size_t separatorSize = 0;
+    size_t i = 0;
+    while (i < size && !isMorseSymbol(static_cast<unsigned char>(text[i]))) ++i;
+    if (i > 0) return 0.0;  // Morse output starts with a symbol
+    while (i < size) {
+        size_t start = i;
+        while (i < size && isMorseSymbol(static_cast<unsigned char>(text[i]))) ++i;
+        if (i - start > MAX_MORSE_TOKEN) return 0.0;
+        ++tokens;
+        if (i == size) break;
+        size_t gapStart = i;
+        while (i < size && !isMorseSymbol(static_cast<unsigned char>(text[i]))) ++i;
+        size_t gapSize = i - gapStart;
+        if (!separator) {
+            separator = text + gapStart;
+            separatorSize = gapSize;
+        }
+        ++gaps;
+        regular += gapSize == separatorSize && std::memcmp(text + gapStart, separator, gapSize) == 0;
+    }
+    return gaps ? double(regular) / double(gaps) : (tokens == 1 ? 1.0 : 0.0);
+}
+
+void classifyLetters(const Statistics& stats, CipherClassifier::Result& result) {
+    const uint64_t n = stats.letters;
+    result.indexOfCoincidence = indexOfCoincidence(stats.histogram, n);
+
+    // Letters one key length apart were shifted alike, so they coincide as often as in
+    // English; at other distances about as often as random letters. The period is the
+    // one whose distances stand out most from the rest. Distance 1 is left out because
+    // English rarely doubles a letter.
+    double bestSquared = 0.0;
+    size_t maxDistance = std::min(MAX_DISTANCE, stats.sampleSize / 4);
+    if (maxDistance >= 4) {
+        uint32_t coincidences[MAX_DISTANCE + 1];
+        countCoincidences(stats.sample, stats.sampleSize, maxDistance, coincidences);
+        uint64_t allMatches = 0, allPairs = 0;
+        for (size_t d = 2; d <= maxDistance; ++d) {
+            allMatches += coincidences[d];
+            allPairs += stats.sampleSize - d;
+        }
+        // z = (m/p - (M-m)/(P-p)) / sqrt(r(1-r)(1/p + 1/(P-p))) with r = M/P, which squared
+        // is (mP - Mp)² / (p(P-p)) over a constant r(1-r)P
+        const double all = double(allPairs);
+        const double matched = double(allMatches);
+        for (size_t period = 2; period <= maxDistance; ++period) {
+            uint64_t matches = 0, pairs = 0;
+            for (size_t d = period; d <= maxDistance; d += period) {
+                matches += coincidences[d];
+                pairs += stats.sampleSize - d;
+            }
+            if (pairs == allPairs) continue;
+            double excess = double(matches) * all - matched * double(pairs);
+            if (excess <= 0) continue;
+            double squared = excess * excess / (double(pairs) * double(allPairs - pairs));
+            if (squared > bestSquared) {
+                bestSquared = squared;
+                result.period = period;
+            }
+        }
+        double rate = matched / all;
+        bestSquared /= std::max(rate * (1.0 - rate), 1e-9) * all;
+    }
+    double periodZ = std::sqrt(bestSquared);
+
+    // Shifted English fits the letter frequencies at its shift. A substitution key
+    // scrambles them so that no shift fits, and Vigenère flattens them.
+    double chi[26];
+    chiSquaredByShift(stats.histogram, n, chi);
+    int shift = int(std::min_element(chi, chi + 26) - chi);
+    double runnerUp = 1e300;
+    for (int s = 0; s < 26; ++s) {
+        if (s != shift) runnerUp = std::min(runnerUp, chi[s]);
+    }
+    const double floor = 1e-6;
+    double fitMargin = std::log((ENGLISH_CHI + CHI_NOISE / double(n)) / std::max(chi[shift], floor)) / CHI_SPREAD;
+
+    // Positive for Vigenère: a low IC for this many letters, unless the coincidences
+    // show no period or the letters fit English at one shift; or a period far beyond
+    // what one alphabet produces by chance
+    double icMargin = (result.indexOfCoincidence - MONO_IC) * std::sqrt(double(n)) / IC_SPREAD;
+    double polyMargin = std::max((periodZ - NEUTRAL_PERIOD_Z) / PERIOD_Z_PER_IC - icMargin -
+                                     FIT_WEIGHT * std::max(fitMargin, 0.0),
+                                 periodZ - CERTAIN_PERIOD_Z);
+    if (polyMargin > 0) {
+        result.label = CipherClassifier::Label::VIGENERE;
+        result.confidence = certainty(polyMargin);
+        if (result.period > 0) result.periodicIc = periodicIc(stats.sample, stats.sampleSize, result.period);
+        return;
+    }
+    result.period = 0;
+    if (fitMargin < 0) {
+        result.label = CipherClassifier::Label::SUBSTITUTION;
+        result.confidence = certainty(-polyMargin) * certainty(-fitMargin);
+        return;
+    }
+    result.label = shift == 0 ? CipherClassifier::Label::PLAINTEXT : CipherClassifier::Label::CAESAR;
+    result.shift = shift;
+    double shiftMargin = std::log(std::max(runnerUp, floor) / std::max(chi[shift], floor)) / SHIFT_SPREAD;
+    result.confidence = certainty(-polyMargin) * certainty(fitMargin) * certainty(shiftMargin);
+}
+
+void appendInteger(std::string& out, uint64_t value) {
+    char digits[20];
+    char* start = digits + sizeof(digits);
+    do {
+        *--start = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value);
+    out.append(start, static_cast<size_t>(digits + sizeof(digits) - start));
+}
+
+// Four decimals; every number written is a non-negative ratio
+void appendNumber(std::string& out, double value) {
+    uint64_t scaled = value > 0 ? static_cast<uint64_t>(value * 10000.0 + 0.5) : 0;
+    appendInteger(out, scaled / 10000);
+    char decimals[5] = {'.'};
+    for (int k = 4; k > 0; --k, scaled /= 10) decimals[k] = static_cast<char>('0' + scaled % 10);
+    out.append(decimals, 5);
+}
+
+// JSON text must be UTF-8, so a byte that does not start a well-formed sequence is
+// written as U+FFFD
+void appendString(std::string& out, const std::string& text) {
+    out += '"';
+    size_t run = 0;  // Start of the bytes not yet copied
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x80) {
+            size_t length = Ascii::utf8SequenceLength(text.data() + i, text.size() - i);
+            if (length > 0) {
+                i += length - 1;
+                continue;
+            }
+        } else if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out.append(text, run, i - run);
+        run = i + 1;
+        if (c >= 0x80) {
+            out += "\\ufffd";
+        } else if (c < 0x20) {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            out += buffer;
+        } else {
+            out += '\\';
+            out += static_cast<char>(c);
+        }
+    }
+    out.append(text, run, std::string::npos);
+    out += '"';
+}
+
+bool readFully(int fd, char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = read(fd, data, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Reads until size bytes or the end of the file; returns the byte count or -1
+ssize_t readBlock(int fd, char* data, size_t size) {
+    size_t total = 0;
+    while (total < size) {
+        ssize_t n = read(fd, data + total, size - total);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return -1;
+        if (n == 0) break;
+        total += static_cast<size_t>(n);
+    }
+    return static_cast<ssize_t>(total);
+}
+
+void countLabel(CipherClassifier::Report& report, const CipherClassifier::Result& result) {
+    ++report.counts[static_cast<int>(result.label)];
+    ++report.records;
+    report.bytes += result.bytes;
+}
+
+// Records of one task: the JSON lines and the results for the report
+struct RecordTask {
+    size_t begin;
+    size_t end;
+    uint64_t firstLine;
+    std::string json;
+    std::vector<CipherClassifier::Result> results;
+};
+
+bool classifyRecords(const std::string& path, std::ostream& out, const CipherClassifier::Options& options,
+                     WorkStealingPool& pool, CipherClassifier::Report& report) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Error: Unable to open input file: " << path << std::endl;
+        return false;
+    }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    const size_t blockSize = std::max<size_t>(options.blockSize, 4096);
+    std::string current, next;
+    ssize_t got = 0;
+    current.resize(blockSize);
+    got = readBlock(fd, &current[0], blockSize);
+    if (got < 0) {
+        std::cerr << "Error: Unable to read " << path << std::endl;
+        close(fd);
+        return false;
+    }
+    current.resize(static_cast<size_t>(got));
+    bool atEnd = got < static_cast<ssize_t>(blockSize);
+    uint64_t line = 1;
+    bool ok = true;
+
+    while (ok && !current.empty()) {
+        // Complete lines only, unless the file has ended
+        size_t end = current.size();
+        if (!atEnd) {
+            size_t lastNewline = current.rfind('\n');
+            end = lastNewline == std::string::npos ? 0 : lastNewline + 1;
+        }
+
+        std::vector<RecordTask> tasks;
+        for (size_t begin = 0; begin < end;) {
+            size_t stop = begin + TASK_BYTES < end ? current.find('\n', begin + TASK_BYTES) : std::string::npos;
+            stop = stop == std::string::npos || stop + 1 > end ? end : stop + 1;
+            RecordTask task;
+            task.begin = begin;
+            task.end = stop;
+            task.firstLine = line;
+            line += static_cast<uint64_t>(std::count(current.begin() + begin, current.begin() + stop, '\n'));
+            if (stop == end && atEnd && current[end - 1] != '\n') ++line;
+            tasks.push_back(std::move(task));
+            begin = stop;
+        }
+        for (RecordTask& task : tasks) {
+            pool.submit([&current, &path, &task]() {
+                const char* data = current.data();
+                task.json.reserve((task.end - task.begin) / 2 + 256);
+                uint64_t number = task.firstLine;
+                for (size_t begin = task.begin; begin < task.end; ++number) {
+                    const void* newline = std::memchr(data + begin, '\n', task.end - begin);
+                    size_t stop = newline ? static_cast<size_t>(static_cast<const char*>(newline) - data) : task.end;
+                    size_t size = stop - begin;
+                    if (size > 0 && data[begin + size - 1] == '\r') --size;
+                    CipherClassifier::Result result = CipherClassifier::classify(data + begin, size);
+                    CipherClassifier::appendJson(task.json, path, number, result);
+                    task.json += '\n';
+                    task.results.push_back(result);
+                    begin = stop + 1;
+                }
+            });
+        }
+
+        // The next block is read while this one is classified
+        next.assign(current, end, std::string::npos);
+        if (!atEnd) {
+            size_t carried = next.size();
+            next.resize(carried + blockSize);
+            got = readBlock(fd, &next[carried], blockSize);
+            if (got < 0) {
+                std::cerr << "Error: Unable to read " << path << std::endl;
+                ok = false;
+                got = 0;
+            }
+            next.resize(carried + static_cast<size_t>(got));
+            atEnd = got < static_cast<ssize_t>(blockSize);
+        }
+        pool.wait();
+
+        for (const RecordTask& task : tasks) {
+            out.write(task.json.data(), static_cast<std::streamsize>(task.json.size()));
+            for (const CipherClassifier::Result& result : task.results) countLabel(report, result);
+        }
+        current.swap(next);
+        next.clear();
+    }
+    close(fd);
+    return ok;
+}
+
+// Regular files under directory; symbolic links and special files are skipped
+void collectFiles(const std::string& directory, std::vector<std::string>& files, uint64_t& failed) {
+    DIR* handle = opendir(directory.c_str());
+    if (!handle) {
+        std::cerr << "Error: Unable to open directory: " << directory << std::endl;
+        ++failed;
+        return;
+    }
+    std::vector<std::string> subdirectories;
+    while (dirent* entry = readdir(handle)) {
+        std::string name = entry->d_name;
+        if (name == "." || name == "..") continue;
+        std::string entryPath = directory + "/" + name;
+        struct stat info;
+        if (lstat(entryPath.c_str(), &info) != 0) continue;
+        if (S_ISDIR(info.st_mode)) {
+            subdirectories.push_back(entryPath);
+        } else if (S_ISREG(info.st_mode)) {
+            files.push_back(entryPath);
+        }
+    }
+    closedir(handle);
+    for (const std::string& subdirectory : subdirectories) collectFiles(subdirectory, files, failed);
+}
+
+bool classifyFile(const std::string& path, CipherClassifier::Result& result) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        if (fd >= 0) close(fd);
+        return false;
+    }
+    std::string text(static_cast<size_t>(info.st_size), '\0');
+    bool ok = text.empty() || readFully(fd, &text[0], text.size());
+    close(fd);
+    if (ok) result = CipherClassifier::classify(text);
+    return ok;
+}
+
+void classifyDirectory(const std::string& directory, std::ostream& out, WorkStealingPool& pool,
+                       CipherClassifier::Report& report) {
+    std::vector<std::string> files;
+    std::string root = directory;
+    while (root.size() > 1 && root.back() == '/') root.pop_back();
+    collectFiles(root, files, report.failed);
+    std::sort(files.begin(), files.end());
+
+    std::vector<CipherClassifier::Result> results;
+    std::vector<char> readable;
+    std::string json;
+    for (size_t first = 0; first < files.size(); first += FILE_WINDOW) {
+        size_t count = std::min(FILE_WINDOW, files.size() - first);
+        results.assign(count, CipherClassifier::Result());
+        readable.assign(count, 0);
+        for (size_t k = 0; k < count; ++k) {
+            pool.submit([&, k]() { readable[k] = classifyFile(files[first + k], results[k]); });
+        }
+        pool.wait();
+
+        json.clear();
+        for (size_t k = 0; k < count; ++k) {
+            if (!readable[k]) {
+                std::cerr << "Error: Unable to read " << files[first + k] << std::endl;
+                ++report.failed;
+                continue;
+            }
+            CipherClassifier::appendJson(json, files[first + k], 0, results[k]);
+            json += '\n';
+            countLabel(report, results[k]);
+        }
+        out.write(json.data(), static_cast<std::streamsize>(json.size()));
+    }
+}
+
+} // namespace
+
+CipherClassifier::Result CipherClassifier::classify(const char* text, size_t size) {
+    Result result;
+    result.bytes = size;
+    Statistics stats;
+    gatherStatistics(text, size, stats);
+    result.letters = stats.letters;
+
+    // Even with a letter separator, Morse output is at least a third symbols
+    if (stats.morse > 0 && stats.morse * 3 >= size - stats.whitespace) {
+        size_t tokens = 0;
+        double regularity = morseRegularity(text, size, tokens);
+        if (regularity >= MORSE_REGULARITY) {
+            result.label = Label::MORSE;
+            result.confidence = regularity * (1.0 - std::exp(-double(tokens) / 4.0));
+            return result;
+        }
+    }
+
+    uint64_t visible = size - stats.whitespace;
+    double mixedCase = stats.letters ? double(std::min(stats.upper, stats.letters - stats.upper)) / double(stats.letters) : 0.0;
+    if (stats.letters < MIN_LETTERS || double(stats.letters) < MIN_LETTER_SHARE * double(visible) ||
+        mixedCase > MAX_MIXED_CASE) {
+        result.label = Label::UNKNOWN;
+        double nonLetters = visible ? 1.0 - double(stats.letters) / double(visible) : 0.0;
+        result.confidence = std::max(nonLetters, std::min(1.0, 2.0 * mixedCase));
+        return result;
+    }
+    classifyLetters(stats, result);
+    return result;
+}
+
+CipherClassifier::Report CipherClassifier::classifyPath(const std::string& path, std::ostream& out) {
+    return classifyPath(path, out, Options());
+}
+
+CipherClassifier::Report CipherClassifier::classifyPath(const std::string& path, std::ostream& out,
+                                                        const Options& options) {
+    Report report;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+        std::cerr << "Error: Unable to open input file: " << path << std::endl;
+        return report;
+    }
+    WorkStealingPool pool(options.threads);
+    if (S_ISDIR(info.st_mode)) {
+        classifyDirectory(path, out, pool, report);
+    } else if (!classifyRecords(path, out, options, pool, report)) {
+        ++report.failed;
+        if (report.records == 0) return report;
+    }
+    out.flush();
+    report.threads = pool.size();
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+void CipherClassifier::appendJson(std::string& out, const std::string& file, uint64_t line, const Result& result) {
+    out += "{\"file\":";
+    appendString(out, file);
+    if (!Ascii::isValidUtf8(file.data(), file.size())) {
+        out += ",\"file_hex\":\"";
+        out += TextArmor::encode(Armor::HEX, file);
+        out += '"';
+    }
+    if (line > 0) {
+        out += ",\"line\":";
+        appendInteger(out, line);
+    }
+    out += ",\"label\":\"";
+    out += result.label == Label::CAESAR && result.shift == 13 ? "rot13" : name(result.label);
+    out += "\",\"confidence\":";
+    appendNumber(out, result.confidence);
+    if (result.label == Label::CAESAR) {
+        out += ",\"shift\":";
+        appendInteger(out, static_cast<uint64_t>(result.shift));
+    } else if (result.label == Label::VIGENERE) {
+        out += ",\"period\":";
+        appendInteger(out, result.period);
+        out += ",\"periodic_ic\":";
+        appendNumber(out, result.periodicIc);
+    }
+    if (result.label != Label::MORSE && result.label != Label::UNKNOWN) {
+        out += ",\"ic\":";
+        appendNumber(out, result.indexOfCoincidence);
+    }
+    out += ",\"bytes\":";
+    appendInteger(out, result.bytes);
+    out += ",\"letters\":";
+    appendInteger(out, result.letters);
+    out += '}';
+}
+
+const char* CipherClassifier::name(Label label) {
+    switch (label) {
+        case Label::PLAINTEXT: return "plaintext";
+        case Label::CAESAR: return "caesar";
+        case Label::SUBSTITUTION: return "substitution";
+        case Label::VIGENERE: return "vigenere";
+        case Label::MORSE: return "morse";
+        default: return "unknown";
+    }
+}
@@ -0,0 +1,243 @@
+#include "CipherExecutor.h"
+#include "IntegrityManifest.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+bool readFully(int fd, char* data, size_t size, off_t offset) {
+    while (size > 0) {
+        ssize_t n = pread(fd, data, size, offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+        offset += n;
+    }
+    return true;
+}
+
+} // namespace
+
+// The whole input and output stay in memory, as with processFile(); chunks are filled in
+// by the I/O thread and processed in place by the pool
+struct CipherExecutor::FileJob {
+    CipherAlgorithm* cipher;
+    bool isEncryption;
+    std::string inputFilename;
+    std::string outputFilename;
+    FileCallback done;
+    Digest digest;
+    std::string text;
+    std::string result;
+    std::atomic<size_t> remaining{0};  // Chunks still being processed
+    std::atomic<bool> ok{true};
+};
+
+CipherExecutor::CipherExecutor() : CipherExecutor(Options()) {}
+
+CipherExecutor::CipherExecutor(const Options& options) : options(options), pool(options.threads) {
+    ioThread = std::thread(&CipherExecutor::ioLoop, this);
+}
+
+CipherExecutor::~CipherExecutor() {
+    {
+        std::unique_lock<std::mutex> lock(idleMutex);
+        idle.wait(lock, [this]() { return outstanding.load() == 0; });
+    }
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        stopping = true;
+    }
+    ioReady.notify_one();
+    ioThread.join();
+}
+
+CipherExecutor::Stats CipherExecutor::stats() const {
+    Stats stats;
+    stats.requests = requestCount.load();
+    stats.batches = batchCount.load();
+    stats.files = fileCount.load();
+    return stats;
+}
+
+void CipherExecutor::complete(size_t count) {
+    // Taking the lock orders the notify after a destructor that saw work outstanding
+    // has started waiting
+    if (outstanding.fetch_sub(count) != count) return;
+    std::lock_guard<std::mutex> lock(idleMutex);
+    idle.notify_all();
+}
+
+void CipherExecutor::submit(CipherAlgorithm& cipher, bool isEncryption, std::string text, TextCallback done) {
+    outstanding.fetch_add(1);
+    requestCount.fetch_add(1, std::memory_order_relaxed);
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back(Request{&cipher, isEncryption, std::move(text), std::move(done)});
+        if (drains < pool.size()) {
+            ++drains;
+            schedule = true;
+        }
+    }
+    if (schedule) pool.submit([this]() { drain(); });
+}
+
+void CipherExecutor::drain() {
+    std::vector<Request> batch;
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (queue.empty()) {
+                --drains;
+                return;
+            }
+            // An even share of the backlog per drain, so one batch does not hold work
+            // that idle workers could take
+            size_t share = (queue.size() + drains - 1) / drains;
+            size_t bytes = 0;
+            while (!queue.empty() && batch.size() < share &&
+                   (batch.empty() || bytes + queue.front().text.size() <= options.batchBytes)) {
+                bytes += queue.front().text.size();
+                batch.push_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+        }
+        batchCount.fetch_add(1, std::memory_order_relaxed);
+        for (Request& request : batch) {
+            std::string result = request.isEncryption ? request.cipher->encrypt(request.text)
+                                                      : request.cipher->decrypt(request.text);
+            request.done(std::move(result));
+        }
+        complete(batch.size());
+        batch.clear();
+    }
+}
+
+void CipherExecutor::runOnIoThread(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        ioQueue.push_back(std::move(job));
+    }
+    ioReady.notify_one();
+}
+
+void CipherExecutor::ioLoop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(ioMutex);
+            ioReady.wait(lock, [this]() { return stopping || !ioQueue.empty(); });
+            if (ioQueue.empty()) return;
+            job = std::move(ioQueue.front());
+            ioQueue.pop_front();
+        }
+        job();
+    }
+}
+
+void CipherExecutor::submitFile(CipherAlgorithm& cipher, const std::string& inputFilename,
+                                const std::string& outputFilename, bool isEncryption, FileCallback done,
+                                Digest digest) {
+    outstanding.fetch_add(1);
+    fileCount.fetch_add(1, std::memory_order_relaxed);
+    auto job = std::make_shared<FileJob>();
+    job->cipher = &cipher;
+    job->isEncryption = isEncryption;
+    job->inputFilename = inputFilename;
+    job->outputFilename = outputFilename;
+    job->done = std::move(done);
+    job->digest = digest;
+    runOnIoThread([this, job]() { readFile(job); });
+}
+
+void CipherExecutor::readFile(const std::shared_ptr<FileJob>& job) {
+    CipherAlgorithm& cipher = *job->cipher;
+    int fd = open(job->inputFilename.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        std::cerr << "Error: Unable to open input file: " << job->inputFilename << std::endl;
+        if (fd >= 0) close(fd);
+        job->ok = false;
+        finishFile(job);
+        return;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    job->text.resize(size);
+    if (!cipher.preservesLength()) {
+        // The cipher has to see the input as a whole; only reading and writing move off the pool
+        bool read = readFully(fd, &job->text[0], size, 0);
+        close(fd);
+        if (!read) {
+            std::cerr << "Error: Unable to read " << job->inputFilename << std::endl;
+            job->ok = false;
+            finishFile(job);
+            return;
+        }
+        pool.submit([this, job]() {
+            CipherAlgorithm& cipher = *job->cipher;
+            // A rejected key or input (a failed AEAD tag) fails the file before anything is written
+            if (!(job->isEncryption ? cipher.tryEncrypt(job->text, job->result) : cipher.tryDecrypt(job->text, job->result))) {
+                job->ok = false;
+            }
+            runOnIoThread([this, job]() { finishFile(job); });
+        });
+        return;
+    }
+
+    size_t chunkSize = std::max<size_t>(1, options.fileChunkSize);
+    size_t chunks = std::max<size_t>(1, (size + chunkSize - 1) / chunkSize);
+    job->result.resize(size);
+    job->remaining = chunks;
+    uint64_t state = 0;
+    for (size_t i = 0; i < chunks; ++i) {
+        size_t offset = i * chunkSize;
+        size_t length = std::min(chunkSize, size - offset);
+        if (!job->ok || !readFully(fd, &job->text[offset], length, static_cast<off_t>(offset))) {
+            if (job->ok.exchange(false)) std::cerr << "Error: Unable to read " << job->inputFilename << std::endl;
+            if (job->remaining.fetch_sub(1) == 1) finishFile(job);
+            continue;
+        }
+        // Ciphertext advances the state exactly as its plaintext does, so the reader can
+        // work out every chunk's starting state either way
+        pool.submit([this, job, offset, length, state]() {
+            std::string piece = job->text.substr(offset, length);
+            std::string output = job->isEncryption ? job->cipher->encryptAt(piece, state)
+                                                   : job->cipher->decryptAt(piece, state);
+            std::memcpy(&job->result[offset], output.data(), std::min(length, output.size()));
+            if (job->remaining.fetch_sub(1) == 1) runOnIoThread([this, job]() { finishFile(job); });
+        });
+        if (cipher.hasStreamState()) state = cipher.advanceState(job->text.substr(offset, length), state);
+    }
+    close(fd);
+}
+
+void CipherExecutor::finishFile(const std::shared_ptr<FileJob>& job) {
+    bool ok = job->ok;
+    bool manifest = IntegrityManifest::appliesTo(*job->cipher);
+    if (ok && manifest && !job->isEncryption) ok = IntegrityManifest::check(*job->cipher, job->result, job->inputFilename);
+    if (ok) {
+        std::ofstream output(job->outputFilename);
+        if (!output.is_open()) {
+            std::cerr << "Error: Unable to open output file: " << job->outputFilename << std::endl;
+            ok = false;
+        } else {
+            output << job->result;
+            output.close();
+        }
+    }
+    if (ok && manifest && job->isEncryption) {
+        ok = IntegrityManifest::write(*job->cipher, job->text, job->outputFilename, job->result.size(), job->digest);
+    }
+    job->done(ok);
+    complete();
+}
@@ -0,0 +1,300 @@
+#include "CipherKernels.h"
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(ET_NO_MULTIVERSIONING)
+#include <immintrin.h>
+#define CIPHER_HAVE_X86_KERNELS 1
+#define VBMI2_TARGET __attribute__((target("avx512f,avx512bw,avx512vbmi2,popcnt")))
+#endif
+
+namespace CipherKernels {
+
+namespace {
+
+const size_t BLOCK = 64;
+
+// Rings map a byte to its index in the alphabet (SIZE or more when it is not a member)
+// and an index back to a byte. Everything is uint8_t arithmetic and selects, so the
+// loops below vectorize and no byte ever needs a division. The vector versions do the
+// same with AVX-512 masks.
+struct LetterRing {
+    static const uint8_t SIZE = 26;
+    static uint8_t index(uint8_t c) { return static_cast<uint8_t>((c | 0x20) - 'a'); }
+    static uint8_t character(uint8_t index, uint8_t c) {
+        return static_cast<uint8_t>((index + 'a') ^ ((c & 0x20) ^ 0x20));  // Case taken from c
+    }
+#ifdef CIPHER_HAVE_X86_KERNELS
+    VBMI2_TARGET static __m512i index(__m512i c) {
+        return _mm512_sub_epi8(_mm512_or_si512(c, _mm512_set1_epi8(0x20)), _mm512_set1_epi8('a'));
+    }
+    VBMI2_TARGET static __m512i character(__m512i index, __m512i c) {
+        const __m512i caseBit = _mm512_set1_epi8(0x20);
+        __m512i caseFlip = _mm512_xor_si512(_mm512_and_si512(c, caseBit), caseBit);
+        return _mm512_xor_si512(_mm512_add_epi8(index, _mm512_set1_epi8('a')), caseFlip);
+    }
+#endif
+};
+
+// 0-9 = 0-9, A-Z = 10-35, a-z = 36-61
+struct AlphanumericRing {
+    static const uint8_t SIZE = 62;
+    // Masks rather than nested selects, which GCC will not if-convert
+    static uint8_t index(uint8_t c) {
+        uint8_t digit = static_cast<uint8_t>(c - '0');
+        uint8_t upper = static_cast<uint8_t>(c - 'A');
+        uint8_t lower = static_cast<uint8_t>(c - 'a');
+        uint8_t isDigit = static_cast<uint8_t>(-(digit < 10));
+        uint8_t isUpper = static_cast<uint8_t>(-(upper < 26));
+        uint8_t isLower = static_cast<uint8_t>(-(lower < 26));
+        return static_cast<uint8_t>((digit & isDigit) | ((upper + 10) & isUpper) | ((lower + 36) & isLower) |
+                                    ~(isDigit | isUpper | isLower));
+    }
+    static uint8_t character(uint8_t index, uint8_t) {
+        // '0' + index, skipping the 7 bytes between '9' and 'A' and the 6 between 'Z' and 'a'
+        return static_cast<uint8_t>(index + '0' + (7 & -(index >= 10)) + (6 & -(index >= 36)));
+    }
+#ifdef CIPHER_HAVE_X86_KERNELS
+    VBMI2_TARGET static __m512i index(__m512i c) {
+        __m512i digit = _mm512_sub_epi8(c, _mm512_set1_epi8('0'));
+        __m512i upper = _mm512_sub_epi8(c, _mm512_set1_epi8('A'));
+        __m512i lower = _mm512_sub_epi8(c, _mm512_set1_epi8('a'));
+        __m512i result = _mm512_set1_epi8(static_cast<char>(0xFF));
+        result = _mm512_mask_mov_epi8(result, _mm512_cmplt_epu8_mask(lower, _mm512_set1_epi8(26)),
+                                      _mm512_add_epi8(lower, _mm512_set1_epi8(36)));
+        result = _mm512_mask_mov_epi8(result, _mm512_cmplt_epu8_mask(upper, _mm512_set1_epi8(26)),
+                                      _mm512_add_epi8(upper, _mm512_set1_epi8(10)));
+        return _mm512_mask_mov_epi8(result, _mm512_cmplt_epu8_mask(digit, _mm512_set1_epi8(10)), digit);
+    }
+    VBMI2_TARGET static __m512i character(__m512i index, __m512i) {
+        __m512i result = _mm512_add_epi8(index, _mm512_set1_epi8('a' - 36));
+        result = _mm512_mask_mov_epi8(result, _mm512_cmplt_epu8_mask(index, _mm512_set1_epi8(36)),
+                                      _mm512_add_epi8(index, _mm512_set1_epi8('A' - 10)));
+        return _mm512_mask_mov_epi8(result, _mm512_cmplt_epu8_mask(index, _mm512_set1_epi8(10)),
+                                    _mm512_add_epi8(index, _mm512_set1_epi8('0')));
+    }
+#endif
+};
+
+// Space (0x20) through '~' (0x7E)
+struct PrintableRing {
+    static const uint8_t SIZE = 95;
+    static uint8_t index(uint8_t c) { return static_cast<uint8_t>(c - 0x20); }
+    static uint8_t character(uint8_t index, uint8_t) { return static_cast<uint8_t>(index + 0x20); }
+#ifdef CIPHER_HAVE_X86_KERNELS
+    VBMI2_TARGET static __m512i index(__m512i c) { return _mm512_sub_epi8(c, _mm512_set1_epi8(0x20)); }
+    VBMI2_TARGET static __m512i character(__m512i index, __m512i) {
+        return _mm512_add_epi8(index, _mm512_set1_epi8(0x20));
+    }
+#endif
+};
+
+// index + shift stays below 2 * SIZE, so one conditional subtract wraps it
+template <typename Ring>
+inline void rotate(char* data, size_t size, uint8_t shift) {
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        uint8_t c = bytes[i];
+        uint8_t index = Ring::index(c);
+        uint8_t shifted = static_cast<uint8_t>(index + shift);
+        shifted = shifted >= Ring::SIZE ? static_cast<uint8_t>(shifted - Ring::SIZE) : shifted;
+        bytes[i] = index < Ring::SIZE ? Ring::character(shifted, c) : c;
+    }
+}
+
+// Counted per block into a byte-wide sum, which keeps the vector lanes narrow
+template <typename Ring>
+inline size_t countMembers(const char* data, size_t size) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    size_t members = 0;
+    size_t i = 0;
+    for (; i + 255 <= size; i += 255) {
+        uint8_t blockMembers = 0;
+        for (size_t j = 0; j < 255; ++j) blockMembers += Ring::index(bytes[i + j]) < Ring::SIZE;
+        members += blockMembers;
+    }
+    for (; i < size; ++i) members += Ring::index(bytes[i]) < Ring::SIZE;
+    return members;
+}
+
+// One byte per step; the key position only advances on members, which chains every
+// byte to the one before it
+template <typename Ring>
+size_t shiftByKeyPortable(char* data, size_t size, const uint8_t* keyStream, size_t keyLength, size_t start) {
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(data);
+    size_t position = start;
+    size_t members = 0;
+    for (size_t i = 0; i < size; ++i) {
+        uint8_t c = bytes[i];
+        uint8_t index = Ring::index(c);
+        uint8_t shifted = static_cast<uint8_t>(index + keyStream[position]);
+        shifted = shifted >= Ring::SIZE ? static_cast<uint8_t>(shifted - Ring::SIZE) : shifted;
+        bool isMember = index < Ring::SIZE;
+        bytes[i] = isMember ? Ring::character(shifted, c) : c;
+        members += isMember;
+        position += isMember;
+        position = position == keyLength ? 0 : position;
+    }
+    return members;
+}
+
+#ifdef CIPHER_HAVE_X86_KERNELS
+
+// 64 bytes per step: the member mask tells how many key bytes the block consumes, and
+// vpexpandb spreads exactly that many consecutive key bytes onto the member lanes
+template <typename Ring>
+VBMI2_TARGET size_t shiftByKeyAvx512(char* data, size_t size, const uint8_t* keyStream, size_t keyLength,
+                                     size_t start) {
+    const __m512i alphabet = _mm512_set1_epi8(static_cast<char>(Ring::SIZE));
+    size_t position = start;
+    size_t members = 0;
+
+    for (size_t i = 0; i < size; i += BLOCK) {
+        __mmask64 lanes = size - i >= BLOCK ? ~__mmask64(0) : (__mmask64(1) << (size - i)) - 1;
+        __m512i c = _mm512_maskz_loadu_epi8(lanes, data + i);
+        __m512i index = Ring::index(c);
+        __mmask64 isMember = _mm512_mask_cmplt_epu8_mask(lanes, index, alphabet);
+        if (isMember == 0) continue;
+
+        __m512i shifts = _mm512_maskz_expandloadu_epi8(isMember, keyStream + position);
+        __m512i shifted = _mm512_add_epi8(index, shifts);
+        shifted = _mm512_min_epu8(shifted, _mm512_sub_epi8(shifted, alphabet));  // Wrapped lanes go huge
+        _mm512_mask_storeu_epi8(data + i, isMember, Ring::character(shifted, c));
+
+        size_t count = static_cast<size_t>(_mm_popcnt_u64(isMember));
+        members += count;
+        position = (position + count) % keyLength;
+    }
+    return members;
+}
+
+bool cpuHasAvx512Vbmi2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vbmi2");
+}
+
+#endif
+
+template <typename Ring>
+size_t shiftByKey(char* data, size_t size, const uint8_t* keyStream, size_t keyLength, size_t start) {
+#ifdef CIPHER_HAVE_X86_KERNELS
+    static const bool hasVbmi2 = cpuHasAvx512Vbmi2();
+    if (hasVbmi2) return shiftByKeyAvx512<Ring>(data, size, keyStream, keyLength, start);
+#endif
+    return shiftByKeyPortable<Ring>(data, size, keyStream, keyLength, start);
+}
+
+CIPHER_KERNEL
+void rotateAlphanumeric(char* data, size_t size, uint8_t shift) {
+    rotate<AlphanumericRing>(data, size, shift);
+}
+
+CIPHER_KERNEL
+void rotatePrintable(char* data, size_t size, uint8_t shift) {
+    rotate<PrintableRing>(data, size, shift);
+}
+
+CIPHER_KERNEL
+void addBytes(char* data, size_t size, uint8_t shift) {
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) bytes[i] = static_cast<uint8_t>(bytes[i] + shift);
+}
+
+// Every byte advances the key, so positions are known up front; the key stream's 64
+// repeated entries let each block read 64 consecutive shifts without wrapping
+CIPHER_KERNEL
+size_t addKeyBytes(char* data, size_t size, const uint8_t* keyStream, size_t keyLength, size_t start) {
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(data);
+    size_t position = start;
+    for (size_t i = 0; i < size; i += BLOCK) {
+        size_t run = std::min(BLOCK, size - i);
+        const uint8_t* shifts = keyStream + position;
+        for (size_t j = 0; j < run; ++j) bytes[i + j] = static_cast<uint8_t>(bytes[i + j] + shifts[j]);
+        position = (position + run) % keyLength;
+    }
+    return size;
+}
+
+CIPHER_KERNEL
+size_t countAlphanumeric(const char* data, size_t size) {
+    return countMembers<AlphanumericRing>(data, size);
+}
+
+CIPHER_KERNEL
+size_t countPrintable(const char* data, size_t size) {
+    return countMembers<PrintableRing>(data, size);
+}
+
+} // namespace
+
+// Written branch-free (select instead of if) so every clone auto-vectorizes
+CIPHER_KERNEL
+void shiftLetters(char* data, size_t size, int shift) {
+    rotate<LetterRing>(data, size, static_cast<uint8_t>(shift));
+}
+
+size_t shiftLettersByKey(char* data, size_t size, const uint8_t* keyStream, size_t keyLength, size_t start) {
+    return shiftByKey<LetterRing>(data, size, keyStream, keyLength, start);
+}
+
+CIPHER_KERNEL
+size_t countLetters(const char* data, size_t size) {
+    return countMembers<LetterRing>(data, size);
+}
+
+void shiftAlphabet(Alphabet alphabet, char* data, size_t size, int shift) {
+    uint8_t amount = static_cast<uint8_t>(shift);
+    switch (alphabet) {
+        case Alphabet::ALPHANUMERIC: rotateAlphanumeric(data, size, amount); break;
+        case Alphabet::PRINTABLE: rotatePrintable(data, size, amount); break;
+        case Alphabet::BYTES: addBytes(data, size, amount); break;
+        default: shiftLetters(data, size, shift); break;
+    }
+}
+
+size_t shiftAlphabetByKey(Alphabet alphabet, char* data, size_t size, const uint8_t* keyStream, size_t keyLength,
+                          size_t start) {
+    switch (alphabet) {
+        case Alphabet::ALPHANUMERIC: return shiftByKey<AlphanumericRing>(data, size, keyStream, keyLength, start);
+        case Alphabet::PRINTABLE: return shiftByKey<PrintableRing>(data, size, keyStream, keyLength, start);
+        case Alphabet::BYTES: return addKeyBytes(data, size, keyStream, keyLength, start);
+        default: return shiftLettersByKey(data, size, keyStream, keyLength, start);
+    }
+}
+
+size_t countAlphabet(Alphabet alphabet, const char* data, size_t size) {
+    switch (alphabet) {
+        case Alphabet::ALPHANUMERIC: return countAlphanumeric(data, size);
+        case Alphabet::PRINTABLE: return countPrintable(data, size);
+        case Alphabet::BYTES: return size;
+        default: return countLetters(data, size);
+    }
+}
+
+// A block is tested with one OR-reduction; the scalar scan only runs inside the block
+// that holds the first high byte
+CIPHER_KERNEL
+size_t asciiPrefixLength(const char* data, size_t size) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    size_t i = 0;
+    for (; i + BLOCK <= size; i += BLOCK) {
+        uint8_t any = 0;
+        for (size_t j = 0; j < BLOCK; ++j) any |= bytes[i + j];
+        if (any & 0x80) break;
+    }
+    while (i < size && bytes[i] < 0x80) ++i;
+    return i;
+}
+
+const char* activeIsa() {
+#if defined(__GNUC__) && defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw")) return "avx512bw";
+    if (__builtin_cpu_supports("avx2")) return "avx2";
+    return "sse2";
+#else
+    return "generic";
+#endif
+}
+
+} // namespace CipherKernels
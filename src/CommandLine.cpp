@@ -0,0 +1,351 @@
+#include "CommandLine.h"
+#include "AeadCipher.h"
+#include "ArmoredCipher.h"
+#include "CaesarCipher.h"
+#include "ChunkedContainer.h"
+#include "CipherClassifier.h"
+#include "CompressedCipher.h"
+#include "DirectoryProcessor.h"
+#include "IntegrityManifest.h"
+#include "MorseCodeCipher.h"
+#include "PasswordManager.h"
+#include "PipeProcessor.h"
+#include "ROT13Cipher.h"
+#include "SecureMemory.h"
+#include "SubstitutionCipher.h"
+#include "VigenereCipher.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cerr << "Usage:\n"
+              << "  " << program << " container-encrypt <algorithm> <input> <container> [chunk-bytes]\n"
+              << "  " << program << " container-decrypt <algorithm> <container> <output>\n"
+              << "  " << program << " container-range <algorithm> <container> <offset> <length> [output]\n"
+              << "  " << program << " container-info <container>\n"
+              << "  " << program << " encrypt-file <algorithm> <input> <output> [crc32c|xxh3]\n"
+              << "  " << program << " decrypt-file <algorithm> <input> <output>\n"
+              << "  " << program << " verify <algorithm> <file> [threads]   (checks <file>.sum, writes nothing)\n"
+              << "  " << program << " encrypt-dir <algorithm> <input-dir> <output-dir> [threads]\n"
+              << "  " << program << " decrypt-dir <algorithm> <input-dir> <output-dir> [threads]\n"
+              << "  " << program << " pipe-encrypt <algorithm> [--zero-copy]   (standard input to standard output)\n"
+              << "  " << program << " pipe-decrypt <algorithm> [--zero-copy]\n"
+              << "  " << program << " vault-diff <vault> <other-vault>   (+ only in other, - only in vault, ~ changed)\n"
+              << "  " << program << " vault-sync <source-vault> <replica-vault> [--force]\n"
+              << "  " << program << " vault-protect <vault> [memory-MiB] [passes] [lanes]   (default 64 3 4)\n"
+              << "  " << program << " classify <file-or-dir> [threads]   (a JSON line per line of the file, or per file)\n"
+              << "Algorithms: caesar, vigenere, substitution, morse, morse-binary, rot13, chacha20-poly1305\n"
+              << "  caesar and vigenere also take an alphabet suffix: -alnum, -printable, -bytes\n"
+              << "  stages are appended in order: +lz compresses before encrypting, +hex or +base64 writes\n"
+              << "  the output as text (e.g. vigenere-bytes+lz+base64)\n"
+              << "A vault is a password file, or a directory of shard files (an existing one or a path ending in '/').\n"
+              << "vault-sync refuses to empty a replica that has records unless --force is given.\n"
+              << "The key comes from ET_KEY or the first line of standard input (pipe modes: ET_KEY only).\n"
+              << "vault-protect reads the current master password (if the vault has one), then the new one,\n"
+              << "  one per line from standard input.\n";
+}
+
+std::unique_ptr<CipherAlgorithm> createCipher(const std::string& name) {
+    // Each "+stage" suffix wraps everything to its left
+    size_t plus = name.rfind('+');
+    if (plus != std::string::npos) {
+        std::string stage = name.substr(plus + 1);
+        Armor armor = Armor::NONE;
+        if (stage != "lz" && !TextArmor::parse(stage, armor)) {
+            std::cerr << "Error: Unknown stage: " << stage << std::endl;
+            return nullptr;
+        }
+        std::unique_ptr<CipherAlgorithm> inner = createCipher(name.substr(0, plus));
+        if (!inner) return nullptr;
+        // Compressed bytes are binary, so the cipher under them must reproduce any input
+        if (stage == "lz" && !inner->isLossless()) {
+            std::cerr << "Error: " << inner->getName() << " cannot carry compressed data (it is not lossless)."
+                      << std::endl;
+            return nullptr;
+        }
+        if (stage == "lz") return std::make_unique<CompressedCipher>(std::move(inner));
+        return std::make_unique<ArmoredCipher>(std::move(inner), armor);
+    }
+
+    std::vector<std::unique_ptr<CipherAlgorithm>> ciphers;
+    for (int i = 0; i < ALPHABET_COUNT; ++i) {
+        ciphers.push_back(std::make_unique<CaesarCipher>(static_cast<Alphabet>(i)));
+        ciphers.push_back(std::make_unique<VigenereCipher>(static_cast<Alphabet>(i)));
+    }
+    ciphers.push_back(std::make_unique<SubstitutionCipher>());
+    ciphers.push_back(std::make_unique<MorseCodeCipher>());
+    ciphers.push_back(std::make_unique<MorseCodeCipher>(MorseFormat::BINARY));
+    ciphers.push_back(std::make_unique<ROT13Cipher>());
+    ciphers.push_back(std::make_unique<AeadCipher>());
+
+    for (auto& cipher : ciphers) {
+        if (name == cipher->getName()) return std::move(cipher);
+    }
+    std::cerr << "Error: Unknown algorithm: " << name << std::endl;
+    return nullptr;
+}
+
+std::unique_ptr<CipherAlgorithm> createKeyedCipher(const std::string& name) {
+    std::unique_ptr<CipherAlgorithm> cipher = createCipher(name);
+    if (!cipher) return nullptr;
+
+    // Read into locked memory that is wiped on release, including the buffers getline()
+    // outgrows; compileKey() gets one exactly sized copy, wiped once the schedule is built
+    SecureString key;
+    key.reserve(SECURE_STRING_MINIMUM);
+    if (const char* environmentKey = std::getenv("ET_KEY")) {
+        key = environmentKey;
+    } else {
+        std::cerr << "Enter key: ";
+        std::getline(std::cin, key);
+    }
+    std::string plainKey(key.data(), key.size());
+    // Falling back to the cipher's default key would leave the data readable by anyone
+    std::shared_ptr<const KeySchedule> schedule = cipher->compileKey(plainKey);
+    SecureMemory::wipe(plainKey);
+    if (!schedule) {
+        std::cerr << "Error: Invalid key for " << cipher->getName() << "." << std::endl;
+        return nullptr;
+    }
+    cipher->applySchedule(schedule);
+    return cipher;
+}
+
+bool openedVault(const PasswordManager& vault, const std::string& path) {
+    if (!vault.exists()) std::cerr << "Error: Unable to read vault: " << path << std::endl;
+    return vault.exists();
+}
+
+bool parseNumber(const std::string& text, uint64_t& value) {
+    try {
+        size_t used = 0;
+        value = std::stoull(text, &used);
+        return used == text.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+} // namespace
+
+int CommandLine::run(int argc, char* argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    const std::string command = args.empty() ? "" : args[0];
+
+    if (command == "container-encrypt" && (args.size() == 4 || args.size() == 5)) {
+        uint64_t chunkSize = ChunkedContainer::DEFAULT_CHUNK_SIZE;
+        if (args.size() == 5 && (!parseNumber(args[4], chunkSize) || chunkSize == 0)) {
+            std::cerr << "Error: Invalid chunk size: " << args[4] << std::endl;
+            return 1;
+        }
+        auto cipher = createKeyedCipher(args[1]);
+        return cipher && ChunkedContainer::encryptFile(*cipher, args[2], args[3], chunkSize) ? 0 : 1;
+    }
+
+    if (command == "container-decrypt" && args.size() == 4) {
+        auto cipher = createKeyedCipher(args[1]);
+        return cipher && ChunkedContainer::decryptFile(*cipher, args[2], args[3]) ? 0 : 1;
+    }
+
+    if (command == "container-range" && (args.size() == 5 || args.size() == 6)) {
+        uint64_t offset, length;
+        if (!parseNumber(args[3], offset) || !parseNumber(args[4], length)) {
+            std::cerr << "Error: Offset and length must be byte counts." << std::endl;
+            return 1;
+        }
+        auto cipher = createKeyedCipher(args[1]);
+        std::string plaintext;
+        if (!cipher || !ChunkedContainer::decryptRange(*cipher, args[2], offset, length, plaintext)) return 1;
+
+        if (args.size() == 5) {
+            std::cout << plaintext;
+            return std::cout ? 0 : 1;
+        }
+        std::ofstream output(args[5], std::ios::binary);
+        if (!output.is_open()) {
+            std::cerr << "Error: Unable to open output file: " << args[5] << std::endl;
+            return 1;
+        }
+        output << plaintext;
+        return output ? 0 : 1;
+    }
+
+    if (command == "container-info" && args.size() == 2) {
+        ChunkedContainer::Info info;
+        if (!ChunkedContainer::readInfo(args[1], info)) return 1;
+        std::cout << "Algorithm:      " << info.algorithm << "\n"
+                  << "Chunk size:     " << info.chunkSize << " bytes\n"
+                  << "Chunks:         " << info.chunkCount << "\n"
+                  << "Plaintext size: " << info.plaintextSize << " bytes\n";
+        return 0;
+    }
+
+    if ((command == "encrypt-file" && (args.size() == 4 || args.size() == 5)) ||
+        (command == "decrypt-file" && args.size() == 4)) {
+        Digest digest = Digest::CRC32C;
+        if (args.size() == 5 && !Checksum::parse(args[4], digest)) {
+            std::cerr << "Error: Unknown checksum: " << args[4] << std::endl;
+            return 1;
+        }
+        auto cipher = createKeyedCipher(args[1]);
+        return cipher && cipher->processFile(args[2], args[3], command == "encrypt-file", digest) ? 0 : 1;
+    }
+
+    if (command == "verify" && (args.size() == 3 || args.size() == 4)) {
+        uint64_t threads = 0;
+        if (args.size() == 4 && (!parseNumber(args[3], threads) || threads > 1024)) {
+            std::cerr << "Error: Invalid thread count: " << args[3] << std::endl;
+            return 1;
+        }
+        auto cipher = createKeyedCipher(args[1]);
+        if (!cipher) return 1;
+        IntegrityManifest::Report report = IntegrityManifest::verify(*cipher, args[2], static_cast<unsigned>(threads));
+        if (report.threads == 0) return 1;  // Nothing was checked; the reason is already printed
+        std::cerr << report.chunks << " chunks, " << report.bytes << " bytes in " << report.seconds << " s ("
+                  << (report.seconds > 0 ? report.bytes / report.seconds / 1e6 : 0.0) << " MB/s, " << report.threads
+                  << " threads)\n";
+        if (report.badChunks > 0) {
+            std::cerr << "Error: " << report.badChunks << " of " << report.chunks
+                      << " chunks do not match their checksums, the first at byte " << report.firstBadOffset
+                      << " (wrong key or damaged file)." << std::endl;
+        }
+        return report.ok ? 0 : 1;
+    }
+
+    if ((command == "encrypt-dir" || command == "decrypt-dir") && (args.size() == 4 || args.size() == 5)) {
+        DirectoryProcessor::Options options;
+        uint64_t threads = 0;
+        if (args.size() == 5 && (!parseNumber(args[4], threads) || threads > 1024)) {
+            std::cerr << "Error: Invalid thread count: " << args[4] << std::endl;
+            return 1;
+        }
+        options.threads = static_cast<unsigned>(threads);
+
+        auto cipher = createKeyedCipher(args[1]);
+        if (!cipher) return 1;
+        DirectoryProcessor::Report report =
+            DirectoryProcessor::process(*cipher, args[2], args[3], command == "encrypt-dir", options);
+        std::cerr << report.files << " files, " << report.bytes << " bytes in " << report.seconds << " s ("
+                  << report.threads << " threads, " << report.chunkTasks << " chunk tasks, " << report.steals
+                  << " steals); " << report.skipped << " already done, " << report.failed << " failed\n";
+        return report.failed == 0 ? 0 : 1;
+    }
+
+    if (command == "classify" && (args.size() == 2 || args.size() == 3)) {
+        CipherClassifier::Options options;
+        uint64_t threads = 0;
+        if (args.size() == 3 && (!parseNumber(args[2], threads) || threads > 1024)) {
+            std::cerr << "Error: Invalid thread count: " << args[2] << std::endl;
+            return 1;
+        }
+        options.threads = static_cast<unsigned>(threads);
+
+        CipherClassifier::Report report = CipherClassifier::classifyPath(args[1], std::cout, options);
+        if (report.threads == 0) return 1;  // Nothing was read; the reason is already printed
+        std::cerr << report.records << " records, " << report.bytes << " bytes in " << report.seconds << " s ("
+                  << (report.seconds > 0 ? report.bytes / report.seconds / 1e6 : 0.0) << " MB/s, " << report.threads
+                  << " threads):";
+        for (int label = 0; label <= static_cast<int>(CipherClassifier::Label::UNKNOWN); ++label) {
+            std::cerr << (label ? ", " : " ") << CipherClassifier::name(static_cast<CipherClassifier::Label>(label))
+                      << " " << report.counts[label];
+        }
+        std::cerr << "; " << report.failed << " failed\n";
+        return report.failed == 0 ? 0 : 1;
+    }
+
+    if ((command == "pipe-encrypt" || command == "pipe-decrypt") &&
+        (args.size() == 2 || (args.size() == 3 && args[2] == "--zero-copy"))) {
+        // Standard input is the data here, so it cannot also supply the key
+        if (!std::getenv("ET_KEY")) {
+            std::cerr << "Error: Pipe mode reads the key from ET_KEY." << std::endl;
+            return 1;
+        }
+        PipeProcessor::Options options;
+        options.zeroCopy = args.size() == 3;
+
+        auto cipher = createKeyedCipher(args[1]);
+        if (!cipher) return 1;
+        PipeProcessor::Report report =
+            PipeProcessor::run(*cipher, command == "pipe-encrypt", STDIN_FILENO, STDOUT_FILENO, options);
+        std::cerr << report.bytesIn << " bytes in " << report.seconds << " s ("
+                  << (report.seconds > 0 ? report.bytesIn / report.seconds / 1e6 : 0.0) << " MB/s, " << report.mode
+                  << ")";
+        std::string mode = report.mode;
+        if (mode == "vmsplice" || mode == "write") {  // The three-stage pipeline
+            std::cerr << "; busy: read " << static_cast<int>(report.readBusy * 100) << "%, cipher "
+                      << static_cast<int>(report.cipherBusy * 100) << "%, write "
+                      << static_cast<int>(report.writeBusy * 100) << "%";
+        }
+        std::cerr << "\n";
+        return report.ok ? 0 : 1;
+    }
+
+    if (command == "vault-diff" && args.size() == 3) {
+        PasswordManager vault(args[1], PasswordManager::Access::READ_ONLY);
+        PasswordManager other(args[2], PasswordManager::Access::READ_ONLY);
+        if (!openedVault(vault, args[1]) || !openedVault(other, args[2])) return 2;
+        std::vector<PasswordManager::Difference> differences = vault.diff(other);
+        for (const PasswordManager::Difference& difference : differences) {
+            char mark = difference.change == PasswordManager::Change::ADDED     ? '+'
+                        : difference.change == PasswordManager::Change::REMOVED ? '-'
+                                                                                 : '~';
+            std::cout << mark << ' ' << difference.service << '\n';
+        }
+        return differences.empty() ? 0 : 1;
+    }
+    
+    if (command == "vault-sync" && (args.size() == 3 || (args.size() == 4 && args[3] == "--force"))) {
+        PasswordManager source(args[1], PasswordManager::Access::READ_ONLY);
+        if (!openedVault(source, args[1])) return 1;
+        PasswordManager replica(args[2]);
+        if (source.size() == 0 && replica.size() > 0 && args.size() == 3) {
+            std::cerr << "Error: " << args[1] << " is empty; syncing would remove all " << replica.size()
+                      << " records from " << args[2] << ". Use --force to sync anyway." << std::endl;
+            return 1;
+        }
+        PasswordManager::SyncReport report = source.syncTo(replica);
+        std::cerr << report.recordsSent << " records sent, " << report.recordsRemoved << " removed; "
+                  << report.bucketsDiffering << " buckets differed, " << report.nodesCompared
+                  << " tree nodes compared\n";
+        return 0;  // The replica is saved when it goes out of scope
+    }
+
+    if (command == "vault-protect" && args.size() >= 2 && args.size() <= 5) {
+        KeyDerivation::Params params;
+        uint64_t values[3] = {params.memoryKiB / 1024, params.passes, params.lanes};
+        for (size_t i = 2; i < args.size(); ++i) {
+            if (!parseNumber(args[i], values[i - 2]) || values[i - 2] == 0 || values[i - 2] > UINT32_MAX / 1024) {
+                std::cerr << "Error: Invalid number: " << args[i] << std::endl;
+                return 2;
+            }
+        }
+        params.memoryKiB = static_cast<uint32_t>(values[0] * 1024);
+        params.passes = static_cast<uint32_t>(values[1]);
+        params.lanes = static_cast<uint32_t>(values[2]);
+        
+        PasswordManager vault(args[1]);
+        std::string current, next;
+        if (vault.isProtected()) {
+            std::cerr << "Current master password: ";
+            std::getline(std::cin, current);
+            bool unlocked = vault.unlock(current);
+            SecureMemory::wipe(current);
+            if (!unlocked) return 1;
+        }
+        std::cerr << "New master password: ";
+        std::getline(std::cin, next);
+        bool ok = vault.protect(next, params);
+        SecureMemory::wipe(next);
+        return ok ? 0 : 1;
+    }
+
+    printUsage(argv[0]);
+    return 2;
+}
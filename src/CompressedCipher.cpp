@@ -0,0 +1,55 @@
+#include "CompressedCipher.h"
+#include <iostream>
+#include <utility>
+
+CompressedCipher::CompressedCipher(std::unique_ptr<CipherAlgorithm> inner)
+    : inner(std::move(inner)), name(internName(std::string(this->inner->getName()) + "+lz")) {}
+
+std::string CompressedCipher::processText(const std::string& text, bool isEncryption) {
+    std::string result;
+    processChecked(text, isEncryption, result);
+    return result;
+}
+
+bool CompressedCipher::processChecked(const std::string& text, bool isEncryption, std::string& result) {
+    if (isEncryption) return inner->tryEncrypt(BlockCompression::compress(text), result);
+    std::string compressed;
+    if (!inner->tryDecrypt(text, compressed)) return false;
+    if (!BlockCompression::decompress(compressed, result)) {
+        std::cerr << "Error: Decrypted data is not valid compressed data (wrong key or algorithm?)." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<const KeySchedule> CompressedCipher::compileKey(const std::string& key) const {
+    return inner->compileKey(key);
+}
+
+void CompressedCipher::applySchedule(const std::shared_ptr<const KeySchedule>& schedule) {
+    inner->applySchedule(schedule);
+}
+
+bool CompressedCipher::isLossless() const {
+    return inner->isLossless();
+}
+
+bool CompressedCipher::isAuthenticated() const {
+    return inner->isAuthenticated();
+}
+
+uint64_t CompressedCipher::keyFingerprint() {
+    return inner->keyFingerprint();
+}
+
+const char* CompressedCipher::getName() const {
+    return name;
+}
+
+std::string CompressedCipher::getDescription() const {
+    return inner->getDescription() + " Plaintext is compressed first.";
+}
+
+std::string CompressedCipher::getKeyInstructions() const {
+    return inner->getKeyInstructions();
+}
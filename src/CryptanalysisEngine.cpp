@@ -0,0 +1,427 @@
+#include "CryptanalysisEngine.h"
+#include "EnglishStatistics.h"
+#include "CaesarCipher.h"
+#include "SubstitutionCipher.h"
+#include "VigenereCipher.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const size_t QUADGRAM_TABLE_SIZE = 26 * 26 * 26 * 26;
+
+// Longer ciphertexts don't make the search more accurate, only slower
+const size_t SEARCH_SAMPLE_LETTERS = 3000;
+
+const int CLIMB_PATIENCE = 1500;
+
+// Period estimation only needs a prefix; column solving always uses the full text
+const size_t PERIOD_SAMPLE_LETTERS = 200000;
+const size_t KASISKI_SAMPLE_LETTERS = 20000;
+const size_t MIN_COLUMN_LETTERS = 10;
+
+// A period whose IC reaches this fraction of the best one is preferred if it is
+// shorter, since every multiple of the true period scores just as well
+const double PERIOD_IC_TOLERANCE = 0.9;
+
+// Flat 26^4 table of log10 probabilities, indexed ((a*26+b)*26+c)*26+d
+const std::vector<float>& quadgramTable() {
+    static const std::vector<float> table = [] {
+        const double total = static_cast<double>(ENGLISH_QUADGRAM_TOTAL);
+        std::vector<float> t(QUADGRAM_TABLE_SIZE, static_cast<float>(std::log10(0.01 / total)));
+        for (size_t i = 0; i < ENGLISH_QUADGRAM_COUNT; ++i) {
+            const char* g = ENGLISH_QUADGRAMS[i].gram;
+            size_t index = (((g[0] - 'A') * 26 + (g[1] - 'A')) * 26 + (g[2] - 'A')) * 26 + (g[3] - 'A');
+            t[index] = static_cast<float>(std::log10(ENGLISH_QUADGRAMS[i].count / total));
+        }
+        return t;
+    }();
+    return table;
+}
+
+std::vector<uint8_t> letterIndices(const std::string& text, size_t limit) {
+    std::vector<uint8_t> letters;
+    letters.reserve(std::min(text.size(), limit));
+    for (char c : text) {
+        unsigned char lower = static_cast<unsigned char>(c) | 0x20;
+        if (lower >= 'a' && lower <= 'z') {
+            letters.push_back(static_cast<uint8_t>(lower - 'a'));
+            if (letters.size() == limit) break;
+        }
+    }
+    return letters;
+}
+
+double scoreLetters(const std::vector<uint8_t>& letters, const uint8_t* mapping, const float* table) {
+    if (letters.size() < 4) return 0.0;
+
+    uint32_t index = (mapping[letters[0]] * 26 + mapping[letters[1]]) * 26 + mapping[letters[2]];
+    double score = 0.0;
+    for (size_t i = 3; i < letters.size(); ++i) {
+        index = (index % (26 * 26 * 26)) * 26 + mapping[letters[i]];
+        score += table[index];
+    }
+    return score;
+}
+
+struct Candidate {
+    std::array<uint8_t, 26> mapping;  // Ciphertext letter -> plaintext letter
+    double score;
+};
+
+void keepTop(std::vector<Candidate>& top, const Candidate& candidate, size_t keepBest) {
+    for (const auto& existing : top) {
+        if (existing.mapping == candidate.mapping) return;
+    }
+    top.push_back(candidate);
+    // Ties are broken by mapping, so the result does not depend on which thread found what
+    std::sort(top.begin(), top.end(), [](const Candidate& a, const Candidate& b) {
+        return a.score > b.score || (a.score == b.score && a.mapping < b.mapping);
+    });
+    if (top.size() > keepBest) top.resize(keepBest);
+}
+
+// Random-swap hill climbing; a climb ends after enough consecutive swaps fail to improve
+Candidate climb(const std::vector<uint8_t>& letters, std::mt19937& rng, const float* table,
+                unsigned long long& keysTried) {
+    Candidate current;
+    for (uint8_t i = 0; i < 26; ++i) current.mapping[i] = i;
+    std::shuffle(current.mapping.begin(), current.mapping.end(), rng);
+    current.score = scoreLetters(letters, current.mapping.data(), table);
+
+    std::uniform_int_distribution<int> pick(0, 25);
+    int failures = 0;
+    while (failures < CLIMB_PATIENCE) {
+        int i = pick(rng);
+        int j = pick(rng);
+        if (i == j) continue;
+
+        std::swap(current.mapping[i], current.mapping[j]);
+        double score = scoreLetters(letters, current.mapping.data(), table);
+        ++keysTried;
+        if (score > current.score) {
+            current.score = score;
+            failures = 0;
+        } else {
+            std::swap(current.mapping[i], current.mapping[j]);
+            ++failures;
+        }
+    }
+    return current;
+}
+
+double indexOfCoincidence(const std::vector<uint8_t>& letters, size_t period) {
+    std::vector<uint32_t> counts(period * 26, 0);
+    for (size_t i = 0; i < letters.size(); ++i) {
+        ++counts[(i % period) * 26 + letters[i]];
+    }
+
+    double total = 0.0;
+    for (size_t column = 0; column < period; ++column) {
+        const uint32_t* columnCounts = &counts[column * 26];
+        double length = 0.0, pairs = 0.0;
+        for (int letter = 0; letter < 26; ++letter) {
+            length += columnCounts[letter];
+            pairs += static_cast<double>(columnCounts[letter]) * (columnCounts[letter] - 1.0);
+        }
+        total += length > 1 ? pairs / (length * (length - 1)) : 0.0;
+    }
+    return total / period;
+}
+
+// Chi-squared against English for all 26 shifts at once; branch-free so it vectorizes
+void chiSquaredAllShifts(const uint64_t* counts, double* out) {
+    double total = 0.0;
+    for (int letter = 0; letter < 26; ++letter) total += counts[letter];
+
+    double expected[26], inverseExpected[26], observed[52];
+    for (int letter = 0; letter < 26; ++letter) {
+        expected[letter] = total * ENGLISH_LETTER_FREQUENCIES[letter];
+        inverseExpected[letter] = expected[letter] > 0 ? 1.0 / expected[letter] : 0.0;
+        observed[letter] = observed[letter + 26] = static_cast<double>(counts[letter]);
+    }
+
+    for (int shift = 0; shift < 26; ++shift) {
+        const double* rotated = observed + shift;
+        double chi = 0.0;
+        for (int letter = 0; letter < 26; ++letter) {
+            double difference = rotated[letter] - expected[letter];
+            chi += difference * difference * inverseExpected[letter];
+        }
+        out[shift] = chi;
+    }
+}
+
+} // namespace
+
+std::array<uint64_t, 26> CryptanalysisEngine::letterHistogram(const std::string& text) {
+    // Four interleaved tables keep back-to-back increments of the same letter independent
+    uint64_t counts[4][26] = {};
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(text.data());
+    size_t size = text.size();
+    size_t i = 0;
+
+#ifdef __SSE2__
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    const __m128i lowerA = _mm_set1_epi8('a');
+    const __m128i maxIndex = _mm_set1_epi8(25);
+    alignas(16) uint8_t indices[16];
+
+    for (; i + 16 <= size; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i index = _mm_sub_epi8(_mm_or_si128(block, caseBit), lowerA);
+        __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(index, maxIndex), index);
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(isLetter));
+        if (mask == 0) continue;
+
+        _mm_store_si128(reinterpret_cast<__m128i*>(indices), index);
+        if (mask == 0xFFFF) {
+            for (int k = 0; k < 16; k += 4) {
+                ++counts[0][indices[k]];
+                ++counts[1][indices[k + 1]];
+                ++counts[2][indices[k + 2]];
+                ++counts[3][indices[k + 3]];
+            }
+        } else {
+            while (mask) {
+                int k = __builtin_ctz(mask);
+                ++counts[k & 3][indices[k]];
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif
+
+    for (; i < size; ++i) {
+        unsigned char index = static_cast<unsigned char>((data[i] | 0x20) - 'a');
+        if (index < 26) ++counts[i & 3][index];
+    }
+
+    std::array<uint64_t, 26> result{};
+    for (int letter = 0; letter < 26; ++letter) {
+        result[letter] = counts[0][letter] + counts[1][letter] + counts[2][letter] + counts[3][letter];
+    }
+    return result;
+}
+
+double CryptanalysisEngine::chiSquared(const std::array<uint64_t, 26>& counts, int shift) {
+    uint64_t total = 0;
+    for (uint64_t count : counts) total += count;
+    if (total == 0) return 0.0;
+
+    double chi = 0.0;
+    for (int plain = 0; plain < 26; ++plain) {
+        double expected = total * ENGLISH_LETTER_FREQUENCIES[plain];
+        double observed = static_cast<double>(counts[(plain + shift) % 26]);
+        chi += (observed - expected) * (observed - expected) / expected;
+    }
+    return chi;
+}
+
+std::vector<CryptanalysisEngine::CaesarResult> CryptanalysisEngine::rankCaesarShifts(const std::string& ciphertext) {
+    std::array<uint64_t, 26> counts = letterHistogram(ciphertext);
+
+    std::vector<CaesarResult> results;
+    for (int shift = 0; shift < 26; ++shift) {
+        results.push_back({shift, chiSquared(counts, shift), ""});
+    }
+    std::sort(results.begin(), results.end(),
+              [](const CaesarResult& a, const CaesarResult& b) { return a.chiSquared < b.chiSquared; });
+    return results;
+}
+
+CryptanalysisEngine::CaesarResult CryptanalysisEngine::breakCaesar(const std::string& ciphertext) {
+    CaesarResult best = rankCaesarShifts(ciphertext).front();
+
+    CaesarCipher cipher;
+    cipher.setKey(std::to_string(best.shift));
+    best.plaintext = cipher.decrypt(ciphertext);
+    return best;
+}
+
+CryptanalysisEngine::SubstitutionReport CryptanalysisEngine::breakSubstitution(const std::string& ciphertext,
+                                                                               unsigned int restarts,
+                                                                               size_t keepBest,
+                                                                               unsigned int seed) {
+    SubstitutionReport report;
+    std::vector<uint8_t> letters = letterIndices(ciphertext, SEARCH_SAMPLE_LETTERS);
+    if (letters.size() < 4 || keepBest == 0) return report;
+
+    unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (restarts == 0) restarts = std::max(16u, hardwareThreads * 4);
+    unsigned int threadCount = std::min(hardwareThreads, restarts);
+
+    const float* table = quadgramTable().data();
+    std::atomic<unsigned int> nextRestart(0);
+    std::atomic<unsigned long long> keysTried(0);
+    std::mutex resultsMutex;
+    std::vector<Candidate> top;
+    if (seed == 0) seed = std::random_device{}();
+
+    auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&]() {
+        std::vector<Candidate> localTop;
+        unsigned long long localKeys = 0;
+        unsigned int restart;
+        while ((restart = nextRestart.fetch_add(1)) < restarts) {
+            std::mt19937 rng(seed + restart * 7919u);
+            keepTop(localTop, climb(letters, rng, table, localKeys), keepBest);
+        }
+        keysTried += localKeys;
+
+        std::lock_guard<std::mutex> lock(resultsMutex);
+        for (const auto& candidate : localTop) keepTop(top, candidate, keepBest);
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < threadCount; ++t) threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads) thread.join();
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    report.keysTried = keysTried.load();
+    report.keysPerSecond = report.seconds > 0 ? report.keysTried / report.seconds : 0.0;
+    report.threadsUsed = threadCount;
+
+    for (const auto& candidate : top) {
+        std::string key(26, 'A');
+        for (int cipherLetter = 0; cipherLetter < 26; ++cipherLetter) {
+            key[candidate.mapping[cipherLetter]] = static_cast<char>('A' + cipherLetter);
+        }
+
+        SubstitutionCipher cipher;
+        cipher.setKey(key);
+        report.bestKeys.push_back({key, candidate.score, cipher.decrypt(ciphertext)});
+    }
+    return report;
+}
+
+double CryptanalysisEngine::englishScore(const std::string& text) {
+    std::vector<uint8_t> letters = letterIndices(text, text.size());
+    if (letters.size() < 4) return 0.0;
+
+    uint8_t identity[26];
+    for (uint8_t i = 0; i < 26; ++i) identity[i] = i;
+    return scoreLetters(letters, identity, quadgramTable().data()) / (letters.size() - 3);
+}
+
+std::vector<CryptanalysisEngine::PeriodCandidate> CryptanalysisEngine::estimateVigenerePeriods(
+        const std::string& ciphertext, size_t maxPeriod) {
+    std::vector<uint8_t> letters = letterIndices(ciphertext, PERIOD_SAMPLE_LETTERS);
+    // Columns shorter than this have meaningless ICs
+    maxPeriod = std::min(maxPeriod, letters.size() / MIN_COLUMN_LETTERS);
+
+    std::vector<PeriodCandidate> candidates;
+    for (size_t period = 1; period <= maxPeriod; ++period) {
+        candidates.push_back({period, 0.0, 0});
+    }
+    if (candidates.empty()) return candidates;
+
+    // Kasiski: distances between repeats of the same trigram tend to be key-length multiples
+    size_t kasiskiLength = std::min(letters.size(), KASISKI_SAMPLE_LETTERS);
+    std::vector<int32_t> lastSeen(26 * 26 * 26, -1);
+    for (size_t i = 0; i + 2 < kasiskiLength; ++i) {
+        size_t trigram = (letters[i] * 26 + letters[i + 1]) * 26 + letters[i + 2];
+        if (lastSeen[trigram] >= 0) {
+            size_t distance = i - static_cast<size_t>(lastSeen[trigram]);
+            for (auto& candidate : candidates) {
+                if (candidate.period > 1 && distance % candidate.period == 0) ++candidate.kasiskiVotes;
+            }
+        }
+        lastSeen[trigram] = static_cast<int32_t>(i);
+    }
+
+    // Each period's IC is independent, so spread them over the hardware threads
+    unsigned int threadCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                                                candidates.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        size_t index;
+        while ((index = next.fetch_add(1)) < candidates.size()) {
+            candidates[index].indexOfCoincidence = indexOfCoincidence(letters, candidates[index].period);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < threadCount; ++t) threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads) thread.join();
+
+    return candidates;
+}
+
+CryptanalysisEngine::VigenereResult CryptanalysisEngine::breakVigenere(const std::string& ciphertext,
+                                                                       size_t maxPeriod) {
+    VigenereResult result;
+    auto start = std::chrono::steady_clock::now();
+
+    result.periods = estimateVigenerePeriods(ciphertext, maxPeriod);
+    if (result.periods.empty()) {
+        result.plaintext = ciphertext;
+        return result;
+    }
+
+    double bestIc = 0.0;
+    unsigned int bestVotes = 0;
+    for (const auto& candidate : result.periods) {
+        bestIc = std::max(bestIc, candidate.indexOfCoincidence);
+        bestVotes = std::max(bestVotes, candidate.kasiskiVotes);
+    }
+
+    // Shortest period close to the best IC; Kasiski support breaks ties between near-equal ICs
+    size_t period = 0;
+    for (int pass = 0; pass < 2 && period == 0; ++pass) {
+        for (const auto& candidate : result.periods) {
+            bool strongIc = candidate.indexOfCoincidence >= bestIc * PERIOD_IC_TOLERANCE;
+            bool kasiskiAgrees = pass == 1 || bestVotes == 0 || candidate.kasiskiVotes * 2 >= bestVotes;
+            if (strongIc && kasiskiAgrees) {
+                period = candidate.period;
+                break;
+            }
+        }
+    }
+
+    // Each column is a Caesar cipher; one pass over the whole text fills every column's histogram
+    std::vector<uint64_t> counts(period * 26, 0);
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(ciphertext.data());
+    size_t column = 0;
+    for (size_t i = 0; i < ciphertext.size(); ++i) {
+        unsigned char index = static_cast<unsigned char>((data[i] | 0x20) - 'a');
+        if (index < 26) {
+            ++counts[column * 26 + index];
+            if (++column == period) column = 0;
+        }
+    }
+
+    result.key.assign(period, 'A');
+    for (column = 0; column < period; ++column) {
+        double scores[26];
+        chiSquaredAllShifts(&counts[column * 26], scores);
+        result.key[column] = static_cast<char>('A' + (std::min_element(scores, scores + 26) - scores));
+    }
+
+    // A multiple of the true period solves to the key repeated; report the shortest form
+    for (size_t unit = 1; unit < period; ++unit) {
+        if (period % unit == 0 && result.key.compare(unit, std::string::npos, result.key, 0, period - unit) == 0) {
+            result.key.resize(unit);
+            break;
+        }
+    }
+
+    VigenereCipher cipher;
+    cipher.setKey(result.key);
+    result.plaintext = cipher.decrypt(ciphertext);
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
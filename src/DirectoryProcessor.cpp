@@ -0,0 +1,409 @@
+#include "DirectoryProcessor.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char PARTIAL_SUFFIX[] = ".etpart";
+const char RESUME_FILE[] = ".etresume";
+
+// Kept in the output root: what the tree was written with, and whether every output in
+// it is known to come from a run with those settings
+struct ResumeRecord {
+    std::string algorithm;
+    bool isEncryption = true;
+    uint64_t keyFingerprint = 0;
+    bool clean = false;
+
+    bool sameSettings(const ResumeRecord& other) const {
+        return algorithm == other.algorithm && isEncryption == other.isEncryption &&
+               keyFingerprint == other.keyFingerprint;
+    }
+};
+
+bool readResumeRecord(const std::string& path, ResumeRecord& record) {
+    std::ifstream file(path);
+    std::string direction, state;
+    if (!(file >> record.algorithm >> direction >> std::hex >> record.keyFingerprint >> state)) return false;
+    record.isEncryption = direction == "encrypt";
+    record.clean = state == "clean";
+    return true;
+}
+
+bool writeResumeRecord(const std::string& path, const ResumeRecord& record) {
+    std::ofstream file(path, std::ios::trunc);
+    file << record.algorithm << ' ' << (record.isEncryption ? "encrypt" : "decrypt") << ' ' << std::hex
+         << record.keyFingerprint << ' ' << (record.clean ? "clean" : "mixed") << '\n';
+    file.close();
+    return !file.fail();
+}
+
+bool isEmptyDirectory(const std::string& path) {
+    DIR* directory = opendir(path.c_str());
+    if (!directory) return false;
+    bool empty = true;
+    while (dirent* entry = readdir(directory)) {
+        std::string name = entry->d_name;
+        if (name != "." && name != "..") {
+            empty = false;
+            break;
+        }
+    }
+    closedir(directory);
+    return empty;
+}
+
+struct Run {
+    CipherAlgorithm& cipher;
+    bool isEncryption;
+    DirectoryProcessor::Options options;
+    WorkStealingPool& pool;
+    std::string inputRecord;  // The input's own resume record is not part of the tree
+
+    std::atomic<uint64_t> files{0};
+    std::atomic<uint64_t> skipped{0};
+    std::atomic<uint64_t> failed{0};
+    std::atomic<uint64_t> directories{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> chunkTasks{0};
+
+    // Output directories and their sources; metadata is applied once nothing more is
+    // written into them
+    std::mutex directoriesMutex;
+    std::vector<std::pair<std::string, struct stat>> createdDirectories;
+
+    Run(CipherAlgorithm& cipher, bool isEncryption, const DirectoryProcessor::Options& options, WorkStealingPool& pool)
+        : cipher(cipher), isEncryption(isEncryption), options(options), pool(pool) {}
+
+    std::string process(const std::string& text, uint64_t state) {
+        return isEncryption ? cipher.encryptAt(text, state) : cipher.decryptAt(text, state);
+    }
+
+    // Whole files go through the checked path, so a rejected key or input (a failed
+    // AEAD tag) fails the file instead of producing empty output
+    bool processWhole(const std::string& text, std::string& result) {
+        return isEncryption ? cipher.tryEncrypt(text, result) : cipher.tryDecrypt(text, result);
+    }
+};
+
+// A file split into chunk tasks; the last chunk to finish completes the file
+struct FileJob {
+    std::string output;
+    std::string partial;
+    struct stat source;
+    int in;
+    int out;
+    std::atomic<size_t> remaining;
+    std::atomic<bool> ok{true};
+};
+
+bool readFully(int fd, char* data, size_t size, off_t offset) {
+    while (size > 0) {
+        ssize_t n = pread(fd, data, size, offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+        offset += n;
+    }
+    return true;
+}
+
+bool writeFully(int fd, const char* data, size_t size, off_t offset) {
+    while (size > 0) {
+        ssize_t n = pwrite(fd, data, size, offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+        offset += n;
+    }
+    return true;
+}
+
+bool sameTime(const struct timespec& a, const struct timespec& b) {
+    return a.tv_sec == b.tv_sec && a.tv_nsec == b.tv_nsec;
+}
+
+// Outputs only appear under their final name once complete and stamped with the
+// input's modification time, so a match means an earlier run finished this file
+bool alreadyDone(const std::string& output, const struct stat& source, bool preservesLength) {
+    struct stat existing;
+    if (stat(output.c_str(), &existing) != 0 || !S_ISREG(existing.st_mode)) return false;
+    return sameTime(existing.st_mtim, source.st_mtim) && (!preservesLength || existing.st_size == source.st_size);
+}
+
+void finishFile(Run& run, int out, const std::string& partial, const std::string& output,
+                const struct stat& source, bool ok) {
+    if (ok) {
+        struct timespec times[2] = {source.st_atim, source.st_mtim};
+        ok = fchmod(out, source.st_mode & 07777) == 0 && futimens(out, times) == 0;
+    }
+    ok = close(out) == 0 && ok;
+    ok = ok && rename(partial.c_str(), output.c_str()) == 0;
+
+    if (!ok) {
+        unlink(partial.c_str());
+        std::cerr << "Error: Unable to write output file: " << output << std::endl;
+        ++run.failed;
+        return;
+    }
+    ++run.files;
+    run.bytes += static_cast<uint64_t>(source.st_size);
+}
+
+void processChunk(Run& run, const std::shared_ptr<FileJob>& job, size_t index, uint64_t state) {
+    size_t chunkSize = run.options.chunkSize;
+    off_t offset = static_cast<off_t>(index * chunkSize);
+    size_t length = std::min(chunkSize, static_cast<size_t>(job->source.st_size - offset));
+
+    if (job->ok) {
+        std::string data(length, '\0');
+        bool ok = readFully(job->in, &data[0], length, offset);
+        if (ok) {
+            std::string result = run.process(data, state);
+            ok = result.size() == length && writeFully(job->out, result.data(), length, offset);
+        }
+        if (!ok) job->ok = false;
+    }
+
+    if (job->remaining.fetch_sub(1) == 1) {
+        close(job->in);
+        finishFile(run, job->out, job->partial, job->output, job->source, job->ok);
+    }
+}
+
+void processFile(Run& run, const std::string& input, const std::string& output, const struct stat& source) {
+    if (run.options.resume && alreadyDone(output, source, run.cipher.preservesLength())) {
+        ++run.skipped;
+        return;
+    }
+
+    int in = open(input.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        std::cerr << "Error: Unable to open input file: " << input << std::endl;
+        ++run.failed;
+        return;
+    }
+    std::string partial = output + PARTIAL_SUFFIX;
+    int out = open(partial.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (out < 0) {
+        close(in);
+        std::cerr << "Error: Unable to open output file: " << output << std::endl;
+        ++run.failed;
+        return;
+    }
+
+    size_t size = static_cast<size_t>(source.st_size);
+    size_t chunkSize = run.options.chunkSize;
+    if (size <= chunkSize || !run.cipher.preservesLength()) {
+        std::string data(size, '\0');
+        bool ok = readFully(in, &data[0], size, 0);
+        close(in);
+        std::string result;
+        if (ok && !run.processWhole(data, result)) {
+            std::cerr << "Error: Unable to process file: " << input << std::endl;
+            ok = false;
+        }
+        ok = ok && writeFully(out, result.data(), result.size(), 0);
+        finishFile(run, out, partial, output, source, ok);
+        return;
+    }
+
+    // Chunk states need everything before the chunk, so stateful ciphers get a quick
+    // sequential pass first; the expensive cipher work still runs in parallel
+    size_t chunkCount = (size + chunkSize - 1) / chunkSize;
+    std::vector<uint64_t> states(chunkCount, 0);
+    bool ok = ftruncate(out, static_cast<off_t>(size)) == 0;
+    if (ok && run.cipher.hasStreamState()) {
+        std::string data;
+        uint64_t state = 0;
+        for (size_t i = 0; i < chunkCount && ok; ++i) {
+            data.resize(std::min(chunkSize, size - i * chunkSize));
+            ok = readFully(in, &data[0], data.size(), static_cast<off_t>(i * chunkSize));
+            states[i] = state;
+            state = run.cipher.advanceState(data, state);
+        }
+    }
+    if (!ok) {
+        close(in);
+        finishFile(run, out, partial, output, source, false);
+        return;
+    }
+
+    auto job = std::make_shared<FileJob>();
+    job->output = output;
+    job->partial = partial;
+    job->source = source;
+    job->in = in;
+    job->out = out;
+    job->remaining = chunkCount;
+    run.chunkTasks += chunkCount;
+    for (size_t i = 0; i < chunkCount; ++i) {
+        uint64_t state = states[i];
+        run.pool.submit([&run, job, i, state]() { processChunk(run, job, i, state); });
+    }
+}
+
+void processDirectory(Run& run, const std::string& input, const std::string& output) {
+    struct stat source;
+    if (stat(input.c_str(), &source) != 0 || (mkdir(output.c_str(), 0700) != 0 && errno != EEXIST)) {
+        std::cerr << "Error: Unable to create directory: " << output << std::endl;
+        ++run.failed;
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(run.directoriesMutex);
+        run.createdDirectories.emplace_back(output, source);
+    }
+    ++run.directories;
+
+    DIR* directory = opendir(input.c_str());
+    if (!directory) {
+        std::cerr << "Error: Unable to open directory: " << input << std::endl;
+        ++run.failed;
+        return;
+    }
+
+    // Symbolic links and special files are neither followed nor copied
+    while (dirent* entry = readdir(directory)) {
+        std::string name = entry->d_name;
+        if (name == "." || name == "..") continue;
+
+        std::string inputPath = input + "/" + name;
+        if (inputPath == run.inputRecord) continue;
+        std::string outputPath = output + "/" + name;
+        struct stat entryStat;
+        if (lstat(inputPath.c_str(), &entryStat) != 0) continue;
+
+        if (S_ISDIR(entryStat.st_mode)) {
+            run.pool.submit([&run, inputPath, outputPath]() { processDirectory(run, inputPath, outputPath); });
+        } else if (S_ISREG(entryStat.st_mode)) {
+            run.pool.submit([&run, inputPath, outputPath, entryStat]() {
+                processFile(run, inputPath, outputPath, entryStat);
+            });
+        }
+    }
+    closedir(directory);
+}
+
+std::string withoutTrailingSlashes(std::string path) {
+    while (path.size() > 1 && path.back() == '/') path.pop_back();
+    return path;
+}
+
+std::string canonicalPath(const std::string& path) {
+    char resolved[PATH_MAX];
+    return realpath(path.c_str(), resolved) ? std::string(resolved) : path;
+}
+
+} // namespace
+
+bool DirectoryProcessor::isDirectory(const std::string& path) {
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+}
+
+DirectoryProcessor::Report DirectoryProcessor::process(CipherAlgorithm& cipher, const std::string& inputDirectory,
+                                                       const std::string& outputDirectory, bool isEncryption) {
+    return process(cipher, inputDirectory, outputDirectory, isEncryption, Options());
+}
+
+DirectoryProcessor::Report DirectoryProcessor::process(CipherAlgorithm& cipher, const std::string& inputDirectory,
+                                                       const std::string& outputDirectory, bool isEncryption,
+                                                       const Options& options) {
+    Report report;
+    auto start = std::chrono::steady_clock::now();
+    std::string input = withoutTrailingSlashes(inputDirectory);
+    std::string output = withoutTrailingSlashes(outputDirectory);
+
+    if (!isDirectory(input)) {
+        std::cerr << "Error: Not a directory: " << input << std::endl;
+        report.failed = 1;
+        return report;
+    }
+    if (mkdir(output.c_str(), 0700) != 0 && errno != EEXIST) {
+        std::cerr << "Error: Unable to create directory: " << output << std::endl;
+        report.failed = 1;
+        return report;
+    }
+
+    // The walk would otherwise descend into its own output
+    std::string inputRoot = canonicalPath(input) + "/";
+    std::string outputRoot = canonicalPath(output) + "/";
+    if (outputRoot.compare(0, inputRoot.size(), inputRoot) == 0) {
+        std::cerr << "Error: The output directory must not be inside the input directory." << std::endl;
+        report.failed = 1;
+        return report;
+    }
+
+    // An output is only skipped when the tree was written with the same cipher, key and
+    // direction; otherwise it may hold stale outputs with matching times, so every file is
+    // rewritten and the tree counts as clean again once a run finishes without failures
+    std::string recordPath = output + "/" + RESUME_FILE;
+    ResumeRecord current, previous;
+    current.algorithm = cipher.getName();
+    current.isEncryption = isEncryption;
+    current.keyFingerprint = cipher.keyFingerprint();
+    if (readResumeRecord(recordPath, previous)) {
+        current.clean = previous.clean && previous.sameSettings(current);
+    } else {
+        current.clean = isEmptyDirectory(output);
+    }
+    if (!writeResumeRecord(recordPath, current)) {
+        std::cerr << "Error: Unable to write output file: " << recordPath << std::endl;
+        report.failed = 1;
+        return report;
+    }
+
+    Options effective = options;
+    effective.chunkSize = std::max<size_t>(1, effective.chunkSize);
+    effective.resume = effective.resume && current.clean;
+    WorkStealingPool pool(effective.threads);
+    Run run(cipher, isEncryption, effective, pool);
+    run.inputRecord = input + "/" + RESUME_FILE;
+    pool.submit([&run, input, output]() { processDirectory(run, input, output); });
+    pool.wait();
+
+    if (run.failed == 0 && !current.clean) {
+        current.clean = true;
+        writeResumeRecord(recordPath, current);
+    }
+
+    // Deepest first, so setting a parent's times is not undone by touching a child
+    std::sort(run.createdDirectories.begin(), run.createdDirectories.end(),
+              [](const std::pair<std::string, struct stat>& a, const std::pair<std::string, struct stat>& b) {
+                  return a.first.size() > b.first.size();
+              });
+    for (const auto& directory : run.createdDirectories) {
+        struct timespec times[2] = {directory.second.st_atim, directory.second.st_mtim};
+        chmod(directory.first.c_str(), directory.second.st_mode & 07777);
+        utimensat(AT_FDCWD, directory.first.c_str(), times, 0);
+    }
+
+    report.files = run.files;
+    report.skipped = run.skipped;
+    report.failed = run.failed;
+    report.directories = run.directories;
+    report.bytes = run.bytes;
+    report.chunkTasks = run.chunkTasks;
+    report.steals = pool.steals();
+    report.threads = pool.size();
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
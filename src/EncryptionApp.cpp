@@ -6,7 +6,12 @@
 #include "ROT13Cipher.h"
 #include "ASCIIArtGenerator.h"
 #include "PasswordStrengthAnalyzer.h"
+#include "CryptanalysisEngine.h"
+#include "DirectoryProcessor.h"
+#include "SecureMemory.h"
 #include <iostream>
+#include <fstream>
+#include <cstdlib>
 #include <ctime>
 #include <string>
 
@@ -16,6 +21,11 @@ EncryptionApp::EncryptionApp() {
     algorithms.push_back(std::make_unique<SubstitutionCipher>());
     algorithms.push_back(std::make_unique<MorseCodeCipher>());
     algorithms.push_back(std::make_unique<ROT13Cipher>());
+    // Alphabet variants go last: stored passwords record the menu index
+    for (int i = 1; i < ALPHABET_COUNT; ++i) {
+        algorithms.push_back(std::make_unique<CaesarCipher>(static_cast<Alphabet>(i)));
+        algorithms.push_back(std::make_unique<VigenereCipher>(static_cast<Alphabet>(i)));
+    }
     
     std::srand(static_cast<unsigned int>(std::time(nullptr)));
 }
@@ -30,7 +40,8 @@ void EncryptionApp::displayMenu() {
     std::cout << "5. Password Manager\n";
     std::cout << "6. Analyze password strength\n";
     std::cout << "7. Generate secure password\n";
-    std::cout << "8. Exit\n";
+    std::cout << "8. Break a cipher (cryptanalysis)\n";
+    std::cout << "9. Exit\n";
     std::cout << "Enter your choice: ";
 }
 
@@ -76,7 +87,8 @@ void EncryptionApp::processMessage(bool isEncryption) {
         return;
     }
     
-    algorithms[algorithmIndex]->setKey(key);
+    algorithms[algorithmIndex]->setKeyCached(key, keyCache);
+    SecureMemory::wipe(key);  // The schedule keeps what it needs in secure memory
     
     std::string message;
     std::cout << "Enter message (or type 'back' to go back): ";
@@ -95,6 +107,8 @@ void EncryptionApp::processMessage(bool isEncryption) {
         result = algorithms[algorithmIndex]->decrypt(message);
         std::cout << "\nDecrypted message: " << result << std::endl;
     }
+    SecureMemory::wipe(message);
+    SecureMemory::wipe(result);
     
     std::cout << "\nPress Enter to continue...";
     std::cin.get();
@@ -118,10 +132,11 @@ void EncryptionApp::processFile(bool isEncryption) {
         return;
     }
     
-    algorithms[algorithmIndex]->setKey(key);
+    algorithms[algorithmIndex]->setKeyCached(key, keyCache);
+    SecureMemory::wipe(key);
     
     std::string inputFile, outputFile;
-    std::cout << "Enter input file path (or type 'back' to go back): ";
+    std::cout << "Enter input file or directory path (or type 'back' to go back): ";
     std::getline(std::cin, inputFile);
     
     if (inputFile == "back") {
@@ -129,7 +144,8 @@ void EncryptionApp::processFile(bool isEncryption) {
         return;
     }
     
-    std::cout << "Enter output file path (or type 'back' to go back): ";
+    bool isDirectory = DirectoryProcessor::isDirectory(inputFile);
+    std::cout << "Enter output " << (isDirectory ? "directory" : "file") << " path (or type 'back' to go back): ";
     std::getline(std::cin, outputFile);
     
     if (outputFile == "back") {
@@ -137,9 +153,17 @@ void EncryptionApp::processFile(bool isEncryption) {
         return;
     }
     
-    bool success = algorithms[algorithmIndex]->processFile(inputFile, outputFile, isEncryption);
-    if (success) {
-        std::cout << "\nFile " << (isEncryption ? "encrypted" : "decrypted") << " successfully." << std::endl;
+    if (isDirectory) {
+        DirectoryProcessor::Report report = DirectoryProcessor::process(*algorithms[algorithmIndex], inputFile,
+                                                                        outputFile, isEncryption);
+        std::cout << "\n" << report.files << " files " << (isEncryption ? "encrypted" : "decrypted") << " ("
+                  << report.bytes / (1024 * 1024) << " MB in " << report.seconds << " s), "
+                  << report.skipped << " already done, " << report.failed << " failed." << std::endl;
+    } else {
+        bool success = algorithms[algorithmIndex]->processFile(inputFile, outputFile, isEncryption);
+        if (success) {
+            std::cout << "\nFile " << (isEncryption ? "encrypted" : "decrypted") << " successfully." << std::endl;
+        }
     }
     
     std::cout << "\nPress Enter to continue...";
@@ -152,11 +176,25 @@ void EncryptionApp::displayPasswordMenu() {
     std::cout << "2. Retrieve a password\n";
     std::cout << "3. List all stored passwords\n";
     std::cout << "4. Delete a password\n";
-    std::cout << "5. Back to main menu\n";
+    std::cout << "5. Search stored passwords\n";
+    std::cout << "6. Set master password\n";
+    std::cout << "7. Back to main menu\n";
     std::cout << "Enter your choice: ";
 }
 
+// Asks for the master password once per session; later calls find the vault unlocked
+bool EncryptionApp::unlockVault() {
+    if (!passwordManager.isProtected() || passwordManager.isUnlocked()) return true;
+    std::string masterPassword;
+    std::cout << "Enter master password: ";
+    std::getline(std::cin, masterPassword);
+    bool unlocked = passwordManager.unlock(masterPassword);
+    SecureMemory::wipe(masterPassword);
+    return unlocked;
+}
+
 void EncryptionApp::passwordManagerMenu() {
+    if (!unlockVault()) return;
     int choice;
     do {
         displayPasswordMenu();
@@ -202,11 +240,13 @@ void EncryptionApp::passwordManagerMenu() {
                     break;
                 }
                 
-                algorithms[algorithmIndex]->setKey(key);
+                algorithms[algorithmIndex]->setKeyCached(key, keyCache);
                 
                 std::string encryptedPassword = algorithms[algorithmIndex]->encrypt(password);
                 passwordManager.addPassword(service, username, encryptedPassword, 
                                           std::to_string(algorithmIndex), key);
+                SecureMemory::wipe(password);
+                SecureMemory::wipe(key);
                 
                 std::cout << "Password stored successfully!" << std::endl;
                 
@@ -226,11 +266,13 @@ void EncryptionApp::passwordManagerMenu() {
                 std::string encryptedPassword, algorithmStr, key;
                 if (passwordManager.getPassword(service, encryptedPassword, algorithmStr, key)) {
                     int algorithmIndex = std::stoi(algorithmStr);
-                    algorithms[algorithmIndex]->setKey(key);
+                    algorithms[algorithmIndex]->setKeyCached(key, keyCache);
                     std::string decryptedPassword = algorithms[algorithmIndex]->decrypt(encryptedPassword);
                     
                     std::cout << "\nPassword for " << service << " retrieved:\n";
                     std::cout << "Decrypted password: " << decryptedPassword << std::endl;
+                    SecureMemory::wipe(decryptedPassword);
+                    SecureMemory::wipe(key);
                 } else {
                     std::cout << "No password found for " << service << "." << std::endl;
                 }
@@ -259,13 +301,61 @@ void EncryptionApp::passwordManagerMenu() {
                 std::cin.get();
                 break;
             }
-            case 5:
+            case 5: {
+                std::string field;
+                std::cout << "Search by (1) service or (2) username: ";
+                std::getline(std::cin, field);
+                
+                std::string query;
+                std::cout << "Enter search text (or type 'back' to go back): ";
+                std::getline(std::cin, query);
+                
+                if (query == "back") {
+                    break;
+                }
+                
+                std::string typos;
+                std::cout << "Allowed typos (0 for prefix search): ";
+                std::getline(std::cin, typos);
+                int maxDistance = std::atoi(typos.c_str());
+                
+                PasswordManager::SearchField searchField =
+                    field == "2" ? PasswordManager::SearchField::USERNAME : PasswordManager::SearchField::SERVICE;
+                if (maxDistance > 0) {
+                    passwordManager.displaySearchResults(passwordManager.fuzzySearch(searchField, query, maxDistance));
+                } else {
+                    passwordManager.displaySearchResults(passwordManager.search(searchField, query));
+                }
+                
+                std::cout << "\nPress Enter to continue...";
+                std::cin.get();
+                break;
+            }
+            case 6: {
+                std::string masterPassword;
+                std::cout << "Enter new master password (or type 'back' to go back): ";
+                std::getline(std::cin, masterPassword);
+                
+                if (masterPassword == "back") {
+                    break;
+                }
+                
+                if (passwordManager.protect(masterPassword)) {
+                    std::cout << "Master password set. Stored keys are now sealed under it." << std::endl;
+                }
+                SecureMemory::wipe(masterPassword);
+                
+                std::cout << "\nPress Enter to continue...";
+                std::cin.get();
+                break;
+            }
+            case 7:
                 std::cout << "Returning to main menu.\n";
                 break;
             default:
                 std::cout << "Invalid choice. Please try again.\n";
         }
-    } while (choice != 5);
+    } while (choice != 7);
 }
 
 void EncryptionApp::analyzePasswordStrength() {
@@ -347,13 +437,93 @@ void EncryptionApp::generateSecurePassword() {
             return;
         }
         
-        algorithms[algorithmIndex]->setKey(key);
+        algorithms[algorithmIndex]->setKeyCached(key, keyCache);
         
         std::string encryptedPassword = algorithms[algorithmIndex]->encrypt(password);
-        passwordManager.addPassword(service, username, encryptedPassword, 
-                                  std::to_string(algorithmIndex), key);
+        bool unlocked = unlockVault();
+        if (unlocked) {
+            passwordManager.addPassword(service, username, encryptedPassword, 
+                                      std::to_string(algorithmIndex), key);
+        }
+        SecureMemory::wipe(password);
+        SecureMemory::wipe(key);
         
-        std::cout << "Password stored successfully!" << std::endl;
+        if (unlocked) std::cout << "Password stored successfully!" << std::endl;
+    }
+    
+    std::cout << "\nPress Enter to continue...";
+    std::cin.get();
+}
+
+void EncryptionApp::breakCipher() {
+    std::cout << "\n==== Cryptanalysis ====\n";
+    std::cout << "1. Caesar / ROT13 (frequency analysis)\n";
+    std::cout << "2. Substitution (parallel hill climbing)\n";
+    std::cout << "3. Vigenère (Kasiski + index of coincidence)\n";
+    std::cout << "4. Back to main menu\n";
+    std::cout << "Enter your choice: ";
+    
+    int choice;
+    std::cin >> choice;
+    std::cin.ignore();
+    
+    if (choice < 1 || choice > 3) {
+        std::cout << "Returning to main menu.\n";
+        return;
+    }
+    
+    std::string ciphertext;
+    std::cout << "Enter ciphertext (type 'file' to read it from a file, or 'back' to go back): ";
+    std::getline(std::cin, ciphertext);
+    
+    if (ciphertext == "back") {
+        std::cout << "Returning to main menu.\n";
+        return;
+    }
+    
+    if (ciphertext == "file") {
+        std::string inputFile;
+        std::cout << "Enter input file path: ";
+        std::getline(std::cin, inputFile);
+        
+        std::ifstream file(inputFile);
+        if (!file.is_open()) {
+            std::cerr << "Error: Unable to open input file: " << inputFile << std::endl;
+            return;
+        }
+        ciphertext.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+    
+    if (choice == 1) {
+        CryptanalysisEngine::CaesarResult result = CryptanalysisEngine::breakCaesar(ciphertext);
+        std::cout << "\nMost likely shift: " << result.shift
+                  << (result.shift == 13 ? " (ROT13)" : "")
+                  << "  [chi-squared " << result.chiSquared << "]\n";
+        std::cout << "Decrypted message: " << result.plaintext << std::endl;
+    } else if (choice == 3) {
+        CryptanalysisEngine::VigenereResult result = CryptanalysisEngine::breakVigenere(ciphertext);
+        if (result.key.empty()) {
+            std::cout << "Not enough letters to analyze.\n";
+        } else {
+            std::cout << "\nMost likely key: " << result.key << " (length " << result.key.size() << ", "
+                      << result.seconds * 1000.0 << " ms)\n";
+            std::cout << "Decrypted message: " << result.plaintext << std::endl;
+        }
+    } else {
+        ASCIIArtGenerator::displayLoadingAnimation("Searching substitution keys", 100);
+        CryptanalysisEngine::SubstitutionReport report = CryptanalysisEngine::breakSubstitution(ciphertext);
+        
+        if (report.bestKeys.empty()) {
+            std::cout << "Not enough letters to analyze.\n";
+        } else {
+            std::cout << "\nBest keys (" << report.keysTried << " keys tried on " << report.threadsUsed
+                      << " threads, " << static_cast<long long>(report.keysPerSecond) << " keys/s):\n";
+            for (size_t i = 0; i < report.bestKeys.size(); ++i) {
+                std::cout << i + 1 << ". " << report.bestKeys[i].key
+                          << "  [score " << report.bestKeys[i].score << "]\n";
+            }
+            std::cout << "Decrypted message: " << report.bestKeys.front().plaintext << std::endl;
+        }
     }
     
     std::cout << "\nPress Enter to continue...";
@@ -392,6 +562,9 @@ void EncryptionApp::run() {
                 generateSecurePassword();
                 break;
             case 8:
+                breakCipher();
+                break;
+            case 9:
                 std::cout << "Exiting program. Goodbye!\n";
                 break;
             default:
@@ -399,5 +572,5 @@ void EncryptionApp::run() {
                 std::cout << "\nPress Enter to continue...";
                 std::cin.get();
         }
-    } while (choice != 8);
+    } while (choice != 9);
 }
\ No newline at end of file
@@ -0,0 +1,518 @@
+#include "EnglishStatistics.h"
+
+const double ENGLISH_LETTER_FREQUENCIES[26] = {
+    0.08167, 0.01492, 0.02782, 0.04253, 0.12702, 0.02228, 0.02015, 0.06094, 0.06966,
+    0.00153, 0.00772, 0.04025, 0.02406, 0.06749, 0.07507, 0.01929, 0.00095, 0.05987,
+    0.06327, 0.09056, 0.02758, 0.00978, 0.02360, 0.00150, 0.01974, 0.00074
+};
+
+// The 3000 most frequent quadgrams in Isaac Newton's "Opticks" (the Project Gutenberg
+// text, public domain), with their counts out of its 436,704 quadgrams. It is a single
+// 18th-century book on optics, so COLOUR, REFRACT, PRISM and the like rank far above
+// their general-English frequency; hill climbing only needs the common structure (THE,
+// TION, ING) to dominate. Anything not listed is scored with a floor value.
+const QuadgramCount ENGLISH_QUADGRAMS[] = {
+    {"OFTH", 2747}, {"FTHE", 2661}, {"THER", 2629}, {"NTHE", 1991}, {"THES", 1791}, {"TION", 1644},
+    {"OTHE", 1486}, {"HERE", 1428}, {"THAT", 1350}, {"DTHE", 1170}, {"NDTH", 1162}, {"IGHT", 1155},
+    {"ANDT", 1148}, {"TTHE", 1131}, {"INTH", 1115}, {"ETHE", 1027}, {"COLO", 1008}, {"OLOU", 997},
+    {"LOUR", 997}, {"WHIC", 991}, {"HICH", 991}, {"REFR", 945}, {"EFRA", 935}, {"THEI", 870},
+    {"THEP", 867}, {"LIGH", 855}, {"SOFT", 853}, {"RACT", 852}, {"SAND", 790}, {"STHE", 786},
+    {"FROM", 776}, {"THEM", 764}, {"THEC", 763}, {"WITH", 757}, {"TOTH", 748}, {"FRAC", 732},
+    {"EAND", 726}, {"ATTH", 678}, {"EREF", 677}, {"PART", 671}, {"THEL", 663}, {"RAYS", 661},
+    {"ACTI", 659}, {"OURS", 657}, {"YTHE", 640}, {"STAN", 638}, {"ESOF", 617}, {"THEF", 616},
+    {"BYTH", 594}, {"HESE", 590}, {"THIS", 568}, {"HEIR", 566}, {"THAN", 564}, {"EOFT", 560},
+    {"RTHE", 559}, {"ONTH", 558}, {"CTIO", 545}, {"TAND", 544}, {"IONS", 531}, {"INGT", 524},
+    {"EFOR", 514}, {"NGTH", 510}, {"ERTH", 510}, {"HTHE", 509}, {"DIST", 508}, {"MTHE", 508},
+    {"THEY", 497}, {"HERA", 497}, {"ATIO", 495}, {"HECO", 494}, {"ROMT", 493}, {"THET", 490},
+    {"OMTH", 487}, {"EFLE", 486}, {"REFL", 484}, {"RING", 484}, {"ANCE", 482}, {"CTED", 474},
+    {"GLAS", 474}, {"LASS", 474}, {"HOSE", 462}, {"ERAY", 460}, {"ENTH", 458}, {"TANC", 452},
+    {"ECOL", 452}, {"TOFT", 451}, {"ENCE", 446}, {"THED", 441}, {"THEO", 435}, {"GREE", 426},
+    {"HATT", 425}, {"IONO", 419}, {"RISM", 419}, {"HESA", 418}, {"RAND", 416}, {"THEB", 415},
+    {"OUGH", 412}, {"PRIS", 412}, {"ECON", 408}, {"ONOF", 405}, {"PROP", 399}, {"EDTH", 396},
+    {"TING", 394}, {"THOS", 393}, {"ISTA", 392}, {"DAND", 391}, {"MORE", 381}, {"ERIN", 381},
+    {"ATER", 378}, {"INTO", 374}, {"WILL", 373}, {"INGS", 366}, {"WHEN", 366}, {"OUND", 366},
+    {"SIDE", 363}, {"NOTH", 357}, {"SAME", 355}, {"EVER", 353}, {"UPON", 352}, {"LECT", 351},
+    {"FORE", 349}, {"RETH", 349}, {"ESAM", 346}, {"THEE", 345}, {"APPE", 345}, {"HELI", 344},
+    {"HITE", 344}, {"VERY", 342}, {"WHIT", 342}, {"NTER", 340}, {"THEA", 339}, {"THEG", 337},
+    {"EINT", 336}, {"GTHE", 335}, {"ANDI", 333}, {"HEFI", 333}, {"ANDB", 333}, {"IRST", 329},
+    {"ANDS", 328}, {"FIRS", 328}, {"LLOW", 328}, {"HETH", 323}, {"INTE", 318}, {"PPEA", 315},
+    {"PEAR", 315}, {"FLEC", 312}, {"THIN", 312}, {"HEDI", 311}, {"RANG", 311}, {"NOFT", 310},
+    {"DINT", 308}, {"MENT", 307}, {"NESS", 306}, {"ERAN", 305}, {"ESAN", 304}, {"THEN", 302},
+    {"EDIN", 301}, {"ANDA", 300}, {"ANOT", 297}, {"SINT", 297}, {"BLUE", 295}, {"SPEC", 294},
+    {"REAT", 292}, {"COMP", 292}, {"TSOF", 292}, {"APER", 291}, {"WERE", 290}, {"EGRE", 290},
+    {"THEW", 288}, {"ATED", 286}, {"ROUG", 286}, {"MADE", 285}, {"IFTH", 285}, {"ETHI", 282},
+    {"ELIG", 280}, {"LINE", 279}, {"HEPR", 279}, {"OULD", 278}, {"TOBE", 277}, {"SWHI", 276},
+    {"BEIN", 275}, {"NEAN", 275}, {"NAND", 271}, {"THRO", 270}, {"HROU", 268}, {"ETHA", 267},
+    {"HEPA", 266}, {"ECTE", 264}, {"DTHA", 263}, {"ONEA", 263}, {"SOME", 262}, {"INCI", 261},
+    {"ESIN", 260}, {"GREA", 259}, {"EPAR", 259}, {"IONA", 258}, {"EFIR", 258}, {"RTHA", 255},
+    {"ERED", 254}, {"MOST", 254}, {"EDIS", 251}, {"SECO", 251}, {"LTHE", 250}, {"PAPE", 249},
+    {"EDAN", 248}, {"CHTH", 248}, {"WHER", 248}, {"ESTH", 248}, {"ARTO", 247}, {"LLTH", 246},
+    {"PERI", 244}, {"IDEN", 244}, {"ETWE", 244}, {"HELE", 243}, {"ROPO", 242}, {"TRAN", 242},
+    {"UGHT", 242}, {"IBLE", 242}, {"EING", 240}, {"WATE", 240}, {"EENT", 239}, {"HATI", 237},
+    {"CONS", 237}, {"HESU", 237}, {"EQUA", 237}, {"EDBY", 236}, {"ARTS", 235}, {"CIRC", 234},
+    {"NDIN", 233}, {"OFAN", 233}, {"INCH", 233}, {"BETW", 233}, {"ELLO", 233}, {"MEDI", 232},
+    {"EWHI", 231}, {"WEEN", 231}, {"ALLT", 230}, {"RANS", 230}, {"HESP", 230}, {"TWEE", 230},
+    {"EXPE", 229}, {"CEOF", 229}, {"QUAL", 229}, {"HERI", 228}, {"CIDE", 227}, {"RTOF", 226},
+    {"XPER", 226}, {"BODI", 226}, {"ODIE", 226}, {"DIES", 226}, {"SARE", 226}, {"NCID", 226},
+    {"ESPE", 226}, {"HAVE", 225}, {"ORTH", 225}, {"LESS", 224}, {"THTH", 223}, {"YELL", 223},
+    {"ERAL", 222}, {"ABOU", 220}, {"NGLE", 220}, {"HENT", 220}, {"SERV", 219}, {"CONT", 218},
+    {"HANT", 218}, {"REFO", 217}, {"FALL", 217}, {"STHA", 215}, {"EPRI", 214}, {"SEVE", 214},
+    {"CLES", 214}, {"ICHT", 213}, {"VIOL", 213}, {"IOLE", 213}, {"ACTE", 212}, {"OLET", 212},
+    {"TURE", 212}, {"BOUT", 210}, {"ERVA", 210}, {"ECOM", 209}, {"DWIT", 209}, {"PLAC", 209},
+    {"ASTH", 209}, {"EATE", 208}, {"HEGL", 208}, {"EGLA", 208}, {"ETER", 208}, {"DBYT", 207},
+    {"ANGI", 207}, {"INGE", 206}, {"EANO", 205}, {"HEFO", 204}, {"PASS", 204}, {"FTER", 203},
+    {"LACE", 203}, {"PONT", 203}, {"TERT", 202}, {"ESEC", 202}, {"REAS", 202}, {"TWHI", 202},
+    {"TREF", 202}, {"FRAN", 201}, {"NGIB", 201}, {"ANTH", 201}, {"NCEO", 201}, {"ALSO", 200},
+    {"OMPO", 200}, {"BSER", 200}, {"STIN", 200}, {"OBSE", 199}, {"EPAP", 199}, {"REEN", 199},
+    {"DING", 198}, {"WARD", 198}, {"AFTE", 197}, {"INES", 197}, {"POSI", 196}, {"SITI", 196},
+    {"HEIN", 196}, {"ORTI", 195}, {"SSES", 195}, {"THEH", 195}, {"VERA", 194}, {"ASSE", 194},
+    {"ANGL", 192}, {"ULAR", 192}, {"EOTH", 192}, {"ANIN", 191}, {"LEXI", 191}, {"LLBE", 191},
+    {"ITIO", 190}, {"IMEN", 190}, {"THOU", 190}, {"NCES", 190}, {"FLEX", 190}, {"ITHT", 189},
+    {"ERIM", 188}, {"ESSI", 188}, {"INGA", 187}, {"FORM", 187}, {"EREA", 187}, {"ALLY", 187},
+    {"NTHA", 187}, {"LATE", 186}, {"ANGE", 186}, {"RTSO", 185}, {"ASTO", 185}, {"MUCH", 185},
+    {"OSIT", 184}, {"COND", 184}, {"ARTH", 184}, {"EARE", 184}, {"TERO", 184}, {"YREF", 184},
+    {"HESI", 183}, {"NDBY", 183}, {"FORT", 182}, {"ARDS", 182}, {"EDIA", 182}, {"RIME", 181},
+    {"RATI", 181}, {"EROF", 181}, {"TIME", 180}, {"SUCH", 180}, {"CAUS", 179}, {"ESUN", 178},
+    {"EREN", 178}, {"TEDT", 178}, {"IONT", 178}, {"EPLA", 178}, {"STRE", 178}, {"EXIO", 178},
+    {"XION", 178}, {"SINE", 178}, {"SOFA", 178}, {"COME", 177}, {"RTIO", 177}, {"ANDW", 176},
+    {"NEOF", 176}, {"PORT", 175}, {"SETH", 175}, {"FFER", 175}, {"YAND", 174}, {"AMET", 174},
+    {"ERET", 174}, {"DIFF", 174}, {"IMAG", 174}, {"ANDC", 173}, {"HERS", 173}, {"OPOR", 173},
+    {"HEMI", 173}, {"HAND", 172}, {"ARTI", 172}, {"OUTO", 171}, {"AUSE", 171}, {"SOTH", 171},
+    {"HOLE", 171}, {"THIC", 171}, {"HING", 170}, {"ONSO", 170}, {"LIQU", 170}, {"UTTH", 169},
+    {"TINT", 169}, {"HICK", 169}, {"SION", 168}, {"EPRO", 168}, {"CTIN", 168}, {"GHTH", 168},
+    {"ANDR", 167}, {"INGO", 167}, {"MAGE", 167}, {"TEDA", 166}, {"RINT", 165}, {"ITHO", 165},
+    {"ONAN", 165}, {"ESSO", 164}, {"PARA", 164}, {"THEV", 164}, {"NDRE", 163}, {"PECT", 163},
+    {"LITT", 163}, {"ITTL", 163}, {"TTLE", 163}, {"REOF", 162}, {"ANDF", 162}, {"ROFT", 162},
+    {"ONSI", 161}, {"FLIG", 161}, {"OTHA", 161}, {"FTHI", 161}, {"EDTO", 160}, {"PRES", 160},
+    {"WOUL", 160}, {"RCLE", 160}, {"GHTO", 159}, {"ISTH", 159}, {"UTOF", 158}, {"INGI", 158},
+    {"SING", 158}, {"LIKE", 158}, {"IRCL", 158}, {"MOTI", 158}, {"OTIO", 158}, {"RSOF", 157},
+    {"ANDL", 157}, {"NDSO", 157}, {"ORDE", 157}, {"CHAN", 157}, {"ALLE", 157}, {"ISTI", 157},
+    {"TEDB", 156}, {"NSOF", 156}, {"TINC", 156}, {"OFLI", 155}, {"AYBE", 155}, {"HEMO", 155},
+    {"MAYB", 154}, {"ORET", 154}, {"SSOF", 154}, {"GHTA", 154}, {"OINT", 153}, {"FERE", 153},
+    {"ELEN", 153}, {"BECO", 152}, {"RALL", 152}, {"METE", 152}, {"ECTI", 151}, {"HERT", 151},
+    {"JECT", 151}, {"BEFO", 150}, {"MAKE", 150}, {"AINT", 150}, {"DENC", 150}, {"ENSI", 150},
+    {"SWHE", 150}, {"CKNE", 150}, {"ITHA", 149}, {"KNES", 149}, {"PEND", 148}, {"TOFA", 148},
+    {"ICUL", 148}, {"GHTW", 147}, {"REDA", 147}, {"SSIN", 147}, {"READ", 146}, {"KING", 146},
+    {"TERA", 146}, {"DIAM", 146}, {"ICKN", 146}, {"NINC", 146}, {"HALL", 145}, {"CULA", 145},
+    {"HEOT", 145}, {"ISMA", 144}, {"EFRO", 144}, {"NTOT", 144}, {"GIBL", 144}, {"GHTT", 143},
+    {"ICHI", 143}, {"EDWI", 143}, {"POSE", 143}, {"LEAS", 143}, {"MAND", 143}, {"ALIT", 143},
+    {"RDER", 142}, {"OMET", 141}, {"ESTO", 141}, {"URFA", 141}, {"FACE", 141}, {"SORT", 141},
+    {"NTRA", 141}, {"ANDM", 140}, {"RVAT", 140}, {"VATI", 140}, {"DFRO", 140}, {"SURF", 140},
+    {"RFAC", 140}, {"DEGR", 140}, {"ITHE", 139}, {"IMES", 139}, {"ENDI", 139}, {"EBYT", 139},
+    {"RTIC", 139}, {"OFRE", 138}, {"ILLU", 138}, {"SPAR", 138}, {"IFFE", 138}, {"PERP", 137},
+    {"IDES", 137}, {"IAME", 137}, {"ILLB", 137}, {"HOUT", 136}, {"ARED", 136}, {"BECA", 136},
+    {"ANDD", 136}, {"SENS", 136}, {"ENTA", 135}, {"SSTH", 135}, {"AYSA", 135}, {"INEO", 135},
+    {"EREI", 135}, {"ERES", 134}, {"REST", 134}, {"UMIN", 134}, {"DARK", 134}, {"HEMA", 133},
+    {"EAST", 133}, {"REAN", 133}, {"ANSM", 133}, {"ESEN", 132}, {"TERM", 132}, {"LEOF", 132},
+    {"ENTE", 132}, {"ENSE", 131}, {"THIR", 131}, {"ETOT", 131}, {"IOUS", 131}, {"IONI", 131},
+    {"NSMI", 131}, {"GETH", 130}, {"BJEC", 130}, {"OFCO", 130}, {"AREN", 130}, {"CETH", 130},
+    {"THRE", 130}, {"ENTS", 129}, {"SHAL", 129}, {"NCEI", 129}, {"LESO", 129}, {"ECIR", 129},
+    {"EOFA", 129}, {"NEAR", 128}, {"TTHA", 128}, {"ICHA", 128}, {"EREB", 128}, {"ATES", 128},
+    {"NING", 127}, {"SFRO", 127}, {"OBJE", 127}, {"ATIS", 126}, {"NCET", 126}, {"INAT", 125},
+    {"OVER", 125}, {"FANI", 125}, {"HEWH", 125}, {"TERS", 124}, {"CESS", 124}, {"ERPE", 124},
+    {"POIN", 124}, {"FITS", 124}, {"REIN", 124}, {"CENT", 124}, {"TERI", 124}, {"HIRD", 123},
+    {"PERF", 123}, {"SFOR", 123}, {"AKIN", 123}, {"SNOT", 123}, {"EINC", 123}, {"EMOR", 123},
+    {"LENS", 123}, {"HEGR", 123}, {"URSA", 123}, {"RESE", 122}, {"RENT", 122}, {"AYSW", 122},
+    {"ALTO", 122}, {"OBLI", 122}, {"BLIQ", 122}, {"ERSO", 122}, {"ANDO", 122}, {"PLAT", 122},
+    {"TICL", 122}, {"ICLE", 122}, {"FOUN", 121}, {"HENC", 121}, {"BYRE", 121}, {"RCOL", 121},
+    {"ANYO", 120}, {"FREF", 120}, {"CONC", 120}, {"DENS", 120}, {"HEPL", 120}, {"NNER", 120},
+    {"EMID", 120}, {"INDI", 119}, {"YCON", 119}, {"TALL", 119}, {"ANDP", 119}, {"SWIT", 119},
+    {"ENOT", 119}, {"ASSI", 119}, {"MINA", 119}, {"REBY", 119}, {"ARAL", 119}, {"DTHI", 119},
+    {"ERGE", 119}, {"TRUM", 119}, {"SOFR", 118}, {"FTHO", 118}, {"LUMI", 118}, {"OFIN", 118},
+    {"PLAN", 118}, {"UCHA", 118}, {"ETWO", 118}, {"ABLE", 118}, {"RESS", 118}, {"NDCO", 117},
+    {"NTIN", 117}, {"NATE", 117}, {"MBER", 117}, {"NDWH", 116}, {"DNOT", 116}, {"TYOF", 116},
+    {"ORAN", 116}, {"TIES", 116}, {"BODY", 116}, {"TOWA", 116}, {"ECTR", 116}, {"SWER", 116},
+    {"TILL", 115}, {"TEDI", 115}, {"EWIT", 115}, {"ONES", 115}, {"STRA", 115}, {"STTH", 115},
+    {"EDIU", 115}, {"DIUM", 115}, {"MIDD", 115}, {"IDDL", 115}, {"DOFT", 114}, {"ONFI", 114},
+    {"LLEL", 114}, {"DDLE", 114}, {"SSIO", 114}, {"NINT", 113}, {"UNDE", 113}, {"ESWH", 113},
+    {"GENE", 112}, {"POUN", 112}, {"STOT", 112}, {"NGAN", 111}, {"ONST", 111}, {"ARER", 111},
+    {"FORI", 111}, {"MEAN", 111}, {"DENT", 111}, {"RPEN", 111}, {"LANE", 111}, {"EBLU", 111},
+    {"CHES", 111}, {"BEAM", 111}, {"STOB", 110}, {"MPOU", 110}, {"ONVE", 110}, {"ITYO", 109},
+    {"NGTO", 109}, {"TRAC", 109}, {"HEBO", 109}, {"RERE", 109}, {"CONV", 109}, {"LYTH", 109},
+    {"SUNS", 109}, {"ENTI", 108}, {"ICHW", 108}, {"ASSA", 108}, {"NDIC", 108}, {"HEOB", 108},
+    {"OFAL", 108}, {"INCT", 108}, {"RIGH", 108}, {"TTRA", 108}, {"IESO", 107}, {"NFIG", 107},
+    {"ORDI", 107}, {"SHAD", 107}, {"EIRC", 106}, {"AYSO", 106}, {"DTHO", 106}, {"TURN", 106},
+    {"YTHA", 106}, {"HEPO", 106}, {"NWHI", 106}, {"HEBL", 106}, {"HOFT", 106}, {"ITIS", 105},
+    {"LAND", 105}, {"LTOT", 105}, {"OWAR", 105}, {"DLIG", 105}, {"EMAN", 105}, {"TFRO", 105},
+    {"ACES", 105}, {"HEVI", 105}, {"ORES", 105}, {"ADTH", 105}, {"CTRU", 105}, {"ALLI", 104},
+    {"MAKI", 104}, {"EDFR", 104}, {"BUTT", 104}, {"SUCC", 104}, {"UCCE", 104}, {"AGRE", 104},
+    {"ARLY", 104}, {"HTOF", 104}, {"PPOS", 104}, {"DPAR", 104}, {"SIBL", 104}, {"EART", 104},
+    {"REES", 104}, {"HADO", 104}, {"STRO", 104}, {"THOF", 104}, {"NGES", 104}, {"FCOL", 103},
+    {"MALL", 103}, {"ENGT", 103}, {"ELES", 103}, {"ESHA", 103}, {"HATO", 103}, {"KETH", 103},
+    {"INGR", 103}, {"EMER", 103}, {"ERTO", 102}, {"HEIM", 102}, {"ITHI", 102}, {"NDED", 102},
+    {"SIST", 102}, {"CHAR", 102}, {"RREF", 102}, {"EPRE", 102}, {"HANG", 102}, {"HEAT", 102},
+    {"ANNE", 101}, {"FOUR", 101}, {"ISCO", 101}, {"PERT", 101}, {"ESOR", 101}, {"REDI", 101},
+    {"DICU", 101}, {"BLAC", 101}, {"LACK", 101}, {"ERWI", 101}, {"ADOW", 101}, {"ATTR", 101},
+    {"SEOF", 100}, {"URED", 100}, {"YWHI", 100}, {"OREA", 100}, {"NCEA", 100}, {"HECI", 100},
+    {"MANN", 100}, {"MUST", 100}, {"HALF", 100}, {"LERA", 100}, {"ADEB", 100}, {"GHTB", 99},
+    {"ANDE", 99}, {"GHTI", 99}, {"BERE", 99}, {"FTHA", 99}, {"ABOV", 99}, {"BOVE", 99},
+    {"ONTI", 99}, {"EEYE", 99}, {"EIMA", 99}, {"NCHE", 99}, {"HINT", 99}, {"FRIN", 99},
+    {"INED", 98}, {"URSO", 98}, {"TOGE", 98}, {"OFIT", 98}, {"BREA", 98}, {"LENG", 98},
+    {"FINC", 98}, {"DEBY", 98}, {"ONLY", 98}, {"ONSA", 97}, {"RECT", 97}, {"OGET", 97},
+    {"TTER", 97}, {"RSTO", 97}, {"NTHI", 97}, {"ESSE", 97}, {"SBUT", 97}, {"NDER", 97},
+    {"TPAR", 97}, {"ERME", 97}, {"ENTR", 97}, {"RATE", 97}, {"HREE", 97}, {"UREO", 97},
+    {"HEBR", 97}, {"ROUN", 97}, {"EIGH", 97}, {"BLER", 97}, {"SREF", 96}, {"EBOD", 96},
+    {"EADT", 96}, {"HEEY", 96}, {"TLIG", 95}, {"SABO", 95}, {"REDT", 95}, {"ININ", 95},
+    {"ASON", 95}, {"STOF", 95}, {"ALLB", 95}, {"STAL", 95}, {"RDIN", 95}, {"ANDV", 95},
+    {"MERG", 95}, {"TWAS", 94}, {"FART", 94}, {"NDLE", 94}, {"INAN", 94}, {"HTWH", 94},
+    {"SPRO", 94}, {"HEWA", 94}, {"UMBE", 94}, {"OUTT", 93}, {"ACCO", 93}, {"EASO", 93},
+    {"CEAN", 93}, {"YOFT", 93}, {"ARET", 93}, {"EALL", 93}, {"SMAD", 93}, {"OURA", 93},
+    {"OWAN", 93}, {"WAND", 93}, {"TRON", 93}, {"HEYA", 92}, {"LONG", 92}, {"NGIN", 92},
+    {"ECAU", 92}, {"NESO", 92}, {"HATW", 92}, {"IONW", 92}, {"ESID", 92}, {"EASE", 92},
+    {"HEME", 92}, {"CONF", 92}, {"ISMS", 92}, {"OURT", 91}, {"INAL", 91}, {"MITT", 91},
+    {"EDOF", 91}, {"REPR", 91}, {"ONTR", 91}, {"BYCO", 91}, {"RONG", 91}, {"TEDF", 90},
+    {"ICAL", 90}, {"REEK", 90}, {"BOTH", 90}, {"INST", 90}, {"OONE", 90}, {"EITH", 90},
+    {"EDLI", 90}, {"ATIN", 90}, {"ACED", 90}, {"ITIE", 90}, {"IATE", 90}, {"NOTT", 89},
+    {"MPOS", 89}, {"ETIM", 89}, {"OUTA", 89}, {"LETT", 89}, {"OFRA", 89}, {"EMOS", 89},
+    {"EMAD", 89}, {"IONF", 89}, {"NDIF", 89}, {"RYST", 89}, {"ERVE", 89}, {"OWER", 89},
+    {"TWHE", 89}, {"VARI", 89}, {"ORIN", 89}, {"GAND", 88}, {"ONSE", 88}, {"DWHE", 88},
+    {"HENI", 88}, {"PARE", 88}, {"SEEM", 88}, {"HATS", 88}, {"TTHI", 88}, {"OSED", 88},
+    {"NTOA", 87}, {"SMAL", 87}, {"THEU", 87}, {"REMA", 87}, {"FOLL", 87}, {"OLLO", 87},
+    {"ATWH", 87}, {"NTLY", 87}, {"LEAN", 87}, {"ERAT", 87}, {"ASIN", 87}, {"CREA", 87},
+    {"HERW", 87}, {"ESTR", 87}, {"IRCO", 87}, {"EVIO", 87}, {"ENTL", 86}, {"WHAT", 86},
+    {"CESO", 86}, {"ONWH", 86}, {"NALL", 86}, {"SEQU", 86}, {"ESST", 86}, {"ERCO", 86},
+    {"NUMB", 86}, {"ENTT", 85}, {"FECT", 85}, {"METI", 85}, {"EATT", 85}, {"BETH", 85},
+    {"NSID", 85}, {"HTTO", 85}, {"RENC", 85}, {"ETTH", 85}, {"YSTA", 85}, {"ETAN", 85},
+    {"TDIS", 85}, {"SMIT", 85}, {"MANY", 84}, {"EWHE", 84}, {"LITY", 84}, {"RMED", 84},
+    {"SSAN", 84}, {"EANG", 84}, {"INGL", 84}, {"ATUR", 84}, {"RWHI", 84}, {"HTAN", 84},
+    {"IESA", 84}, {"ERST", 83}, {"SENT", 83}, {"SOFC", 83}, {"IONB", 83}, {"UNDT", 83},
+    {"TRAT", 83}, {"UALL", 83}, {"ILLA", 83}, {"EDGE", 83}, {"LYAN", 83}, {"LEIN", 83},
+    {"HETW", 83}, {"GESO", 83}, {"NISH", 83}, {"DIAT", 83}, {"LOWA", 83}, {"XTUR", 83},
+    {"EARS", 82}, {"DWHI", 82}, {"NTOF", 82}, {"SUFF", 82}, {"TAIN", 82}, {"TAKE", 82},
+    {"RPAR", 82}, {"YSWH", 82}, {"LETH", 82}, {"OSET", 82}, {"RARE", 82}, {"NDBE", 82},
+    {"RINC", 82}, {"CORD", 82}, {"COUL", 82}, {"MEAS", 82}, {"TEST", 82}, {"SINC", 81},
+    {"SCON", 81}, {"NTAN", 81}, {"FRAY", 81}, {"IDER", 81}, {"HEAN", 81}, {"ATOF", 81},
+    {"CRYS", 81}, {"EASU", 81}, {"ARIS", 81}, {"MIXT", 81}, {"ITTE", 80}, {"NDTO", 80},
+    {"LYRE", 80}, {"ESEV", 80}, {"YSOF", 80}, {"ELIN", 80}, {"ASST", 80}, {"ILIT", 80},
+    {"TIST", 80}, {"EOFI", 80}, {"SUPP", 80}, {"EONE", 80}, {"RSID", 80}, {"HEYW", 80},
+    {"CCOR", 80}, {"SALT", 80}, {"NATU", 80}, {"BSTA", 80}, {"SPAC", 80}, {"PACE", 80},
+    {"IXTU", 80}, {"ERSI", 79}, {"ETHO", 79}, {"CHIN", 79}, {"ESAR", 79}, {"ISTO", 79},
+    {"ESBE", 79}, {"OREF", 79}, {"MIGH", 79}, {"SLIG", 79}, {"FFIC", 78}, {"ENTO", 78},
+    {"VETH", 78}, {"TERW", 78}, {"NDAN", 78}, {"UALT", 78}, {"LYIN", 78}, {"NPRO", 78},
+    {"ROMO", 78}, {"EOBJ", 78}, {"ESSA", 78}, {"ASUR", 78}, {"RISE", 78}, {"SUBS", 78},
+    {"HERP", 77}, {"OREI", 77}, {"ENDE", 77}, {"RENO", 77}, {"WING", 77}, {"RFOR", 77},
+    {"SUAL", 77}, {"ENEA", 77}, {"UPPO", 77}, {"OFWH", 77}, {"ALLO", 77}, {"SBYT", 77},
+    {"HEHO", 77}, {"TONE", 77}, {"TICK", 76}, {"SOFL", 76}, {"NDOF", 76}, {"LAST", 76},
+    {"IRCU", 76}, {"QUAR", 76}, {"RESO", 76}, {"TTED", 76}, {"INGF", 76}, {"EDIF", 76},
+    {"EASI", 76}, {"OSTR", 76}, {"HATA", 76}, {"EOUT", 76}, {"BUTI", 76}, {"EBET", 76},
+    {"TOON", 76}, {"OWTH", 76}, {"ASTR", 76}, {"ANDG", 76}, {"FANY", 75}, {"URSW", 75},
+    {"METH", 75}, {"EQUE", 75}, {"CCES", 75}, {"SMAN", 75}, {"ITSO", 75}, {"SWIL", 75},
+    {"RMIN", 75}, {"HERC", 75}, {"PHER", 75}, {"STBE", 75}, {"INGM", 75}, {"ORRE", 74},
+    {"SATT", 74}, {"CEPT", 74}, {"HEEX", 74}, {"NOTB", 74}, {"SEPA", 74}, {"INEA", 74},
+    {"ATEL", 74}, {"ELEA", 74}, {"ORTS", 74}, {"OGEN", 74}, {"DTHR", 74}, {"AGAI", 74},
+    {"GAIN", 74}, {"UGHA", 74}, {"EWAS", 74}, {"LUEA", 74}, {"SURE", 74}, {"ENES", 74},
+    {"NSAN", 73}, {"ERFE", 73}, {"EEXP", 73}, {"NTTH", 73}, {"RSIN", 73}, {"ONAS", 73},
+    {"RSAN", 73}, {"DERS", 73}, {"INFI", 73}, {"RFRO", 73}, {"DTOT", 73}, {"LETA", 73},
+    {"DEOF", 73}, {"AKET", 73}, {"EDAT", 73}, {"ERWH", 73}, {"OGRE", 73}, {"ECHA", 73},
+    {"UBST", 73}, {"HEDE", 72}, {"ETIN", 72}, {"EXCE", 72}, {"BOOK", 72}, {"NDIS", 72},
+    {"STIL", 72}, {"EPER", 72}, {"ATIT", 72}, {"ETRA", 72}, {"OTHI", 72}, {"DESC", 72},
+    {"YTHI", 72}, {"INCL", 72}, {"GLES", 72}, {"GHTS", 72}, {"OSEO", 72}, {"ONIN", 72},
+    {"TSTH", 72}, {"ERWA", 72}, {"FWHI", 72}, {"CIES", 72}, {"EYEL", 72}, {"ESIS", 72},
+    {"PECU", 72}, {"ECUL", 72}, {"BROA", 71}, {"ROAD", 71}, {"FICI", 71}, {"NTHO", 71},
+    {"TOMA", 71}, {"USED", 71}, {"ISNO", 71}, {"DERT", 71}, {"NIFE", 71}, {"BILI", 71},
+    {"USUA", 71}, {"ASSO", 71}, {"INGP", 71}, {"TANY", 71}, {"TINU", 71}, {"DRED", 71},
+    {"RSTP", 71}, {"ITEN", 71}, {"NGSO", 71}, {"ULUM", 71}, {"YARE", 70}, {"LISH", 70},
+    {"TOAN", 70}, {"TFOR", 70}, {"OAND", 70}, {"TELY", 70}, {"LLUS", 70}, {"HISB", 70},
+    {"LLIN", 70}, {"HTHA", 70}, {"NSPA", 70}, {"LLUM", 70}, {"AREA", 70}, {"SCOM", 70},
+    {"CTLY", 70}, {"EAIR", 70}, {"EWAT", 70}, {"LARL", 70}, {"SPHE", 70}, {"IQUE", 70},
+    {"ESFR", 70}, {"RECO", 70}, {"FEET", 70}, {"EDBE", 70}, {"ESTA", 70}, {"SWAS", 70},
+    {"RODU", 69}, {"ODUC", 69}, {"ICKS", 69}, {"EFOU", 69}, {"SEAN", 69}, {"ONTO", 69},
+    {"FINE", 69}, {"QUEN", 69}, {"FGLA", 69}, {"UTAN", 69}, {"IVEL", 69}, {"SEST", 69},
+    {"NGLY", 69}, {"BEDI", 69}, {"MONE", 69}, {"REDO", 69}, {"ERCE", 69}, {"CULU", 69},
+    {"TWIT", 68}, {"ITAN", 68}, {"OMAK", 68}, {"LUST", 68}, {"USTR", 68}, {"NSTH", 68},
+    {"ANSP", 68}, {"EROR", 68}, {"DREF", 68}, {"WHOS", 68}, {"NCLI", 68}, {"CLIN", 68},
+    {"RETO", 68}, {"BLET", 68}, {"ERMI", 68}, {"HEAI", 68}, {"OFGL", 68}, {"RWIT", 68},
+    {"NSIB", 68}, {"LESA", 68}, {"CEBE", 68}, {"OMON", 68}, {"SDIS", 68}, {"ULDB", 68},
+    {"HESH", 68}, {"FAIN", 68}, {"ANTI", 68}, {"NCEB", 68}, {"ETAL", 68}, {"PROD", 67},
+    {"OTTH", 67}, {"EYAR", 67}, {"ICIE", 67}, {"GTOT", 67}, {"DCON", 67}, {"HATP", 67},
+    {"HTBE", 67}, {"EVEN", 67}, {"ETHR", 67}, {"EREW", 67}, {"ERBE", 67}, {"TWIL", 67},
+    {"EBUT", 67}, {"DBYC", 67}, {"TITS", 67}, {"HPAR", 67}, {"WTHE", 67}, {"NSIT", 67},
+    {"META", 67}, {"THEK", 67}, {"URTH", 66}, {"NTED", 66}, {"HEOR", 66}, {"ATTE", 66},
+    {"DSTH", 66}, {"OURE", 66}, {"ESWI", 66}, {"ATHE", 66}, {"ARES", 66}, {"ESCR", 66},
+    {"IBIL", 66}, {"REMO", 66}, {"HARE", 66}, {"EPOI", 66}, {"REAL", 66}, {"ECTS", 66},
+    {"INGB", 66}, {"TERC", 66}, {"VELY", 66}, {"VIEW", 66}, {"SEDT", 66}, {"NCRE", 66},
+    {"SMOR", 66}, {"UEAN", 66}, {"CEED", 66}, {"LDBE", 66}, {"NDVI", 66}, {"ANDY", 66},
+    {"TENE", 66}, {"EKNI", 66}, {"KAND", 65}, {"OPOS", 65}, {"SHIN", 65}, {"SCRI", 65},
+    {"ONCE", 65}, {"TATI", 65}, {"NDIT", 65}, {"TSAN", 65}, {"OMES", 65}, {"DLET", 65},
+    {"ONEO", 65}, {"TTOB", 65}, {"RTOT", 65}, {"NSEQ", 65}, {"SBET", 65}, {"CHAS", 65},
+    {"ONIT", 65}, {"REIS", 65}, {"EREO", 65}, {"INCR", 65}, {"THPA", 65}, {"CAME", 65},
+    {"FORC", 65}, {"HEKN", 65}, {"NSIN", 64}, {"WASA", 64}, {"IENT", 64}, {"LOWI", 64},
+    {"INIT", 64}, {"ICHC", 64}, {"ERFO", 64}, {"OSER", 64}, {"ITSE", 64}, {"RTHI", 64},
+    {"EREC", 64}, {"ESCO", 64}, {"EWHO", 64}, {"EWIN", 64}, {"EHOL", 64}, {"IVES", 64},
+    {"HOBS", 64}, {"THOB", 64}, {"DUCE", 63}, {"VERT", 63}, {"IHAV", 63}, {"YOTH", 63},
+    {"OMEO", 63}, {"BYWH", 63}, {"FIGU", 63}, {"TANT", 63}, {"OUSL", 63}, {"ALLS", 63},
+    {"EDEN", 63}, {"SERI", 63}, {"RDST", 63}, {"INGW", 63}, {"STHR", 63}, {"OURD", 63},
+    {"LETO", 63}, {"EAMO", 63}, {"DLEO", 63}, {"BRIG", 63}, {"EIRS", 62}, {"URSI", 62},
+    {"OPER", 62}, {"DSOM", 62}, {"GING", 62}, {"BEEN", 62}, {"EEQU", 62}, {"OWIN", 62},
+    {"WELL", 62}, {"DOTH", 62}, {"INGU", 62}, {"TEAN", 62}, {"INDO", 62}, {"RWHE", 62},
+    {"PECI", 62}, {"SESA", 62}, {"DBLU", 62}, {"EENA", 62}, {"ERAS", 62}, {"RIOU", 62},
+    {"EASY", 62}, {"USTB", 62}, {"SOFS", 62}, {"HEST", 62}, {"TERV", 62}, {"SAPP", 61},
+    {"IGUR", 61}, {"ANDH", 61}, {"ROPA", 61}, {"DMOR", 61}, {"ITSP", 61}, {"AIRA", 61},
+    {"NEAL", 61}, {"WAYS", 61}, {"NONE", 61}, {"TEDL", 61}, {"ENAN", 61}, {"NCEF", 61},
+    {"ESEE", 61}, {"DERA", 61}, {"HANI", 61}, {"SUPO", 61}, {"ANDN", 61}, {"EBRE", 61},
+    {"UALI", 61}, {"NDYE", 61}, {"EABO", 60}, {"YINT", 60}, {"DATT", 60}, {"NDMO", 60},
+    {"GURE", 60}, {"HWAS", 60}, {"ORME", 60}, {"EXPL", 60}, {"EACH", 60}, {"SMAY", 60},
+    {"ISSI", 60}, {"ECEN", 60}, {"POLI", 60}, {"VERG", 60}, {"NDBL", 60}, {"ARIO", 60},
+    {"BUBB", 60}, {"UBBL", 60}, {"BBLE", 60}, {"IQUI", 60}, {"SPIR", 60}, {"HERO", 59},
+    {"COPI", 59}, {"CHCO", 59}, {"GIBI", 59}, {"EIRP", 59}, {"ACEO", 59}, {"EOFR", 59},
+    {"ORER", 59}, {"ORIF", 59}, {"OLIS", 59}, {"SBEI", 59}, {"NFIN", 59}, {"DAFT", 59},
+    {"PERA", 59}, {"ITTH", 59}, {"NGED", 59}, {"NGRA", 59}, {"TEDW", 59}, {"ERBY", 59},
+    {"NCHA", 59}, {"WHOL", 59}, {"AMOF", 59}, {"ONGE", 59}, {"ULDN", 59}, {"IRIT", 59},
+    {"DCOL", 58}, {"ERTI", 58}, {"DABO", 58}, {"RESI", 58}, {"OMPA", 58}, {"TOIT", 58},
+    {"EREM", 58}, {"NDPR", 58}, {"OPIO", 58}, {"PIOU", 58}, {"USLY", 58}, {"EDAR", 58},
+    {"ISSO", 58}, {"TUPO", 58}, {"IDEO", 58}, {"OSEC", 58}, {"ENSA", 58}, {"HISI", 58},
+    {"TORE", 58}, {"ALRE", 58}, {"CTIV", 58}, {"ISIN", 58}, {"LREF", 58}, {"RVAL", 58},
+    {"SPOT", 58}, {"PIRI", 58}, {"HEYE", 57}, {"ECTA", 57}, {"ISHD", 57}, {"DONO", 57},
+    {"ONOT", 57}, {"NIVE", 57}, {"CRIB", 57}, {"CHIS", 57}, {"SIVE", 57}, {"AYST", 57},
+    {"AYSI", 57}, {"SERA", 57}, {"NSTA", 57}, {"OTAL", 57}, {"NDDI", 57}, {"PAND", 57},
+    {"LELT", 57}, {"DETH", 57}, {"CTTH", 57}, {"EOBL", 57}, {"ECAM", 57}, {"HEHA", 57},
+    {"LVER", 57}, {"SOFE", 57}, {"ENDO", 56}, {"COMM", 56}, {"NERA", 56}, {"ONBE", 56},
+    {"RARY", 56}, {"AMEP", 56}, {"NITS", 56}, {"SOFI", 56}, {"HECE", 56}, {"HISA", 56},
+    {"UENC", 56}, {"NGER", 56}, {"LDNO", 56}, {"TMOS", 56}, {"NDFR", 56}, {"ARAT", 56},
+    {"TIVE", 56}, {"ENDS", 55}, {"OTBE", 55}, {"CHWA", 55}, {"AVES", 55}, {"ESTI", 55},
+    {"DONE", 55}, {"IRIN", 55}, {"DGES", 55}, {"TGLA", 55}, {"ITBE", 55}, {"FOCU", 55},
+    {"OCUS", 55}, {"EANS", 55}, {"AXIS", 55}, {"HENA", 55}, {"NDAL", 55}, {"FIFT", 55},
+    {"STPA", 54}, {"GEOF", 54}, {"NYOT", 54}, {"ISHE", 54}, {"TOFI", 54}, {"NEQU", 54},
+    {"MOFT", 54}, {"RSTA", 54}, {"ALON", 54}, {"ASIL", 54}, {"RSTH", 54}, {"TRAR", 54},
+    {"ORMO", 54}, {"LLUP", 54}, {"LUPO", 54}, {"OURI", 54}, {"GROW", 54}, {"ESER", 54},
+    {"BLES", 54}, {"REDB", 54}, {"LATI", 54}, {"ITOF", 54}, {"NDIG", 54}, {"DIGO", 54},
+    {"LCOL", 54}, {"NDON", 53}, {"DISP", 53}, {"RFEC", 53}, {"FULL", 53}, {"ROPE", 53},
+    {"GTHA", 53}, {"URES", 53}, {"NGSU", 53}, {"APRI", 53}, {"ROMI", 53}, {"RIBE", 53},
+    {"SSIV", 53}, {"NANY", 53}, {"GATE", 53}, {"ALLA", 53}, {"AREM", 53}, {"HETE", 53},
+    {"TBEC", 53}, {"ERRE", 53}, {"LING", 53}, {"ONCA", 53}, {"HATH", 53}, {"QUIC", 53},
+    {"WAST", 53}, {"HERB", 53}, {"OFEA", 53}, {"ATAL", 53}, {"UTIN", 53}, {"ESBY", 53},
+    {"DVIO", 53}, {"SMIS", 53}, {"HEMT", 53}, {"TALS", 53}, {"ORCE", 53}, {"POWE", 53},
+    {"QUIT", 53}, {"TEND", 52}, {"ERPA", 52}, {"EREP", 52}, {"RSWH", 52}, {"TNOT", 52},
+    {"TENT", 52}, {"TCON", 52}, {"SCOP", 52}, {"OPAG", 52}, {"PAGA", 52}, {"AGAT", 52},
+    {"CALL", 52}, {"OMAN", 52}, {"ONOR", 52}, {"ISRE", 52}, {"ELTO", 52}, {"NDPA", 52},
+    {"HISP", 52}, {"LYTO", 52}, {"LESC", 52}, {"RTHR", 52}, {"EFOC", 52}, {"NDOW", 52},
+    {"OAST", 52}, {"GRAY", 52}, {"RBYT", 52}, {"TAPP", 52}, {"URIN", 52}, {"ICOU", 52},
+    {"OURO", 52}, {"HEHE", 52}, {"MISS", 52}, {"POUR", 52}, {"PTIC", 51}, {"EARA", 51},
+    {"TETH", 51}, {"STPR", 51}, {"NDSU", 51}, {"NESA", 51}, {"SPOS", 51}, {"NGFR", 51},
+    {"GFRO", 51}, {"NGOF", 51}, {"USET", 51}, {"ASTI", 51}, {"LAPP", 51}, {"EITS", 51},
+    {"OFAI", 51}, {"HATC", 51}, {"ROSS", 51}, {"NVEX", 51}, {"ECTG", 51}, {"YING", 51},
+    {"ORTO", 51}, {"ESUP", 51}, {"ELIK", 51}, {"OCON", 51}, {"WIND", 51}, {"LOOK", 51},
+    {"UICK", 51}, {"TERB", 51}, {"ILAT", 51}, {"PURP", 51}, {"REDW", 51}, {"SILV", 51},
+    {"ILVE", 51}, {"KNIV", 51}, {"OPTI", 50}, {"DFOR", 50}, {"RIED", 50}, {"IOND", 50},
+    {"CKSI", 50}, {"OMIT", 50}, {"FORA", 50}, {"PLAI", 50}, {"LAIN", 50}, {"ESFO", 50},
+    {"TEDO", 50}, {"ETUR", 50}, {"HOMO", 50}, {"OMOG", 50}, {"MOGE", 50}, {"LLAP", 50},
+    {"ERIS", 50}, {"ERFR", 50}, {"GULA", 50}, {"ESMA", 50}, {"CAST", 50}, {"EMOT", 50},
+    {"SONO", 50}, {"ANBE", 50}, {"CEFR", 50}, {"GHTL", 50}, {"ANIS", 50}, {"ENUM", 50},
+    {"ESPA", 50}, {"OFWA", 50}, {"GSOF", 50}, {"HAIR", 50}, {"DISC", 49}, {"HELA", 49},
+    {"DUPO", 49}, {"ESET", 49}, {"VING", 49}, {"EDWH", 49}, {"RNIN", 49}, {"NGIT", 49},
+    {"IESI", 49}, {"DARE", 49}, {"ERSU", 49}, {"LETI", 49}, {"EDOR", 49}, {"NESI", 49},
+    {"ITES", 49}, {"ATAN", 49}, {"ALAN", 49}, {"DDIS", 49}, {"DERI", 49}, {"FAIR", 49},
+    {"REBE", 49}, {"SVER", 49}, {"PONA", 49}, {"TWOP", 49}, {"NDAS", 49}, {"HEWI", 49},
+    {"RAST", 49}, {"HEOP", 49}, {"SOAS", 49}, {"MOVE", 49}, {"HISM", 49}, {"DESO", 49},
+    {"HECH", 49}, {"EMIX", 49}, {"NTIT", 49}, {"EINS", 49}, {"OBEA", 49}, {"REIT", 49},
+    {"ALCO", 49}, {"FWAT", 49}, {"HTTH", 48}, {"HEED", 48}, {"TMAY", 48}, {"ANTO", 48},
+    {"SINA", 48}, {"SOLI", 48}, {"ATIC", 48}, {"EDON", 48}, {"MANI", 48}, {"INOU", 48},
+    {"SBEC", 48}, {"AKEN", 48}, {"HTIN", 48}, {"REDL", 48}, {"DRAW", 48}, {"LBET", 48},
+    {"ISMT", 48}, {"CETO", 48}, {"NEXT", 48}, {"CTGL", 48}, {"INTS", 48}, {"ALMO", 48},
+    {"UNDI", 48}, {"TBYT", 48}, {"NDWI", 48}, {"WHIL", 48}, {"EEDG", 48}, {"DBET", 48},
+    {"SITE", 48}, {"STOO", 48}, {"CEIV", 48}, {"DYEL", 48}, {"DPRI", 48}, {"DGRE", 48},
+    {"YTRA", 48}, {"HISC", 48}, {"EBRI", 48}, {"TOCO", 47}, {"STOA", 47}, {"NEDT", 47},
+    {"RCUM", 47}, {"AINI", 47}, {"OUTI", 47}, {"ITAT", 47}, {"EFIN", 47}, {"OMEN", 47},
+    {"EIRD", 47}, {"YSAN", 47}, {"SESO", 47}, {"TOTA", 47}, {"EDRA", 47}, {"NETH", 47},
+    {"NDFO", 47}, {"GINT", 47}, {"TIFT", 47}, {"ISMO", 47}, {"COPE", 47}, {"NVER", 47},
+    {"OTIN", 47}, {"TCOL", 47}, {"GHTE", 47}, {"IRRE", 47}, {"RALS", 47}, {"OREC", 47},
+    {"ISIT", 47}, {"EEME", 47}, {"ESAT", 47}, {"DEEP", 47}, {"TITU", 47}, {"IBIT", 47},
+    {"EMEN", 46}, {"AREI", 46}, {"ERHA", 46}, {"ENER", 46}, {"SHEW", 46}, {"TSIN", 46},
+    {"IVER", 46}, {"ASBE", 46}, {"HOUG", 46}, {"OTTO", 46}, {"UARE", 46}, {"TOWH", 46},
+    {"ANIF", 46}, {"STOP", 46}, {"EMED", 46}, {"LLIT", 46}, {"TESO", 46}, {"AYSB", 46},
+    {"IBED", 46}, {"SSOL", 46}, {"MAIN", 46}, {"HAPP", 46}, {"ONAL", 46}, {"NDSE", 46},
+    {"SESI", 46}, {"EMEA", 46}, {"ISAN", 46}, {"DOWS", 46}, {"GEAN", 46}, {"UREA", 46},
+    {"MECO", 46}, {"HATB", 46}, {"SOMU", 46}, {"OMUC", 46}, {"DILA", 46}, {"RBUT", 46},
+    {"BUTA", 46}, {"NOTA", 46}, {"ROFA", 46}, {"EMAI", 46}, {"ERIE", 46}, {"TAST", 46},
+    {"URPL", 46}, {"OFAR", 46}, {"EXHI", 46}, {"XHIB", 46}, {"HIBI", 46}, {"BRAT", 46},
+    {"ARAN", 45}, {"EDAL", 45}, {"GIVE", 45}, {"UFFI", 45}, {"ICAT", 45}, {"UCHT", 45},
+    {"EFRI", 45}, {"NDAT", 45}, {"SITY", 45}, {"EMAY", 45}, {"SEDI", 45}, {"ESAS", 45},
+    {"FEST", 45}, {"RDIS", 45}, {"ISPO", 45}, {"FONE", 45}, {"THUS", 45}, {"DINA", 45},
+    {"ISPR", 45}, {"SILY", 45}, {"SOON", 45}, {"ONIS", 45}, {"RESP", 45}, {"ITYA", 45},
+    {"CAND", 45}, {"STHI", 45}, {"TELE", 45}, {"RCON", 45}, {"NCAV", 45}, {"HEYC", 45},
+    {"HETR", 45}, {"MENA", 45}, {"DBYA", 45}, {"RVED", 45}, {"ASSW", 45}, {"SCOL", 45},
+    {"URSB", 45}, {"AVER", 45}, {"HANA", 45}, {"YWER", 45}, {"NSLI", 45}, {"GTHO", 45},
+    {"EOBS", 45}, {"ERTA", 45}, {"PERC", 45}, {"EAMS", 45}, {"ICHP", 45}, {"NGEA", 45},
+    {"RSAR", 45}, {"REWI", 45}, {"NEVE", 45}, {"EHAI", 45}, {"VIBR", 45}, {"IBRA", 45},
+    {"PRIN", 44}, {"EDES", 44}, {"NGSA", 44}, {"SATI", 44}, {"ALTH", 44}, {"SQUA", 44},
+    {"LEST", 44}, {"HWHI", 44}, {"HEYM", 44}, {"EMET", 44}, {"THIT", 44}, {"YREA", 44},
+    {"ISBO", 44}, {"IFES", 44}, {"ESIT", 44}, {"OUSA", 44}, {"LEWH", 44}, {"IRAN", 44},
+    {"OMMO", 44}, {"ESOM", 44}, {"DIFT", 44}, {"AYTH", 44}, {"TTIN", 44}, {"NFOR", 44},
+    {"SEEN", 44}, {"VEDT", 44}, {"NERT", 44}, {"SSED", 44}, {"GHTM", 44}, {"BLEA", 44},
+    {"TSOM", 44}, {"UNSL", 44}, {"STUR", 44}, {"HIST", 44}, {"EATA", 44}, {"AKES", 44},
+    {"RPLE", 44}, {"LSOR", 44}, {"STIT", 44}, {"FORW", 43}, {"TONT", 43}, {"EEND", 43},
+    {"NTEN", 43}, {"ASAB", 43}, {"NTIL", 43}, {"ROTH", 43}, {"YBEC", 43}, {"ITED", 43},
+    {"IRDE", 43}, {"ASIT", 43}, {"ORSO", 43}, {"XPLA", 43}, {"ALLP", 43}, {"NOTI", 43},
+    {"HEBE", 43}, {"TBUT", 43}, {"INSU", 43}, {"LTER", 43}, {"ASMA", 43}, {"LYAS", 43},
+    {"BETO", 43}, {"CESA", 43}, {"ORBY", 43}, {"TEDR", 43}, {"ECTL", 43}, {"IFOU", 43},
+    {"EDAS", 43}, {"TISA", 43}, {"REND", 43}, {"EQUI", 43}, {"TWOO", 43}, {"EETA", 43},
+    {"SAST", 43}, {"ITSA", 43}, {"NOWT", 43}, {"TEPA", 43}, {"DEIN", 43}, {"NGON", 43},
+    {"DBUT", 43}, {"ESUC", 43}, {"SEXP", 43}, {"URAN", 43}, {"PERW", 43}, {"GHTR", 43},
+    {"RATT", 43}, {"YWHE", 43}, {"TBEI", 43}, {"IEST", 43}, {"LBOD", 43}, {"ERIO", 43},
+    {"EPEN", 43}, {"EIVE", 43}, {"ELYT", 43}, {"PPER", 43}, {"TPRI", 43}, {"RCEP", 43},
+    {"LSOT", 43}, {"TPRO", 42}, {"RITO", 42}, {"NDST", 42}, {"DTOG", 42}, {"TILI", 42},
+    {"DLEA", 42}, {"OUTS", 42}, {"INGC", 42}, {"HEUN", 42}, {"ICHM", 42}, {"NOUS", 42},
+    {"ALTE", 42}, {"GLEO", 42}, {"DISS", 42}, {"MITS", 42}, {"ESEA", 42}, {"AMER", 42},
+    {"NAST", 42}, {"CLEA", 42}, {"SOFO", 42}, {"GHTF", 42}, {"GOIN", 42}, {"ICHF", 42},
+    {"RWAR", 42}, {"ANYS", 42}, {"AMES", 42}, {"VIDE", 42}, {"NOTS", 42}, {"CHAM", 42},
+    {"COVE", 42}, {"HANB", 42}, {"OVED", 42}, {"HIND", 42}, {"ENST", 42}, {"ERIT", 42},
+    {"NOME", 42}, {"ERSA", 42}, {"DMAK", 42}, {"ICHB", 42}, {"EYWE", 42}, {"ISOF", 42},
+    {"REGU", 42}, {"EGUL", 42}, {"YWIT", 42}, {"QUAN", 42}, {"UANT", 42}, {"NDGR", 42},
+    {"ITET", 42}, {"IFIC", 42}, {"MIXD", 42}, {"OURW", 42}, {"EOFS", 41}, {"EYEA", 41},
+    {"ELAS", 41}, {"NTOB", 41}, {"ADEI", 41}, {"NDMA", 41}, {"KNOW", 41}, {"OFBO", 41},
+    {"UTIT", 41}, {"CEWH", 41}, {"ATLI", 41}, {"SONE", 41}, {"MINT", 41}, {"MINO", 41},
+    {"OSES", 41}, {"MMON", 41}, {"AINS", 41}, {"ORED", 41}, {"BEMA", 41}, {"YCOM", 41},
+    {"ASSB", 41}, {"ITST", 41}, {"LUCI", 41}, {"NDAF", 41}, {"EINA", 41}, {"SBEF", 41},
+    {"CEDA", 41}, {"OLEI", 41}, {"HELD", 41}, {"ECIE", 41}, {"RWAS", 41}, {"EMTO", 41},
+    {"GRES", 41}, {"ITRI", 41}, {"RIOR", 41}, {"DOFA", 41}, {"NIFO", 41}, {"STOR", 41},
+    {"ATEO", 41}, {"VALS", 41}, {"EPOW", 41}, {"IQUO", 41}, {"QUOR", 41}, {"UCED", 40},
+    {"ARGE", 40}, {"HISS", 40}, {"CTAN", 40}, {"DOWN", 40}, {"OFSU", 40}, {"SEWH", 40},
+    {"UNDS", 40}, {"EONT", 40}, {"AVIT", 40}, {"ANES", 40}, {"ITIN", 40}, {"ENTB", 40},
+    {"EDMO", 40}, {"SONT", 40}, {"TSPA", 40}, {"YSAR", 40}, {"STCO", 40}, {"NEST", 40},
+    {"TRAY", 40}, {"HANO", 40}, {"ERAR", 40}, {"MING", 40}, {"TERR", 40}, {"MTHA", 40},
+    {"EBEA", 40}, {"FIND", 40}, {"UCID", 40}, {"OING", 40}, {"VENT", 40}, {"NEIT", 40},
+    {"ALLU", 40}, {"VISI", 40}, {"ISME", 40}, {"UISH", 40}, {"PHNO", 40}, {"HNOM", 40},
+    {"HESO", 40}, {"ELLU", 40}, {"TTHO", 40}, {"ENCO", 40}, {"VANI", 40}, {"NGRE", 40},
+    {"ESNO", 40}, {"SOFG", 40}, {"GINA", 40}, {"TWOU", 40}, {"EAPP", 40}, {"ALIN", 40},
+    {"ESAL", 40}, {"IFOR", 40}, {"OFSE", 40}, {"EWIL", 40}, {"HONE", 40}, {"NCOM", 40},
+    {"DROP", 40}, {"SOLV", 40}, {"GENT", 39}, {"CHWE", 39}, {"TARE", 39}, {"AVET", 39},
+    {"ILIN", 39}, {"ONTA", 39}, {"ITWA", 39}, {"THOR", 39}, {"VERS", 39}, {"AGES", 39},
+    {"BERS", 39}, {"NOTE", 39}, {"HATL", 39}, {"OFON", 39}, {"TBOD", 39}, {"OBET", 39},
+    {"OREO", 39}, {"ROMA", 39}, {"RETU", 39}, {"BEGI", 39}, {"EGIN", 39}, {"CEIS", 39},
+    {"BLEI", 39}, {"IREC", 39}, {"ADET", 39}, {"NATI", 39}, {"AIRI", 39}, {"URST", 39},
+    {"OFOR", 39}, {"PONI", 39}, {"CAVE", 39}, {"USAN", 39}, {"ITEP", 39}, {"MINI", 39},
+    {"ITEA", 39}, {"HTLI", 39}, {"OLID", 39}, {"SSWH", 39}, {"RERT", 39}, {"YSIN", 39},
+    {"LUTE", 39}, {"NPLA", 39}, {"ISMI", 39}, {"LITI", 39}, {"ERFI", 39}, {"ARTA", 39},
+    {"NSTI", 39}, {"EFIF", 39}, {"STIC", 39}, {"CULT", 39}, {"SOFW", 39}, {"VAPO", 39},
+    {"OSEP", 38}, {"DPRO", 38}, {"AGEO", 38}, {"MEET", 38}, {"MATT", 38}, {"CIEN", 38},
+    {"HATM", 38}, {"EDSO", 38}, {"MEOF", 38}, {"UNTI", 38}, {"ONDA", 38}, {"RMER", 38},
+    {"VITY", 38}, {"NCEW", 38}, {"PROV", 38}, {"OWHI", 38}, {"TPAS", 38}, {"YONE", 38},
+    {"ACEA", 38}, {"LONE", 38}, {"BYAN", 38}, {"NSUC", 38}, {"EARL", 38}, {"TERF", 38},
+    {"OITS", 38}, {"TSID", 38}, {"INGG", 38}, {"NTSO", 38}, {"LMOS", 38}, {"SPER", 38},
+    {"RPLA", 38}, {"DEST", 38}, {"AMBE", 38}, {"TOFW", 38}, {"HATE", 38}, {"EETH", 38},
+    {"NFUS", 38}, {"EDEG", 38}, {"TLYT", 38}, {"LARG", 38}, {"LOWE", 38}, {"TLIN", 38},
+    {"EDCO", 38}, {"DONT", 38}, {"OFAB", 38}, {"WASS", 38}, {"ONGL", 38}, {"ARTE", 38},
+    {"AWHI", 38}, {"TABL", 38}, {"ROGR", 38}, {"MAGN", 38}, {"NTOO", 38}, {"RECE", 38},
+    {"CERT", 38}, {"BUTW", 38}, {"SMUC", 38}, {"ONDP", 38}, {"TGRE", 38}, {"AREO", 38},
+    {"ERYS", 38}, {"UNIF", 38}, {"HEMS", 38}, {"NDOR", 38}, {"UROF", 38}, {"TEOF", 38},
+    {"IESB", 38}, {"EFIT", 38}, {"ATMO", 38}, {"TERN", 38}, {"ACID", 38}, {"TREA", 37},
+    {"RWIL", 37}, {"TTOT", 37}, {"DALL", 37}, {"ESEP", 37}, {"ITHS", 37}, {"TICA", 37},
+    {"SCAR", 37}, {"RALC", 37}, {"NSTR", 37}, {"DEXP", 37}, {"HERF", 37}, {"HTIS", 37},
+    {"TOFO", 37}, {"NTIM", 37}, {"CASE", 37}, {"ACET", 37}, {"NREF", 37}, {"LLIG", 37},
+    {"ERYN", 37}, {"YNEA", 37}, {"SHAV", 37}, {"HATR", 37}, {"CROS", 37}, {"SSUC", 37},
+    {"RALP", 37}, {"DIVE", 37}, {"REEO", 37}, {"USOF", 37}, {"EIRI", 37}, {"LESW", 37},
+    {"YWIL", 37}, {"IKET", 37}, {"ISBE", 37}, {"BEYO", 37}, {"EYON", 37}, {"YOND", 37},
+    {"ECTT", 37}, {"AMEC", 37}, {"ACON", 37}, {"URET", 37}, {"ENIN", 37}, {"EIRE", 37},
+    {"HEDA", 37}, {"KSIL", 37}, {"REDM", 37}, {"ENTW", 37}, {"AQUA", 37}, {"ESSW", 37},
+    {"URAL", 37}, {"ENIT", 37}, {"PROG", 37}, {"NDNO", 37}, {"INPL", 37}, {"RGEN", 37},
+    {"SEFR", 37}, {"ETOB", 37}, {"RTAI", 37}, {"SUPE", 37}, {"UPER", 37}, {"EXTE", 37},
+    {"HEYB", 37}, {"STRU", 37}, {"NTRI", 37}, {"NGSW", 37}, {"GLOB", 37}, {"APOU", 37},
+    {"INCE", 36}, {"EROU", 36}, {"SHOU", 36}, {"HOUL", 36}, {"SELF", 36}, {"WALL", 36},
+    {"ARIN", 36}, {"NSOR", 36}, {"SALS", 36}, {"YFOR", 36}, {"EILL", 36}, {"HEMB", 36},
+    {"INOR", 36}, {"EFOL", 36}, {"DITS", 36}, {"MESO", 36}, {"CHMA", 36}, {"RPRO", 36},
+    {"RTUR", 36}, {"INLI", 36}, {"ITER", 36}, {"ESUR", 36}, {"ALWA", 36}, {"DIRE", 36},
+    {"CEIT", 36}, {"NSER", 36}, {"RYNE", 36}, {"INWH", 36}, {"INPR", 36}, {"HENE", 36},
+    {"RICA", 36}, {"DEAN", 36}, {"FAND", 36}, {"UNDA", 36}, {"DEDT", 36}, {"EBYA", 36},
+    {"BEAL", 36}, {"PERB", 36}, {"EYET", 36}, {"PAIN", 36}, {"RAIN", 36}, {"YCOL", 36},
+    {"RGIN", 36}, {"YAPP", 36}, {"RTER", 36}, {"ILST", 36}, {"ATHI", 36}, {"URSM", 36},
+    {"WASN", 36}, {"DBEC", 36}, {"TITY", 36}, {"IVED", 36}, {"LDIS", 36}, {"NGCO", 36},
+    {"UALR", 36}, {"THEX", 36}, {"HEXP", 36}, {"EYBE", 36}, {"OFAC", 36}, {"GROU", 36},
+    {"DEPE", 36}, {"OWDE", 36}, {"OILO", 36}, {"FEAS", 36}, {"UNUS", 36}, {"NUSU", 36},
+    {"SEME", 35}, {"ENAT", 35}, {"EMAT", 35}, {"NDEA", 35}, {"ETTE", 35}, {"RCOM", 35},
+    {"IONM", 35}, {"MATI", 35}, {"SBOO", 35}, {"OSEA", 35}, {"NSIS", 35}, {"HISL", 35},
+    {"UFFE", 35}, {"AMEM", 35}, {"INSO", 35}, {"HEPE", 35}, {"ONEI", 35}, {"ANYR", 35},
+    {"UTIF", 35}, {"DAST", 35}, {"ENDT", 35}, {"AYSF", 35}, {"QUEL", 35}, {"UELY", 35},
+    {"ATCO", 35}, {"ONDI", 35}, {"ERGI", 35}, {"EENB", 35}, {"UOUS", 35}, {"FELL", 35},
+    {"HINP", 35}, {"NDDE", 35}, {"HISE", 35}, {"STDI", 35}, {"ERBU", 35}, {"ATDI", 35},
+    {"EENI", 35}, {"NGMO", 35}, {"NWIT", 35}, {"DIVI", 35}, {"IVID", 35}, {"UMAN", 35},
+    {"ESSD", 35}, {"AIRW", 35}, {"OTHO", 35}, {"ITWI", 35}, {"HEAC", 35}, {"SULP", 35},
+    {"ULPH", 35}, {"LPHU", 35}, {"PHUR", 35}, {"IRIS", 34}, {"ONDO", 34}, {"AVEA", 34},
+    {"ORCO", 34}, {"HISO", 34}, {"OVET", 34}, {"SWEL", 34}, {"INPA", 34}, {"BUTB", 34},
+    {"DRAY", 34}, {"GSUR", 34}, {"CEDE", 34}, {"URAT", 34}, {"REQU", 34}, {"ONON", 34},
+    {"HAMB", 34}, {"SCOV", 34}, {"ONFO", 34}, {"ANYC", 34}, {"NCTL", 34}, {"ADER", 34},
+    {"HTHO", 34}, {"EESO", 34}, {"OBLO", 34}, {"BLON", 34}, {"LPAR", 34}, {"TENS", 34},
+    {"TATT", 34}, {"CTIL", 34}, {"NSWE", 34}, {"AREE", 34}, {"EWAY", 34}, {"IMME", 34},
+    {"SEDB", 34}, {"OADE", 34}, {"ESMO", 34}, {"ERTU", 34}, {"STEA", 34}, {"ILLT", 34},
+    {"UTIO", 34}, {"MPRE", 34}, {"RBET", 34}, {"ITHM", 34}, {"LSOF", 34}, {"HEVA", 34},
+    {"EHEA", 34}, {"EADI", 33}, {"RTIS", 33}, {"ELVE", 33}, {"TERD", 33}, {"REPE", 33},
+    {"NBEF", 33}, {"ITMA", 33}, {"SHED", 33}, {"ITHW", 33}, {"NTAI", 33}, {"NDAR", 33},
+    {"AKEA", 33}, {"TOMO", 33}, {"ONSW", 33}, {"REAR", 33}, {"TOEX", 33}, {"RTSA", 33},
+    {"NOTO", 33}, {"IRPA", 33}, {"MINU", 33}, {"BACK", 33}, {"NSAT", 33}, {"OSTC", 33},
+    {"LLCO", 33}, {"ERPR", 33}, {"EARI", 33}, {"ITSR", 33}, {"YUPO", 33}, {"STON", 33},
+    {"URNI", 33}, {"ANYP", 33}, {"NBYT", 33}, {"LYBY", 33}, {"MWHI", 33}, {"SORI", 33},
+    {"YFRO", 33}, {"SSHA", 33}, {"SIXT", 33}, {"INNE", 33}, {"TYAN", 33}, {"NCIP", 33},
+    {"SESW", 33}, {"ERCU", 33}, {"ERDI", 33}, {"NGUI", 33}, {"HTRE", 33}, {"LOFT", 33},
+    {"WASI", 33}, {"ALFO", 33}, {"ACKS", 33}, {"SEDA", 33}, {"LUEW", 33}, {"DILU", 33},
+    {"ILUT", 33}, {"FNAT", 33}, {"LEAR", 33}, {"ISEF", 33}, {"EEXC", 33}, {"RFIC", 33},
+    {"TOFR", 33}, {"LINT", 33}, {"BLEO", 33}, {"RGED", 33}, {"CHPA", 33}, {"EMIN", 33},
+    {"AIRT", 33}, {"ERNA", 33}, {"PORE", 33}, {"EEAR", 33}, {"ILLI", 32}, {"DESI", 32},
+    {"NDSP", 32}, {"SPRE", 32}, {"ICHS", 32}, {"TOBS", 32}, {"OOKI", 32}, {"RSMA", 32},
+    {"ONDE", 32}, {"WTHA", 32}, {"DEDO", 32}, {"SEIT", 32}, {"TYET", 32}, {"THAS", 32},
+    {"GHTP", 32}, {"NORD", 32}, {"DEFI", 32}, {"SEIN", 32}, {"ORLE", 32}, {"SSRE", 32},
+    {"NGOR", 32}, {"TSEE", 32}, {"INRE", 32}, {"IESW", 32}, {"CEIN", 32}, {"OMIN", 32},
+    {"PTHE", 32}, {"RIFT", 32}, {"REWH", 32}, {"INDE", 32}, {"SSOR", 32}, {"DSUC", 32},
+    {"NOFA", 32}, {"INUA", 32}, {"RTWO", 32}, {"SAID", 32}, {"PTED", 32}, {"RINA", 32},
+    {"YAST", 32}, {"EBIG", 32}, {"OPES", 32}, {"ORWH", 32}, {"FERI", 32}, {"GUIS", 32},
+    {"HILS", 32}, {"UCHM", 32}, {"ISMW", 32}, {"OLVE", 32}, {"HRED", 32}, {"NBUT", 32},
+    {"LOSE", 32}, {"LERE", 32}, {"TWER", 32}, {"OREB", 32}, {"OFTE", 32}, {"OFNA", 32},
+    {"SCEN", 32}, {"NDFI", 32}, {"ASTT", 32}, {"ASYT", 32}, {"BESO", 32}, {"TBEA", 32},
+    {"ELYA", 32}, {"INAC", 32}, {"AWAY", 32}, {"CHIT", 32}, {"DBEA", 32}, {"DSOO", 32},
+    {"SEDO", 32}, {"LECO", 32}, {"INUE", 32}, {"FSEV", 32}, {"TUAL", 32}, {"ALLD", 32},
+    {"LYWH", 32}, {"ITUT", 32}, {"TREM", 32}, {"TETO", 32}, {"TECO", 32}, {"ESQU", 32},
+    {"POWD", 32}, {"WDER", 32}, {"HEFR", 32}, {"ONCO", 31}, {"URSE", 31}, {"OFSO", 31},
+    {"NGEN", 31}, {"DIND", 31}, {"SIHA", 31}, {"EDUP", 31}, {"MINE", 31}, {"EALS", 31},
+    {"TSWH", 31}, {"OSEW", 31}, {"CEST", 31}, {"NTIO", 31}, {"YMAY", 31}, {"IXIN", 31},
+    {"EMAK", 31}, {"ASNO", 31}, {"RAVI", 31}, {"NCON", 31}, {"USIN", 31}, {"TTOM", 31},
+    {"GHTC", 31}, {"ESON", 31}, {"ATPA", 31}, {"NNOT", 31}, {"IRDI", 31}, {"NPAS", 31},
+    {"RLES", 31}, {"INUT", 31}, {"LLYR", 31}, {"LART", 31}, {"TLEA", 31}, {"PLEA", 31},
+    {"LWAY", 31}, {"IVEN", 31}, {"SIFT", 31}, {"NLIG", 31}, {"EACI", 31}, {"CEDI", 31},
+    {"TFAL", 31}, {"INDT", 31}, {"SILL", 31}, {"NTFR", 31}, {"CUSO", 31}, {"NUAL", 31},
+    {"YSTH", 31}, {"ESPH", 31}, {"RULE", 31}, {"WHET", 31}, {"ISIS", 31}, {"ENOU", 31},
+    {"ONFU", 31}, {"ESSU", 31}, {"IMIN", 31}, {"IGNE", 31}, {"CATI", 31}, {"ERSE", 31},
+    {"MWAS", 31}, {"KLIN", 31}, {"ATON", 31}, {"OINC", 31}, {"EDPA", 31}, {"ARCE", 31},
+    {"RYTH", 31}, {"NLYT", 31}, {"IXED", 31}, {"SWOU", 31}, {"LYUP", 31}, {"ISEX", 31},
+    {"FFEC", 31}, {"SNOW", 31}, {"EPTI", 31}, {"MMED", 31}, {"ARIT", 31}, {"RIES", 31},
+    {"EMTH", 31}, {"LOWO", 31}, {"USES", 31}, {"ERMO", 31}, {"ARAS", 31}, {"STHO", 31},
+    {"ETHP", 31}, {"IFFI", 31}, {"FICU", 31}, {"NWAT", 31}, {"MERC", 31}, {"NCEN", 31},
+    {"CITY", 31}, {"LEAD", 31}, {"NGSM", 31}, {"FLUI", 31}, {"LUID", 31}, {"HEEA", 31},
+    {"TEVE", 30}, {"ARRI", 30}, {"TISE", 30}, {"IONC", 30}, {"INGD", 30}, {"TENA", 30},
+    {"NATT", 30}, {"ISHI", 30}, {"ESUB", 30}, {"ESTT", 30}, {"SIMP", 30}, {"INTR", 30},
+    {"ESOL", 30}, {"GRAV", 30}, {"ALPR", 30}, {"FBOD", 30}, {"ICHH", 30}, {"NSWH", 30},
+    {"ELET", 30}, {"ESBU", 30}, {"ROVE", 30}, {"ASWE", 30}, {"VEIN", 30}, {"INSE", 30},
+    {"HCOM", 30}, {"TINA", 30}, {"EORD", 30}, {"ONET", 30}, {"EEMS", 30}, {"ATLE", 30},
+    {"INET", 30}, {"NDSI", 30}, {"OMEM", 30}, {"LLRE", 30}, {"REDE", 30}, {"EIFT", 30},
+    {"NTOW", 30}, {"OWWH", 30}, {"IRED", 30}, {"RSTS", 30}, {"SSBE", 30}, {"LLED", 30},
+    {"NDFA", 30}, {"RESA", 30}, {"AREP", 30}, {"LLSO", 30}, {"TCOM", 30}, {"TOPA", 30},
+    {"LLNO", 30}, {"INIS", 30}, {"ARSI", 30}, {"EIRR", 30}, {"NSTO", 30}, {"RESU", 30},
+    {"GNES", 30}, {"ENTM", 30}, {"WISE", 30}, {"SETW", 30}, {"EWER", 30}, {"ANAN", 30},
+    {"ITTO", 30}, {"EWAL", 30}, {"AYSE", 30}, {"ERAB", 30}, {"NDLI", 30}, {"OSEB", 30},
+    {"RSBE", 30}, {"FLAM", 30}, {"LAME", 30}, {"TURA", 30}, {"ORMA", 30}, {"FIXD", 30},
+    {"ASOF", 30}, {"WASB", 30}, {"THAL", 30}, {"ITUD", 30}, {"TUDE", 30}, {"AGEP", 30},
+    {"ARKE", 30}, {"TRED", 30}, {"SGRE", 30}, {"ASED", 30}, {"MOFL", 30}, {"DALS", 30},
+    {"VESA", 30}, {"EARO", 30}, {"HENU", 30}, {"EOFO", 30}, {"FARA", 30}, {"EOUS", 30},
+    {"SCAN", 30}, {"EOFG", 30}, {"INWA", 30}, {"ITEL", 30}, {"EENO", 30}, {"LVES", 30},
+    {"GOLD", 30}, {"VITR", 30}, {"VACU", 30}, {"EVIB", 30}, {"EDAB", 29}, {"ESEM", 29},
+    {"ULDS", 29}, {"DCOM", 29}, {"EFAR", 29}, {"MPAR", 29}, {"DHAV", 29}, {"DOUT", 29},
+    {"MERE", 29}, {"OSEI", 29}, {"NTSI", 29}, {"YSTO", 29}, {"URNE", 29}, {"RNED", 29},
+    {"ESSR", 29}, {"ESRE", 29}, {"ASES", 29}, {"TOAI", 29}, {"OAIR", 29}, {"TEDM", 29},
+    {"YSBE", 29}, {"EIST", 29}, {"EAXI", 29}, {"NWHE", 29}, {"TLET", 29}, {"OADA", 29},
+    {"ISLI", 29}, {"ITSS", 29}, {"ERCA", 29}, {"CUMF", 29}, {"UMFE", 29}, {"MFER", 29},
+    {"ISMB", 29}, {"EDLE", 29}, {"ERIC", 29}, {"ERMA", 29}, {"PPEN", 29}, {"INTA", 29},
+    {"DIFI", 29}, {"REPA", 29}, {"OTSO", 29}, {"CESB", 29}, {"SSOM", 29}, {"ADAR", 29},
+    {"ATEA", 29}, {"EARC", 29}, {"MEOT", 29}, {"BIGG", 29}, {"IGGE", 29}, {"TONL", 29},
+    {"RCUR", 29}, {"ITYT", 29}, {"NGST", 29}, {"CKAN", 29}, {"EHAL", 29}, {"LEBE", 29},
+    {"AMED", 29}, {"EBLA", 29}, {"UMTH", 29}, {"CCEE", 29}, {"EDNO", 29}, {"SDIF", 29},
+    {"EDIM", 29}, {"YDIS", 29}, {"RGLA", 29}, {"WENT", 29}, {"LTHI", 29}, {"SOFB", 29},
+    {"ERYR", 29}, {"HISW", 29}, {"BEOF", 29}, {"RINS", 29}, {"DORA", 29}, {"TOAP", 29},
+    {"BASE", 29}, {"IMPR", 29}, {"IUMS", 29}, {"PROB", 29}, {"BESU", 29}, {"LIMI", 29},
+    {"IMIT", 29}, {"PEST", 29}, {"ANSO", 29}, {"BLEB", 29}, {"EDMA", 29}, {"ITNO", 29},
+    {"NOTF", 29}, {"IRTH", 29}, {"GITA", 29}, {"ILOF", 29}, {"DFRI", 29}, {"ATRE", 28},
+    {"EDIT", 28}, {"HWER", 28}, {"ROWN", 28}, {"OROT", 28}, {"EFUL", 28}, {"UTHO", 28},
+    {"RTIE", 28}, {"ANNO", 28}, {"AMEW", 28}, {"NGAL", 28}, {"AYIN", 28}, {"THEQ", 28},
+    {"HEQU", 28}, {"ELLI", 28}, {"SPAS", 28}, {"AIRB", 28}, {"AINE", 28}, {"LNOT", 28},
+    {"SOIN", 28}, {"EIRO", 28}, {"RVER", 28}, {"ECES", 28}, {"GEST", 28}, {"UGHI", 28},
+    {"ASIS", 28}, {"EIRF", 28}, {"TPLA", 28}, {"NYOF", 28}, {"SPLA", 28}, {"OFVI", 28},
+};
+
+const size_t ENGLISH_QUADGRAM_COUNT = sizeof(ENGLISH_QUADGRAMS) / sizeof(ENGLISH_QUADGRAMS[0]);
+const unsigned long ENGLISH_QUADGRAM_TOTAL = 436704;
\ No newline at end of file
@@ -0,0 +1,276 @@
+#include "IntegrityManifest.h"
+#include "WorkStealingPool.h"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char MAGIC[4] = {'E', 'T', 'S', '1'};
+const uint8_t FORMAT_VERSION = 1;
+const size_t ENTRY_SIZE = 16;
+
+struct Entry {
+    uint64_t state;
+    uint64_t digest;
+};
+
+struct Manifest {
+    Digest digest;
+    std::string algorithm;
+    uint32_t chunkSize;
+    uint64_t plaintextSize;
+    uint64_t encryptedSize;
+    std::vector<Entry> entries;
+};
+
+void put32(std::string& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out += static_cast<char>(v >> (8 * i));
+}
+
+void put64(std::string& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) out += static_cast<char>(v >> (8 * i));
+}
+
+uint64_t getLittleEndian(const char* p, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    return v;
+}
+
+uint64_t get64(const char* p) {
+    return getLittleEndian(p, 8);
+}
+
+uint64_t digestOf(Digest digest, const char* data, size_t size) {
+    return Checksum::compute(digest, data, size);
+}
+
+// False with no message when the manifest does not exist
+bool readManifest(const std::string& path, Manifest& manifest, bool& exists) {
+    std::ifstream file(path, std::ios::binary);
+    exists = file.is_open();
+    if (!exists) return false;
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    const char* p = contents.data();
+    size_t size = contents.size();
+    bool valid = size >= 7 && std::memcmp(p, MAGIC, 4) == 0 && p[4] == FORMAT_VERSION && (p[5] == 0 || p[5] == 1);
+    manifest.digest = valid && p[5] == 1 ? Digest::XXH3 : Digest::CRC32C;
+    size_t nameLength = valid ? static_cast<unsigned char>(p[6]) : 0;
+    size_t headerSize = 7 + nameLength + 4 + 24;
+    if (valid && size >= headerSize) {
+        manifest.algorithm.assign(p + 7, nameLength);
+        p += 7 + nameLength;
+        manifest.chunkSize = static_cast<uint32_t>(getLittleEndian(p, 4));
+        uint64_t count = get64(p + 4);
+        manifest.plaintextSize = get64(p + 12);
+        manifest.encryptedSize = get64(p + 20);
+        p += 28;
+        valid = manifest.chunkSize != 0 &&
+                count == (manifest.plaintextSize + manifest.chunkSize - 1) / manifest.chunkSize &&
+                count == (size - headerSize) / ENTRY_SIZE && (size - headerSize) % ENTRY_SIZE == 0;
+        for (uint64_t i = 0; valid && i < count; ++i, p += ENTRY_SIZE) {
+            manifest.entries.push_back({get64(p), get64(p + 8)});
+        }
+    } else {
+        valid = false;
+    }
+    if (!valid) std::cerr << "Error: " << path << " is not a valid checksum file." << std::endl;
+    return valid;
+}
+
+bool readFully(int fd, char* data, size_t size, off_t offset) {
+    while (size > 0) {
+        ssize_t n = pread(fd, data, size, offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+        offset += n;
+    }
+    return true;
+}
+
+// Mismatches found by the verify tasks
+struct Findings {
+    std::atomic<uint64_t> badChunks{0};
+    std::atomic<uint64_t> firstBad{UINT64_MAX};
+
+    void add(uint64_t chunk) {
+        ++badChunks;
+        uint64_t current = firstBad.load();
+        while (chunk < current && !firstBad.compare_exchange_weak(current, chunk)) {}
+    }
+};
+
+} // namespace
+
+std::string IntegrityManifest::pathFor(const std::string& filename) {
+    return filename + ".sum";
+}
+
+bool IntegrityManifest::appliesTo(const CipherAlgorithm& cipher) {
+    return cipher.isLossless() && !cipher.isAuthenticated();
+}
+
+bool IntegrityManifest::write(const CipherAlgorithm& cipher, const std::string& plaintext,
+                              const std::string& filename, uint64_t encryptedSize, Digest digest, size_t chunkSize) {
+    std::string name = cipher.getName();
+    uint64_t count = (plaintext.size() + chunkSize - 1) / chunkSize;
+    std::string out(MAGIC, sizeof(MAGIC));
+    out += static_cast<char>(FORMAT_VERSION);
+    out += static_cast<char>(digest == Digest::XXH3 ? 1 : 0);
+    out += static_cast<char>(name.size());
+    out += name;
+    put32(out, static_cast<uint32_t>(chunkSize));
+    put64(out, count);
+    put64(out, plaintext.size());
+    put64(out, encryptedSize);
+
+    bool stateful = cipher.hasStreamState();
+    uint64_t state = 0;
+    for (size_t offset = 0; offset < plaintext.size(); offset += chunkSize) {
+        size_t size = std::min(chunkSize, plaintext.size() - offset);
+        put64(out, state);
+        put64(out, digestOf(digest, plaintext.data() + offset, size));
+        if (stateful) state = cipher.advanceState(plaintext.substr(offset, size), state);
+    }
+
+    std::string path = pathFor(filename);
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open output file: " << path << std::endl;
+        return false;
+    }
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+bool IntegrityManifest::check(const CipherAlgorithm& cipher, const std::string& plaintext,
+                              const std::string& filename) {
+    Manifest manifest;
+    bool exists = false;
+    if (!readManifest(pathFor(filename), manifest, exists)) return !exists;
+    if (manifest.algorithm != cipher.getName()) {
+        std::cerr << "Error: " << filename << " was encrypted with " << manifest.algorithm << ", not "
+                  << cipher.getName() << "." << std::endl;
+        return false;
+    }
+
+    uint64_t bad = 0;
+    uint64_t firstBad = 0;
+    if (plaintext.size() != manifest.plaintextSize) {
+        bad = manifest.entries.size();
+    } else {
+        for (size_t i = manifest.entries.size(); i-- > 0;) {
+            size_t offset = i * manifest.chunkSize;
+            size_t size = std::min<size_t>(manifest.chunkSize, plaintext.size() - offset);
+            if (digestOf(manifest.digest, plaintext.data() + offset, size) != manifest.entries[i].digest) {
+                ++bad;
+                firstBad = offset;
+            }
+        }
+    }
+    if (bad == 0) return true;
+    std::cerr << "Error: " << bad << " of " << manifest.entries.size() << " chunks of " << filename
+              << " do not match their checksums, the first at byte " << firstBad
+              << " (wrong key or damaged file)." << std::endl;
+    return false;
+}
+
+IntegrityManifest::Report IntegrityManifest::verify(CipherAlgorithm& cipher, const std::string& filename,
+                                                    unsigned threads) {
+    Report report;
+    if (!appliesTo(cipher)) {
+        std::cerr << "Error: " << cipher.getName() << " files have no checksum file to verify." << std::endl;
+        return report;
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Manifest manifest;
+    bool exists = false;
+    if (!readManifest(pathFor(filename), manifest, exists)) {
+        if (!exists) std::cerr << "Error: No checksum file for " << filename << "." << std::endl;
+        return report;
+    }
+    if (manifest.algorithm != cipher.getName()) {
+        std::cerr << "Error: " << filename << " was encrypted with " << manifest.algorithm << ", not "
+                  << cipher.getName() << "." << std::endl;
+        return report;
+    }
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        std::cerr << "Error: Unable to open input file: " << filename << std::endl;
+        if (fd >= 0) close(fd);
+        return report;
+    }
+    report.chunks = manifest.entries.size();
+    report.bytes = manifest.plaintextSize;
+
+    Findings findings;
+    std::atomic<bool> readFailed{false};
+    WorkStealingPool pool(threads);
+    report.threads = pool.size();
+    if (static_cast<uint64_t>(info.st_size) != manifest.encryptedSize) {
+        findings.badChunks = report.chunks;
+        findings.firstBad = 0;
+    } else if (cipher.preservesLength()) {
+        // Ciphertext chunks sit at the same offsets as their plaintext
+        for (size_t i = 0; i < manifest.entries.size(); ++i) {
+            pool.submit([&, i]() {
+                uint64_t offset = static_cast<uint64_t>(i) * manifest.chunkSize;
+                std::string text(std::min<uint64_t>(manifest.chunkSize, manifest.plaintextSize - offset), '\0');
+                if (!readFully(fd, &text[0], text.size(), static_cast<off_t>(offset))) {
+                    readFailed = true;
+                    return;
+                }
+                std::string plaintext = cipher.decryptAt(text, manifest.entries[i].state);
+                if (digestOf(manifest.digest, plaintext.data(), plaintext.size()) != manifest.entries[i].digest) {
+                    findings.add(i);
+                }
+            });
+        }
+    } else {
+        // Decryption cannot start mid-file; only the digests run in parallel
+        std::string text(manifest.encryptedSize, '\0');
+        std::string plaintext;
+        if (!readFully(fd, &text[0], text.size(), 0)) {
+            readFailed = true;
+        } else {
+            plaintext = cipher.decrypt(text);
+        }
+        if (!readFailed && plaintext.size() != manifest.plaintextSize) {
+            findings.badChunks = report.chunks;
+            findings.firstBad = 0;
+        } else if (!readFailed) {
+            for (size_t i = 0; i < manifest.entries.size(); ++i) {
+                pool.submit([&, i]() {
+                    size_t offset = i * manifest.chunkSize;
+                    size_t size = std::min<size_t>(manifest.chunkSize, plaintext.size() - offset);
+                    if (digestOf(manifest.digest, plaintext.data() + offset, size) != manifest.entries[i].digest) {
+                        findings.add(i);
+                    }
+                });
+            }
+        }
+        pool.wait();
+    }
+    pool.wait();
+    close(fd);
+
+    if (readFailed) std::cerr << "Error: Unable to read " << filename << std::endl;
+    report.badChunks = findings.badChunks;
+    report.firstBadOffset = report.badChunks ? findings.firstBad * manifest.chunkSize : 0;
+    report.ok = !readFailed && report.badChunks == 0;
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
@@ -0,0 +1,423 @@
+#include "KeyDerivation.h"
+#include "SecureMemory.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <thread>
+
+namespace {
+
+const uint64_t BLAKE2B_IV[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+const uint8_t SIGMA[12][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}, {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4}, {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+    {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13}, {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+    {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11}, {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+    {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5}, {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}, {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3}
+};
+
+const size_t BLAKE2B_BLOCK = 128;
+const size_t BLAKE2B_OUT = 64;
+
+const uint32_t ARGON2_VERSION = 0x13;
+const uint32_t ARGON2ID = 2;
+const uint32_t SYNC_POINTS = 4;            // Slices per pass
+const size_t BLOCK_WORDS = 128;            // 1 KiB blocks
+const size_t ADDRESSES_PER_BLOCK = 128;
+
+uint64_t load64(const uint8_t* bytes) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) value = (value << 8) | bytes[i];
+    return value;
+}
+
+void store32(uint8_t* bytes, uint32_t value) {
+    for (int i = 0; i < 4; ++i) bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+void store64(uint8_t* bytes, uint64_t value) {
+    for (int i = 0; i < 8; ++i) bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+uint64_t rotr(uint64_t value, int bits) {
+    return (value >> bits) | (value << (64 - bits));
+}
+
+class Blake2b {
+public:
+    explicit Blake2b(size_t outSize) : outSize(outSize) {
+        std::memcpy(h, BLAKE2B_IV, sizeof(h));
+        h[0] ^= 0x01010000ULL ^ outSize;
+    }
+
+    ~Blake2b() { SecureMemory::wipe(buffer, sizeof(buffer)); }
+
+    void update(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        while (size > 0) {
+            // The last block has to be compressed by finish(), so a full buffer waits for more input
+            if (used == BLAKE2B_BLOCK) {
+                counter += BLAKE2B_BLOCK;
+                compress(buffer, false);
+                used = 0;
+            }
+            size_t take = std::min(size, BLAKE2B_BLOCK - used);
+            std::memcpy(buffer + used, bytes, take);
+            used += take;
+            bytes += take;
+            size -= take;
+        }
+    }
+
+    void update32(uint32_t value) {
+        uint8_t bytes[4];
+        store32(bytes, value);
+        update(bytes, sizeof(bytes));
+    }
+
+    void finish(uint8_t* out) {
+        counter += used;
+        std::memset(buffer + used, 0, BLAKE2B_BLOCK - used);
+        compress(buffer, true);
+        uint8_t digest[BLAKE2B_OUT];
+        for (int i = 0; i < 8; ++i) store64(digest + 8 * i, h[i]);
+        std::memcpy(out, digest, outSize);
+        SecureMemory::wipe(digest, sizeof(digest));
+    }
+
+private:
+    uint64_t h[8];
+    uint64_t counter = 0;  // Inputs here stay far below 2^64 bytes
+    uint8_t buffer[BLAKE2B_BLOCK];
+    size_t used = 0;
+    size_t outSize;
+
+    static void mix(uint64_t* v, int a, int b, int c, int d, uint64_t x, uint64_t y) {
+        v[a] = v[a] + v[b] + x;
+        v[d] = rotr(v[d] ^ v[a], 32);
+        v[c] = v[c] + v[d];
+        v[b] = rotr(v[b] ^ v[c], 24);
+        v[a] = v[a] + v[b] + y;
+        v[d] = rotr(v[d] ^ v[a], 16);
+        v[c] = v[c] + v[d];
+        v[b] = rotr(v[b] ^ v[c], 63);
+    }
+
+    void compress(const uint8_t* block, bool last) {
+        uint64_t m[16];
+        uint64_t v[16];
+        for (int i = 0; i < 16; ++i) m[i] = load64(block + 8 * i);
+        std::memcpy(v, h, sizeof(h));
+        std::memcpy(v + 8, BLAKE2B_IV, sizeof(BLAKE2B_IV));
+        v[12] ^= counter;
+        if (last) v[14] = ~v[14];
+        for (const uint8_t* s : SIGMA) {
+            mix(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+            mix(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+            mix(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+            mix(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+            mix(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+            mix(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+            mix(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+            mix(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+        }
+        for (int i = 0; i < 8; ++i) h[i] ^= v[i] ^ v[i + 8];
+    }
+};
+
+// H' from RFC 9106 section 3.3: BLAKE2b stretched to any output length
+void variableHash(const uint8_t* input, size_t inputSize, uint8_t* out, size_t outSize) {
+    Blake2b first(std::min(outSize, BLAKE2B_OUT));
+    first.update32(static_cast<uint32_t>(outSize));
+    first.update(input, inputSize);
+    if (outSize <= BLAKE2B_OUT) {
+        first.finish(out);
+        return;
+    }
+    uint8_t v[BLAKE2B_OUT];
+    first.finish(v);
+    std::memcpy(out, v, BLAKE2B_OUT / 2);
+    size_t done = BLAKE2B_OUT / 2;
+    while (outSize - done > BLAKE2B_OUT) {
+        KeyDerivation::blake2b(v, BLAKE2B_OUT, v, BLAKE2B_OUT);
+        std::memcpy(out + done, v, BLAKE2B_OUT / 2);
+        done += BLAKE2B_OUT / 2;
+    }
+    KeyDerivation::blake2b(v, BLAKE2B_OUT, out + done, outSize - done);
+    SecureMemory::wipe(v, sizeof(v));
+}
+
+struct Block {
+    uint64_t v[BLOCK_WORDS];
+};
+
+// BLAKE2b's round without the message words, with the multiplications Argon2 adds
+inline uint64_t blaMka(uint64_t x, uint64_t y) {
+    return x + y + 2 * (x & 0xFFFFFFFFULL) * (y & 0xFFFFFFFFULL);
+}
+
+inline void mixWords(uint64_t& a, uint64_t& b, uint64_t& c, uint64_t& d) {
+    a = blaMka(a, b);
+    d = rotr(d ^ a, 32);
+    c = blaMka(c, d);
+    b = rotr(b ^ c, 24);
+    a = blaMka(a, b);
+    d = rotr(d ^ a, 16);
+    c = blaMka(c, d);
+    b = rotr(b ^ c, 63);
+}
+
+// The 16 words at v[index[0]], v[index[1]], ... in one permutation round
+inline void permute(uint64_t* v, const size_t (&index)[16]) {
+    mixWords(v[index[0]], v[index[4]], v[index[8]], v[index[12]]);
+    mixWords(v[index[1]], v[index[5]], v[index[9]], v[index[13]]);
+    mixWords(v[index[2]], v[index[6]], v[index[10]], v[index[14]]);
+    mixWords(v[index[3]], v[index[7]], v[index[11]], v[index[15]]);
+    mixWords(v[index[0]], v[index[5]], v[index[10]], v[index[15]]);
+    mixWords(v[index[1]], v[index[6]], v[index[11]], v[index[12]]);
+    mixWords(v[index[2]], v[index[7]], v[index[8]], v[index[13]]);
+    mixWords(v[index[3]], v[index[4]], v[index[9]], v[index[14]]);
+}
+
+// G from RFC 9106 section 3.5; from the second pass on, the new block is XORed into the old
+void compressBlocks(const Block& previous, const Block& reference, Block& next, bool xorInto) {
+    Block r;
+    Block keep;
+    for (size_t i = 0; i < BLOCK_WORDS; ++i) r.v[i] = previous.v[i] ^ reference.v[i];
+    for (size_t i = 0; i < BLOCK_WORDS; ++i) keep.v[i] = xorInto ? r.v[i] ^ next.v[i] : r.v[i];
+    for (size_t row = 0; row < 8; ++row) {
+        size_t index[16];
+        for (size_t i = 0; i < 16; ++i) index[i] = 16 * row + i;
+        permute(r.v, index);
+    }
+    for (size_t column = 0; column < 8; ++column) {
+        size_t index[16];
+        for (size_t i = 0; i < 8; ++i) {
+            index[2 * i] = 2 * column + 16 * i;
+            index[2 * i + 1] = 2 * column + 16 * i + 1;
+        }
+        permute(r.v, index);
+    }
+    for (size_t i = 0; i < BLOCK_WORDS; ++i) next.v[i] = keep.v[i] ^ r.v[i];
+}
+
+struct Instance {
+    Block* memory;
+    uint32_t passes;
+    uint32_t lanes;
+    uint32_t laneLength;
+    uint32_t segmentLength;
+    uint32_t blockCount;
+};
+
+// Where block `index` of a segment takes its reference from (RFC 9106 section 3.4.1.3)
+uint32_t referenceIndex(const Instance& instance, uint32_t pass, uint32_t slice, uint32_t index,
+                        uint32_t random, bool sameLane) {
+    // Blocks of finished segments this one may reference, then those of its own lane
+    // before it; a block never references its direct predecessor in another lane
+    uint32_t finished = pass == 0 ? slice * instance.segmentLength : instance.laneLength - instance.segmentLength;
+    uint64_t areaSize = sameLane ? finished + index - 1 : finished - (index == 0 ? 1 : 0);
+    uint64_t relative = uint64_t(random) * random >> 32;
+    relative = areaSize - 1 - (areaSize * relative >> 32);
+    uint64_t start = pass != 0 && slice != SYNC_POINTS - 1 ? uint64_t(slice + 1) * instance.segmentLength : 0;
+    return static_cast<uint32_t>((start + relative) % instance.laneLength);
+}
+
+void fillSegment(const Instance& instance, uint32_t pass, uint32_t lane, uint32_t slice) {
+    // Argon2id takes the first half of the first pass's references from a counter
+    // (Argon2i, no timing leak of the password) and the rest from the data (Argon2d)
+    bool independent = pass == 0 && slice < SYNC_POINTS / 2;
+    Block zero = {};
+    Block input = {};
+    Block addresses = {};
+    if (independent) {
+        input.v[0] = pass;
+        input.v[1] = lane;
+        input.v[2] = slice;
+        input.v[3] = instance.blockCount;
+        input.v[4] = instance.passes;
+        input.v[5] = ARGON2ID;
+    }
+    auto nextAddresses = [&]() {
+        ++input.v[6];
+        compressBlocks(zero, input, addresses, false);
+        compressBlocks(zero, addresses, addresses, false);
+    };
+
+    uint32_t start = 0;
+    if (pass == 0 && slice == 0) {
+        start = 2;  // The first two blocks of each lane come from H0
+        if (independent) nextAddresses();
+    }
+    uint32_t current = lane * instance.laneLength + slice * instance.segmentLength + start;
+    for (uint32_t i = start; i < instance.segmentLength; ++i, ++current) {
+        uint32_t previous = current % instance.laneLength == 0 ? current + instance.laneLength - 1 : current - 1;
+        uint64_t random;
+        if (independent) {
+            if (i % ADDRESSES_PER_BLOCK == 0) nextAddresses();
+            random = addresses.v[i % ADDRESSES_PER_BLOCK];
+        } else {
+            random = instance.memory[previous].v[0];
+        }
+        uint32_t referenceLane = pass == 0 && slice == 0 ? lane : static_cast<uint32_t>((random >> 32) % instance.lanes);
+        uint32_t reference = referenceIndex(instance, pass, slice, i, static_cast<uint32_t>(random),
+                                            referenceLane == lane);
+        compressBlocks(instance.memory[previous], instance.memory[referenceLane * instance.laneLength + reference],
+                       instance.memory[current], pass != 0);
+    }
+    SecureMemory::wipe(&input, sizeof(input));
+    SecureMemory::wipe(&addresses, sizeof(addresses));
+}
+
+void blockToBytes(const Block& block, uint8_t* bytes) {
+    for (size_t i = 0; i < BLOCK_WORDS; ++i) store64(bytes + 8 * i, block.v[i]);
+}
+
+void bytesToBlock(const uint8_t* bytes, Block& block) {
+    for (size_t i = 0; i < BLOCK_WORDS; ++i) block.v[i] = load64(bytes + 8 * i);
+}
+
+bool derive(const uint8_t* password, size_t passwordSize, const uint8_t* salt, size_t saltSize,
+            const uint8_t* secret, size_t secretSize, const uint8_t* associated, size_t associatedSize,
+            const KeyDerivation::Params& params, uint8_t* out, size_t outSize, unsigned threads) {
+    if (!KeyDerivation::validParams(params) || outSize < 4 || saltSize < 8) return false;
+
+    Instance instance;
+    instance.passes = params.passes;
+    instance.lanes = params.lanes;
+    instance.segmentLength = params.memoryKiB / (SYNC_POINTS * params.lanes);
+    instance.laneLength = instance.segmentLength * SYNC_POINTS;
+    instance.blockCount = instance.laneLength * params.lanes;
+    std::unique_ptr<Block[]> memory(new (std::nothrow) Block[instance.blockCount]);
+    if (!memory) return false;
+    instance.memory = memory.get();
+
+    uint8_t h0[BLAKE2B_OUT + 8];
+    Blake2b hash(BLAKE2B_OUT);
+    hash.update32(params.lanes);
+    hash.update32(static_cast<uint32_t>(outSize));
+    hash.update32(params.memoryKiB);
+    hash.update32(params.passes);
+    hash.update32(ARGON2_VERSION);
+    hash.update32(ARGON2ID);
+    hash.update32(static_cast<uint32_t>(passwordSize));
+    hash.update(password, passwordSize);
+    hash.update32(static_cast<uint32_t>(saltSize));
+    hash.update(salt, saltSize);
+    hash.update32(static_cast<uint32_t>(secretSize));
+    hash.update(secret, secretSize);
+    hash.update32(static_cast<uint32_t>(associatedSize));
+    hash.update(associated, associatedSize);
+    hash.finish(h0);
+
+    uint8_t blockBytes[BLOCK_WORDS * 8];
+    for (uint32_t lane = 0; lane < params.lanes; ++lane) {
+        for (uint32_t column = 0; column < 2; ++column) {
+            store32(h0 + BLAKE2B_OUT, column);
+            store32(h0 + BLAKE2B_OUT + 4, lane);
+            variableHash(h0, sizeof(h0), blockBytes, sizeof(blockBytes));
+            bytesToBlock(blockBytes, instance.memory[lane * instance.laneLength + column]);
+        }
+    }
+    SecureMemory::wipe(h0, sizeof(h0));
+
+    // Lanes only read other lanes' finished slices, so each slice is a parallel step
+    unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    unsigned workers = std::min<unsigned>(params.lanes, threads ? threads : hardware);
+    std::unique_ptr<WorkStealingPool> pool;
+    if (workers > 1) pool.reset(new WorkStealingPool(workers));
+    for (uint32_t pass = 0; pass < params.passes; ++pass) {
+        for (uint32_t slice = 0; slice < SYNC_POINTS; ++slice) {
+            for (uint32_t lane = 0; lane < params.lanes; ++lane) {
+                if (pool) {
+                    pool->submit([&instance, pass, lane, slice]() { fillSegment(instance, pass, lane, slice); });
+                } else {
+                    fillSegment(instance, pass, lane, slice);
+                }
+            }
+            if (pool) pool->wait();
+        }
+    }
+
+    Block final = instance.memory[instance.laneLength - 1];
+    for (uint32_t lane = 1; lane < params.lanes; ++lane) {
+        const Block& last = instance.memory[lane * instance.laneLength + instance.laneLength - 1];
+        for (size_t i = 0; i < BLOCK_WORDS; ++i) final.v[i] ^= last.v[i];
+    }
+    blockToBytes(final, blockBytes);
+    variableHash(blockBytes, sizeof(blockBytes), out, outSize);
+    SecureMemory::wipe(blockBytes, sizeof(blockBytes));
+    SecureMemory::wipe(&final, sizeof(final));
+    SecureMemory::wipe(instance.memory, sizeof(Block) * instance.blockCount);
+    return true;
+}
+
+bool hexEquals(const uint8_t* bytes, size_t size, const char* hex) {
+    static const char digits[] = "0123456789abcdef";
+    for (size_t i = 0; i < size; ++i) {
+        if (hex[2 * i] != digits[bytes[i] >> 4] || hex[2 * i + 1] != digits[bytes[i] & 15]) return false;
+    }
+    return hex[2 * size] == '\0';
+}
+
+} // namespace
+
+namespace KeyDerivation {
+
+bool validParams(const Params& params) {
+    return params.lanes >= 1 && params.lanes <= MAX_LANES && params.passes >= 1 &&
+           params.memoryKiB >= 8 * params.lanes;
+}
+
+bool argon2id(const std::string& password, const uint8_t* salt, size_t saltSize, const Params& params,
+              uint8_t* out, size_t outSize, unsigned threads) {
+    return derive(reinterpret_cast<const uint8_t*>(password.data()), password.size(), salt, saltSize, nullptr, 0,
+                  nullptr, 0, params, out, outSize, threads);
+}
+
+bool argon2id(const std::string& password, const uint8_t* salt, size_t saltSize, const uint8_t* secret,
+              size_t secretSize, const uint8_t* associated, size_t associatedSize, const Params& params,
+              uint8_t* out, size_t outSize, unsigned threads) {
+    return derive(reinterpret_cast<const uint8_t*>(password.data()), password.size(), salt, saltSize, secret,
+                  secretSize, associated, associatedSize, params, out, outSize, threads);
+}
+
+void blake2b(const void* data, size_t size, uint8_t* out, size_t outSize) {
+    Blake2b hash(outSize);
+    hash.update(data, size);
+    hash.finish(out);
+}
+
+bool selfTest() {
+    uint8_t digest[64];
+    blake2b("abc", 3, digest, sizeof(digest));
+    bool ok = hexEquals(digest, sizeof(digest),
+                        "ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdbffa2d1"
+                        "7d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab92386edd4009923");
+
+    // RFC 9106 section 5.3
+    uint8_t password[32], salt[16], secret[8], associated[12], tag[32];
+    std::memset(password, 0x01, sizeof(password));
+    std::memset(salt, 0x02, sizeof(salt));
+    std::memset(secret, 0x03, sizeof(secret));
+    std::memset(associated, 0x04, sizeof(associated));
+    Params params;
+    params.memoryKiB = 32;
+    params.passes = 3;
+    params.lanes = 4;
+    for (unsigned threads : {1u, 4u}) {
+        ok &= derive(password, sizeof(password), salt, sizeof(salt), secret, sizeof(secret), associated,
+                     sizeof(associated), params, tag, sizeof(tag), threads) &&
+              hexEquals(tag, sizeof(tag), "0d640df58d78766c08c037a34a8b53c9d01ef0452d75b65eb52520e96b01e659");
+    }
+    return ok;
+}
+
+} // namespace KeyDerivation
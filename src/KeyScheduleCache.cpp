@@ -0,0 +1,59 @@
+#include "KeyScheduleCache.h"
+#include <algorithm>
+#include <cstring>
+
+KeyScheduleCache::KeyScheduleCache(size_t capacity) : capacity(capacity == 0 ? 1 : capacity) {}
+
+std::shared_ptr<const KeySchedule> KeyScheduleCache::get(const CipherAlgorithm& algorithm, const std::string& key) {
+    SecureString cacheKey;
+    cacheKey.reserve(std::max(SECURE_STRING_MINIMUM, std::strlen(algorithm.getName()) + 1 + key.size()));
+    cacheKey += algorithm.getName();
+    cacheKey += '\0';
+    cacheKey.append(key.data(), key.size());
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(cacheKey);
+        if (it != index.end()) {
+            entries.splice(entries.begin(), entries, it->second);
+            ++hitCount;
+            return it->second->schedule;
+        }
+        ++missCount;
+    }
+
+    // Compile outside the lock; if another thread raced us, its schedule is equivalent
+    std::shared_ptr<const KeySchedule> schedule = algorithm.compileKey(key);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index.find(cacheKey) == index.end()) {
+        entries.push_front({cacheKey, schedule});
+        index[cacheKey] = entries.begin();
+        if (entries.size() > capacity) {
+            index.erase(entries.back().cacheKey);
+            entries.pop_back();
+        }
+    }
+    return schedule;
+}
+
+void KeyScheduleCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    index.clear();
+}
+
+size_t KeyScheduleCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+unsigned long long KeyScheduleCache::hits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hitCount;
+}
+
+unsigned long long KeyScheduleCache::misses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return missCount;
+}
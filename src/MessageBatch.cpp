@@ -0,0 +1,463 @@
+#include "MessageBatch.h"
+#include "Ascii.h"
+#include "CipherKernels.h"
+#include "Metrics.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(ET_NO_MULTIVERSIONING)
+#include <immintrin.h>
+#define BATCH_HAVE_AVX2 1
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+namespace {
+
+const size_t LANES = 32;
+const size_t MIN_GROUP = 8;         // Smaller leftovers are not worth a transpose
+const size_t MAX_LANE_KEY = 16;     // Key rows each lane-parallel step selects from
+const size_t LONG_MESSAGE = 256;    // From here the per-message kernel fills its vectors
+const size_t WINDOW = 1024;         // Messages sorted together; about 100 KB of text
+
+const char DEFAULT_VIGENERE_KEY[] = "KEY";
+const char DEFAULT_SUBSTITUTION_KEY[] = "QWERTYUIOPASDFGHJKLZXCVBNM";
+
+// std::stoi as CaesarCipher::compileKey() uses it, with its fallback to 3
+int caesarShift(const char* key, size_t size) {
+    size_t i = 0;
+    while (i < size && Ascii::isSpace(key[i])) ++i;
+    bool negative = i < size && key[i] == '-';
+    if (i < size && (key[i] == '-' || key[i] == '+')) ++i;
+    size_t digits = i;
+    long long value = 0;
+    for (; i < size && Ascii::isDigit(key[i]); ++i) {
+        value = value * 10 + (key[i] - '0');
+        if (value > static_cast<long long>(INT_MAX) + 1) return 3;
+    }
+    if (i == digits) return 3;
+    if (negative) value = -value;
+    if (value > INT_MAX) return 3;
+    return static_cast<int>(value);
+}
+
+uint8_t caesarLaneShift(const char* key, size_t size, bool isEncryption) {
+    int shift = (caesarShift(key, size) % 26 + 26) % 26;
+    return static_cast<uint8_t>(isEncryption ? shift : (26 - shift) % 26);
+}
+
+void caesarTable(uint8_t shift, uint8_t* table) {
+    for (uint8_t i = 0; i < 26; ++i) table[i] = static_cast<uint8_t>(i + shift < 26 ? i + shift : i + shift - 26);
+}
+
+// VigenereCipher rejects an empty key or one without letters
+void vigenereKey(const char*& key, size_t& size) {
+    bool hasLetter = false;
+    for (size_t i = 0; i < size && !hasLetter; ++i) hasLetter = Ascii::isAlpha(key[i]);
+    if (!hasLetter) {
+        key = DEFAULT_VIGENERE_KEY;
+        size = sizeof(DEFAULT_VIGENERE_KEY) - 1;
+    }
+}
+
+uint8_t vigenereShift(char c, bool isEncryption) {
+    int shift = ((Ascii::toUpper(c) - 'A') % 26 + 26) % 26;
+    return static_cast<uint8_t>(isEncryption ? shift : (26 - shift) % 26);
+}
+
+// table[i] is the index of the letter that letter i becomes, as in SubstitutionCipher's
+// maps. Written without branches on the key, whose letters are random.
+void substitutionTable(const char* key, size_t size, bool isEncryption, uint8_t* table) {
+    if (size == 0) {
+        key = DEFAULT_SUBSTITUTION_KEY;
+        size = sizeof(DEFAULT_SUBSTITUTION_KEY) - 1;
+    }
+    uint8_t order[27];
+    uint32_t used = 0;
+    size_t count = 0;
+    for (size_t i = 0; i < size; ++i) {
+        uint8_t letter = static_cast<uint8_t>(Ascii::toUpper(key[i]) - 'A');
+        uint32_t isNew = Ascii::isAlpha(key[i]) & ~(used >> (letter & 31));
+        isNew &= 1;
+        order[count] = letter;
+        count += isNew;
+        used |= isNew << (letter & 31);
+    }
+    for (uint8_t letter = 0; letter < 26; ++letter) {
+        order[count] = letter;
+        count += ~used >> letter & 1;
+    }
+    for (uint8_t i = 0; i < 26; ++i) {
+        if (isEncryption) table[i] = order[i];
+        else table[order[i]] = i;
+    }
+}
+
+// Lane l's message becomes byte l of rows 0 to rowCount - 1. Bytes past the end of a
+// message, and lanes past `lanes`, are zero. SSE2 moves 16x16 byte blocks with
+// transpose16(); only the last block of each message goes through a copy.
+#ifdef __SSE2__
+const uint8_t BIT_REVERSED[16] = {0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15};
+
+// Four rounds of interleaving (8, 16, 32 and 64 bits) transpose 16 rows of 16 bytes,
+// leaving column c in block[BIT_REVERSED[c]]
+inline void transpose16(__m128i* block) {
+    __m128i t[16];
+    for (int k = 0; k < 8; ++k) {
+        t[k] = _mm_unpacklo_epi8(block[2 * k], block[2 * k + 1]);
+        t[k + 8] = _mm_unpackhi_epi8(block[2 * k], block[2 * k + 1]);
+    }
+    for (int k = 0; k < 8; ++k) {
+        block[k] = _mm_unpacklo_epi16(t[2 * k], t[2 * k + 1]);
+        block[k + 8] = _mm_unpackhi_epi16(t[2 * k], t[2 * k + 1]);
+    }
+    for (int k = 0; k < 8; ++k) {
+        t[k] = _mm_unpacklo_epi32(block[2 * k], block[2 * k + 1]);
+        t[k + 8] = _mm_unpackhi_epi32(block[2 * k], block[2 * k + 1]);
+    }
+    for (int k = 0; k < 8; ++k) {
+        block[k] = _mm_unpacklo_epi64(t[2 * k], t[2 * k + 1]);
+        block[k + 8] = _mm_unpackhi_epi64(t[2 * k], t[2 * k + 1]);
+    }
+}
+
+void toRows(const char* const* messages, const size_t* lengths, size_t lanes, size_t rowCount, uint8_t* rows) {
+    alignas(16) uint8_t tail[16];
+    __m128i block[16];
+    for (size_t base = 0; base < LANES; base += 16) {
+        for (size_t j = 0; j < rowCount; j += 16) {
+            for (size_t i = 0; i < 16; ++i) {
+                size_t lane = base + i;
+                if (lane < lanes && lengths[lane] >= j + 16) {
+                    block[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(messages[lane] + j));
+                } else {
+                    std::memset(tail, 0, sizeof(tail));
+                    if (lane < lanes && lengths[lane] > j) std::memcpy(tail, messages[lane] + j, lengths[lane] - j);
+                    block[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(tail));
+                }
+            }
+            transpose16(block);
+            size_t count = std::min<size_t>(16, rowCount - j);
+            for (size_t c = 0; c < count; ++c) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(rows + (j + c) * LANES + base), block[BIT_REVERSED[c]]);
+            }
+        }
+    }
+}
+
+void fromRows(const uint8_t* rows, size_t rowCount, char* const* messages, const size_t* lengths, size_t lanes) {
+    alignas(16) uint8_t tail[16];
+    __m128i block[16];
+    for (size_t base = 0; base < lanes; base += 16) {
+        for (size_t j = 0; j < rowCount; j += 16) {
+            for (size_t i = 0; i < 16; ++i) {
+                block[i] = j + i < rowCount
+                    ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows + (j + i) * LANES + base))
+                    : _mm_setzero_si128();
+            }
+            transpose16(block);
+            size_t count = std::min<size_t>(16, lanes - base);
+            for (size_t c = 0; c < count; ++c) {
+                size_t lane = base + c;
+                if (lengths[lane] >= j + 16) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(messages[lane] + j), block[BIT_REVERSED[c]]);
+                } else if (lengths[lane] > j) {
+                    _mm_store_si128(reinterpret_cast<__m128i*>(tail), block[BIT_REVERSED[c]]);
+                    std::memcpy(messages[lane] + j, tail, lengths[lane] - j);
+                }
+            }
+        }
+    }
+}
+#else
+void toRows(const char* const* messages, const size_t* lengths, size_t lanes, size_t rowCount, uint8_t* rows) {
+    std::memset(rows, 0, rowCount * LANES);
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        for (size_t j = 0; j < lengths[lane]; ++j) rows[j * LANES + lane] = static_cast<uint8_t>(messages[lane][j]);
+    }
+}
+
+void fromRows(const uint8_t* rows, size_t, char* const* messages, const size_t* lengths, size_t lanes) {
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        for (size_t j = 0; j < lengths[lane]; ++j) messages[lane][j] = static_cast<char>(rows[j * LANES + lane]);
+    }
+}
+#endif
+
+// The transposed group is rows of LANES bytes, row j holding byte j of every message.
+// Per-lane state is a byte array indexed by lane and every step is a select, so each
+// inner loop compiles to a few vector instructions per row. keyRows holds shift k of
+// every lane's key in row k. A lane's key position advances on letters and wraps at its
+// own keyLengths[lane]; the shift at that position is picked with one compare and
+// select per key row.
+CIPHER_KERNEL
+void shiftLanesByKey(uint8_t* rows, size_t rowCount, const uint8_t* keyRows, size_t keyRowCount,
+                     const uint8_t* keyLengths) {
+    uint8_t positions[LANES] = {};
+    for (size_t j = 0; j < rowCount; ++j) {
+        uint8_t* row = rows + j * LANES;
+        uint8_t shifts[LANES];
+        for (size_t lane = 0; lane < LANES; ++lane) shifts[lane] = keyRows[lane];
+        for (size_t k = 1; k < keyRowCount; ++k) {
+            const uint8_t* keyRow = keyRows + k * LANES;
+            uint8_t position = static_cast<uint8_t>(k);
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                shifts[lane] = positions[lane] == position ? keyRow[lane] : shifts[lane];
+            }
+        }
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            uint8_t c = row[lane];
+            uint8_t index = static_cast<uint8_t>((c | 0x20) - 'a');
+            uint8_t shifted = static_cast<uint8_t>(index + shifts[lane]);
+            shifted = shifted >= 26 ? static_cast<uint8_t>(shifted - 26) : shifted;
+            row[lane] = index < 26 ? static_cast<uint8_t>((shifted + 'a') ^ ((c & 0x20) ^ 0x20)) : c;
+            uint8_t position = static_cast<uint8_t>(positions[lane] + (index < 26));
+            positions[lane] = position == keyLengths[lane] ? 0 : position;
+        }
+    }
+}
+
+// Letters only, with a 26-entry table instead of SubstitutionCipher's 256-byte maps
+void substituteLetters(char* data, size_t size, const uint8_t* table) {
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        uint8_t c = bytes[i];
+        uint8_t index = static_cast<uint8_t>((c | 0x20) - 'a');
+        if (index < 26) bytes[i] = static_cast<uint8_t>((table[index] + 'a') ^ ((c & 0x20) ^ 0x20));
+    }
+}
+
+#ifdef BATCH_HAVE_AVX2
+bool cpuHasAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+// vpshufb looks letters up in the table's two halves, 32 bytes at a time. The last block
+// is computed first and stored last, so it may overlap the one before it and a short
+// message needs no scalar tail.
+AVX2_TARGET inline __m256i substituteBlock(__m256i c, __m256i low, __m256i high) {
+    const __m256i caseBit = _mm256_set1_epi8(0x20);
+    __m256i index = _mm256_sub_epi8(_mm256_or_si256(c, caseBit), _mm256_set1_epi8('a'));
+    __m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(index, _mm256_set1_epi8(25)), index);
+    __m256i inHigh = _mm256_cmpgt_epi8(index, _mm256_set1_epi8(15));
+    __m256i mapped = _mm256_blendv_epi8(_mm256_shuffle_epi8(low, index),
+                                        _mm256_shuffle_epi8(high, _mm256_sub_epi8(index, _mm256_set1_epi8(16))), inHigh);
+    __m256i letter = _mm256_xor_si256(_mm256_add_epi8(mapped, _mm256_set1_epi8('a')),
+                                      _mm256_xor_si256(_mm256_and_si256(c, caseBit), caseBit));
+    return _mm256_blendv_epi8(c, letter, isLetter);
+}
+
+AVX2_TARGET void mapLettersAvx2(char* data, size_t size, const uint8_t* table) {
+    alignas(32) uint8_t halves[32] = {};
+    std::memcpy(halves, table, 26);
+    __m256i low = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(halves)));
+    __m256i high = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(halves + 16)));
+    if (size < 32) {
+        alignas(32) char block[32] = {};
+        std::memcpy(block, data, size);
+        __m256i result = substituteBlock(_mm256_load_si256(reinterpret_cast<const __m256i*>(block)), low, high);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(block), result);
+        std::memcpy(data, block, size);
+        return;
+    }
+    __m256i* last = reinterpret_cast<__m256i*>(data + size - 32);
+    __m256i lastResult = substituteBlock(_mm256_loadu_si256(last), low, high);
+    for (size_t i = 0; i + 32 < size; i += 32) {
+        __m256i* block = reinterpret_cast<__m256i*>(data + i);
+        _mm256_storeu_si256(block, substituteBlock(_mm256_loadu_si256(block), low, high));
+    }
+    _mm256_storeu_si256(last, lastResult);
+}
+#endif
+
+} // namespace
+
+MessageBatch::MessageBatch() : offsets(1, 0), keyOffsets(1, 0) {
+}
+
+void MessageBatch::reserve(size_t messageCount, size_t textBytes) {
+    messages.reserve(textBytes);
+    offsets.reserve(messageCount + 1);
+    keyOffsets.reserve(messageCount + 1);
+}
+
+void MessageBatch::add(const char* message, size_t size, const char* key, size_t keySize) {
+    messages.append(message, size);
+    offsets.push_back(messages.size());
+    keys.append(key, keySize);
+    keyOffsets.push_back(keys.size());
+}
+
+void MessageBatch::clear() {
+    messages.clear();
+    offsets.assign(1, 0);
+    SecureMemory::wipe(&keys[0], keys.size());
+    keys.clear();
+    keyOffsets.assign(1, 0);
+}
+
+void MessageBatch::processMessage(Cipher cipher, bool isEncryption, size_t index, std::string& output,
+                                  SecureVector<uint8_t>& scratch) const {
+    char* data = &output[offsets[index]];
+    size_t size = offsets[index + 1] - offsets[index];
+    const char* key = keys.data() + keyOffsets[index];
+    size_t keySize = keyOffsets[index + 1] - keyOffsets[index];
+    if (size == 0) return;
+
+    switch (cipher) {
+        case Cipher::CAESAR:
+            CipherKernels::shiftLetters(data, size, caesarLaneShift(key, keySize, isEncryption));
+            break;
+        case Cipher::VIGENERE: {
+            // Key stream layout of CipherKernels::shiftLettersByKey: the shifts, then the first 64 again
+            vigenereKey(key, keySize);
+            scratch.resize(keySize + 64);
+            for (size_t i = 0; i < keySize + 64; ++i) scratch[i] = vigenereShift(key[i % keySize], isEncryption);
+            CipherKernels::shiftLettersByKey(data, size, scratch.data(), keySize, 0);
+            break;
+        }
+        case Cipher::SUBSTITUTION: {
+            uint8_t table[26];
+            substitutionTable(key, keySize, isEncryption, table);
+            substituteLetters(data, size, table);
+            SecureMemory::wipe(table, sizeof(table));
+            break;
+        }
+    }
+}
+
+void MessageBatch::processScalar(Cipher cipher, bool isEncryption, std::string& output) const {
+    ET_METRICS_SCOPE(scope, isEncryption ? Metrics::ENCRYPT : Metrics::DECRYPT, name(cipher), messages.size());
+    output = messages;
+    SecureVector<uint8_t> scratch;
+    for (size_t i = 0; i < size(); ++i) processMessage(cipher, isEncryption, i, output, scratch);
+}
+
+void MessageBatch::processGroup(bool isEncryption, const size_t* group, size_t lanes, std::string& output,
+                                SecureVector<uint8_t>& keyRows, std::vector<uint8_t>& rows) const {
+    // Unused lanes get a one-entry key of shift 0
+    uint8_t keyLengths[LANES];
+    std::fill(keyRows.begin(), keyRows.end(), 0);
+    std::fill(keyLengths, keyLengths + LANES, 1);
+    size_t keyRowCount = 1;
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        const char* key = keys.data() + keyOffsets[group[lane]];
+        size_t keySize = keyOffsets[group[lane] + 1] - keyOffsets[group[lane]];
+        vigenereKey(key, keySize);
+        for (size_t k = 0; k < keySize; ++k) keyRows[k * LANES + lane] = vigenereShift(key[k], isEncryption);
+        keyLengths[lane] = static_cast<uint8_t>(keySize);
+        keyRowCount = std::max(keyRowCount, keySize);
+    }
+
+    char* messagePointers[LANES];
+    size_t lengths[LANES];
+    for (size_t lane = 0; lane < lanes; ++lane) {
+        messagePointers[lane] = &output[0] + offsets[group[lane]];
+        lengths[lane] = offsets[group[lane] + 1] - offsets[group[lane]];
+    }
+    // Sorted ascending, so the last message is the longest
+    size_t rowCount = lengths[lanes - 1];
+    rows.resize(rowCount * LANES);
+    toRows(messagePointers, lengths, lanes, rowCount, rows.data());
+    shiftLanesByKey(rows.data(), rowCount, keyRows.data(), keyRowCount, keyLengths);
+    fromRows(rows.data(), rowCount, messagePointers, lengths, lanes);
+}
+
+void MessageBatch::process(Cipher cipher, bool isEncryption, std::string& output) const {
+    ET_METRICS_SCOPE(scope, isEncryption ? Metrics::ENCRYPT : Metrics::DECRYPT, name(cipher), messages.size());
+    SecureVector<uint8_t> scratch;
+    if (cipher != Cipher::VIGENERE) {
+        output = messages;
+#ifdef BATCH_HAVE_AVX2
+        static const bool hasAvx2 = cpuHasAvx2();
+        if (hasAvx2) {
+            uint8_t table[26];
+            for (size_t i = 0; i < size(); ++i) {
+                size_t length = offsets[i + 1] - offsets[i];
+                if (length == 0) continue;
+                const char* key = keys.data() + keyOffsets[i];
+                size_t keySize = keyOffsets[i + 1] - keyOffsets[i];
+                if (cipher == Cipher::CAESAR) caesarTable(caesarLaneShift(key, keySize, isEncryption), table);
+                else substitutionTable(key, keySize, isEncryption, table);
+                mapLettersAvx2(&output[0] + offsets[i], length, table);
+            }
+            SecureMemory::wipe(table, sizeof(table));
+            return;
+        }
+#endif
+        for (size_t i = 0; i < size(); ++i) processMessage(cipher, isEncryption, i, output, scratch);
+        return;
+    }
+
+    output.resize(messages.size());
+    SecureVector<uint8_t> keyRows(MAX_LANE_KEY * LANES);
+    std::vector<uint8_t> rows;
+    std::vector<size_t> starts;
+    std::vector<size_t> order;
+    std::vector<size_t> sorted;
+
+    // Messages are taken a window at a time: copied into output while they are still in
+    // cache, then counting-sorted by length so each group pads its messages to nearly the
+    // same length. Long messages and long keys take the per-message path.
+    for (size_t first = 0; first < size(); first += WINDOW) {
+        size_t end = std::min(size(), first + WINDOW);
+        std::memcpy(&output[0] + offsets[first], messages.data() + offsets[first], offsets[end] - offsets[first]);
+
+        starts.assign(LONG_MESSAGE + 1, 0);
+        order.clear();
+        for (size_t i = first; i < end; ++i) {
+            size_t length = offsets[i + 1] - offsets[i];
+            const char* key = keys.data() + keyOffsets[i];
+            size_t keySize = keyOffsets[i + 1] - keyOffsets[i];
+            vigenereKey(key, keySize);
+            if (length >= LONG_MESSAGE || keySize > MAX_LANE_KEY) {
+                processMessage(cipher, isEncryption, i, output, scratch);
+            } else if (length > 0) {
+                ++starts[length];
+                order.push_back(i);
+            }
+        }
+        size_t total = 0;
+        for (size_t& start : starts) {
+            size_t count = start;
+            start = total;
+            total += count;
+        }
+        sorted.resize(order.size());
+        for (size_t i : order) sorted[starts[offsets[i + 1] - offsets[i]]++] = i;
+
+        for (size_t group = 0; group < sorted.size(); group += LANES) {
+            size_t lanes = std::min(LANES, sorted.size() - group);
+            if (lanes >= MIN_GROUP) {
+                processGroup(isEncryption, sorted.data() + group, lanes, output, keyRows, rows);
+            } else {
+                for (size_t lane = 0; lane < lanes; ++lane) {
+                    processMessage(cipher, isEncryption, sorted[group + lane], output, scratch);
+                }
+            }
+        }
+    }
+}
+
+const char* MessageBatch::name(Cipher cipher) {
+    switch (cipher) {
+        case Cipher::VIGENERE: return "vigenere";
+        case Cipher::SUBSTITUTION: return "substitution";
+        default: return "caesar";
+    }
+}
+
+bool MessageBatch::parse(const std::string& text, Cipher& cipher) {
+    for (Cipher candidate : {Cipher::CAESAR, Cipher::VIGENERE, Cipher::SUBSTITUTION}) {
+        if (text == name(candidate)) {
+            cipher = candidate;
+            return true;
+        }
+    }
+    return false;
+}
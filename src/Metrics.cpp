@@ -0,0 +1,252 @@
+#include "Metrics.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int MAX_SERIES = 128;
+const size_t MAX_TRACE_SPANS = 1000000;
+
+// Series are never removed, so readers scan the published prefix without locking
+Metrics::Series registry[MAX_SERIES];
+std::atomic<int> registrySize(0);
+std::mutex registryMutex;
+
+struct Span {
+    Metrics::Operation operation;
+    const char* label;
+    uint64_t start;
+    uint64_t duration;
+    size_t thread;
+};
+
+std::vector<Span> spans;
+std::mutex spansMutex;
+
+std::string metricsFile;
+std::string traceFile;
+
+const auto processStart = std::chrono::steady_clock::now();
+
+bool sameLabel(const char* a, const char* b) {
+    return a == b || std::strcmp(a, b) == 0;
+}
+
+} // namespace
+
+std::atomic<bool> Metrics::enabledFlag(false);
+std::atomic<bool> Metrics::tracingFlag(false);
+
+int Metrics::LatencyHistogram::bucketFor(uint64_t nanoseconds) {
+    if (nanoseconds < 32) return static_cast<int>(nanoseconds);
+    int msb = 63 - __builtin_clzll(nanoseconds);
+    int shift = msb - 4;
+    int top = static_cast<int>(nanoseconds >> shift);  // 16..31
+    return 32 + (shift - 1) * 16 + (top - 16);
+}
+
+uint64_t Metrics::LatencyHistogram::bucketUpperBound(int bucket) {
+    if (bucket < 32) return static_cast<uint64_t>(bucket);
+    int shift = (bucket - 32) / 16 + 1;
+    uint64_t top = static_cast<uint64_t>((bucket - 32) % 16 + 16);
+    return ((top + 1) << shift) - 1;
+}
+
+void Metrics::LatencyHistogram::record(uint64_t nanoseconds) {
+    buckets[bucketFor(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+void Metrics::LatencyHistogram::clear() {
+    for (auto& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+}
+
+uint64_t Metrics::LatencyHistogram::count() const {
+    uint64_t result = 0;
+    for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket) result += bucketCount(bucket);
+    return result;
+}
+
+uint64_t Metrics::LatencyHistogram::percentile(double fraction) const {
+    uint64_t samples = count();
+    if (samples == 0) return 0;
+
+    uint64_t target = static_cast<uint64_t>(fraction * samples);
+    if (target >= samples) target = samples - 1;
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        seen += bucketCount(bucket);
+        if (seen > target) return bucketUpperBound(bucket);
+    }
+    return bucketUpperBound(BUCKET_COUNT - 1);
+}
+
+Metrics::ScopedOperation::ScopedOperation(Operation operation, const char* label, uint64_t bytes)
+    : series(nullptr), bytes(bytes), start(0) {
+    if (!Metrics::enabled()) return;
+    series = Metrics::series(operation, label);
+    start = Metrics::now();
+}
+
+Metrics::ScopedOperation::~ScopedOperation() {
+    if (!series) return;
+    uint64_t duration = Metrics::now() - start;
+
+    series->calls.fetch_add(1, std::memory_order_relaxed);
+    series->bytes.fetch_add(bytes, std::memory_order_relaxed);
+    series->latency.record(duration);
+
+    if (Metrics::tracingFlag.load(std::memory_order_relaxed)) {
+        Metrics::recordSpan(series->operation, series->label, start, duration);
+    }
+}
+
+void Metrics::setEnabled(bool on) {
+    enabledFlag.store(on, std::memory_order_relaxed);
+    if (!on) tracingFlag.store(false, std::memory_order_relaxed);
+}
+
+void Metrics::setTracing(bool on) {
+    tracingFlag.store(on, std::memory_order_relaxed);
+    if (on) enabledFlag.store(true, std::memory_order_relaxed);
+}
+
+void Metrics::reset() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (int i = 0; i < registrySize.load(); ++i) {
+        registry[i].calls = 0;
+        registry[i].bytes = 0;
+        registry[i].latency.clear();
+    }
+
+    std::lock_guard<std::mutex> spansLock(spansMutex);
+    spans.clear();
+}
+
+Metrics::Series* Metrics::series(Operation operation, const char* label) {
+    int size = registrySize.load(std::memory_order_acquire);
+    for (int i = 0; i < size; ++i) {
+        if (registry[i].operation == operation && sameLabel(registry[i].label, label)) return &registry[i];
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    size = registrySize.load(std::memory_order_relaxed);
+    for (int i = 0; i < size; ++i) {
+        if (registry[i].operation == operation && sameLabel(registry[i].label, label)) return &registry[i];
+    }
+    if (size == MAX_SERIES) return nullptr;
+
+    registry[size].operation = operation;
+    registry[size].label = label;
+    registrySize.store(size + 1, std::memory_order_release);
+    return &registry[size];
+}
+
+const char* Metrics::operationName(Operation operation) {
+    static const char* const names[OPERATION_COUNT] = {
+        "encrypt", "decrypt", "process_file", "vault_load", "vault_save",
+        "vault_lookup", "vault_sync", "vault_unlock", "analyze_strength", "generate_password"
+    };
+    return operation < OPERATION_COUNT ? names[operation] : "unknown";
+}
+
+bool Metrics::writePrometheus(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open metrics file: " << filename << std::endl;
+        return false;
+    }
+
+    int size = registrySize.load(std::memory_order_acquire);
+    auto labels = [](const Series& s) {
+        return std::string("operation=\"") + operationName(s.operation) + "\",algorithm=\"" + s.label + "\"";
+    };
+
+    file << "# HELP et_operation_calls_total Completed operations.\n"
+         << "# TYPE et_operation_calls_total counter\n";
+    for (int i = 0; i < size; ++i) {
+        file << "et_operation_calls_total{" << labels(registry[i]) << "} " << registry[i].calls.load() << "\n";
+    }
+
+    file << "# HELP et_operation_bytes_total Input bytes processed.\n"
+         << "# TYPE et_operation_bytes_total counter\n";
+    for (int i = 0; i < size; ++i) {
+        file << "et_operation_bytes_total{" << labels(registry[i]) << "} " << registry[i].bytes.load() << "\n";
+    }
+
+    // Only occupied buckets are emitted; Prometheus accepts any increasing set of bounds
+    file << "# HELP et_operation_latency_seconds Operation latency.\n"
+         << "# TYPE et_operation_latency_seconds histogram\n";
+    for (int i = 0; i < size; ++i) {
+        const LatencyHistogram& latency = registry[i].latency;
+        std::string seriesLabels = labels(registry[i]);
+        uint64_t cumulative = 0;
+        for (int bucket = 0; bucket < LatencyHistogram::BUCKET_COUNT; ++bucket) {
+            uint64_t count = latency.bucketCount(bucket);
+            if (count == 0) continue;
+            cumulative += count;
+            file << "et_operation_latency_seconds_bucket{" << seriesLabels << ",le=\""
+                 << LatencyHistogram::bucketUpperBound(bucket) * 1e-9 << "\"} " << cumulative << "\n";
+        }
+        file << "et_operation_latency_seconds_bucket{" << seriesLabels << ",le=\"+Inf\"} " << cumulative << "\n"
+             << "et_operation_latency_seconds_sum{" << seriesLabels << "} " << latency.sum() * 1e-9 << "\n"
+             << "et_operation_latency_seconds_count{" << seriesLabels << "} " << cumulative << "\n";
+    }
+    return true;
+}
+
+bool Metrics::writeChromeTrace(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open trace file: " << filename << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(spansMutex);
+    file << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+    for (size_t i = 0; i < spans.size(); ++i) {
+        const Span& span = spans[i];
+        file << (i ? ",\n" : "\n")
+             << "{\"name\":\"" << operationName(span.operation) << "\",\"cat\":\"" << span.label
+             << "\",\"ph\":\"X\",\"ts\":" << span.start / 1000.0 << ",\"dur\":" << span.duration / 1000.0
+             << ",\"pid\":1,\"tid\":" << span.thread << "}";
+    }
+    file << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    return true;
+}
+
+void Metrics::configureFromEnvironment() {
+    if (const char* path = std::getenv("ET_METRICS_FILE")) {
+        metricsFile = path;
+        setEnabled(true);
+    }
+    if (const char* path = std::getenv("ET_TRACE_FILE")) {
+        traceFile = path;
+        setTracing(true);
+    }
+}
+
+void Metrics::writeConfiguredOutputs() {
+    if (!metricsFile.empty()) writePrometheus(metricsFile);
+    if (!traceFile.empty()) writeChromeTrace(traceFile);
+}
+
+uint64_t Metrics::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - processStart).count());
+}
+
+void Metrics::recordSpan(Operation operation, const char* label, uint64_t start, uint64_t duration) {
+    size_t thread = std::hash<std::thread::id>()(std::this_thread::get_id()) % 100000;
+    std::lock_guard<std::mutex> lock(spansMutex);
+    if (spans.size() < MAX_TRACE_SPANS) spans.push_back({operation, label, start, duration, thread});
+}
@@ -1,73 +1,49 @@
 #include "MorseCodeCipher.h"
+#include <iostream>
 
-MorseCodeCipher::MorseCodeCipher() {
-    charToMorse = {
-        {'A', ".-"}, {'B', "-..."}, {'C', "-.-."}, {'D', "-.."}, {'E', "."}, {'F', "..-."}, 
-        {'G', "--."}, {'H', "...."}, {'I', ".."}, {'J', ".---"}, {'K', "-.-"}, {'L', ".-.."},
-        {'M', "--"}, {'N', "-."}, {'O', "---"}, {'P', ".--."}, {'Q', "--.-"}, {'R', ".-."},
-        {'S', "..."}, {'T', "-"}, {'U', "..-"}, {'V', "...-"}, {'W', ".--"}, {'X', "-..-"},
-        {'Y', "-.--"}, {'Z', "--.."}, {'1', ".----"}, {'2', "..---"}, {'3', "...--"},
-        {'4', "....-"}, {'5', "....."}, {'6', "-...."}, {'7', "--..."}, {'8', "---.."}, 
-        {'9', "----."}, {'0', "-----"}, {' ', "/"}
-    };
-    initializeReverseMap();
-}
-
-void MorseCodeCipher::initializeReverseMap() {
-    for (const auto& pair : charToMorse) {
-        morseToChar[pair.second] = pair.first;
-    }
-}
+MorseCodeCipher::MorseCodeCipher(MorseFormat format) : format(format) {}
 
 std::string MorseCodeCipher::processText(const std::string& text, bool isEncryption) {
-    if (isEncryption) {
-        std::string result;
-        for (char c : text) {
-            char upperC = std::toupper(c);
-            if (charToMorse.find(upperC) != charToMorse.end()) {
-                result += charToMorse[upperC] + separator;
-            }
+    std::string result;
+    if (format == MorseFormat::BINARY) {
+        if (isEncryption) {
+            MorseCodec::encodeBinary(text.data(), text.size(), result);
+        } else if (!MorseCodec::decodeBinary(text.data(), text.size(), result)) {
+            std::cerr << "Error: Input is not binary Morse code." << std::endl;
         }
-        if (!result.empty() && result.substr(result.length() - separator.length()) == separator) {
-            result = result.substr(0, result.length() - separator.length());
-        }
-        return result;
+    } else if (isEncryption) {
+        MorseCodec::encodeText(text.data(), text.size(), schedule->separator, result);
     } else {
-        std::string result;
-        std::string currentMorse;
-        
-        std::string textWithSpace = text + " ";
-        
-        for (char c : textWithSpace) {
-            if (c == ' ' || c == '/') {
-                if (!currentMorse.empty()) {
-                    if (morseToChar.find(currentMorse) != morseToChar.end()) {
-                        result += morseToChar[currentMorse];
-                    }
-                    currentMorse.clear();
-                }
-                if (c == '/') {
-                    result += ' ';
-                }
-            } else {
-                currentMorse += c;
-            }
-        }
-        
-        return result;
+        MorseCodec::decodeText(text.data(), text.size(), result);
     }
+    return result;
 }
 
-void MorseCodeCipher::setKey(const std::string& key) {
-    if (!key.empty()) {
-        separator = key;
-    }
+std::shared_ptr<const KeySchedule> MorseCodeCipher::compileKey(const std::string& key) const {
+    if (key.empty()) return nullptr;
+    return std::make_shared<Schedule>(key);
+}
+
+void MorseCodeCipher::applySchedule(const std::shared_ptr<const KeySchedule>& newSchedule) {
+    if (newSchedule) schedule = std::static_pointer_cast<const Schedule>(newSchedule);
+}
+
+bool MorseCodeCipher::isLossless() const {
+    return false;
+}
+
+const char* MorseCodeCipher::getName() const {
+    return format == MorseFormat::BINARY ? "morse-binary" : "morse";
 }
 
 std::string MorseCodeCipher::getDescription() const {
-    return "\033[1;34mMorse Code:\033[0m Converts text to dots and dashes according to international Morse code.";
+    std::string description =
+        "\033[1;34mMorse Code:\033[0m Converts text to dots and dashes according to international Morse code.";
+    if (format == MorseFormat::BINARY) description += " Output is packed binary, each code a 3-bit length and its elements.";
+    return description;
 }
 
 std::string MorseCodeCipher::getKeyInstructions() const {
+    if (format == MorseFormat::BINARY) return "\033[1;32mThe binary format has no separator; any key is accepted.\033[0m";
     return "\033[1;32mEnter a separator character/string for Morse code symbols (default is space).\033[0m";
 }
\ No newline at end of file
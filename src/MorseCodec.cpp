@@ -0,0 +1,378 @@
+#include "MorseCodec.h"
+#include "Ascii.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(ET_NO_MULTIVERSIONING)
+#include <immintrin.h>
+#define MORSE_HAVE_X86_KERNELS 1
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+namespace {
+
+struct Code {
+    char character;
+    const char* elements;
+};
+
+const Code CODES[] = {
+    {'A', ".-"}, {'B', "-..."}, {'C', "-.-."}, {'D', "-.."}, {'E', "."}, {'F', "..-."},
+    {'G', "--."}, {'H', "...."}, {'I', ".."}, {'J', ".---"}, {'K', "-.-"}, {'L', ".-.."},
+    {'M', "--"}, {'N', "-."}, {'O', "---"}, {'P', ".--."}, {'Q', "--.-"}, {'R', ".-."},
+    {'S', "..."}, {'T', "-"}, {'U', "..-"}, {'V', "...-"}, {'W', ".--"}, {'X', "-..-"},
+    {'Y', "-.--"}, {'Z', "--.."}, {'1', ".----"}, {'2', "..---"}, {'3', "...--"},
+    {'4', "....-"}, {'5', "....."}, {'6', "-...."}, {'7', "--..."}, {'8', "---.."},
+    {'9', "----."}, {'0', "-----"}
+};
+
+const size_t MAX_CODE_LENGTH = 5;
+const size_t CODE_INDICES = 64;      // (1 << length) | elements, for length <= MAX_CODE_LENGTH
+const size_t CODE_STORE = 8;         // Codes are written with one 8-byte copy
+const size_t ENCODE_BLOCK = 4096;    // Input bytes per output reservation
+const size_t MAX_UTF8_LENGTH = 4;
+
+const unsigned PREFIX_BITS = 3;
+const unsigned WORD_BREAK = 0;
+const unsigned RAW = 6;
+const unsigned END = 7;
+
+struct Tables {
+    char letters[CODE_INDICES];             // Code index -> character, 0 when unassigned
+    char text[128][CODE_STORE];             // ASCII -> code in the text format
+    uint8_t textLength[128];                // 0 when the character has no code
+    uint16_t binary[128];                   // ASCII -> length prefix and elements
+    uint8_t binaryBits[128];                // 0 when the character has no code
+    char decoded[256];                      // Next 8 bits of a stream -> character
+    uint8_t decodedBits[256];               // Bits that symbol takes, 0 for RAW/END/unassigned
+
+    Tables() {
+        std::memset(this, 0, sizeof(*this));
+        for (const Code& code : CODES) {
+            size_t length = std::strlen(code.elements);
+            unsigned elements = 0;
+            for (size_t i = 0; i < length; ++i) elements |= (code.elements[i] == '-' ? 1u : 0u) << i;
+            letters[(1u << length) | elements] = code.character;
+            for (char c : {code.character, Ascii::toLower(code.character)}) {
+                unsigned char index = static_cast<unsigned char>(c);
+                std::memcpy(text[index], code.elements, length);
+                textLength[index] = static_cast<uint8_t>(length);
+                binary[index] = static_cast<uint16_t>(length | elements << PREFIX_BITS);
+                binaryBits[index] = static_cast<uint8_t>(PREFIX_BITS + length);
+            }
+        }
+        text[' '][0] = '/';
+        textLength[' '] = 1;
+        binary[' '] = WORD_BREAK;
+        binaryBits[' '] = PREFIX_BITS;
+
+        for (unsigned window = 0; window < 256; ++window) {
+            unsigned prefix = window & 7;
+            if (prefix == WORD_BREAK) {
+                decoded[window] = ' ';
+                decodedBits[window] = PREFIX_BITS;
+            } else if (prefix <= MAX_CODE_LENGTH) {
+                unsigned elements = (window >> PREFIX_BITS) & ((1u << prefix) - 1);
+                decoded[window] = letters[(1u << prefix) | elements];
+                if (decoded[window]) decodedBits[window] = static_cast<uint8_t>(PREFIX_BITS + prefix);
+            }
+        }
+    }
+};
+
+const Tables& tables() {
+    static const Tables instance;
+    return instance;
+}
+
+uint64_t lowBits(size_t count) {
+    return (uint64_t(1) << count) - 1;
+}
+
+// A token of dots and dashes is looked up; anything else survives only as one whole
+// UTF-8 character
+char* decodeToken(const char* token, size_t length, char* out) {
+    if (length <= MAX_CODE_LENGTH) {
+        unsigned index = 1u << length;
+        bool elements = true;
+        for (size_t i = 0; i < length; ++i) {
+            index |= (token[i] == '-' ? 1u : 0u) << i;
+            elements &= token[i] == '-' || token[i] == '.';
+        }
+        if (elements) {
+            char letter = tables().letters[index];
+            *out = letter;
+            return out + (letter != 0);
+        }
+    }
+    if (Ascii::utf8SequenceLength(token, length) == length) {
+        std::memcpy(out, token, length);
+        out += length;
+    }
+    return out;
+}
+
+// Decodes morse[begin, size) where the current token started at tokenStart, then the
+// final token
+char* decodeRange(const char* morse, size_t begin, size_t size, size_t tokenStart, char* out) {
+    for (size_t i = begin; i < size; ++i) {
+        char c = morse[i];
+        if (c != ' ' && c != '/') continue;
+        if (i > tokenStart) out = decodeToken(morse + tokenStart, i - tokenStart, out);
+        if (c == '/') *out++ = ' ';
+        tokenStart = i + 1;
+    }
+    if (size > tokenStart) out = decodeToken(morse + tokenStart, size - tokenStart, out);
+    return out;
+}
+
+#ifdef MORSE_HAVE_X86_KERNELS
+
+bool cpuHasAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+AVX2_TARGET inline uint64_t matches(__m256i low, __m256i high, char c) {
+    __m256i value = _mm256_set1_epi8(c);
+    uint32_t lowMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, value)));
+    uint32_t highMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, value)));
+    return lowMask | uint64_t(highMask) << 32;
+}
+
+// 64 bytes at a time: one bit per separator, dash and unexpected byte. A token inside
+// the block gets its table index straight from the dash bits; one that started in an
+// earlier block or holds other bytes goes through decodeToken()
+AVX2_TARGET char* decodeTextAvx2(const char* morse, size_t size, char* out) {
+    const char* letters = tables().letters;
+    size_t tokenStart = 0;
+    size_t base = 0;
+    for (; base + 64 <= size; base += 64) {
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(morse + base));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(morse + base + 32));
+        uint64_t slashes = matches(low, high, '/');
+        uint64_t separators = matches(low, high, ' ') | slashes;
+        uint64_t dashes = matches(low, high, '-');
+        uint64_t others = ~(separators | dashes | matches(low, high, '.'));
+
+        while (separators) {
+            size_t position = static_cast<size_t>(__builtin_ctzll(separators));
+            separators &= separators - 1;
+            size_t end = base + position;
+            // An empty token (separators in a row) has index 1, which is unassigned
+            size_t length = end - tokenStart;
+            size_t offset = tokenStart - base;
+            if (tokenStart >= base && length <= MAX_CODE_LENGTH && ((others >> offset) & lowBits(length)) == 0) {
+                char letter = letters[(1u << length) | ((dashes >> offset) & lowBits(length))];
+                *out = letter;
+                out += letter != 0;
+            } else {
+                out = decodeToken(morse + tokenStart, length, out);
+            }
+            *out = ' ';
+            out += (slashes >> position) & 1;
+            tokenStart = end + 1;
+        }
+    }
+    return decodeRange(morse, base, size, tokenStart, out);
+}
+
+#endif
+
+// Collects bits and writes whole bytes of them
+class BitWriter {
+public:
+    explicit BitWriter(std::string& packed) : packed(packed) {}
+
+    void put(uint32_t value, unsigned count) {
+        bits |= uint64_t(value) << used;
+        used += count;
+        if (used >= 32) {
+            char bytes[4];
+            for (int i = 0; i < 4; ++i) bytes[i] = static_cast<char>(bits >> (8 * i));
+            packed.append(bytes, 4);
+            bits >>= 32;
+            used -= 32;
+        }
+    }
+
+    void flush() {
+        while (used > 0) {
+            packed.push_back(static_cast<char>(bits));
+            bits >>= 8;
+            used = used > 8 ? used - 8 : 0;
+        }
+    }
+
+private:
+    std::string& packed;
+    uint64_t bits = 0;
+    unsigned used = 0;
+};
+
+// The 8 bits starting at bit position, zero past the end
+unsigned peek(const uint8_t* bytes, size_t size, uint64_t position) {
+    size_t index = static_cast<size_t>(position / 8);
+    unsigned window = bytes[index];
+    if (index + 1 < size) window |= unsigned(bytes[index + 1]) << 8;
+    return (window >> (position % 8)) & 0xFF;
+}
+
+size_t utf8LengthOf(unsigned lead) {
+    if (lead >= 0xC2 && lead <= 0xDF) return 2;
+    if (lead >= 0xE0 && lead <= 0xEF) return 3;
+    if (lead >= 0xF0 && lead <= 0xF4) return 4;
+    return 0;
+}
+
+} // namespace
+
+namespace MorseCodec {
+
+void encodeText(const char* text, size_t size, const std::string& separator, std::string& morse) {
+    const Tables& t = tables();
+    const size_t start = morse.size();
+    const size_t separatorSize = separator.size();
+    const size_t perByte = MAX_CODE_LENGTH + separatorSize;  // Most output one input byte can give
+    size_t used = start;
+    for (size_t i = 0; i < size;) {
+        // A UTF-8 character may run up to 3 bytes past the block
+        size_t blockEnd = std::min(size, i + ENCODE_BLOCK);
+        morse.resize(used + (blockEnd - i + MAX_UTF8_LENGTH - 1) * perByte + CODE_STORE);
+        char* out = &morse[used];
+        while (i < blockEnd) {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if (c < 0x80) {
+                ++i;
+                if (!t.textLength[c]) continue;
+                std::memcpy(out, t.text[c], CODE_STORE);
+                out += t.textLength[c];
+            } else if (size_t length = Ascii::utf8SequenceLength(text + i, size - i)) {
+                std::memcpy(out, text + i, length);
+                out += length;
+                i += length;
+            } else {
+                ++i;
+                continue;
+            }
+            if (separatorSize == 1) {
+                *out++ = separator[0];
+            } else {
+                std::memcpy(out, separator.data(), separatorSize);
+                out += separatorSize;
+            }
+        }
+        used = static_cast<size_t>(out - &morse[0]);
+    }
+    if (used > start) used -= separatorSize;
+    morse.resize(used);
+}
+
+void decodeTextScalar(const char* morse, size_t size, std::string& text) {
+    // Every token decodes to at most its own length, and a '/' to one space
+    size_t start = text.size();
+    text.resize(start + size);
+    char* out = decodeRange(morse, 0, size, 0, &text[start]);
+    text.resize(static_cast<size_t>(out - &text[0]));
+}
+
+void decodeText(const char* morse, size_t size, std::string& text) {
+#ifdef MORSE_HAVE_X86_KERNELS
+    static const bool hasAvx2 = cpuHasAvx2();
+    if (hasAvx2) {
+        size_t start = text.size();
+        text.resize(start + size);
+        char* out = decodeTextAvx2(morse, size, &text[start]);
+        text.resize(static_cast<size_t>(out - &text[0]));
+        return;
+    }
+#endif
+    decodeTextScalar(morse, size, text);
+}
+
+void encodeBinary(const char* text, size_t size, std::string& packed) {
+    const Tables& t = tables();
+    BitWriter writer(packed);
+    bool any = false;
+    for (size_t i = 0; i < size;) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c < 0x80) {
+            ++i;
+            if (!t.binaryBits[c]) continue;
+            writer.put(t.binary[c], t.binaryBits[c]);
+        } else if (size_t length = Ascii::utf8SequenceLength(text + i, size - i)) {
+            writer.put(RAW, PREFIX_BITS);
+            for (size_t j = 0; j < length; ++j) writer.put(static_cast<unsigned char>(text[i + j]), 8);
+            i += length;
+        } else {
+            ++i;
+            continue;
+        }
+        any = true;
+    }
+    if (!any) return;
+    writer.put(END, PREFIX_BITS);
+    writer.flush();
+}
+
+bool decodeBinary(const char* packed, size_t size, std::string& text) {
+    if (size == 0) return true;
+    const Tables& t = tables();
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(packed);
+    const uint64_t totalBits = uint64_t(size) * 8;
+
+    // A symbol takes at least 3 bits per byte it gives
+    size_t start = text.size();
+    text.resize(start + size * 3);
+    char* out = &text[start];
+    uint64_t position = 0;
+    bool ok = false;
+    while (position + PREFIX_BITS <= totalBits) {
+        // Codes and word breaks come straight from the table while 8 bytes can be
+        // loaded at once; the rest of the stream goes one symbol at a time below
+        size_t index = static_cast<size_t>(position / 8);
+        if (index + 8 <= size) {
+            uint64_t bitsAhead;
+            std::memcpy(&bitsAhead, bytes + index, 8);
+            bitsAhead >>= position % 8;  // At least 57 bits, and a symbol takes at most 8
+            unsigned consumed = 0;
+            while (consumed <= 48) {
+                unsigned bits = t.decodedBits[bitsAhead & 0xFF];
+                if (!bits) break;
+                *out++ = t.decoded[bitsAhead & 0xFF];
+                bitsAhead >>= bits;
+                consumed += bits;
+            }
+            position += consumed;
+            if (consumed > 48) continue;
+        }
+
+        unsigned window = peek(bytes, size, position);
+        unsigned prefix = window & 7;
+        if (prefix == END) {
+            position += PREFIX_BITS;
+            // Only zero padding may follow
+            ok = (position + 7) / 8 == size && (position % 8 == 0 || (bytes[size - 1] >> (position % 8)) == 0);
+            break;
+        }
+        if (prefix == RAW) {
+            position += PREFIX_BITS;
+            if (position + 8 > totalBits) break;
+            size_t length = utf8LengthOf(peek(bytes, size, position));
+            if (!length || position + 8 * length > totalBits) break;
+            for (size_t i = 0; i < length; ++i, position += 8) out[i] = static_cast<char>(peek(bytes, size, position));
+            if (Ascii::utf8SequenceLength(out, length) != length) break;
+            out += length;
+            continue;
+        }
+        unsigned bits = t.decodedBits[window];
+        if (!bits || position + bits > totalBits) break;
+        *out++ = t.decoded[window];
+        position += bits;
+    }
+    text.resize(ok ? static_cast<size_t>(out - &text[0]) : start);
+    return ok;
+}
+
+} // namespace MorseCodec
@@ -0,0 +1,247 @@
+#include "NameIndex.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+const uint32_t NONE = UINT32_MAX;
+
+} // namespace
+
+NameIndex::NameIndex() {
+    clear();
+}
+
+void NameIndex::clear() {
+    nodes.clear();
+    postings.clear();
+    nodes.push_back(Node{NONE, NONE, NONE, 0});
+    freeNodes = NONE;
+    freePostings = NONE;
+}
+
+uint32_t NameIndex::allocateNode(uint8_t label) {
+    Node node{NONE, NONE, NONE, label};
+    if (freeNodes == NONE) {
+        nodes.push_back(node);
+        return static_cast<uint32_t>(nodes.size() - 1);
+    }
+    uint32_t index = freeNodes;
+    freeNodes = nodes[index].nextSibling;
+    nodes[index] = node;
+    return index;
+}
+
+uint32_t NameIndex::allocatePosting(uint32_t id, uint32_t next) {
+    Posting posting{id, next};
+    if (freePostings == NONE) {
+        postings.push_back(posting);
+        return static_cast<uint32_t>(postings.size() - 1);
+    }
+    uint32_t index = freePostings;
+    freePostings = postings[index].next;
+    postings[index] = posting;
+    return index;
+}
+
+uint32_t NameIndex::findChild(uint32_t node, uint8_t label) const {
+    for (uint32_t child = nodes[node].firstChild; child != NONE; child = nodes[child].nextSibling) {
+        if (nodes[child].label == label) return child;
+        if (nodes[child].label > label) break;
+    }
+    return NONE;
+}
+
+// Inserts in label order
+uint32_t NameIndex::addChild(uint32_t node, uint8_t label) {
+    uint32_t previous = NONE;
+    uint32_t child = nodes[node].firstChild;
+    while (child != NONE && nodes[child].label < label) {
+        previous = child;
+        child = nodes[child].nextSibling;
+    }
+    if (child != NONE && nodes[child].label == label) return child;
+
+    uint32_t created = allocateNode(label);  // May reallocate nodes, so no references held
+    nodes[created].nextSibling = child;
+    if (previous == NONE) {
+        nodes[node].firstChild = created;
+    } else {
+        nodes[previous].nextSibling = created;
+    }
+    return created;
+}
+
+void NameIndex::unlinkChild(uint32_t parent, uint32_t child) {
+    if (nodes[parent].firstChild == child) {
+        nodes[parent].firstChild = nodes[child].nextSibling;
+    } else {
+        uint32_t previous = nodes[parent].firstChild;
+        while (nodes[previous].nextSibling != child) previous = nodes[previous].nextSibling;
+        nodes[previous].nextSibling = nodes[child].nextSibling;
+    }
+    nodes[child].nextSibling = freeNodes;
+    freeNodes = child;
+}
+
+void NameIndex::insert(const char* name, size_t length, uint32_t id) {
+    uint32_t node = 0;
+    for (size_t i = 0; i < length; ++i) node = addChild(node, static_cast<uint8_t>(name[i]));
+    nodes[node].postings = allocatePosting(id, nodes[node].postings);
+}
+
+void NameIndex::remove(const char* name, size_t length, uint32_t id) {
+    std::vector<uint32_t> path(1, 0);
+    for (size_t i = 0; i < length; ++i) {
+        uint32_t child = findChild(path.back(), static_cast<uint8_t>(name[i]));
+        if (child == NONE) return;
+        path.push_back(child);
+    }
+
+    uint32_t* link = &nodes[path.back()].postings;
+    while (*link != NONE && postings[*link].id != id) link = &postings[*link].next;
+    if (*link == NONE) return;
+    uint32_t removed = *link;
+    *link = postings[removed].next;
+    postings[removed].next = freePostings;
+    freePostings = removed;
+
+    // Drop the branch back to the deepest node still in use
+    for (size_t depth = path.size() - 1; depth > 0; --depth) {
+        const Node& node = nodes[path[depth]];
+        if (node.postings != NONE || node.firstChild != NONE) break;
+        unlinkChild(path[depth - 1], path[depth]);
+    }
+}
+
+void NameIndex::renumberAfterErase(uint32_t erasedId) {
+    for (Posting& posting : postings) {
+        if (posting.id > erasedId) --posting.id;  // Free entries too; harmless
+    }
+}
+
+std::vector<uint32_t> NameIndex::prefixMatches(const std::string& prefix, size_t limit) const {
+    std::vector<uint32_t> matches;
+    uint32_t start = 0;
+    for (char c : prefix) {
+        start = findChild(start, static_cast<uint8_t>(c));
+        if (start == NONE) return matches;
+    }
+
+    // Preorder walk; siblings are pushed last-first so the smallest label pops next
+    std::vector<uint32_t> stack(1, start);
+    std::vector<uint32_t> children;
+    while (!stack.empty() && matches.size() < limit) {
+        uint32_t node = stack.back();
+        stack.pop_back();
+        for (uint32_t p = nodes[node].postings; p != NONE && matches.size() < limit; p = postings[p].next) {
+            matches.push_back(postings[p].id);
+        }
+        children.clear();
+        for (uint32_t child = nodes[node].firstChild; child != NONE; child = nodes[child].nextSibling) {
+            children.push_back(child);
+        }
+        stack.insert(stack.end(), children.rbegin(), children.rend());
+    }
+    return matches;
+}
+
+std::vector<NameIndex::Match> NameIndex::fuzzyMatches(const std::string& query, int maxDistance,
+                                                      size_t limit) const {
+    std::vector<Match> matches;
+    size_t length = query.size();
+    if (length > MAX_FUZZY_LENGTH || maxDistance < 0) return matches;
+    auto keepClosest = [&matches, limit]() {
+        std::stable_sort(matches.begin(), matches.end(),
+                         [](const Match& a, const Match& b) { return a.distance < b.distance; });
+        if (matches.size() > limit) matches.resize(limit);
+    };
+
+    // A name is as many edits from the empty query as it is long
+    if (length == 0) {
+        std::vector<std::pair<uint32_t, int>> pending(1, std::make_pair(0u, 0));
+        while (!pending.empty()) {
+            std::pair<uint32_t, int> entry = pending.back();
+            pending.pop_back();
+            for (uint32_t p = nodes[entry.first].postings; p != NONE; p = postings[p].next) {
+                matches.push_back(Match{postings[p].id, entry.second});
+            }
+            if (entry.second == maxDistance) continue;
+            for (uint32_t child = nodes[entry.first].firstChild; child != NONE; child = nodes[child].nextSibling) {
+                pending.emplace_back(child, entry.second + 1);
+            }
+        }
+        keepClosest();
+        return matches;
+    }
+
+    // The walk starts below the root, so an empty name (length edits away) is seen here
+    if (static_cast<int>(length) <= maxDistance) {
+        for (uint32_t p = nodes[0].postings; p != NONE; p = postings[p].next) {
+            matches.push_back(Match{postings[p].id, static_cast<int>(length)});
+        }
+    }
+
+    // peq[c] has bit i set where query[i] == c
+    uint64_t peq[256] = {};
+    for (size_t i = 0; i < length; ++i) peq[static_cast<uint8_t>(query[i])] |= uint64_t(1) << i;
+    const uint64_t all = length == 64 ? ~uint64_t(0) : (uint64_t(1) << length) - 1;
+    const uint64_t last = uint64_t(1) << (length - 1);
+
+    // One column of the DP table: vp/vn are the +1/-1 vertical deltas, score the bottom cell
+    struct Frame {
+        uint32_t node;
+        uint32_t depth;
+        uint64_t vp;
+        uint64_t vn;
+        int score;
+    };
+    std::vector<Frame> stack;
+    for (uint32_t child = nodes[0].firstChild; child != NONE; child = nodes[child].nextSibling) {
+        stack.push_back(Frame{child, 1, all, 0, static_cast<int>(length)});
+    }
+
+    while (!stack.empty()) {
+        Frame frame = stack.back();
+        stack.pop_back();
+        const Node& node = nodes[frame.node];
+
+        // Advance the parent's column by this node's label
+        uint64_t eq = peq[node.label];
+        uint64_t xv = eq | frame.vn;
+        uint64_t xh = (((eq & frame.vp) + frame.vp) ^ frame.vp) | eq;
+        uint64_t hp = frame.vn | ~(xh | frame.vp);
+        uint64_t hn = frame.vp & xh;
+        int score = frame.score + ((hp & last) != 0) - ((hn & last) != 0);
+        hp = (hp << 1) | 1;  // Row 0 is the depth itself: whole-string distance
+        hn <<= 1;
+        uint64_t vp = (hn | ~(xv | hp)) & all;
+        uint64_t vn = hp & xv & all;
+
+        if (score <= maxDistance) {
+            for (uint32_t p = node.postings; p != NONE; p = postings[p].next) {
+                matches.push_back(Match{postings[p].id, score});
+            }
+        } else {
+            // Only descend while some cell of the column is still within reach
+            int cell = static_cast<int>(frame.depth);
+            int best = cell;
+            for (size_t i = 0; i < length && best > maxDistance; ++i) {
+                cell += static_cast<int>((vp >> i) & 1) - static_cast<int>((vn >> i) & 1);
+                best = std::min(best, cell);
+            }
+            if (best > maxDistance) continue;
+        }
+
+        for (uint32_t child = node.firstChild; child != NONE; child = nodes[child].nextSibling) {
+            stack.push_back(Frame{child, frame.depth + 1, vp, vn, score});
+        }
+    }
+
+    keepClosest();
+    return matches;
+}
+
+size_t NameIndex::memoryUsage() const {
+    return nodes.capacity() * sizeof(Node) + postings.capacity() * sizeof(Posting);
+}
@@ -1,62 +1,406 @@
 #include "PasswordManager.h"
+#include "ChaCha20Poly1305.h"
+#include "Metrics.h"
+#include "SecureMemory.h"
+#include "TextArmor.h"
+#include <array>
 #include <iostream>
 #include <fstream>
 #include <iomanip>
 #include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <sys/stat.h>
 
-PasswordManager::PasswordManager() {
-    loadFromFile("password_database.txt");
+namespace {
+
+const int FIELD_COUNT = 5;
+const char KDF_PREFIX[] = "$argon2id$";
+const char WRAP_PREFIX[] = "$wrap$";  // Followed by Base64 of nonce, sealed key and tag
+const char MASTER_FILE[] = "master.txt";  // A directory vault's header
+const size_t NONCE_SIZE = ChaCha20Poly1305::NONCE_SIZE;
+const size_t TAG_SIZE = ChaCha20Poly1305::TAG_SIZE;
+
+bool startsWith(const char* data, size_t length, const char* prefix) {
+    size_t prefixLength = std::strlen(prefix);
+    return length >= prefixLength && std::memcmp(data, prefix, prefixLength) == 0;
+}
+
+void fillRandom(uint8_t* out, size_t size) {
+    static thread_local std::random_device device;
+    for (size_t i = 0; i < size; i += 4) {
+        uint32_t word = device();
+        for (size_t j = i; j < size && j < i + 4; ++j) out[j] = static_cast<uint8_t>(word >> (8 * (j - i)));
+    }
+}
+
+std::string base64(const uint8_t* data, size_t size) {
+    return TextArmor::encode(Armor::BASE64, std::string(reinterpret_cast<const char*>(data), size));
+}
+
+// "$argon2id$v=19$m=<KiB>,t=<passes>,p=<lanes>$<salt>", the part of the header the check
+// value covers
+std::string headerPrefix(const KeyDerivation::Params& params, const uint8_t* salt) {
+    char text[96];
+    std::snprintf(text, sizeof(text), "%sv=19$m=%u,t=%u,p=%u$", KDF_PREFIX, params.memoryKiB, params.passes,
+                  params.lanes);
+    return text + base64(salt, KeyDerivation::SALT_SIZE);
+}
+
+bool parseHeader(const std::string& header, KeyDerivation::Params& params, std::string& salt, std::string& check,
+                 std::string& prefix) {
+    unsigned memoryKiB, passes, lanes;
+    int used = 0;
+    if (std::sscanf(header.c_str(), "$argon2id$v=19$m=%u,t=%u,p=%u$%n", &memoryKiB, &passes, &lanes, &used) != 3 ||
+        used == 0) {
+        return false;
+    }
+    size_t dollar = header.find('$', static_cast<size_t>(used));
+    if (dollar == std::string::npos) return false;
+    params.memoryKiB = memoryKiB;
+    params.passes = passes;
+    params.lanes = lanes;
+    prefix = header.substr(0, dollar);
+    return KeyDerivation::validParams(params) &&
+           TextArmor::decode(Armor::BASE64, header.substr(static_cast<size_t>(used), dollar - used), salt) &&
+           TextArmor::decode(Armor::BASE64, header.substr(dollar + 1), check) && check.size() == TAG_SIZE;
+}
+
+// The tag of an empty message sealed under the vault key, so a wrong password is caught
+// before any entry key is opened
+std::string checkValue(const uint8_t* key, const std::string& prefix) {
+    uint8_t nonce[NONCE_SIZE] = {};
+    uint8_t tag[TAG_SIZE];
+    ChaCha20Poly1305::seal(key, nonce, reinterpret_cast<const uint8_t*>(prefix.data()), prefix.size(), nullptr, 0,
+                           nullptr, tag);
+    return std::string(reinterpret_cast<const char*>(tag), sizeof(tag));
+}
+
+bool constantTimeEquals(const std::string& a, const std::string& b) {
+    if (a.size() != b.size()) return false;
+    unsigned char difference = 0;
+    for (size_t i = 0; i < a.size(); ++i) difference |= static_cast<unsigned char>(a[i] ^ b[i]);
+    return difference == 0;
+}
+
+bool isDirectoryVault(const std::string& path) {
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0) return S_ISDIR(info.st_mode);
+    return !path.empty() && path.back() == '/';
+}
+
+std::string shardPath(const std::string& directory, uint32_t shard) {
+    char name[16];
+    std::snprintf(name, sizeof(name), "shard-%02x.txt", shard);
+    return directory + "/" + name;
+}
+
+// False when the file cannot be opened
+bool readText(const std::string& path, std::string& contents) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+    file.seekg(0, std::ios::end);
+    contents.assign(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0, std::ios::beg);
+    file.read(&contents[0], static_cast<std::streamsize>(contents.size()));
+    contents.resize(static_cast<size_t>(file.gcount()));  // Text mode may translate line endings
+    return true;
+}
+
+// The RFC 9106 vectors are checked once, before the first key is derived
+bool kdfVerified() {
+    static const bool verified = KeyDerivation::selfTest();
+    if (!verified) std::cerr << "Error: Argon2id failed its self-test on this CPU." << std::endl;
+    return verified;
+}
+
+} // namespace
+
+struct PasswordManager::VaultKey {
+    std::array<uint8_t, ChaCha20Poly1305::KEY_SIZE> bytes;
+};
+
+std::map<std::string, std::shared_ptr<const PasswordManager::VaultKey>> PasswordManager::sessionKeys;
+std::mutex PasswordManager::sessionMutex;
+
+PasswordManager::PasswordManager(const std::string& databaseFile, Access access)
+    : databaseFile(databaseFile), access(access) {
+    loadFromFile(databaseFile);
 }
 
 PasswordManager::~PasswordManager() {
-    saveToFile("password_database.txt");
+    if (access == Access::READ_WRITE) saveToFile(databaseFile);
 }
 
 void PasswordManager::saveToFile(const std::string& filename) {
+    if (access == Access::READ_ONLY && filename == databaseFile) {
+        std::cerr << "Error: " << filename << " was opened read-only." << std::endl;
+        return;
+    }
+    ET_METRICS_SCOPE(scope, Metrics::VAULT_SAVE, "vault", passwords.size());
+    if (isDirectoryVault(filename)) {
+        saveShards(filename);
+        return;
+    }
     std::ofstream file(filename);
     if (!file.is_open()) {
         std::cerr << "Error: Unable to open password file for writing." << std::endl;
         return;
     }
     
-    for (const auto& entry : passwords) {
-        file << entry.service << "\n"
-             << entry.username << "\n"
-             << entry.encryptedPassword << "\n"
-             << entry.algorithm << "\n"
-             << entry.key << "\n";
-    }
+    if (!kdfHeader.empty()) file << kdfHeader << '\n';
+    for (const auto& entry : passwords) writeRecord(file, entry);
     
     file.close();
 }
 
+void PasswordManager::saveShards(const std::string& directory) {
+    bool incremental = directory == cleanDirectory;
+    if (incremental && dirtyShards == 0 && !headerDirty) return;
+    if (mkdir(directory.c_str(), 0700) != 0 && errno != EEXIST) {
+        std::cerr << "Error: Unable to create vault directory: " << directory << std::endl;
+        return;
+    }
+    
+    std::vector<std::vector<uint32_t>> members(VaultShards::SHARD_COUNT);
+    for (size_t i = 0; i < passwords.size(); ++i) {
+        uint32_t bucket = shards.built() ? shards.bucketOf(static_cast<uint32_t>(i))
+                                         : VaultShards::bucketFor(arena.data(passwords[i].service),
+                                                                  passwords[i].service.length);
+        uint32_t shard = VaultShards::shardOf(bucket);
+        if (!incremental || (dirtyShards >> shard & 1)) members[shard].push_back(static_cast<uint32_t>(i));
+    }
+    for (uint32_t shard = 0; shard < VaultShards::SHARD_COUNT; ++shard) {
+        if (incremental && !(dirtyShards >> shard & 1)) continue;
+        std::ofstream file(shardPath(directory, shard));
+        if (!file.is_open()) {
+            std::cerr << "Error: Unable to open password file for writing." << std::endl;
+            return;
+        }
+        for (uint32_t id : members[shard]) writeRecord(file, passwords[id]);
+    }
+    if (!incremental || headerDirty) {
+        std::string masterPath = directory + "/" + MASTER_FILE;
+        if (kdfHeader.empty()) {
+            std::remove(masterPath.c_str());
+        } else {
+            std::ofstream master(masterPath);
+            if (!master.is_open()) {
+                std::cerr << "Error: Unable to open password file for writing." << std::endl;
+                return;
+            }
+            master << kdfHeader << '\n';
+        }
+    }
+    cleanDirectory = directory;
+    headerDirty = false;
+    dirtyShards = 0;
+}
+
+void PasswordManager::writeRecord(std::ostream& file, const StoredPassword& entry) const {
+    for (const StringArena::Ref& field : {entry.service, entry.username, entry.encryptedPassword,
+                                          entry.algorithm, entry.key}) {
+        file.write(arena.data(field), field.length);
+        file.put('\n');
+    }
+}
+
 void PasswordManager::loadFromFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "No existing password file found. Creating new database." << std::endl;
+    ET_METRICS_SCOPE(scope, Metrics::VAULT_LOAD, "vault", 0);
+    // One read per file and a memchr per line; the text goes straight into the arena
+    bool sharded = isDirectoryVault(filename);
+    std::vector<std::string> contents(sharded ? VaultShards::SHARD_COUNT : 1);
+    struct stat info;
+    found = sharded ? stat(filename.c_str(), &info) == 0 : readText(filename, contents[0]);
+    if (!found) {
+        if (access == Access::READ_WRITE) {
+            std::cerr << "No existing password file found. Creating new database." << std::endl;
+        }
         return;
     }
+    for (uint32_t shard = 0; sharded && shard < VaultShards::SHARD_COUNT; ++shard) {
+        readText(shardPath(filename, shard), contents[shard]);  // A missing shard is empty
+    }
+    // The master password header is master.txt in a directory, else the file's first line
+    std::string header;
+    size_t headerBytes = 0;
+    if (sharded) {
+        readText(filename + "/" + MASTER_FILE, header);
+        header.erase(std::min(header.size(), header.find('\n')));
+    } else if (startsWith(contents[0].data(), contents[0].size(), KDF_PREFIX)) {
+        headerBytes = std::min(contents[0].size(), contents[0].find('\n') + 1);
+        header = contents[0].substr(0, contents[0].find('\n'));
+    }
     
     passwords.clear();
+    arena.clear();
+    deletedBytes = 0;
+    serviceIndex.clear();
+    usernameIndex.clear();
+    indexed = false;
+    shards.clear();
+    cleanDirectory = sharded ? filename : "";
+    dirtyShards = 0;
+    kdfHeader = header;
+    headerDirty = false;
+    vaultKey = nullptr;
+    if (!header.empty()) {
+        std::lock_guard<std::mutex> lock(sessionMutex);
+        auto unlocked = sessionKeys.find(header);
+        if (unlocked != sessionKeys.end()) vaultKey = unlocked->second;
+    }
     
-    std::string service, username, encryptedPassword, algorithm, key;
-    while (std::getline(file, service) && 
-           std::getline(file, username) && 
-           std::getline(file, encryptedPassword) && 
-           std::getline(file, algorithm) && 
-           std::getline(file, key)) {
-        
-        passwords.push_back({service, username, encryptedPassword, algorithm, key});
+    size_t lines = 0;
+    size_t bytes = 0;
+    for (const std::string& text : contents) {
+        lines += static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+        bytes += text.size();
     }
+    passwords.reserve(lines / FIELD_COUNT + 1);
+    arena.reserve(bytes);
+    parseRecords(contents[0].data() + headerBytes, contents[0].data() + contents[0].size());
+    for (size_t i = 1; i < contents.size(); ++i) parseRecords(contents[i].data(), contents[i].data() + contents[i].size());
     
-    file.close();
+    ET_METRICS_SET_BYTES(scope, passwords.size());
+}
+
+void PasswordManager::parseRecords(const char* cursor, const char* end) {
+    // As with getline, a last line without a newline still counts and an incomplete
+    // record at the end is dropped
+    const char* fields[FIELD_COUNT];
+    size_t lengths[FIELD_COUNT];
+    int field = 0;
+    while (cursor < end) {
+        const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+        const char* lineEnd = newline ? newline : end;
+        fields[field] = cursor;
+        lengths[field] = static_cast<size_t>(lineEnd - cursor);
+        cursor = newline ? newline + 1 : end;
+        
+        if (++field == FIELD_COUNT) {
+            field = 0;
+            if (!store(fields, lengths)) break;
+        }
+    }
 }
 
 void PasswordManager::addPassword(const std::string& service, const std::string& username, 
                                 const std::string& encryptedPassword, const std::string& algorithm, 
                                 const std::string& key) {
-    passwords.push_back({service, username, encryptedPassword, algorithm, key});
-    saveToFile("password_database.txt");
+    std::string wrapped;
+    if (isProtected() && !(requireUnlocked() && wrapKey(*vaultKey, service, key, wrapped))) return;
+    const std::string& storedKey = isProtected() ? wrapped : key;
+    const char* fields[FIELD_COUNT] = {service.data(), username.data(), encryptedPassword.data(),
+                                       algorithm.data(), storedKey.data()};
+    size_t lengths[FIELD_COUNT] = {service.size(), username.size(), encryptedPassword.size(),
+                                   algorithm.size(), storedKey.size()};
+    if (store(fields, lengths)) {
+        markDirty(passwords.back());
+        saveToFile(databaseFile);
+    }
+}
+
+bool PasswordManager::store(const char* const fields[], const size_t lengths[]) {
+    size_t total = 0;
+    for (int i = 0; i < FIELD_COUNT; ++i) total += lengths[i];
+    if (!arena.canHold(total)) {
+        std::cerr << "Error: Password database is too large (4 GB limit)." << std::endl;
+        return false;
+    }
+    
+    StoredPassword entry;
+    entry.service = arena.append(fields[0], lengths[0]);
+    entry.username = arena.append(fields[1], lengths[1]);
+    entry.encryptedPassword = arena.append(fields[2], lengths[2]);
+    entry.algorithm = arena.intern(fields[3], lengths[3]);
+    entry.key = arena.intern(fields[4], lengths[4]);
+    if (indexed) {
+        uint32_t id = static_cast<uint32_t>(passwords.size());
+        serviceIndex.insert(fields[0], lengths[0], id);
+        usernameIndex.insert(fields[1], lengths[1], id);
+    }
+    if (shards.built()) {
+        shards.append(VaultShards::bucketFor(fields[0], lengths[0]),
+                      VaultShards::recordDigest(fields, lengths, FIELD_COUNT));
+    }
+    passwords.push_back(entry);
+    return true;
+}
+
+bool PasswordManager::replace(uint32_t id, const char* const fields[], const size_t lengths[]) {
+    size_t total = 0;
+    for (int i = 1; i < FIELD_COUNT; ++i) total += lengths[i];
+    if (!arena.canHold(total)) {
+        std::cerr << "Error: Password database is too large (4 GB limit)." << std::endl;
+        return false;
+    }
+    
+    StoredPassword& entry = passwords[id];
+    deletedBytes += entry.username.length + entry.encryptedPassword.length;
+    if (indexed) usernameIndex.remove(arena.data(entry.username), entry.username.length, id);
+    entry.username = arena.append(fields[1], lengths[1]);
+    entry.encryptedPassword = arena.append(fields[2], lengths[2]);
+    entry.algorithm = arena.intern(fields[3], lengths[3]);
+    entry.key = arena.intern(fields[4], lengths[4]);
+    if (indexed) usernameIndex.insert(fields[1], lengths[1], id);
+    if (shards.built()) shards.replace(id, VaultShards::recordDigest(fields, lengths, FIELD_COUNT));
+    return true;
+}
+
+// Unlike deletePassword this moves the last record into the gap, so it costs the same
+// at any vault size
+void PasswordManager::swapRemove(uint32_t id) {
+    uint32_t last = static_cast<uint32_t>(passwords.size() - 1);
+    const StoredPassword& entry = passwords[id];
+    const StoredPassword& moved = passwords[last];
+    deletedBytes += entry.service.length + entry.username.length + entry.encryptedPassword.length;
+    if (indexed) {
+        serviceIndex.remove(arena.data(entry.service), entry.service.length, id);
+        usernameIndex.remove(arena.data(entry.username), entry.username.length, id);
+        if (id != last) {
+            serviceIndex.remove(arena.data(moved.service), moved.service.length, last);
+            usernameIndex.remove(arena.data(moved.username), moved.username.length, last);
+            serviceIndex.insert(arena.data(moved.service), moved.service.length, id);
+            usernameIndex.insert(arena.data(moved.username), moved.username.length, id);
+        }
+    }
+    if (shards.built()) shards.swapRemove(id);
+    passwords[id] = moved;
+    passwords.pop_back();
+}
+
+void PasswordManager::fieldsOf(const StoredPassword& entry, const char* fields[], size_t lengths[]) const {
+    int i = 0;
+    for (const StringArena::Ref& field : {entry.service, entry.username, entry.encryptedPassword,
+                                          entry.algorithm, entry.key}) {
+        fields[i] = arena.data(field);
+        lengths[i++] = field.length;
+    }
+}
+
+void PasswordManager::markDirty(const StoredPassword& entry) {
+    uint32_t bucket = VaultShards::bucketFor(arena.data(entry.service), entry.service.length);
+    dirtyShards |= uint64_t(1) << VaultShards::shardOf(bucket);
+}
+
+// Copies the live strings into a fresh arena, dropping those of deleted entries. The
+// old arena is wiped, since it still holds deleted (or, from protect(), unsealed) keys.
+void PasswordManager::compact() {
+    StringArena fresh;
+    fresh.reserve(arena.bytes() - deletedBytes);
+    for (auto& entry : passwords) {
+        entry.service = fresh.append(arena.data(entry.service), entry.service.length);
+        entry.username = fresh.append(arena.data(entry.username), entry.username.length);
+        entry.encryptedPassword = fresh.append(arena.data(entry.encryptedPassword), entry.encryptedPassword.length);
+        entry.algorithm = fresh.intern(arena.data(entry.algorithm), entry.algorithm.length);
+        entry.key = fresh.intern(arena.data(entry.key), entry.key.length);
+    }
+    arena.swap(fresh);
+    fresh.clear();
+    deletedBytes = 0;
 }
 
 void PasswordManager::listPasswords() {
@@ -70,34 +414,348 @@ void PasswordManager::listPasswords() {
     std::cout << std::string(40, '-') << std::endl;
     
     for (const auto& entry : passwords) {
-        std::cout << std::left << std::setw(20) << entry.service << std::setw(20) << entry.username << std::endl;
+        std::cout << std::left << std::setw(20) << arena.get(entry.service) << std::setw(20)
+                  << arena.get(entry.username) << std::endl;
     }
 }
 
 bool PasswordManager::getPassword(const std::string& service, std::string& encryptedPassword, 
                                  std::string& algorithm, std::string& key) {
+    ET_METRICS_SCOPE(scope, Metrics::VAULT_LOOKUP, "vault", 0);
     for (const auto& entry : passwords) {
-        if (entry.service == service) {
-            encryptedPassword = entry.encryptedPassword;
-            algorithm = entry.algorithm;
-            key = entry.key;
+        if (arena.equals(entry.service, service)) {
+            // Assigned in place so no temporary copy of the key is freed unwiped
+            encryptedPassword.assign(arena.data(entry.encryptedPassword), entry.encryptedPassword.length);
+            algorithm.assign(arena.data(entry.algorithm), entry.algorithm.length);
+            if (startsWith(arena.data(entry.key), entry.key.length, WRAP_PREFIX)) {
+                return requireUnlocked() && unwrapKey(*vaultKey, service, arena.data(entry.key), entry.key.length, key);
+            }
+            key.assign(arena.data(entry.key), entry.key.length);
             return true;
         }
     }
     return false;
 }
 
+bool PasswordManager::requireUnlocked() const {
+    if (vaultKey) return true;
+    std::cerr << "Error: The vault is locked. Unlock it with the master password first." << std::endl;
+    return false;
+}
+
+bool PasswordManager::wrapKey(const VaultKey& vault, const std::string& service, const std::string& key,
+                              std::string& wrapped) {
+    // The service is the associated data, so a sealed key cannot be moved to another entry
+    std::string sealed(NONCE_SIZE + key.size() + TAG_SIZE, '\0');
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(&sealed[0]);
+    fillRandom(bytes, NONCE_SIZE);
+    ChaCha20Poly1305::seal(vault.bytes.data(), bytes, reinterpret_cast<const uint8_t*>(service.data()), service.size(),
+                           reinterpret_cast<const uint8_t*>(key.data()), key.size(), bytes + NONCE_SIZE,
+                           bytes + NONCE_SIZE + key.size());
+    wrapped = WRAP_PREFIX + TextArmor::encode(Armor::BASE64, sealed);
+    return true;
+}
+
+bool PasswordManager::unwrapKey(const VaultKey& vault, const std::string& service, const char* wrapped,
+                                size_t length, std::string& key) {
+    size_t prefixLength = sizeof(WRAP_PREFIX) - 1;
+    std::string sealed;
+    if (!TextArmor::decode(Armor::BASE64, std::string(wrapped + prefixLength, length - prefixLength), sealed) ||
+        sealed.size() < NONCE_SIZE + TAG_SIZE) {
+        std::cerr << "Error: The stored key for " << service << " is corrupt." << std::endl;
+        return false;
+    }
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(sealed.data());
+    size_t size = sealed.size() - NONCE_SIZE - TAG_SIZE;
+    key.assign(size, '\0');
+    if (!ChaCha20Poly1305::open(vault.bytes.data(), bytes, reinterpret_cast<const uint8_t*>(service.data()),
+                                service.size(), bytes + NONCE_SIZE, size, bytes + NONCE_SIZE + size,
+                                reinterpret_cast<uint8_t*>(&key[0]))) {
+        SecureMemory::wipe(key);
+        std::cerr << "Error: The stored key for " << service << " failed authentication." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool PasswordManager::unlock(const std::string& masterPassword) {
+    ET_METRICS_SCOPE(scope, Metrics::VAULT_UNLOCK, "vault", 0);
+    KeyDerivation::Params params;
+    std::string salt, check, prefix;
+    if (!isProtected()) {
+        std::cerr << "Error: The vault has no master password." << std::endl;
+        return false;
+    }
+    if (!parseHeader(kdfHeader, params, salt, check, prefix)) {
+        std::cerr << "Error: The vault's master password header is corrupt." << std::endl;
+        return false;
+    }
+    
+    if (!kdfVerified()) return false;
+    std::shared_ptr<VaultKey> key = makeSecureShared<VaultKey>();
+    if (!KeyDerivation::argon2id(masterPassword, reinterpret_cast<const uint8_t*>(salt.data()), salt.size(), params,
+                                 key->bytes.data(), key->bytes.size())) {
+        std::cerr << "Error: Not enough memory for the key derivation." << std::endl;
+        return false;
+    }
+    if (!constantTimeEquals(checkValue(key->bytes.data(), prefix), check)) {
+        std::cerr << "Error: Wrong master password." << std::endl;
+        return false;
+    }
+    vaultKey = key;
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    sessionKeys[kdfHeader] = key;
+    return true;
+}
+
+bool PasswordManager::protect(const std::string& masterPassword, const KeyDerivation::Params& params) {
+    if (isProtected() && !requireUnlocked()) return false;
+    if (!KeyDerivation::validParams(params)) {
+        std::cerr << "Error: Key derivation needs at least one pass, one lane and 8 KiB per lane." << std::endl;
+        return false;
+    }
+    
+    if (!kdfVerified()) return false;
+    uint8_t salt[KeyDerivation::SALT_SIZE];
+    fillRandom(salt, sizeof(salt));
+    std::string prefix = headerPrefix(params, salt);
+    std::shared_ptr<VaultKey> key = makeSecureShared<VaultKey>();
+    if (!KeyDerivation::argon2id(masterPassword, salt, sizeof(salt), params, key->bytes.data(), key->bytes.size())) {
+        std::cerr << "Error: Not enough memory for the key derivation." << std::endl;
+        return false;
+    }
+    
+    // Every key is resealed before anything changes, so a failure leaves the vault as it was
+    std::vector<std::string> sealed(passwords.size());
+    std::string plain;
+    size_t total = 0;
+    for (size_t i = 0; i < passwords.size(); ++i) {
+        const StoredPassword& entry = passwords[i];
+        std::string service = arena.get(entry.service);
+        if (startsWith(arena.data(entry.key), entry.key.length, WRAP_PREFIX)) {
+            if (!unwrapKey(*vaultKey, service, arena.data(entry.key), entry.key.length, plain)) return false;
+        } else {
+            plain.assign(arena.data(entry.key), entry.key.length);
+        }
+        wrapKey(*key, service, plain, sealed[i]);
+        SecureMemory::wipe(plain);
+        total += sealed[i].size();
+    }
+    if (!arena.canHold(total)) {
+        std::cerr << "Error: Password database is too large (4 GB limit)." << std::endl;
+        return false;
+    }
+    for (size_t i = 0; i < passwords.size(); ++i) passwords[i].key = arena.intern(sealed[i]);
+    
+    kdfHeader = prefix + "$" + base64(reinterpret_cast<const uint8_t*>(checkValue(key->bytes.data(), prefix).data()),
+                                      TAG_SIZE);
+    vaultKey = key;
+    {
+        std::lock_guard<std::mutex> lock(sessionMutex);
+        sessionKeys[kdfHeader] = key;
+    }
+    headerDirty = true;
+    dirtyShards = ~uint64_t(0);
+    shards.clear();  // Every record digest changed; rebuilt by the next diff or sync
+    compact();       // Drops the unsealed keys from the arena
+    saveToFile(databaseFile);
+    return true;
+}
+
+void PasswordManager::lockSession() {
+    std::lock_guard<std::mutex> lock(sessionMutex);
+    sessionKeys.clear();
+}
+
 void PasswordManager::deletePassword(const std::string& service) {
     auto it = std::find_if(passwords.begin(), passwords.end(), 
-                         [&service](const StoredPassword& entry) {
-                             return entry.service == service;
+                         [this, &service](const StoredPassword& entry) {
+                             return arena.equals(entry.service, service);
                          });
     
     if (it != passwords.end()) {
+        // Interned algorithm and key strings may still be shared, so only these count
+        deletedBytes += it->service.length + it->username.length + it->encryptedPassword.length;
+        uint32_t id = static_cast<uint32_t>(it - passwords.begin());
+        if (indexed) {
+            serviceIndex.remove(arena.data(it->service), it->service.length, id);
+            usernameIndex.remove(arena.data(it->username), it->username.length, id);
+            serviceIndex.renumberAfterErase(id);
+            usernameIndex.renumberAfterErase(id);
+        }
+        if (shards.built()) shards.erase(id);
+        markDirty(*it);
         passwords.erase(it);
-        saveToFile("password_database.txt");
+        if (deletedBytes * 2 > arena.bytes()) compact();
+        saveToFile(databaseFile);
         std::cout << "Password for " << service << " deleted successfully." << std::endl;
     } else {
         std::cout << "No password found for " << service << "." << std::endl;
     }
-}
\ No newline at end of file
+}
+
+void PasswordManager::buildIndexes() const {
+    serviceIndex.clear();
+    usernameIndex.clear();
+    for (size_t i = 0; i < passwords.size(); ++i) {
+        const StoredPassword& entry = passwords[i];
+        serviceIndex.insert(arena.data(entry.service), entry.service.length, static_cast<uint32_t>(i));
+        usernameIndex.insert(arena.data(entry.username), entry.username.length, static_cast<uint32_t>(i));
+    }
+    indexed = true;
+}
+
+void PasswordManager::buildShards() const {
+    std::vector<uint32_t> buckets(passwords.size());
+    std::vector<uint64_t> digests(passwords.size());
+    const char* fields[FIELD_COUNT];
+    size_t lengths[FIELD_COUNT];
+    for (size_t i = 0; i < passwords.size(); ++i) {
+        fieldsOf(passwords[i], fields, lengths);
+        buckets[i] = VaultShards::bucketFor(fields[0], lengths[0]);
+        digests[i] = VaultShards::recordDigest(fields, lengths, FIELD_COUNT);
+    }
+    shards.assign(buckets, digests);
+}
+
+std::vector<PasswordManager::SearchResult> PasswordManager::search(SearchField field, const std::string& prefix,
+                                                                   size_t limit) const {
+    if (!indexed) buildIndexes();
+    const NameIndex& index = field == SearchField::SERVICE ? serviceIndex : usernameIndex;
+    std::vector<SearchResult> results;
+    for (uint32_t id : index.prefixMatches(prefix, limit)) {
+        results.push_back({arena.get(passwords[id].service), arena.get(passwords[id].username), 0});
+    }
+    return results;
+}
+
+std::vector<PasswordManager::SearchResult> PasswordManager::fuzzySearch(SearchField field, const std::string& query,
+                                                                        int maxDistance, size_t limit) const {
+    if (query.size() > NameIndex::MAX_FUZZY_LENGTH) {
+        std::cerr << "Error: Fuzzy search is limited to " << NameIndex::MAX_FUZZY_LENGTH << " characters." << std::endl;
+        return {};
+    }
+    if (!indexed) buildIndexes();
+    const NameIndex& index = field == SearchField::SERVICE ? serviceIndex : usernameIndex;
+    std::vector<SearchResult> results;
+    for (const NameIndex::Match& match : index.fuzzyMatches(query, maxDistance, limit)) {
+        results.push_back({arena.get(passwords[match.id].service), arena.get(passwords[match.id].username),
+                           match.distance});
+    }
+    return results;
+}
+
+void PasswordManager::displaySearchResults(const std::vector<SearchResult>& results) const {
+    if (results.empty()) {
+        std::cout << "No matching passwords found." << std::endl;
+        return;
+    }
+    
+    std::cout << std::left << std::setw(20) << "Service" << std::setw(20) << "Username" << "Edits" << std::endl;
+    std::cout << std::string(45, '-') << std::endl;
+    for (const auto& result : results) {
+        std::cout << std::left << std::setw(20) << result.service << std::setw(20) << result.username
+                  << result.distance << std::endl;
+    }
+}
+
+void PasswordManager::unmatchedInBucket(const PasswordManager& other, uint32_t bucket, std::vector<uint32_t>& mine,
+                                        std::vector<uint32_t>& theirs) const {
+    mine.clear();
+    theirs.clear();
+    for (uint32_t id = shards.firstIn(bucket); id != VaultShards::NONE; id = shards.nextInBucket(id)) {
+        mine.push_back(id);
+    }
+    for (uint32_t id = other.shards.firstIn(bucket); id != VaultShards::NONE; id = other.shards.nextInBucket(id)) {
+        theirs.push_back(id);
+    }
+    // Records with equal digests are the same on both sides; cross them off in pairs
+    for (size_t i = 0; i < mine.size();) {
+        auto same = std::find_if(theirs.begin(), theirs.end(), [&](uint32_t id) {
+            return other.shards.digestOf(id) == shards.digestOf(mine[i]);
+        });
+        if (same == theirs.end()) {
+            ++i;
+            continue;
+        }
+        *same = theirs.back();
+        theirs.pop_back();
+        mine[i] = mine.back();
+        mine.pop_back();
+    }
+}
+
+std::vector<PasswordManager::Difference> PasswordManager::diff(const PasswordManager& other) const {
+    if (!shards.built()) buildShards();
+    if (!other.shards.built()) other.buildShards();
+    
+    std::vector<Difference> differences;
+    std::vector<uint32_t> mine, theirs;
+    uint64_t nodesCompared;
+    for (uint32_t bucket : VaultShards::differingBuckets(shards, other.shards, nodesCompared)) {
+        unmatchedInBucket(other, bucket, mine, theirs);
+        for (uint32_t id : mine) {
+            std::string service = arena.get(passwords[id].service);
+            auto counterpart = std::find_if(theirs.begin(), theirs.end(), [&](uint32_t theirId) {
+                return other.arena.equals(other.passwords[theirId].service, service);
+            });
+            bool changed = counterpart != theirs.end();
+            if (changed) theirs.erase(counterpart);
+            differences.push_back({changed ? Change::CHANGED : Change::REMOVED, service});
+        }
+        for (uint32_t id : theirs) {
+            differences.push_back({Change::ADDED, other.arena.get(other.passwords[id].service)});
+        }
+    }
+    return differences;
+}
+
+PasswordManager::SyncReport PasswordManager::syncTo(PasswordManager& replica) const {
+    SyncReport report;
+    if (&replica == this) return report;
+    ET_METRICS_SCOPE(scope, Metrics::VAULT_SYNC, "vault", 0);
+    if (!shards.built()) buildShards();
+    if (!replica.shards.built()) replica.buildShards();
+    
+    std::vector<uint32_t> buckets = VaultShards::differingBuckets(shards, replica.shards, report.nodesCompared);
+    report.bucketsDiffering = buckets.size();
+    std::vector<uint32_t> mine, theirs, removals;
+    const char* fields[FIELD_COUNT];
+    size_t lengths[FIELD_COUNT];
+    for (uint32_t bucket : buckets) {
+        unmatchedInBucket(replica, bucket, mine, theirs);
+        if (!mine.empty() || !theirs.empty()) replica.dirtyShards |= uint64_t(1) << VaultShards::shardOf(bucket);
+        for (uint32_t id : mine) {
+            fieldsOf(passwords[id], fields, lengths);
+            auto counterpart = std::find_if(theirs.begin(), theirs.end(), [&](uint32_t theirId) {
+                const StringArena::Ref& service = replica.passwords[theirId].service;
+                return service.length == lengths[0] &&
+                       std::memcmp(replica.arena.data(service), fields[0], lengths[0]) == 0;
+            });
+            bool sent;
+            if (counterpart != theirs.end()) {
+                sent = replica.replace(*counterpart, fields, lengths);
+                theirs.erase(counterpart);
+            } else {
+                sent = replica.store(fields, lengths);
+            }
+            if (!sent) return report;
+            ++report.recordsSent;
+        }
+        removals.insert(removals.end(), theirs.begin(), theirs.end());
+    }
+    
+    // Highest first, so the record moved into each gap is never one still to be removed
+    std::sort(removals.begin(), removals.end(), std::greater<uint32_t>());
+    for (uint32_t id : removals) replica.swapRemove(id);
+    report.recordsRemoved = removals.size();
+    if (replica.deletedBytes * 2 > replica.arena.bytes()) replica.compact();
+    // The sealed keys only open with this vault's key, so the header goes along with them
+    if (replica.kdfHeader != kdfHeader) {
+        replica.kdfHeader = kdfHeader;
+        replica.vaultKey = vaultKey;
+        replica.headerDirty = true;
+    }
+    ET_METRICS_SET_BYTES(scope, report.recordsSent + report.recordsRemoved);
+    return report;
+}
@@ -1,4 +1,5 @@
 #include "PasswordStrengthAnalyzer.h"
+#include "Metrics.h"
 #include <iostream>
 #include <cctype>
 #include <random>
@@ -6,6 +7,7 @@
 #include <algorithm>
 
 void PasswordStrengthAnalyzer::analyzeStrength(const std::string& password) {
+    ET_METRICS_SCOPE(scope, Metrics::ANALYZE_STRENGTH, "analyzer", password.size());
     int length = password.length();
     bool hasLower = false, hasUpper = false, hasDigit = false, hasSpecial = false;
     std::set<char> uniqueChars;
@@ -167,6 +169,7 @@ void PasswordStrengthAnalyzer::analyzeStrength(const std::string& password) {
 }
 
 std::string PasswordStrengthAnalyzer::generateSecurePassword(int length) {
+    ET_METRICS_SCOPE(scope, Metrics::GENERATE_PASSWORD, "analyzer", 0);
     // Ensure minimum length for security
     if (length < 8) length = 12;
     if (length > 50) length = 50;
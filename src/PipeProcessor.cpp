@@ -0,0 +1,403 @@
+#include "PipeProcessor.h"
+#include "ArmoredCipher.h"
+#include "CompressedCipher.h"
+#include "SpscRing.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+
+const int PIPE_CAPACITY = 1 << 20;       // Requested for pipes on either side
+const size_t MIN_BLOCKS = 4;
+const size_t MAX_BLOCK_SIZE = 64 << 20;
+const unsigned YIELD_ROUNDS = 1000;      // Before a waiting stage starts sleeping
+const size_t STAGED_BLOCK_SIZE = 256 << 10;
+
+typedef std::chrono::steady_clock Clock;
+
+// A buffer handed from one stage to the next; size 0 marks the end of the stream
+struct Slot {
+    uint32_t block;
+    uint32_t size;
+};
+
+uint64_t nanosecondsSince(Clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+// Yields while the wait is short and then sleeps, so a stage idling on a slow neighbour
+// gives its core away instead of spinning on it
+class Backoff {
+public:
+    void pause() {
+        if (rounds < YIELD_ROUNDS) {
+            ++rounds;
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+private:
+    unsigned rounds = 0;
+};
+
+struct Pipeline {
+    CipherAlgorithm& cipher;
+    bool isEncryption;
+    int in;
+    int out;
+    size_t blockSize;
+    size_t blockCount;
+    bool zeroCopy;
+    char* memory = nullptr;
+
+    SpscRing<Slot> freeBlocks;   // Writer -> reader
+    SpscRing<Slot> filled;       // Reader -> cipher
+    SpscRing<Slot> processed;    // Cipher -> writer
+    std::atomic<bool> failed{false};
+
+    uint64_t bytesIn = 0;
+    uint64_t bytesOut = 0;
+    uint64_t readWaitNs = 0;
+    uint64_t cipherWaitNs = 0;
+    uint64_t writeWaitNs = 0;
+
+    Pipeline(CipherAlgorithm& cipher, bool isEncryption, int in, int out, size_t blockSize, size_t blockCount,
+             bool zeroCopy)
+        : cipher(cipher), isEncryption(isEncryption), in(in), out(out), blockSize(blockSize),
+          blockCount(blockCount), zeroCopy(zeroCopy),
+          freeBlocks(blockCount), filled(blockCount), processed(blockCount) {
+        // Anonymous mappings rather than the heap: pages still referenced by the output
+        // pipe when the run ends stay intact after munmap, where freed heap memory
+        // could be reused while the consumer is still reading it
+        void* mapping = mmap(nullptr, blockSize * blockCount, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping != MAP_FAILED) memory = static_cast<char*>(mapping);
+        for (size_t i = 0; i < blockCount; ++i) freeBlocks.tryPush({static_cast<uint32_t>(i), 0});
+    }
+
+    ~Pipeline() {
+        if (memory) munmap(memory, blockSize * blockCount);
+    }
+
+    char* block(uint32_t index) { return memory + index * blockSize; }
+
+    static void push(SpscRing<Slot>& ring, const Slot& slot, uint64_t& waitedNs) {
+        if (ring.tryPush(slot)) return;
+        Clock::time_point start = Clock::now();
+        Backoff backoff;
+        while (!ring.tryPush(slot)) backoff.pause();
+        waitedNs += nanosecondsSince(start);
+    }
+
+    static void pop(SpscRing<Slot>& ring, Slot& slot, uint64_t& waitedNs) {
+        if (ring.tryPop(slot)) return;
+        Clock::time_point start = Clock::now();
+        Backoff backoff;
+        while (!ring.tryPop(slot)) backoff.pause();
+        waitedNs += nanosecondsSince(start);
+    }
+};
+
+bool writeFully(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = write(fd, data, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Gives the buffer's pages to the pipe. Kernels or sandboxes that refuse vmsplice
+// switch the run to write()
+bool spliceFully(Pipeline& p, const char* data, size_t size, bool& spliced) {
+    while (size > 0) {
+        iovec chunk = {const_cast<char*>(data), size};
+        ssize_t n = vmsplice(p.out, &chunk, 1, SPLICE_F_GIFT);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && errno != EPIPE && errno != EAGAIN) {
+            p.zeroCopy = false;
+            return writeFully(p.out, data, size);
+        }
+        if (n <= 0) return false;
+        spliced = true;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// The pipe keeps referring to spliced pages until the consumer has read them, and a
+// consumer that splices them onward may hold them longer than it takes to drain the
+// pipe. So a spliced block never sees those pages again: fresh ones are moved over it.
+// They are mapped before the block is spliced; when that fails the block is copied.
+bool writeBlock(Pipeline& p, uint32_t index, size_t size) {
+    const char* data = p.block(index);
+    if (!p.zeroCopy) return writeFully(p.out, data, size);
+    void* fresh = mmap(nullptr, p.blockSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (fresh == MAP_FAILED) return writeFully(p.out, data, size);
+
+    bool spliced = false;
+    bool ok = spliceFully(p, data, size, spliced);
+    if (!spliced) {
+        munmap(fresh, p.blockSize);
+    } else if (mremap(fresh, p.blockSize, p.blockSize, MREMAP_MAYMOVE | MREMAP_FIXED, p.block(index)) == MAP_FAILED) {
+        // The block still shares its pages with the pipe; failing the run stops the
+        // reader from refilling it
+        munmap(fresh, p.blockSize);
+        std::cerr << "Error: Unable to allocate pipe buffers." << std::endl;
+        p.failed = true;
+    }
+    return ok;
+}
+
+void readStage(Pipeline& p) {
+    Slot slot;
+    while (true) {
+        Pipeline::pop(p.freeBlocks, slot, p.readWaitNs);
+        ssize_t n = 0;
+        if (!p.failed) {
+            do {
+                n = read(p.in, p.block(slot.block), p.blockSize);
+            } while (n < 0 && errno == EINTR);
+        }
+        if (n < 0) {
+            std::cerr << "Error: Unable to read input: " << std::strerror(errno) << std::endl;
+            p.failed = true;
+        }
+        slot.size = n > 0 ? static_cast<uint32_t>(n) : 0;
+        p.bytesIn += slot.size;
+        Pipeline::push(p.filled, slot, p.readWaitNs);
+        if (slot.size == 0) return;
+    }
+}
+
+void cipherStage(Pipeline& p) {
+    bool stateful = p.cipher.hasStreamState();
+    uint64_t state = 0;
+    Slot slot;
+    while (true) {
+        Pipeline::pop(p.filled, slot, p.cipherWaitNs);
+        if (slot.size > 0 && !p.failed) {
+            char* data = p.block(slot.block);
+            std::string text(data, slot.size);
+            std::string result = p.isEncryption ? p.cipher.encryptAt(text, state) : p.cipher.decryptAt(text, state);
+            if (stateful) state = p.cipher.advanceState(text, state);
+            std::memcpy(data, result.data(), std::min(result.size(), text.size()));
+        }
+        Pipeline::push(p.processed, slot, p.cipherWaitNs);
+        if (slot.size == 0) return;
+    }
+}
+
+void writeStage(Pipeline& p) {
+    Slot slot;
+    while (true) {
+        Pipeline::pop(p.processed, slot, p.writeWaitNs);
+        if (slot.size == 0) return;
+
+        if (!p.failed) {
+            if (writeBlock(p, slot.block, slot.size)) {
+                p.bytesOut += slot.size;
+            } else {
+                std::cerr << "Error: Unable to write output: " << std::strerror(errno) << std::endl;
+                p.failed = true;
+            }
+        }
+        Pipeline::push(p.freeBlocks, {slot.block, 0}, p.writeWaitNs);
+    }
+}
+
+bool isPipe(int fd) {
+    struct stat info;
+    return fstat(fd, &info) == 0 && S_ISFIFO(info.st_mode);
+}
+
+double busyFraction(uint64_t waitedNs, double seconds) {
+    if (seconds <= 0.0) return 0.0;
+    return std::max(0.0, 1.0 - static_cast<double>(waitedNs) / (seconds * 1e9));
+}
+
+// Ciphers that cannot be cut into blocks see the whole input in one call
+PipeProcessor::Report runBuffered(CipherAlgorithm& cipher, bool isEncryption, int inputFd, int outputFd) {
+    PipeProcessor::Report report;
+    report.mode = "buffered";
+    Clock::time_point start = Clock::now();
+
+    std::string text;
+    char buffer[64 * 1024];
+    while (true) {
+        ssize_t n = read(inputFd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            std::cerr << "Error: Unable to read input: " << std::strerror(errno) << std::endl;
+            report.ok = false;
+            return report;
+        }
+        if (n == 0) break;
+        text.append(buffer, static_cast<size_t>(n));
+    }
+    report.bytesIn = text.size();
+
+    std::string result;
+    if (!(isEncryption ? cipher.tryEncrypt(text, result) : cipher.tryDecrypt(text, result))) {
+        report.ok = false;  // Nothing is written, so a forged stream yields no output
+    } else if (!writeFully(outputFd, result.data(), result.size())) {
+        std::cerr << "Error: Unable to write output: " << std::strerror(errno) << std::endl;
+        report.ok = false;
+    }
+    report.bytesOut = report.ok ? result.size() : 0;
+    report.seconds = nanosecondsSince(start) / 1e9;
+    return report;
+}
+
+// Compression in front of and armor behind a length-preserving cipher stream block by
+// block: each block is ciphered at its stream position, compression works in independent
+// blocks, and the armor and decompression stages carry partial groups and blocks over
+PipeProcessor::Report runStaged(CipherAlgorithm& cipher, bool compressed, Armor armor, bool isEncryption,
+                                int inputFd, int outputFd) {
+    PipeProcessor::Report report;
+    report.mode = "staged";
+    Clock::time_point start = Clock::now();
+
+    bool stateful = cipher.hasStreamState();
+    uint64_t state = 0;
+    TextArmor::Encoder encoder(armor);
+    TextArmor::Decoder decoder(armor);
+    BlockCompression::Decoder decompressor;
+    std::string input(STAGED_BLOCK_SIZE, '\0');
+    std::string text;
+    std::string output;
+
+    while (report.ok) {
+        ssize_t n = read(inputFd, &input[0], input.size());
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            std::cerr << "Error: Unable to read input: " << std::strerror(errno) << std::endl;
+            report.ok = false;
+            break;
+        }
+        size_t size = static_cast<size_t>(n);
+        output.clear();
+        if (n == 0) {
+            if (isEncryption) {
+                encoder.finish(output);
+            } else if (!decoder.finish(output) || (compressed && !decompressor.finish())) {
+                std::cerr << "Error: Input ends in the middle of a block." << std::endl;
+                report.ok = false;
+            }
+        } else if (isEncryption) {
+            text.clear();
+            if (compressed) {
+                for (size_t offset = 0; offset < size; offset += BlockCompression::BLOCK_SIZE) {
+                    BlockCompression::compressBlock(input.data() + offset,
+                                                    std::min(BlockCompression::BLOCK_SIZE, size - offset), text);
+                }
+            } else {
+                text.assign(input.data(), size);
+            }
+            std::string ciphertext = cipher.encryptAt(text, state);
+            if (stateful) state = cipher.advanceState(text, state);
+            encoder.update(ciphertext.data(), ciphertext.size(), output);
+        } else {
+            text.clear();
+            if (!decoder.update(input.data(), size, text)) {
+                std::cerr << "Error: Input is not valid " << TextArmor::name(armor) << " text." << std::endl;
+                report.ok = false;
+            }
+            std::string plaintext = cipher.decryptAt(text, state);
+            if (stateful) state = cipher.advanceState(plaintext, state);
+            if (!compressed) {
+                output.swap(plaintext);
+            } else if (!decompressor.update(plaintext.data(), plaintext.size(), output)) {
+                std::cerr << "Error: Decrypted data is not valid compressed data (wrong key or algorithm?)."
+                          << std::endl;
+                report.ok = false;
+            }
+        }
+        report.bytesIn += size;
+
+        if (report.ok && !writeFully(outputFd, output.data(), output.size())) {
+            std::cerr << "Error: Unable to write output: " << std::strerror(errno) << std::endl;
+            report.ok = false;
+        }
+        if (report.ok) report.bytesOut += output.size();
+        if (n == 0) break;
+    }
+    report.seconds = nanosecondsSince(start) / 1e9;
+    return report;
+}
+
+} // namespace
+
+PipeProcessor::Report PipeProcessor::run(CipherAlgorithm& cipher, bool isEncryption, int inputFd, int outputFd) {
+    return run(cipher, isEncryption, inputFd, outputFd, Options());
+}
+
+PipeProcessor::Report PipeProcessor::run(CipherAlgorithm& cipher, bool isEncryption, int inputFd, int outputFd,
+                                         const Options& options) {
+    // Peel off armor and compression stages; they stream if what is left can
+    CipherAlgorithm* core = &cipher;
+    Armor armor = Armor::NONE;
+    if (ArmoredCipher* armored = dynamic_cast<ArmoredCipher*>(core)) {
+        armor = armored->getArmor();
+        core = &armored->getInner();
+    }
+    CompressedCipher* compressed = dynamic_cast<CompressedCipher*>(core);
+    if (compressed) core = &compressed->getInner();
+    if (core != &cipher && core->preservesLength()) {
+        return runStaged(*core, compressed != nullptr, armor, isEncryption, inputFd, outputFd);
+    }
+    if (!cipher.preservesLength()) return runBuffered(cipher, isEncryption, inputFd, outputFd);
+
+    // Larger pipes mean fewer wakeups for us and for the processes on either side
+    if (isPipe(inputFd)) fcntl(inputFd, F_SETPIPE_SZ, PIPE_CAPACITY);
+    bool outputIsPipe = isPipe(outputFd);
+    if (outputIsPipe) fcntl(outputFd, F_SETPIPE_SZ, PIPE_CAPACITY);
+
+    bool zeroCopy = options.zeroCopy && outputIsPipe;
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t blockSize = std::min(MAX_BLOCK_SIZE, std::max(options.blockSize, page));
+    blockSize = (blockSize + page - 1) / page * page;
+    size_t blockCount = std::max(MIN_BLOCKS, options.blocks);
+
+    Report report;
+    Clock::time_point start = Clock::now();
+    Pipeline pipeline(cipher, isEncryption, inputFd, outputFd, blockSize, blockCount, zeroCopy);
+    if (!pipeline.memory) {
+        std::cerr << "Error: Unable to allocate pipe buffers." << std::endl;
+        report.ok = false;
+        return report;
+    }
+
+    std::thread reader(readStage, std::ref(pipeline));
+    std::thread worker(cipherStage, std::ref(pipeline));
+    writeStage(pipeline);
+    reader.join();
+    worker.join();
+
+    report.ok = !pipeline.failed;
+    report.bytesIn = pipeline.bytesIn;
+    report.bytesOut = pipeline.bytesOut;
+    report.seconds = nanosecondsSince(start) / 1e9;
+    report.readBusy = busyFraction(pipeline.readWaitNs, report.seconds);
+    report.cipherBusy = busyFraction(pipeline.cipherWaitNs, report.seconds);
+    report.writeBusy = busyFraction(pipeline.writeWaitNs, report.seconds);
+    report.mode = pipeline.zeroCopy ? "vmsplice" : "write";
+    return report;
+}
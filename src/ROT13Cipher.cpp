@@ -1,30 +1,38 @@
 #include "ROT13Cipher.h"
-#include <cctype>
+#include "CipherKernels.h"
 #include <iostream>
 
 ROT13Cipher::ROT13Cipher() {
     // Default initialization
 }
 
-ROT13Cipher::ROT13Cipher(const std::string& info) {
-    // Use info for custom initialization
+ROT13Cipher::ROT13Cipher(const std::string&) {
+    // ROT13 takes no settings; the overload matches the other ciphers'
 }
 
-std::string ROT13Cipher::processText(const std::string& text, bool isEncryption) {
+// Its own inverse, so the direction does not matter
+std::string ROT13Cipher::processText(const std::string& text, bool) {
     std::string result = text;
     
-    for (char& c : result) {
-        if (std::isalpha(c)) {
-            char base = std::isupper(c) ? 'A' : 'a';
-            c = static_cast<char>(base + (c - base + 13) % 26);
-        }
-    }
+    CipherKernels::shiftLetters(&result[0], result.size(), 13);
     
     return result;
 }
 
-void ROT13Cipher::setKey(const std::string& key) {
+std::shared_ptr<const KeySchedule> ROT13Cipher::compileKey(const std::string&) const {
     // ROT13 doesn't use a key
+    return nullptr;
+}
+
+void ROT13Cipher::applySchedule(const std::shared_ptr<const KeySchedule>&) {
+}
+
+bool ROT13Cipher::preservesLength() const {
+    return true;
+}
+
+const char* ROT13Cipher::getName() const {
+    return "rot13";
 }
 
 std::string ROT13Cipher::getDescription() const {
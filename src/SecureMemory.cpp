@@ -0,0 +1,220 @@
+#include "SecureMemory.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t SLAB_BYTES = 64 * 1024;
+const size_t MIN_BLOCK = 32;
+const int CLASS_COUNT = 12;  // 32 B to 64 KB in powers of two
+const size_t MAX_BLOCK = MIN_BLOCK << (CLASS_COUNT - 1);
+const size_t CACHE_BATCH = 32;  // Blocks moved between a thread cache and its pool at once
+
+struct SizeClass {
+    std::mutex mutex;
+    std::vector<void*> freeBlocks;
+};
+
+struct Pool {
+    SizeClass classes[CLASS_COUNT];
+    std::atomic<size_t> slabBytes{0};
+    std::atomic<size_t> lockedBytes{0};
+    std::atomic<bool> warned{false};
+};
+
+// Never destroyed: secrets held by other statics may be released after main returns
+Pool& pool() {
+    static Pool* instance = new Pool;
+    return *instance;
+}
+
+size_t pageSize() {
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+size_t roundToPages(size_t bytes) {
+    size_t page = pageSize();
+    return (bytes + page - 1) / page * page;
+}
+
+int classOf(size_t bytes) {
+    if (bytes <= MIN_BLOCK) return 0;
+    return 64 - __builtin_clzll(static_cast<unsigned long long>(bytes - 1)) - 5;  // log2(MIN_BLOCK) = 5
+}
+
+// Opens [data, data + bytes) for use inside a PROT_NONE reservation
+bool openRegion(char* data, size_t bytes) {
+    if (mprotect(data, bytes, PROT_READ | PROT_WRITE) != 0) return false;
+#ifdef MADV_DONTDUMP
+    madvise(data, bytes, MADV_DONTDUMP);
+#endif
+    Pool& shared = pool();
+    shared.slabBytes += bytes;
+    if (mlock(data, bytes) == 0) {
+        shared.lockedBytes += bytes;
+    } else if (!shared.warned.exchange(true)) {
+        std::cerr << "Warning: Unable to lock secure memory (RLIMIT_MEMLOCK); secrets may be swapped." << std::endl;
+    }
+    return true;
+}
+
+char* reserve(size_t bytes) {
+    void* base = mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return base == MAP_FAILED ? nullptr : static_cast<char*>(base);
+}
+
+// Blocks under a page share one guarded run of pages; larger blocks are each followed
+// by their own guard page
+bool refill(int index, SizeClass& sizeClass) {
+    size_t page = pageSize();
+    size_t blockSize = MIN_BLOCK << index;
+    bool ownGuards = blockSize >= page;
+    size_t stride = ownGuards ? blockSize + page : blockSize;
+    size_t blocks = blockSize >= SLAB_BYTES ? 1 : SLAB_BYTES / blockSize;
+    size_t dataBytes = ownGuards ? stride * blocks : SLAB_BYTES;
+
+    char* base = reserve(page + dataBytes + (ownGuards ? 0 : page));
+    if (!base) return false;
+    char* data = base + page;
+    if (ownGuards) {
+        for (size_t i = 0; i < blocks; ++i) {
+            if (!openRegion(data + i * stride, blockSize)) return false;
+        }
+    } else if (!openRegion(data, dataBytes)) {
+        return false;
+    }
+
+    // Pushed in reverse so blocks are handed out in address order
+    for (size_t i = blocks; i > 0; --i) sizeClass.freeBlocks.push_back(data + (i - 1) * stride);
+    return true;
+}
+
+// Moves the last count blocks of a thread's list back to the shared pool
+void returnBlocks(int index, std::vector<void*>& blocks, size_t count) {
+    SizeClass& sizeClass = pool().classes[index];
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    sizeClass.freeBlocks.insert(sizeClass.freeBlocks.end(), blocks.end() - count, blocks.end());
+    blocks.resize(blocks.size() - count);
+}
+
+// Per-thread free lists, so the common allocate/release pair takes no lock. Blocks move
+// to and from the shared pool in batches and go back to it when the thread exits.
+thread_local bool threadCacheGone = false;  // Trivial, so still readable during thread exit
+
+struct ThreadCache {
+    std::vector<void*> blocks[CLASS_COUNT];
+
+    ~ThreadCache() {
+        threadCacheGone = true;
+        for (int index = 0; index < CLASS_COUNT; ++index) returnBlocks(index, blocks[index], blocks[index].size());
+    }
+};
+
+thread_local ThreadCache threadCache;
+
+} // namespace
+
+namespace SecureMemory {
+
+void* allocate(size_t bytes) {
+    if (bytes == 0) bytes = 1;
+    Pool& shared = pool();
+
+    if (bytes > MAX_BLOCK) {
+        size_t page = pageSize();
+        size_t dataBytes = roundToPages(bytes);
+        char* base = reserve(dataBytes + 2 * page);
+        if (!base || !openRegion(base + page, dataBytes)) throw std::bad_alloc();
+        return base + page;
+    }
+
+    int index = classOf(bytes);
+    SizeClass& sizeClass = shared.classes[index];
+    if (threadCacheGone) {
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        if (sizeClass.freeBlocks.empty() && !refill(index, sizeClass)) throw std::bad_alloc();
+        void* block = sizeClass.freeBlocks.back();
+        sizeClass.freeBlocks.pop_back();
+        return block;
+    }
+
+    std::vector<void*>& cached = threadCache.blocks[index];
+    if (cached.empty()) {
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        if (sizeClass.freeBlocks.empty() && !refill(index, sizeClass)) throw std::bad_alloc();
+        size_t take = std::min(CACHE_BATCH, sizeClass.freeBlocks.size());
+        cached.assign(sizeClass.freeBlocks.end() - take, sizeClass.freeBlocks.end());
+        sizeClass.freeBlocks.resize(sizeClass.freeBlocks.size() - take);
+    }
+    void* block = cached.back();
+    cached.pop_back();
+    return block;
+}
+
+void release(void* pointer, size_t bytes) {
+    if (!pointer) return;
+    if (bytes == 0) bytes = 1;
+    wipe(pointer, bytes);
+
+    if (bytes > MAX_BLOCK) {
+        Pool& shared = pool();
+        size_t page = pageSize();
+        size_t dataBytes = roundToPages(bytes);
+        munlock(pointer, dataBytes);
+        munmap(static_cast<char*>(pointer) - page, dataBytes + 2 * page);
+        shared.slabBytes -= dataBytes;
+        shared.lockedBytes -= std::min<size_t>(shared.lockedBytes, dataBytes);
+        return;
+    }
+
+    int index = classOf(bytes);
+    if (threadCacheGone) {
+        SizeClass& sizeClass = pool().classes[index];
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        sizeClass.freeBlocks.push_back(pointer);
+        return;
+    }
+
+    std::vector<void*>& cached = threadCache.blocks[index];
+    cached.push_back(pointer);
+    if (cached.size() >= 2 * CACHE_BATCH) returnBlocks(index, cached, CACHE_BATCH);
+}
+
+void wipe(void* pointer, size_t bytes) {
+    std::memset(pointer, 0, bytes);
+#if defined(__GNUC__)
+    __asm__ __volatile__("" : : "r"(pointer) : "memory");  // The zeroes must be considered read
+#else
+    volatile char* bytesToClear = static_cast<volatile char*>(pointer);
+    for (size_t i = 0; i < bytes; ++i) bytesToClear[i] = 0;
+#endif
+}
+
+void wipe(std::string& text) {
+    text.resize(text.capacity());  // Never reallocates
+    if (!text.empty()) wipe(&text[0], text.size());
+    text.clear();
+}
+
+Stats stats() {
+    Pool& shared = pool();
+    return Stats{shared.slabBytes.load(), shared.lockedBytes.load()};
+}
+
+} // namespace SecureMemory
+
+// FNV-1a
+size_t SecureStringHash::operator()(const SecureString& text) const {
+    uint64_t value = 14695981039346656037ULL;
+    for (char c : text) {
+        value ^= static_cast<unsigned char>(c);
+        value *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(value);
+}
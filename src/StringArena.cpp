@@ -0,0 +1,93 @@
+#include "StringArena.h"
+#include "SecureMemory.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+const uint32_t EMPTY_SLOT = UINT32_MAX;
+const size_t INITIAL_INTERN_SLOTS = 64;
+
+} // namespace
+
+StringArena::Ref StringArena::append(const char* data, size_t length) {
+    Ref ref;
+    ref.offset = static_cast<uint32_t>(storage.size());
+    ref.length = static_cast<uint32_t>(length);
+    if (length > storage.capacity() - storage.size()) grow(std::max(storage.size() + length, 2 * storage.capacity()));
+    storage.insert(storage.end(), data, data + length);
+    return ref;
+}
+
+StringArena::Ref StringArena::intern(const char* data, size_t length) {
+    // Kept at most half full, so probe runs stay short
+    if ((internCount + 1) * 2 > internSlots.size()) growInternTable();
+
+    size_t mask = internSlots.size() - 1;
+    size_t slot = static_cast<size_t>(hash(data, length)) & mask;
+    while (internSlots[slot].length != EMPTY_SLOT) {
+        const Ref& candidate = internSlots[slot];
+        if (candidate.length == length && std::memcmp(this->data(candidate), data, length) == 0) return candidate;
+        slot = (slot + 1) & mask;
+    }
+
+    Ref ref = append(data, length);
+    internSlots[slot] = ref;
+    ++internCount;
+    return ref;
+}
+
+void StringArena::reserve(size_t bytes) {
+    if (bytes > storage.capacity()) grow(bytes);
+}
+
+void StringArena::clear() {
+    if (!storage.empty()) SecureMemory::wipe(storage.data(), storage.size());
+    storage.clear();
+    internSlots.clear();
+    internCount = 0;
+}
+
+void StringArena::swap(StringArena& other) {
+    storage.swap(other.storage);
+    internSlots.swap(other.internSlots);
+    std::swap(internCount, other.internCount);
+}
+
+size_t StringArena::memoryUsage() const {
+    return storage.capacity() + internSlots.capacity() * sizeof(Ref);
+}
+
+// FNV-1a
+uint64_t StringArena::hash(const char* data, size_t length) {
+    uint64_t value = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; ++i) {
+        value ^= static_cast<unsigned char>(data[i]);
+        value *= 1099511628211ULL;
+    }
+    return value;
+}
+
+// Moves to a buffer of the given capacity by hand, so the old one can be wiped
+void StringArena::grow(size_t bytes) {
+    std::vector<char> larger;
+    larger.reserve(bytes);
+    larger.assign(storage.begin(), storage.end());
+    if (!storage.empty()) SecureMemory::wipe(storage.data(), storage.size());
+    storage.swap(larger);
+}
+
+void StringArena::growInternTable() {
+    Ref empty;
+    empty.length = EMPTY_SLOT;
+    std::vector<Ref> slots(internSlots.empty() ? INITIAL_INTERN_SLOTS : internSlots.size() * 2, empty);
+
+    size_t mask = slots.size() - 1;
+    for (const Ref& ref : internSlots) {
+        if (ref.length == EMPTY_SLOT) continue;
+        size_t slot = static_cast<size_t>(hash(data(ref), ref.length)) & mask;
+        while (slots[slot].length != EMPTY_SLOT) slot = (slot + 1) & mask;
+        slots[slot] = ref;
+    }
+    internSlots.swap(slots);
+}
@@ -1,22 +1,24 @@
 #include "SubstitutionCipher.h"
+#include "Ascii.h"
 #include <algorithm>
-#include <cctype>
 
 SubstitutionCipher::SubstitutionCipher() {
     setKey("QWERTYUIOPASDFGHJKLZXCVBNM");
 }
 
-void SubstitutionCipher::generateMaps(const std::string& key) {
-    encryptionMap.clear();
-    decryptionMap.clear();
+std::shared_ptr<const SubstitutionCipher::Schedule> SubstitutionCipher::generateMaps(const std::string& key) {
+    auto maps = makeSecureShared<Schedule>();
+    for (int i = 0; i < 256; ++i) {
+        maps->encryptionMap[i] = maps->decryptionMap[i] = static_cast<char>(i);
+    }
     
     std::string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
     std::string processedKey = key;
     
-    std::transform(processedKey.begin(), processedKey.end(), processedKey.begin(), ::toupper);
+    std::transform(processedKey.begin(), processedKey.end(), processedKey.begin(), Ascii::toUpper);
     
     processedKey.erase(
-        std::remove_if(processedKey.begin(), processedKey.end(), [](char c) { return !std::isalpha(c); }),
+        std::remove_if(processedKey.begin(), processedKey.end(), [](char c) { return !Ascii::isAlpha(c); }),
         processedKey.end()
     );
     
@@ -33,37 +35,46 @@ void SubstitutionCipher::generateMaps(const std::string& key) {
         }
     }
     
+    auto index = [](char c) { return static_cast<unsigned char>(c); };
     for (size_t i = 0; i < alphabet.size(); ++i) {
-        encryptionMap[alphabet[i]] = uniqueKey[i];
-        decryptionMap[uniqueKey[i]] = alphabet[i];
+        maps->encryptionMap[index(alphabet[i])] = uniqueKey[i];
+        maps->decryptionMap[index(uniqueKey[i])] = alphabet[i];
         
-        encryptionMap[std::tolower(alphabet[i])] = std::tolower(uniqueKey[i]);
-        decryptionMap[std::tolower(uniqueKey[i])] = std::tolower(alphabet[i]);
+        maps->encryptionMap[index(Ascii::toLower(alphabet[i]))] = Ascii::toLower(uniqueKey[i]);
+        maps->decryptionMap[index(Ascii::toLower(uniqueKey[i]))] = Ascii::toLower(alphabet[i]);
     }
+    return maps;
 }
 
 std::string SubstitutionCipher::processText(const std::string& text, bool isEncryption) {
     std::string result = text;
+    const std::array<char, 256>& map = isEncryption ? schedule->encryptionMap : schedule->decryptionMap;
     
     for (char& c : result) {
-        if (std::isalpha(c)) {
-            auto& map = isEncryption ? encryptionMap : decryptionMap;
-            auto it = map.find(c);
-            if (it != map.end()) {
-                c = it->second;
-            }
-        }
+        c = map[static_cast<unsigned char>(c)];
     }
     
     return result;
 }
 
-void SubstitutionCipher::setKey(const std::string& key) {
+std::shared_ptr<const KeySchedule> SubstitutionCipher::compileKey(const std::string& key) const {
     std::string processedKey = key;
     if (processedKey.empty()) {
         processedKey = "QWERTYUIOPASDFGHJKLZXCVBNM";
     }
-    generateMaps(processedKey);
+    return generateMaps(processedKey);
+}
+
+void SubstitutionCipher::applySchedule(const std::shared_ptr<const KeySchedule>& newSchedule) {
+    if (newSchedule) schedule = std::static_pointer_cast<const Schedule>(newSchedule);
+}
+
+bool SubstitutionCipher::preservesLength() const {
+    return true;
+}
+
+const char* SubstitutionCipher::getName() const {
+    return "substitution";
 }
 
 std::string SubstitutionCipher::getDescription() const {
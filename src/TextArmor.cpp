@@ -0,0 +1,430 @@
+#include "TextArmor.h"
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(ET_NO_MULTIVERSIONING)
+#include <immintrin.h>
+#define ARMOR_HAVE_X86_KERNELS 1
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+namespace {
+
+const char HEX_DIGITS[] = "0123456789abcdef";
+const char BASE64_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+const uint8_t INVALID = 0xFF;
+const size_t WHITESPACE_BLOCK = 32;
+
+struct DecodeTables {
+    uint8_t hex[256];
+    uint8_t base64[256];
+
+    DecodeTables() {
+        std::memset(hex, INVALID, sizeof(hex));
+        std::memset(base64, INVALID, sizeof(base64));
+        for (int i = 0; i < 16; ++i) {
+            hex[static_cast<uint8_t>(HEX_DIGITS[i])] = static_cast<uint8_t>(i);
+            hex[static_cast<uint8_t>(i < 10 ? HEX_DIGITS[i] : HEX_DIGITS[i] - 'a' + 'A')] = static_cast<uint8_t>(i);
+        }
+        for (int i = 0; i < 64; ++i) base64[static_cast<uint8_t>(BASE64_ALPHABET[i])] = static_cast<uint8_t>(i);
+    }
+};
+
+const DecodeTables& tables() {
+    static const DecodeTables instance;
+    return instance;
+}
+
+bool isWhitespace(char c) {
+    return c == '\n' || c == '\r' || c == ' ' || c == '\t';
+}
+
+bool hasControl(const uint8_t* bytes, size_t size) {
+    uint8_t low = 0;
+    for (size_t i = 0; i < size; ++i) low |= static_cast<uint8_t>(bytes[i] <= ' ');
+    return low != 0;
+}
+
+// The checks are branch-free ORs the compiler vectorizes, so unwrapped text is a plain
+// append and wrapped text copies whole 32-byte blocks between line breaks
+void appendWithoutWhitespace(std::string& target, const char* text, size_t size) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(text);
+    if (!hasControl(bytes, size)) {
+        target.append(text, size);
+        return;
+    }
+    size_t start = target.size();
+    target.resize(start + size);
+    char* out = &target[start];
+    size_t kept = 0;
+    size_t i = 0;
+    for (; i + WHITESPACE_BLOCK <= size; i += WHITESPACE_BLOCK) {
+        if (!hasControl(bytes + i, WHITESPACE_BLOCK)) {
+            std::memcpy(out + kept, text + i, WHITESPACE_BLOCK);
+            kept += WHITESPACE_BLOCK;
+            continue;
+        }
+        // Every character is stored and the write position only moves past the kept ones
+        for (size_t j = i; j < i + WHITESPACE_BLOCK; ++j) {
+            out[kept] = text[j];
+            kept += !isWhitespace(text[j]);
+        }
+    }
+    for (; i < size; ++i) {
+        out[kept] = text[i];
+        kept += !isWhitespace(text[i]);
+    }
+    target.resize(start + kept);
+}
+
+#ifdef ARMOR_HAVE_X86_KERNELS
+
+bool cpuHasAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+// Nibbles through a 16-entry shuffle table, then interleaved back into byte order
+AVX2_TARGET size_t hexEncodeAvx2(const uint8_t* data, size_t size, char* text) {
+    const __m256i digits = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd',
+                                            'e', 'f', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b',
+                                            'c', 'd', 'e', 'f');
+    const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i high = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(in, 4), lowNibble));
+        __m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(in, lowNibble));
+        __m256i first = _mm256_unpacklo_epi8(high, low);   // Bytes 0-7 | 16-23
+        __m256i second = _mm256_unpackhi_epi8(high, low);  // Bytes 8-15 | 24-31
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(text + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(text + 2 * i + 32),
+                            _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    return i;
+}
+
+// Digit or letter value per character, with an all-ones mask when every one was valid
+AVX2_TARGET inline __m256i hexValues(__m256i text, int& validMask) {
+    __m256i digit = _mm256_sub_epi8(text, _mm256_set1_epi8('0'));
+    __m256i letter = _mm256_sub_epi8(_mm256_or_si256(text, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    __m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+    validMask = _mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter));
+    return _mm256_blendv_epi8(_mm256_add_epi8(letter, _mm256_set1_epi8(10)), digit, isDigit);
+}
+
+// Returns the characters consumed, or SIZE_MAX on an invalid character
+AVX2_TARGET size_t hexDecodeAvx2(const char* text, size_t size, uint8_t* data) {
+    const __m256i weights = _mm256_set1_epi16(0x0110);  // High nibble * 16 + low nibble
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        int valid0 = 0;
+        int valid1 = 0;
+        __m256i values0 = hexValues(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i)), valid0);
+        __m256i values1 = hexValues(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i + 32)), valid1);
+        if ((valid0 & valid1) != -1) return SIZE_MAX;
+        __m256i bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(values0, weights),
+                                            _mm256_maddubs_epi16(values1, weights));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i / 2), _mm256_permute4x64_epi64(bytes, 0xD8));
+    }
+    return i;
+}
+
+// 24 bytes to 32 characters per step (W. Muła and D. Lemire): spread each 3-byte group
+// over a 32-bit lane, cut out the four 6-bit fields with multiplies, then map 0-63 to
+// ASCII by adding a per-range offset picked with a shuffle
+AVX2_TARGET size_t base64EncodeAvx2(const uint8_t* data, size_t size, char* text) {
+    const __m256i spread = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5,
+                                            4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i offsets = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                             '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+                                             'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                             '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    size_t i = 0;
+    size_t out = 0;
+    for (; i + 28 <= size; i += 24, out += 32) {  // The second load reads 4 bytes past the group
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 12));
+        __m256i in = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1), spread);
+
+        __m256i ac = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)),
+                                        _mm256_set1_epi32(0x04000040));
+        __m256i bd = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)),
+                                        _mm256_set1_epi32(0x01000010));
+        __m256i indices = _mm256_or_si256(ac, bd);
+
+        __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        __m256i isUpper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        range = _mm256_or_si256(range, _mm256_and_si256(isUpper, _mm256_set1_epi8(13)));
+        __m256i ascii = _mm256_add_epi8(_mm256_shuffle_epi8(offsets, range), indices);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(text + out), ascii);
+    }
+    return i;
+}
+
+// 32 characters to 24 bytes per step (W. Muła and D. Lemire). Validity is a bitmap
+// lookup: the low nibble selects which high nibbles are allowed. Blocks that fail,
+// including the one holding '=' padding, are left to the scalar loop.
+AVX2_TARGET size_t base64DecodeAvx2(const char* text, size_t size, uint8_t* data) {
+    const __m256i allowed = _mm256_setr_epi8(
+        static_cast<char>(0xA8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8),
+        static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8),
+        static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF0), 0x54, 0x50, 0x50, 0x50, 0x54,
+        static_cast<char>(0xA8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8),
+        static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF8),
+        static_cast<char>(0xF8), static_cast<char>(0xF8), static_cast<char>(0xF0), 0x54, 0x50, 0x50, 0x50, 0x54);
+    const __m256i highBit = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, static_cast<char>(0x80), 0, 0, 0, 0, 0, 0, 0, 0,
+                                             1, 2, 4, 8, 16, 32, 64, static_cast<char>(0x80), 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i shifts = _mm256_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 19, 4,
+                                            -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i gather = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5,
+                                            4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+
+    size_t i = 0;
+    size_t out = 0;
+    for (; i + 32 + 4 <= size; i += 32, out += 24) {  // The last group always goes to the scalar loop
+        __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+        __m256i high = _mm256_and_si256(_mm256_srli_epi32(in, 4), lowNibble);
+        __m256i low = _mm256_and_si256(in, lowNibble);
+        __m256i hits = _mm256_and_si256(_mm256_shuffle_epi8(allowed, low), _mm256_shuffle_epi8(highBit, high));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(hits, _mm256_setzero_si256())) != 0) break;
+
+        __m256i isSlash = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('/'));
+        __m256i shift = _mm256_blendv_epi8(_mm256_shuffle_epi8(shifts, high), _mm256_set1_epi8(16), isSlash);
+        __m256i values = _mm256_add_epi8(in, shift);
+
+        __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        __m256i groups = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        __m256i bytes = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(groups, gather),
+                                                    _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 0, 0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + out), _mm256_castsi256_si128(bytes));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(data + out + 16), _mm256_extracti128_si256(bytes, 1));
+    }
+    return i;
+}
+
+#endif
+
+} // namespace
+
+namespace TextArmor {
+
+const char* name(Armor armor) {
+    switch (armor) {
+        case Armor::HEX: return "hex";
+        case Armor::BASE64: return "base64";
+        default: return "";
+    }
+}
+
+bool parse(const std::string& text, Armor& armor) {
+    if (text == "hex") {
+        armor = Armor::HEX;
+    } else if (text == "base64") {
+        armor = Armor::BASE64;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+size_t encodedSize(Armor armor, size_t bytes) {
+    switch (armor) {
+        case Armor::HEX: return 2 * bytes;
+        case Armor::BASE64: return (bytes + 2) / 3 * 4;
+        default: return bytes;
+    }
+}
+
+void hexEncodeScalar(const uint8_t* data, size_t size, char* text) {
+    for (size_t i = 0; i < size; ++i) {
+        text[2 * i] = HEX_DIGITS[data[i] >> 4];
+        text[2 * i + 1] = HEX_DIGITS[data[i] & 0x0F];
+    }
+}
+
+bool hexDecodeScalar(const char* text, size_t size, uint8_t* data) {
+    if (size % 2 != 0) return false;
+    const uint8_t* table = tables().hex;
+    for (size_t i = 0; i < size; i += 2) {
+        uint8_t high = table[static_cast<uint8_t>(text[i])];
+        uint8_t low = table[static_cast<uint8_t>(text[i + 1])];
+        if ((high | low) & 0xF0) return false;  // Valid values are below 16
+        data[i / 2] = static_cast<uint8_t>(high << 4 | low);
+    }
+    return true;
+}
+
+void base64EncodeScalar(const uint8_t* data, size_t size, char* text) {
+    size_t i = 0;
+    for (; i + 3 <= size; i += 3, text += 4) {
+        uint32_t group = static_cast<uint32_t>(data[i]) << 16 | static_cast<uint32_t>(data[i + 1]) << 8 | data[i + 2];
+        text[0] = BASE64_ALPHABET[group >> 18];
+        text[1] = BASE64_ALPHABET[(group >> 12) & 63];
+        text[2] = BASE64_ALPHABET[(group >> 6) & 63];
+        text[3] = BASE64_ALPHABET[group & 63];
+    }
+    if (i < size) {
+        uint32_t group = static_cast<uint32_t>(data[i]) << 16;
+        if (i + 1 < size) group |= static_cast<uint32_t>(data[i + 1]) << 8;
+        text[0] = BASE64_ALPHABET[group >> 18];
+        text[1] = BASE64_ALPHABET[(group >> 12) & 63];
+        text[2] = i + 1 < size ? BASE64_ALPHABET[(group >> 6) & 63] : '=';
+        text[3] = '=';
+    }
+}
+
+bool base64DecodeScalar(const char* text, size_t size, uint8_t* data, size_t& dataSize) {
+    dataSize = 0;
+    if (size % 4 != 0) return false;
+    const uint8_t* table = tables().base64;
+    for (size_t i = 0; i < size; i += 4) {
+        // Padding is only allowed as the last one or two characters of the input
+        int padding = 0;
+        if (i + 4 == size) padding = text[i + 3] == '=' ? (text[i + 2] == '=' ? 2 : 1) : 0;
+        uint8_t a = table[static_cast<uint8_t>(text[i])];
+        uint8_t b = table[static_cast<uint8_t>(text[i + 1])];
+        uint8_t c = padding >= 2 ? 0 : table[static_cast<uint8_t>(text[i + 2])];
+        uint8_t d = padding >= 1 ? 0 : table[static_cast<uint8_t>(text[i + 3])];
+        if (a == INVALID || b == INVALID || c == INVALID || d == INVALID) return false;
+
+        uint32_t group = static_cast<uint32_t>(a) << 18 | static_cast<uint32_t>(b) << 12 |
+                         static_cast<uint32_t>(c) << 6 | d;
+        data[dataSize++] = static_cast<uint8_t>(group >> 16);
+        if (padding < 2) data[dataSize++] = static_cast<uint8_t>(group >> 8);
+        if (padding < 1) data[dataSize++] = static_cast<uint8_t>(group);
+    }
+    return true;
+}
+
+void hexEncode(const uint8_t* data, size_t size, char* text) {
+    size_t done = 0;
+#ifdef ARMOR_HAVE_X86_KERNELS
+    static const bool hasAvx2 = cpuHasAvx2();
+    if (hasAvx2) done = hexEncodeAvx2(data, size, text);
+#endif
+    hexEncodeScalar(data + done, size - done, text + 2 * done);
+}
+
+bool hexDecode(const char* text, size_t size, uint8_t* data) {
+    if (size % 2 != 0) return false;
+    size_t done = 0;
+#ifdef ARMOR_HAVE_X86_KERNELS
+    static const bool hasAvx2 = cpuHasAvx2();
+    if (hasAvx2) done = hexDecodeAvx2(text, size, data);
+    if (done == SIZE_MAX) return false;
+#endif
+    return hexDecodeScalar(text + done, size - done, data + done / 2);
+}
+
+void base64Encode(const uint8_t* data, size_t size, char* text) {
+    size_t done = 0;
+#ifdef ARMOR_HAVE_X86_KERNELS
+    static const bool hasAvx2 = cpuHasAvx2();
+    if (hasAvx2) done = base64EncodeAvx2(data, size, text);
+#endif
+    base64EncodeScalar(data + done, size - done, text + done / 3 * 4);
+}
+
+bool base64Decode(const char* text, size_t size, uint8_t* data, size_t& dataSize) {
+    dataSize = 0;
+    if (size % 4 != 0) return false;
+    size_t done = 0;
+#ifdef ARMOR_HAVE_X86_KERNELS
+    static const bool hasAvx2 = cpuHasAvx2();
+    if (hasAvx2) done = base64DecodeAvx2(text, size, data);
+#endif
+    size_t tailSize = 0;
+    bool ok = base64DecodeScalar(text + done, size - done, data + done / 4 * 3, tailSize);
+    dataSize = done / 4 * 3 + tailSize;
+    return ok;
+}
+
+void Encoder::update(const char* data, size_t size, std::string& text) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    if (armor == Armor::NONE) {
+        text.append(data, size);
+    } else if (armor == Armor::HEX) {
+        size_t start = text.size();
+        text.resize(start + 2 * size);
+        hexEncode(bytes, size, &text[start]);
+    } else {
+        // Top up a partial group from the previous call, then encode whole groups in place
+        while (!pending.empty() && pending.size() < 3 && size > 0) {
+            pending += *data++;
+            ++bytes;
+            --size;
+        }
+        if (pending.size() == 3) {
+            size_t start = text.size();
+            text.resize(start + 4);
+            base64Encode(reinterpret_cast<const uint8_t*>(pending.data()), 3, &text[start]);
+            pending.clear();
+        }
+        size_t whole = size / 3 * 3;
+        size_t start = text.size();
+        text.resize(start + whole / 3 * 4);
+        if (whole > 0) base64Encode(bytes, whole, &text[start]);
+        pending.append(data + whole, size - whole);
+    }
+}
+
+void Encoder::finish(std::string& text) {
+    if (armor != Armor::BASE64 || pending.empty()) return;
+    size_t start = text.size();
+    text.resize(start + 4);
+    base64Encode(reinterpret_cast<const uint8_t*>(pending.data()), pending.size(), &text[start]);
+    pending.clear();
+}
+
+bool Decoder::update(const char* text, size_t size, std::string& data) {
+    if (armor == Armor::NONE) {
+        data.append(text, size);
+        return true;
+    }
+    appendWithoutWhitespace(pending, text, size);
+    size_t group = armor == Armor::HEX ? 2 : 4;
+    size_t whole = pending.size() / group * group;
+    if (whole == 0) return true;
+    if (padded) return false;  // Text after the final '=' group
+
+    size_t start = data.size();
+    bool ok;
+    if (armor == Armor::HEX) {
+        data.resize(start + whole / 2);
+        ok = hexDecode(pending.data(), whole, reinterpret_cast<uint8_t*>(&data[start]));
+    } else {
+        data.resize(start + whole / 4 * 3);
+        size_t decoded = 0;
+        ok = base64Decode(pending.data(), whole, reinterpret_cast<uint8_t*>(&data[start]), decoded);
+        data.resize(start + decoded);
+        padded = pending[whole - 1] == '=';
+    }
+    pending.erase(0, whole);
+    return ok;
+}
+
+bool Decoder::finish(std::string&) {
+    bool ok = pending.empty();
+    pending.clear();
+    padded = false;
+    return ok;
+}
+
+std::string encode(Armor armor, const std::string& data) {
+    std::string text;
+    text.reserve(encodedSize(armor, data.size()));
+    Encoder encoder(armor);
+    encoder.update(data.data(), data.size(), text);
+    encoder.finish(text);
+    return text;
+}
+
+bool decode(Armor armor, const std::string& text, std::string& data) {
+    data.clear();
+    Decoder decoder(armor);
+    return decoder.update(text.data(), text.size(), data) && decoder.finish(data);
+}
+
+} // namespace TextArmor
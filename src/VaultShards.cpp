@@ -0,0 +1,185 @@
+#include "VaultShards.h"
+#include "Checksum.h"
+#include <utility>
+
+namespace {
+
+const int BUCKET_BITS = 18;  // log2(BUCKET_COUNT)
+
+// Index of a shard's first node at depth, counted from the shard root
+uint32_t levelOffset(int depth) {
+    uint32_t offset = 0;
+    for (uint32_t width = 1; depth > 0; --depth, width *= VaultShards::FANOUT) offset += width;
+    return offset;
+}
+
+uint64_t hashChildren(const uint64_t* children) {
+    return Checksum::xxh3(children, VaultShards::FANOUT * sizeof(uint64_t));
+}
+
+template <typename T>
+void release(std::vector<T>& values) {
+    std::vector<T>().swap(values);
+}
+
+} // namespace
+
+uint32_t VaultShards::bucketFor(const char* service, size_t length) {
+    return static_cast<uint32_t>(Checksum::xxh3(service, length) >> (64 - BUCKET_BITS));
+}
+
+uint64_t VaultShards::recordDigest(const char* const fields[], const size_t lengths[], int count) {
+    // Hashing each field and then the field hashes keeps the boundaries without copying
+    // the key and password text into a scratch buffer
+    uint64_t fieldHashes[8];
+    for (int i = 0; i < count; ++i) fieldHashes[i] = Checksum::xxh3(fields[i], lengths[i]);
+    return Checksum::xxh3(fieldHashes, count * sizeof(uint64_t));
+}
+
+const uint64_t* VaultShards::level(uint32_t shard, int depth) const {
+    if (depth == DEPTH) return &bucketSums[shard * BUCKETS_PER_SHARD];
+    return &inner[shard * INNER_PER_SHARD + levelOffset(depth)];
+}
+
+void VaultShards::rehashPath(uint32_t bucket) {
+    uint32_t shard = shardOf(bucket);
+    uint32_t index = bucket % BUCKETS_PER_SHARD;
+    const uint64_t* children = level(shard, DEPTH);
+    for (int depth = DEPTH - 1; depth >= 0; --depth) {
+        index /= FANOUT;
+        uint64_t* nodes = &inner[shard * INNER_PER_SHARD + levelOffset(depth)];
+        nodes[index] = hashChildren(children + index * FANOUT);
+        children = nodes;
+    }
+}
+
+void VaultShards::rehashAll() {
+    inner.assign(SHARD_COUNT * INNER_PER_SHARD, 0);
+    for (uint32_t shard = 0; shard < SHARD_COUNT; ++shard) {
+        uint32_t width = BUCKETS_PER_SHARD;
+        for (int depth = DEPTH - 1; depth >= 0; --depth) {
+            width /= FANOUT;
+            const uint64_t* children = level(shard, depth + 1);
+            uint64_t* nodes = &inner[shard * INNER_PER_SHARD + levelOffset(depth)];
+            for (uint32_t i = 0; i < width; ++i) nodes[i] = hashChildren(children + i * FANOUT);
+        }
+    }
+}
+
+void VaultShards::rebuildChains() {
+    heads.assign(BUCKET_COUNT, static_cast<uint32_t>(NONE));
+    links.resize(digests.size());
+    for (uint32_t id = 0; id < digests.size(); ++id) {
+        links[id] = heads[buckets[id]];
+        heads[buckets[id]] = id;
+    }
+}
+
+void VaultShards::unlink(uint32_t id) {
+    uint32_t* slot = &heads[buckets[id]];
+    while (*slot != id) slot = &links[*slot];
+    *slot = links[id];
+}
+
+void VaultShards::assign(const std::vector<uint32_t>& recordBuckets, const std::vector<uint64_t>& recordDigests) {
+    buckets = recordBuckets;
+    digests = recordDigests;
+    bucketSums.assign(BUCKET_COUNT, 0);
+    for (size_t id = 0; id < digests.size(); ++id) bucketSums[buckets[id]] += digests[id];
+    rebuildChains();
+    rehashAll();
+}
+
+void VaultShards::clear() {
+    release(bucketSums);
+    release(inner);
+    release(digests);
+    release(buckets);
+    release(links);
+    release(heads);
+}
+
+void VaultShards::append(uint32_t bucket, uint64_t digest) {
+    uint32_t id = static_cast<uint32_t>(digests.size());
+    digests.push_back(digest);
+    buckets.push_back(bucket);
+    links.push_back(heads[bucket]);
+    heads[bucket] = id;
+    bucketSums[bucket] += digest;
+    rehashPath(bucket);
+}
+
+void VaultShards::replace(uint32_t id, uint64_t digest) {
+    bucketSums[buckets[id]] += digest - digests[id];
+    digests[id] = digest;
+    rehashPath(buckets[id]);
+}
+
+void VaultShards::erase(uint32_t id) {
+    uint32_t bucket = buckets[id];
+    bucketSums[bucket] -= digests[id];
+    digests.erase(digests.begin() + id);
+    buckets.erase(buckets.begin() + id);
+    rebuildChains();
+    rehashPath(bucket);
+}
+
+void VaultShards::swapRemove(uint32_t id) {
+    uint32_t bucket = buckets[id];
+    uint32_t last = static_cast<uint32_t>(digests.size() - 1);
+    unlink(id);
+    bucketSums[bucket] -= digests[id];
+    if (id != last) {
+        unlink(last);
+        digests[id] = digests[last];
+        buckets[id] = buckets[last];
+        links[id] = heads[buckets[id]];
+        heads[buckets[id]] = id;
+    }
+    digests.pop_back();
+    buckets.pop_back();
+    links.pop_back();
+    rehashPath(bucket);
+}
+
+uint64_t VaultShards::root() const {
+    uint64_t roots[SHARD_COUNT];
+    for (uint32_t shard = 0; shard < SHARD_COUNT; ++shard) roots[shard] = shardRoot(shard);
+    return Checksum::xxh3(roots, sizeof(roots));
+}
+
+std::vector<uint32_t> VaultShards::differingBuckets(const VaultShards& a, const VaultShards& b,
+                                                    uint64_t& nodesCompared) {
+    std::vector<uint32_t> differing;
+    nodesCompared = 1;
+    if (a.root() == b.root()) return differing;
+
+    // Depth-first, children pushed in reverse so buckets come out in ascending order
+    std::vector<std::pair<int, uint32_t>> pending;
+    for (uint32_t shard = 0; shard < SHARD_COUNT; ++shard) {
+        ++nodesCompared;
+        if (a.shardRoot(shard) == b.shardRoot(shard)) continue;
+        pending.push_back({0, 0});
+        while (!pending.empty()) {
+            int depth = pending.back().first;
+            uint32_t index = pending.back().second;
+            pending.pop_back();
+            if (depth == DEPTH) {
+                differing.push_back(shard * BUCKETS_PER_SHARD + index);
+                continue;
+            }
+            const uint64_t* childrenA = a.level(shard, depth + 1) + index * FANOUT;
+            const uint64_t* childrenB = b.level(shard, depth + 1) + index * FANOUT;
+            for (uint32_t child = FANOUT; child-- > 0;) {
+                ++nodesCompared;
+                if (childrenA[child] != childrenB[child]) pending.push_back({depth + 1, index * FANOUT + child});
+            }
+        }
+    }
+    return differing;
+}
+
+size_t VaultShards::memoryUsage() const {
+    return (bucketSums.capacity() + inner.capacity() + digests.capacity()) * sizeof(uint64_t) +
+           (buckets.capacity() + links.capacity() + heads.capacity()) * sizeof(uint32_t);
+}
@@ -1,56 +1,100 @@
 #include "VigenereCipher.h"
+#include "Ascii.h"
+#include "CipherKernels.h"
 #include <iostream>
 #include <string>
-#include <cctype>
+
+VigenereCipher::VigenereCipher(Alphabet alphabet) : alphabet(alphabet) {
+    setKey("KEY");  // Default key
+}
 
 std::string VigenereCipher::processText(const std::string& text, bool isEncryption) {
+    return processTextAt(text, isEncryption, 0);
+}
+
+std::string VigenereCipher::processTextAt(const std::string& text, bool isEncryption, uint64_t state) {
     std::string result = text;
-    size_t keyIndex = 0;
+    int index = static_cast<int>(alphabet);
+    const SecureVector<uint8_t>& stream =
+        isEncryption ? schedule->encryptionStreams[index] : schedule->decryptionStreams[index];
+    size_t keyIndex = static_cast<size_t>(state % schedule->keyLength);
     
-    for (char& c : result) {
-        if (std::isalpha(c)) {
-            char base = std::isupper(c) ? 'A' : 'a';
-            char keyChar = std::toupper(key[keyIndex % key.length()]) - 'A';
-            
-            if (isEncryption) {
-                c = static_cast<char>(base + (c - base + keyChar) % 26);
-            } else {
-                c = static_cast<char>(base + (c - base - keyChar + 26) % 26);
-            }
-            
-            keyIndex++;
-        }
-    }
+    CipherKernels::shiftAlphabetByKey(alphabet, &result[0], result.size(), stream.data(), schedule->keyLength, keyIndex);
     
     return result;
 }
 
-void VigenereCipher::setKey(const std::string& newKey) {
+uint64_t VigenereCipher::advanceState(const std::string& plaintext, uint64_t state) const {
+    return state + CipherKernels::countAlphabet(alphabet, plaintext.data(), plaintext.size());
+}
+
+std::shared_ptr<const KeySchedule> VigenereCipher::compileKey(const std::string& newKey) const {
     if (newKey.empty()) {
         std::cerr << "Empty key not allowed. Using default key." << std::endl;
-        return;
+        return nullptr;
     }
     
     bool hasLetter = false;
     for (char c : newKey) {
-        if (std::isalpha(c)) {
+        if (Ascii::isAlpha(c)) {
             hasLetter = true;
             break;
         }
     }
     
-    if (!hasLetter) {
+    if (!hasLetter && alphabet == Alphabet::LETTERS) {
         std::cerr << "Key must contain at least one letter. Using default key." << std::endl;
-        return;
+        return nullptr;
     }
     
-    key = newKey;
+    // Every key character counts, as it always has. A character's shift is its position
+    // in the alphabet; characters outside it wrap into range by their byte value, which
+    // for letters keeps the historical toupper(c) - 'A'
+    auto compiled = makeSecureShared<Schedule>();
+    compiled->keyLength = newKey.size();
+    for (int a = 0; a < ALPHABET_COUNT; ++a) {
+        Alphabet target = static_cast<Alphabet>(a);
+        int size = Alphabets::size(target);
+        compiled->encryptionStreams[a].reserve(newKey.size() + 64);
+        compiled->decryptionStreams[a].reserve(newKey.size() + 64);
+        for (size_t i = 0; i < newKey.size() + 64; ++i) {
+            char c = newKey[i % newKey.size()];
+            int shift = Alphabets::indexOf(target, c);
+            if (shift < 0) {
+                int code = target == Alphabet::LETTERS ? Ascii::toUpper(c) - 'A' : static_cast<unsigned char>(c);
+                shift = (code % size + size) % size;
+            }
+            compiled->encryptionStreams[a].push_back(static_cast<uint8_t>(shift));
+            compiled->decryptionStreams[a].push_back(static_cast<uint8_t>((size - shift) % size));
+        }
+    }
+    return compiled;
+}
+
+void VigenereCipher::applySchedule(const std::shared_ptr<const KeySchedule>& newSchedule) {
+    if (newSchedule) schedule = std::static_pointer_cast<const Schedule>(newSchedule);
+}
+
+bool VigenereCipher::hasStreamState() const {
+    return true;
+}
+
+bool VigenereCipher::preservesLength() const {
+    return true;
+}
+
+const char* VigenereCipher::getName() const {
+    static const char* const NAMES[ALPHABET_COUNT] = {"vigenere", "vigenere-alnum", "vigenere-printable", "vigenere-bytes"};
+    return NAMES[static_cast<int>(alphabet)];
 }
 
 std::string VigenereCipher::getDescription() const {
-    return "\033[1;34mVigenère Cipher:\033[0m A method of encrypting text using a series of different Caesar ciphers based on the letters of a keyword.";
+    std::string description = "\033[1;34mVigenère Cipher:\033[0m A method of encrypting text using a series of different Caesar ciphers based on the letters of a keyword.";
+    if (alphabet != Alphabet::LETTERS) description += std::string(" (alphabet: ") + Alphabets::name(alphabet) + ")";
+    return description;
 }
 
 std::string VigenereCipher::getKeyInstructions() const {
-    return "Enter a keyword made up of letters (e.g., 'SECRET').";
+    if (alphabet == Alphabet::LETTERS) return "Enter a keyword made up of letters (e.g., 'SECRET').";
+    return std::string("Enter a keyword; each character shifts by its position in the ") + Alphabets::name(alphabet) + " alphabet.";
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+namespace {
+
+// Lets submit() recognize calls made from inside one of this pool's tasks
+thread_local const WorkStealingPool* currentPool = nullptr;
+thread_local unsigned currentWorker = 0;
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(unsigned threadCount) {
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < threadCount; ++i) workers.push_back(std::make_unique<Worker>());
+    for (unsigned i = 0; i < threadCount; ++i) threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto& thread : threads) thread.join();
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    unsigned target = currentPool == this ? currentWorker
+                                          : nextWorker.fetch_add(1, std::memory_order_relaxed) % size();
+    pending.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(workers[target]->mutex);
+        workers[target]->tasks.push_back(std::move(task));
+    }
+    queued.fetch_add(1);
+
+    // Sleepers register before re-checking `queued`, so with sequentially consistent
+    // atomics either they see this task or this sees them; taking the lock then orders
+    // the notify after the sleeper is actually waiting
+    if (sleepers.load() == 0) return;
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    workAvailable.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    allDone.wait(lock, [this]() { return pending.load() == 0; });
+}
+
+bool WorkStealingPool::takeTask(unsigned self, std::function<void()>& task) {
+    {
+        Worker& own = *workers[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    for (unsigned step = 1; step < size(); ++step) {
+        Worker& victim = *workers[(self + step) % size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued.fetch_sub(1);
+            stealCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(unsigned index) {
+    currentPool = this;
+    currentWorker = index;
+
+    std::function<void()> task;
+    while (true) {
+        if (takeTask(index, task)) {
+            try {
+                task();
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Task failed: " << e.what() << std::endl;
+            }
+            task = nullptr;
+
+            if (pending.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepers.fetch_add(1);
+        workAvailable.wait(lock, [this]() { return stopping || queued.load() > 0; });
+        sleepers.fetch_sub(1);
+        if (stopping) return;
+    }
+}
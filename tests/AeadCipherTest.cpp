@@ -0,0 +1,312 @@
+#include "AeadCipher.h"
+#include "ChaCha20Poly1305.h"
+#include "CommandLine.h"
+#include "TestData.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const std::string KEY = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f";
+const std::string SUNSCREEN = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip "
+                              "for the future, sunscreen would be it.";
+
+std::vector<uint8_t> fromHex(const std::string& hex) {
+    std::vector<uint8_t> bytes;
+    for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+        bytes.push_back(static_cast<uint8_t>(std::stoul(hex.substr(i, 2), nullptr, 16)));
+    }
+    return bytes;
+}
+
+std::vector<uint8_t> toBytes(const std::string& text) {
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+int runCommand(std::vector<std::string> args) {
+    args.insert(args.begin(), "EncryptionTool");
+    std::vector<char*> argv;
+    for (std::string& arg : args) argv.push_back(&arg[0]);
+    testing::internal::CaptureStderr();
+    int status = CommandLine::run(static_cast<int>(argv.size()), argv.data());
+    testing::internal::GetCapturedStderr();
+    return status;
+}
+
+const ChaCha20Poly1305::Implementation IMPLEMENTATIONS[] = {
+    ChaCha20Poly1305::PORTABLE, ChaCha20Poly1305::AVX2, ChaCha20Poly1305::AVX512
+};
+
+// Runs each case with every kernel forced in turn (missing ones fall back to a slower one)
+class ChaCha20Poly1305Kernels : public testing::TestWithParam<ChaCha20Poly1305::Implementation> {
+protected:
+    void SetUp() override { ChaCha20Poly1305::setImplementation(GetParam()); }
+    void TearDown() override { ChaCha20Poly1305::setImplementation(ChaCha20Poly1305::AUTO); }
+};
+
+// RFC 8439 section 2.3.2: the block function is the keystream XORed into zeros
+TEST_P(ChaCha20Poly1305Kernels, Rfc8439BlockFunction) {
+    std::vector<uint8_t> key = fromHex(KEY), nonce = fromHex("000000090000004a00000000");
+    std::vector<uint8_t> block(64, 0);
+    ChaCha20Poly1305::chacha20Xor(key.data(), nonce.data(), 1, block.data(), block.data(), block.size());
+    EXPECT_EQ(block, fromHex("10f1e7e4d13b5915500fdd1fa32071c4c7d1f4c733c068030422aa9ac3d46c4e"
+                             "d2826446079faa0914c2d705d98b02a2b5129cd1de164eb9cbd083e8a2503c4e"));
+}
+
+// RFC 8439 section 2.4.2
+TEST_P(ChaCha20Poly1305Kernels, Rfc8439Encryption) {
+    std::vector<uint8_t> key = fromHex(KEY), nonce = fromHex("000000000000004a00000000");
+    std::vector<uint8_t> data = toBytes(SUNSCREEN);
+    ChaCha20Poly1305::chacha20Xor(key.data(), nonce.data(), 1, data.data(), data.data(), data.size());
+    EXPECT_EQ(data, fromHex("6e2e359a2568f98041ba0728dd0d6981e97e7aec1d4360c20a27afccfd9fae0b"
+                            "f91b65c5524733ab8f593dabcd62b3571639d624e65152ab8f530c359f0861d8"
+                            "07ca0dbf500d6a6156a38e088a22b65e52bc514d16ccf806818ce91ab7793736"
+                            "5af90bbf74a35be6b40b8eedf2785e42874d"));
+}
+
+// RFC 8439 section 2.8.2
+TEST_P(ChaCha20Poly1305Kernels, Rfc8439Aead) {
+    std::vector<uint8_t> key = fromHex("808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f");
+    std::vector<uint8_t> nonce = fromHex("070000004041424344454647");
+    std::vector<uint8_t> aad = fromHex("50515253c0c1c2c3c4c5c6c7");
+    std::vector<uint8_t> plaintext = toBytes(SUNSCREEN), ciphertext(plaintext.size());
+    uint8_t tag[ChaCha20Poly1305::TAG_SIZE];
+    ChaCha20Poly1305::seal(key.data(), nonce.data(), aad.data(), aad.size(), plaintext.data(), plaintext.size(),
+                           ciphertext.data(), tag);
+    EXPECT_EQ(ciphertext, fromHex("d31a8d34648e60db7b86afbc53ef7ec2a4aded51296e08fea9e2b5a736ee62d6"
+                                  "3dbea45e8ca9671282fafb69da92728b1a71de0a9e060b2905d6a5b67ecd3b36"
+                                  "92ddbd7f2d778b8c9803aee328091b58fab324e4fad675945585808b4831d7bc"
+                                  "3ff4def08e4b7a9de576d26586cec64b6116"));
+    EXPECT_EQ(std::vector<uint8_t>(tag, tag + sizeof(tag)), fromHex("1ae10b594f09e26a7e902ecbd0600691"));
+
+    std::vector<uint8_t> decrypted(ciphertext.size());
+    EXPECT_TRUE(ChaCha20Poly1305::open(key.data(), nonce.data(), aad.data(), aad.size(), ciphertext.data(),
+                                       ciphertext.size(), tag, decrypted.data()));
+    EXPECT_EQ(decrypted, plaintext);
+
+    aad[0] ^= 1;
+    EXPECT_FALSE(ChaCha20Poly1305::open(key.data(), nonce.data(), aad.data(), aad.size(), ciphertext.data(),
+                                        ciphertext.size(), tag, decrypted.data()));
+}
+
+// Long inputs run the wide kernels; they must agree with the portable code at every
+// boundary around their 512- and 1024-byte steps
+TEST_P(ChaCha20Poly1305Kernels, AgreesWithPortable) {
+    std::vector<uint8_t> key = fromHex(KEY), nonce = fromHex("000000000000004a00000000");
+    std::string message = TestData::bytes(5000, 31);
+    for (size_t size : {0, 1, 63, 64, 255, 256, 511, 512, 513, 1023, 1024, 1025, 4096, 5000}) {
+        std::vector<uint8_t> tags[2], outputs[2];
+        for (int pass = 0; pass < 2; ++pass) {
+            ChaCha20Poly1305::setImplementation(pass == 0 ? ChaCha20Poly1305::PORTABLE : GetParam());
+            outputs[pass].resize(size);
+            tags[pass].resize(ChaCha20Poly1305::TAG_SIZE);
+            ChaCha20Poly1305::seal(key.data(), nonce.data(), key.data(), 7,
+                                   reinterpret_cast<const uint8_t*>(message.data()), size, outputs[pass].data(),
+                                   tags[pass].data());
+        }
+        EXPECT_EQ(outputs[0], outputs[1]) << "size " << size;
+        EXPECT_EQ(tags[0], tags[1]) << "size " << size;
+
+        ChaCha20Poly1305::Poly1305 portable(key.data(), ChaCha20Poly1305::PORTABLE), vector(key.data(), GetParam());
+        uint8_t portableTag[16], vectorTag[16];
+        portable.update(reinterpret_cast<const uint8_t*>(message.data()), size);
+        vector.update(reinterpret_cast<const uint8_t*>(message.data()), size);
+        portable.finish(portableTag);
+        vector.finish(vectorTag);
+        EXPECT_EQ(std::memcmp(portableTag, vectorTag, 16), 0) << "size " << size;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllKernels, ChaCha20Poly1305Kernels, testing::ValuesIn(IMPLEMENTATIONS));
+
+// RFC 8439 section 2.5.2
+TEST(Poly1305, Rfc8439Vector) {
+    std::vector<uint8_t> key = fromHex("85d6be7857556d337f4452fe42d506a80103808afb0db2fd4abff6af4149f51b");
+    std::string message = "Cryptographic Forum Research Group";
+    ChaCha20Poly1305::Poly1305 mac(key.data());
+    mac.update(reinterpret_cast<const uint8_t*>(message.data()), 10);
+    mac.update(reinterpret_cast<const uint8_t*>(message.data()) + 10, message.size() - 10);
+    uint8_t tag[16];
+    mac.finish(tag);
+    EXPECT_EQ(std::vector<uint8_t>(tag, tag + 16), fromHex("a8061dc1305136c6c22b8baf0c0127a9"));
+}
+
+// selfTest() must not change which kernel concurrent seal/open calls use
+TEST(ChaCha20Poly1305, SelfTestIsSafeDuringConcurrentUse) {
+    ChaCha20Poly1305::setImplementation(ChaCha20Poly1305::PORTABLE);
+    std::vector<uint8_t> key = fromHex(KEY), nonce(12, 0);
+    std::string message = TestData::bytes(3000, 37);
+    std::vector<uint8_t> expected(message.size());
+    uint8_t expectedTag[16];
+    ChaCha20Poly1305::seal(key.data(), nonce.data(), nullptr, 0, reinterpret_cast<const uint8_t*>(message.data()),
+                           message.size(), expected.data(), expectedTag);
+
+    std::atomic<bool> done(false);
+    std::atomic<int> mismatches(0);
+    std::thread sealer([&] {
+        std::vector<uint8_t> output(message.size());
+        uint8_t tag[16];
+        while (!done) {
+            ChaCha20Poly1305::seal(key.data(), nonce.data(), nullptr, 0,
+                                   reinterpret_cast<const uint8_t*>(message.data()), message.size(), output.data(), tag);
+            if (output != expected || std::memcmp(tag, expectedTag, 16) != 0) ++mismatches;
+            if (std::strcmp(ChaCha20Poly1305::implementationName(), "portable") != 0) ++mismatches;
+        }
+    });
+    for (int i = 0; i < 50; ++i) EXPECT_TRUE(ChaCha20Poly1305::selfTest());
+    done = true;
+    sealer.join();
+    EXPECT_EQ(mismatches.load(), 0);
+    ChaCha20Poly1305::setImplementation(ChaCha20Poly1305::AUTO);
+}
+
+AeadCipher makeCipher(size_t chunkSize = AeadCipher::DEFAULT_CHUNK_SIZE) {
+    AeadCipher cipher;
+    cipher.setKey(KEY);
+    cipher.setChunkSize(chunkSize);
+    return cipher;
+}
+
+TEST(AeadCipher, RoundTripsAcrossChunkBoundaries) {
+    std::string data = TestData::bytes(3 * 1000 + 17, 41);
+    for (size_t chunk : {1, 16, 1000, 64 * 1024}) {
+        AeadCipher cipher = makeCipher(chunk);
+        for (size_t size : {0, 1, 999, 1000, 1001, 3017}) {
+            std::string plaintext = data.substr(0, size);
+            std::string ciphertext = cipher.encrypt(plaintext);
+            size_t chunks = size == 0 ? 1 : (size + chunk - 1) / chunk;
+            ASSERT_EQ(ciphertext.size(), AeadCipher::HEADER_SIZE + size + chunks * 16);
+            ASSERT_EQ(cipher.decrypt(ciphertext), plaintext) << "chunk " << chunk << " size " << size;
+        }
+    }
+}
+
+TEST(AeadCipher, EncryptionIsRandomized) {
+    AeadCipher cipher = makeCipher();
+    EXPECT_NE(cipher.encrypt("same message"), cipher.encrypt("same message"));
+}
+
+TEST(AeadCipher, RejectsEveryTamperedByte) {
+    AeadCipher cipher = makeCipher(32);
+    std::string plaintext = TestData::text(100, 80, 43);
+    std::string ciphertext = cipher.encrypt(plaintext);
+    testing::internal::CaptureStderr();
+    for (size_t i = 0; i < ciphertext.size(); ++i) {
+        std::string tampered = ciphertext;
+        tampered[i] ^= 0x40;
+        EXPECT_EQ(cipher.decrypt(tampered), "") << "byte " << i;
+    }
+    testing::internal::GetCapturedStderr();
+}
+
+TEST(AeadCipher, RejectsTruncationReorderingAndWrongKey) {
+    AeadCipher cipher = makeCipher(32);
+    std::string plaintext = TestData::text(96, 80, 47);  // Three full chunks
+    std::string ciphertext = cipher.encrypt(plaintext);
+    const size_t record = 32 + 16;
+
+    testing::internal::CaptureStderr();
+    EXPECT_EQ(cipher.decrypt(ciphertext.substr(0, ciphertext.size() - record)), "");  // Last chunk dropped
+    EXPECT_EQ(cipher.decrypt(ciphertext.substr(0, ciphertext.size() - 1)), "");
+    EXPECT_EQ(cipher.decrypt(ciphertext.substr(0, AeadCipher::HEADER_SIZE)), "");
+    EXPECT_EQ(cipher.decrypt(ciphertext + "x"), "");
+
+    std::string swapped = ciphertext;
+    std::swap_ranges(swapped.begin() + AeadCipher::HEADER_SIZE, swapped.begin() + AeadCipher::HEADER_SIZE + record,
+                     swapped.begin() + AeadCipher::HEADER_SIZE + record);
+    EXPECT_EQ(cipher.decrypt(swapped), "");
+
+    AeadCipher other;
+    other.setKey("f" + KEY.substr(1));
+    EXPECT_EQ(other.decrypt(ciphertext), "");
+    std::string errors = testing::internal::GetCapturedStderr();
+    EXPECT_NE(errors.find("Authentication failed"), std::string::npos);
+}
+
+TEST(AeadCipher, StreamsRoundTripAndDetectTruncation) {
+    AeadCipher cipher = makeCipher(100);
+    std::string plaintext = TestData::bytes(1000, 53);  // Ends on a chunk boundary
+    std::istringstream input(plaintext);
+    std::ostringstream sealed;
+    ASSERT_TRUE(cipher.encryptStream(input, sealed));
+    EXPECT_EQ(cipher.decrypt(sealed.str()), plaintext);
+
+    std::istringstream whole(sealed.str());
+    std::ostringstream opened;
+    ASSERT_TRUE(cipher.decryptStream(whole, opened));
+    EXPECT_EQ(opened.str(), plaintext);
+
+    // Cut at a chunk boundary: every remaining chunk is authentic, but none is final
+    std::istringstream cut(sealed.str().substr(0, sealed.str().size() - 116));
+    std::ostringstream partial;
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(cipher.decryptStream(cut, partial));
+    testing::internal::GetCapturedStderr();
+}
+
+TEST(AeadCipher, RejectsOversizedChunkHeaders) {
+    AeadCipher cipher = makeCipher();
+    std::string ciphertext = cipher.encrypt("hello");
+    for (uint32_t chunk : {0u, static_cast<uint32_t>(AeadCipher::MAX_CHUNK_SIZE) + 1, 0xffffffffu}) {
+        std::string crafted = ciphertext;
+        for (int i = 0; i < 4; ++i) crafted[8 + i] = static_cast<char>(chunk >> (8 * i));
+
+        testing::internal::CaptureStderr();
+        EXPECT_EQ(cipher.decrypt(crafted), "");
+        std::istringstream input(crafted);
+        std::ostringstream output;
+        EXPECT_FALSE(cipher.decryptStream(input, output));
+        std::string errors = testing::internal::GetCapturedStderr();
+        EXPECT_NE(errors.find("not chacha20-poly1305 data"), std::string::npos) << chunk;
+    }
+
+    cipher.setChunkSize(~static_cast<size_t>(0));
+    EXPECT_EQ(cipher.getChunkSize(), static_cast<size_t>(AeadCipher::MAX_CHUNK_SIZE));
+}
+
+TEST(AeadCipher, RejectsMalformedKeys) {
+    AeadCipher cipher;
+    testing::internal::CaptureStderr();
+    EXPECT_EQ(cipher.compileKey("abc"), nullptr);
+    EXPECT_EQ(cipher.compileKey(std::string(64, 'g')), nullptr);
+    EXPECT_EQ(cipher.encrypt("no key"), "");
+    testing::internal::GetCapturedStderr();
+    EXPECT_EQ(AeadCipher::generateKey().size(), 64u);
+    EXPECT_NE(cipher.compileKey(AeadCipher::generateKey()), nullptr);
+}
+
+TEST(AeadCipher, CommandLineFailsOnTamperedFileOrBadKey) {
+    std::string input = TestData::tempPath("aead_cli_input");
+    std::string sealed = TestData::tempPath("aead_cli_sealed");
+    std::string output = TestData::tempPath("aead_cli_output");
+    TestData::writeFile(input, SUNSCREEN);
+
+    setenv("ET_KEY", "not a key", 1);
+    EXPECT_NE(runCommand({"encrypt-file", "chacha20-poly1305", input, sealed}), 0);
+    EXPECT_FALSE(TestData::exists(sealed));
+
+    setenv("ET_KEY", KEY.c_str(), 1);
+    ASSERT_EQ(runCommand({"encrypt-file", "chacha20-poly1305", input, sealed}), 0);
+    ASSERT_EQ(runCommand({"decrypt-file", "chacha20-poly1305", sealed, output}), 0);
+    EXPECT_EQ(TestData::readFile(output), SUNSCREEN);
+    std::remove(output.c_str());
+
+    std::string ciphertext = TestData::readFile(sealed);
+    ciphertext[AeadCipher::HEADER_SIZE + 5] ^= 1;
+    TestData::writeFile(sealed, ciphertext);
+    EXPECT_NE(runCommand({"decrypt-file", "chacha20-poly1305", sealed, output}), 0);
+    EXPECT_FALSE(TestData::exists(output));
+    EXPECT_NE(runCommand({"decrypt-file", "chacha20-poly1305+base64", sealed, output}), 0);
+    EXPECT_FALSE(TestData::exists(output));
+
+    unsetenv("ET_KEY");
+    std::remove(input.c_str());
+    std::remove(sealed.c_str());
+}
+
+} // namespace
@@ -0,0 +1,145 @@
+#include "Alphabet.h"
+#include "CaesarCipher.h"
+#include "CipherKernels.h"
+#include "TestData.h"
+#include "VigenereCipher.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+const Alphabet ALPHABETS[] = {Alphabet::LETTERS, Alphabet::ALPHANUMERIC, Alphabet::PRINTABLE, Alphabet::BYTES};
+
+// The character at `index` of the alphabet; LETTERS keeps the case of `like`
+char symbol(Alphabet alphabet, int index, char like) {
+    switch (alphabet) {
+        case Alphabet::LETTERS: return static_cast<char>((like >= 'a' ? 'a' : 'A') + index);
+        case Alphabet::ALPHANUMERIC: return "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"[index];
+        case Alphabet::PRINTABLE: return static_cast<char>(0x20 + index);
+        default: return static_cast<char>(index);
+    }
+}
+
+std::string shiftReference(Alphabet alphabet, const std::string& text, int shift) {
+    int size = Alphabets::size(alphabet);
+    std::string result = text;
+    for (char& c : result) {
+        int index = Alphabets::indexOf(alphabet, c);
+        if (index >= 0) c = symbol(alphabet, (index + shift) % size, c);
+    }
+    return result;
+}
+
+std::string vigenereReference(Alphabet alphabet, const std::string& text, const std::string& key) {
+    int size = Alphabets::size(alphabet);
+    std::string result = text;
+    size_t position = 0;
+    for (char& c : result) {
+        int index = Alphabets::indexOf(alphabet, c);
+        if (index < 0) continue;
+        char k = key[position++ % key.size()];
+        int shift = Alphabets::indexOf(alphabet, k);
+        if (shift < 0) {
+            int code = alphabet == Alphabet::LETTERS ? (k >= 'a' && k <= 'z' ? k - 0x20 : k) - 'A'
+                                                     : static_cast<unsigned char>(k);
+            shift = (code % size + size) % size;
+        }
+        c = symbol(alphabet, (index + shift) % size, c);
+    }
+    return result;
+}
+
+std::string mixedText(size_t size, unsigned int seed) {
+    return TestData::bytes(size / 2, seed) + TestData::text(size - size / 2, 70, seed);
+}
+
+TEST(Alphabets, NamesParseAndIndices) {
+    for (Alphabet alphabet : ALPHABETS) {
+        Alphabet parsed = Alphabet::LETTERS;
+        ASSERT_TRUE(Alphabets::parse(Alphabets::name(alphabet), parsed));
+        EXPECT_EQ(parsed, alphabet);
+        for (int i = 0; i < Alphabets::size(alphabet); ++i) {
+            EXPECT_EQ(Alphabets::indexOf(alphabet, symbol(alphabet, i, 'A')), i);
+        }
+    }
+    Alphabet unused;
+    EXPECT_FALSE(Alphabets::parse("hex", unused));
+    EXPECT_EQ(Alphabets::indexOf(Alphabet::LETTERS, 'q'), 16);
+    EXPECT_EQ(Alphabets::indexOf(Alphabet::ALPHANUMERIC, '-'), -1);
+    EXPECT_EQ(Alphabets::indexOf(Alphabet::PRINTABLE, '\n'), -1);
+    EXPECT_EQ(Alphabets::indexOf(Alphabet::PRINTABLE, '\x7F'), -1);
+}
+
+TEST(Alphabets, ShiftKernelMatchesReference) {
+    std::string text = mixedText(600, 101);
+    for (Alphabet alphabet : ALPHABETS) {
+        int size = Alphabets::size(alphabet);
+        for (size_t length : {0, 1, 31, 63, 64, 65, 200, 600}) {
+            for (int shift : {0, 1, size / 2, size - 1}) {
+                std::string data = text.substr(0, length);
+                CipherKernels::shiftAlphabet(alphabet, &data[0], data.size(), shift);
+                ASSERT_EQ(data, shiftReference(alphabet, text.substr(0, length), shift))
+                    << Alphabets::name(alphabet) << " length " << length << " shift " << shift;
+            }
+        }
+    }
+}
+
+TEST(Alphabets, CaesarKnownAnswersAndRoundTrip) {
+    CaesarCipher alnum(Alphabet::ALPHANUMERIC);
+    alnum.setKey("1");
+    EXPECT_EQ(alnum.encrypt("9Zz-"), "Aa0-");
+    CaesarCipher printable(Alphabet::PRINTABLE);
+    printable.setKey("1");
+    EXPECT_EQ(printable.encrypt("~ a\n"), " !b\n");
+
+    std::string text = mixedText(5000, 103);
+    for (Alphabet alphabet : ALPHABETS) {
+        CaesarCipher cipher(alphabet);
+        for (int shift : {-300, -1, 7, 61, 94, 255, 1000}) {
+            cipher.setKey(std::to_string(shift));
+            int size = Alphabets::size(alphabet);
+            std::string ciphertext = cipher.encrypt(text);
+            ASSERT_EQ(ciphertext, shiftReference(alphabet, text, (shift % size + size) % size));
+            ASSERT_EQ(cipher.decrypt(ciphertext), text) << Alphabets::name(alphabet) << " shift " << shift;
+        }
+    }
+}
+
+TEST(Alphabets, VigenereMatchesReferenceAndRoundTrips) {
+    std::string text = mixedText(3000, 107);
+    for (Alphabet alphabet : ALPHABETS) {
+        for (const std::string key : {"LEMON", "k3y!", "a~Z 9"}) {
+            VigenereCipher cipher(alphabet);
+            cipher.setKey(key);
+            std::string ciphertext = cipher.encrypt(text);
+            ASSERT_EQ(ciphertext, vigenereReference(alphabet, text, key)) << Alphabets::name(alphabet) << " " << key;
+            ASSERT_EQ(cipher.decrypt(ciphertext), text);
+        }
+    }
+}
+
+TEST(Alphabets, VigenereStreamStateSplitsAnywhere) {
+    std::string text = mixedText(2000, 109);
+    for (Alphabet alphabet : ALPHABETS) {
+        VigenereCipher cipher(alphabet);
+        cipher.setKey("SPLITKEY");
+        std::string whole = cipher.encrypt(text);
+        for (size_t split : {1, 63, 64, 777, 1999}) {
+            std::string head = text.substr(0, split);
+            uint64_t state = cipher.advanceState(head, 0);
+            ASSERT_EQ(cipher.encryptAt(head, 0) + cipher.encryptAt(text.substr(split), state), whole)
+                << Alphabets::name(alphabet) << " split " << split;
+            ASSERT_EQ(cipher.decryptAt(whole.substr(split), state), text.substr(split));
+        }
+    }
+}
+
+TEST(Alphabets, SetAlphabetKeepsTheKey) {
+    VigenereCipher cipher;
+    cipher.setKey("KEY");
+    cipher.setAlphabet(Alphabet::PRINTABLE);
+    EXPECT_EQ(cipher.encrypt("a b"), vigenereReference(Alphabet::PRINTABLE, "a b", "KEY"));
+    EXPECT_STREQ(cipher.getName(), "vigenere-printable");
+}
+
+} // namespace
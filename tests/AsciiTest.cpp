@@ -0,0 +1,125 @@
+#include "Ascii.h"
+#include "MorseCodeCipher.h"
+#include "TestData.h"
+#include "VigenereCipher.h"
+#include <gtest/gtest.h>
+#include <cctype>
+#include <random>
+
+namespace {
+
+// Byte-at-a-time reference built on utf8SequenceLength()
+bool validUtf8Reference(const std::string& text) {
+    for (size_t i = 0; i < text.size();) {
+        if (static_cast<unsigned char>(text[i]) < 0x80) {
+            ++i;
+            continue;
+        }
+        size_t length = Ascii::utf8SequenceLength(text.data() + i, text.size() - i);
+        if (length == 0) return false;
+        i += length;
+    }
+    return true;
+}
+
+bool valid(const std::string& text) {
+    return Ascii::isValidUtf8(text.data(), text.size());
+}
+
+TEST(Ascii, MatchesCctypeForAsciiAndClassifiesNothingAbove) {
+    for (int b = 0; b < 256; ++b) {
+        char c = static_cast<char>(b);
+        if (b < 0x80) {
+            EXPECT_EQ(Ascii::isAlpha(c), std::isalpha(b) != 0) << b;
+            EXPECT_EQ(Ascii::isUpper(c), std::isupper(b) != 0) << b;
+            EXPECT_EQ(Ascii::isDigit(c), std::isdigit(b) != 0) << b;
+            EXPECT_EQ(Ascii::toUpper(c), static_cast<char>(std::toupper(b))) << b;
+            EXPECT_EQ(Ascii::toLower(c), static_cast<char>(std::tolower(b))) << b;
+        } else {
+            EXPECT_EQ(Ascii::classOf(c), 0) << b;
+            EXPECT_EQ(Ascii::toUpper(c), c);
+        }
+    }
+}
+
+TEST(Ascii, SequenceLengthFollowsRfc3629) {
+    struct Case {
+        const char* bytes;
+        size_t length;
+    };
+    const Case cases[] = {
+        {"\xC3\xA9", 2},              // é
+        {"\xE2\x82\xAC", 3},          // €
+        {"\xF0\x9F\x98\x80", 4},      // U+1F600
+        {"\xF4\x8F\xBF\xBF", 4},      // U+10FFFF
+        {"\xC0\x80", 0},              // Overlong NUL
+        {"\xC1\xBF", 0},
+        {"\xE0\x80\x80", 0},          // Overlong three-byte form
+        {"\xED\xA0\x80", 0},          // Surrogate U+D800
+        {"\xF0\x80\x80\x80", 0},      // Overlong four-byte form
+        {"\xF4\x90\x80\x80", 0},      // Above U+10FFFF
+        {"\xF5\x80\x80\x80", 0},
+        {"\xE2\x82", 0},              // Truncated
+        {"\xE2\x28\xA1", 0},          // Bad continuation
+        {"\x80\x80", 0},              // Continuation without a lead
+        {"Ab", 0},
+    };
+    for (const Case& c : cases) {
+        std::string bytes = c.bytes;
+        EXPECT_EQ(Ascii::utf8SequenceLength(bytes.data(), bytes.size()), c.length) << bytes;
+        EXPECT_EQ(valid(bytes), c.length == bytes.size() || bytes == "Ab") << bytes;
+    }
+}
+
+TEST(Ascii, ValidatorMatchesReferenceAtEveryPosition) {
+    // A bad or split sequence at each offset around the 64-byte windows and in long ASCII runs
+    const std::string ascii = TestData::text(200, 70, 89);
+    const char* const inserts[] = {"\xC3\xA9", "\xF0\x9F\x98\x80", "\xED\xA0\x80", "\xE2\x82", "\x80", "\xFF"};
+    for (const char* insert : inserts) {
+        for (size_t offset = 0; offset <= ascii.size(); ++offset) {
+            std::string text = ascii;
+            text.insert(offset, insert);
+            ASSERT_EQ(valid(text), validUtf8Reference(text)) << "offset " << offset;
+        }
+    }
+    std::string prefix = ascii + "\xE2\x82\xAC";
+    EXPECT_FALSE(valid(prefix.substr(0, prefix.size() - 1)));  // Ends inside a sequence
+}
+
+TEST(Ascii, ValidatorMatchesReferenceOnRandomText) {
+    std::mt19937 rng(97);
+    const std::string pieces[] = {"a", "Z", " ", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\x80", "\xC0",
+                                  "\xED\xA0\x80", "\xF4\x90\x80\x80"};
+    int invalid = 0;
+    for (int round = 0; round < 2000; ++round) {
+        std::string text;
+        size_t count = rng() % 100;
+        for (size_t i = 0; i < count; ++i) {
+            // Mostly valid pieces, so that both outcomes are common
+            text += pieces[rng() % 8 == 0 ? rng() % 10 : rng() % 6];
+        }
+        bool expected = validUtf8Reference(text);
+        invalid += !expected;
+        ASSERT_EQ(valid(text), expected) << "round " << round;
+    }
+    EXPECT_GT(invalid, 100);
+    EXPECT_TRUE(valid(""));
+    EXPECT_TRUE(valid(TestData::prose(100000)));
+}
+
+TEST(Ascii, CiphersLeaveMultibyteTextUntouched) {
+    const std::string text = "Caf\xC3\xA9 na\xC3\xAFve \xE2\x82\xAC" "5 \xF0\x9F\x98\x80 done";
+    VigenereCipher vigenere;
+    vigenere.setKey("KEY");
+    std::string ciphertext = vigenere.encrypt(text);
+    EXPECT_TRUE(valid(ciphertext));
+    EXPECT_NE(ciphertext.find("\xC3\xA9"), std::string::npos);
+    EXPECT_NE(ciphertext.find("\xF0\x9F\x98\x80"), std::string::npos);
+    EXPECT_EQ(vigenere.decrypt(ciphertext), text);
+
+    MorseCodeCipher morse;
+    morse.setKey(" ");  // Decoding splits on spaces whatever the separator was
+    EXPECT_EQ(morse.decrypt(morse.encrypt("\xC3\xA9T\xE2\x82\xAC")), "\xC3\xA9T\xE2\x82\xAC");
+}
+
+} // namespace
@@ -0,0 +1,138 @@
+#include "BlockCompression.h"
+#include "CommandLine.h"
+#include "CompressedCipher.h"
+#include "TestData.h"
+#include "VigenereCipher.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::string roundTrip(const std::string& data) {
+    std::string out;
+    EXPECT_TRUE(BlockCompression::decompress(BlockCompression::compress(data), out));
+    return out;
+}
+
+TEST(BlockCompression, RoundTripsAssortedInputs) {
+    EXPECT_EQ(roundTrip(""), "");
+    EXPECT_EQ(roundTrip("a"), "a");
+    EXPECT_EQ(roundTrip(std::string(100000, 'z')), std::string(100000, 'z'));
+    EXPECT_EQ(roundTrip(TestData::bytes(200000, 151)), TestData::bytes(200000, 151));
+    EXPECT_EQ(roundTrip(TestData::text(300000, 70, 151)), TestData::text(300000, 70, 151));
+
+    // Sizes around the block boundary, and one large enough to be split across threads
+    const size_t block = BlockCompression::BLOCK_SIZE;
+    std::string prose = TestData::prose(3 * block + 1);
+    ASSERT_FALSE(prose.empty());
+    for (size_t size : {block - 1, block, block + 1, 2 * block, 3 * block + 1}) {
+        ASSERT_EQ(roundTrip(prose.substr(0, size)), prose.substr(0, size)) << size;
+    }
+    std::string large = TestData::prose(12 << 20);
+    EXPECT_EQ(roundTrip(large), large);
+}
+
+TEST(BlockCompression, CompressesRedundantDataAndStoresRandomData) {
+    std::string prose = TestData::prose(BlockCompression::BLOCK_SIZE);
+    EXPECT_LT(BlockCompression::compress(prose).size(), prose.size() / 2);
+
+    // Incompressible data is stored: the header's top bit is set and the size barely grows
+    std::string random = TestData::bytes(1000, 157);
+    std::string framed = BlockCompression::compress(random);
+    EXPECT_EQ(framed.size(), random.size() + BlockCompression::HEADER_SIZE);
+    EXPECT_NE(static_cast<uint8_t>(framed[7]) & 0x80, 0);
+}
+
+TEST(BlockCompression, Lz4BlockKnownAnswers) {
+    // Inputs shorter than 13 bytes are all literals in the LZ4 block format
+    uint8_t payload[32];
+    const char* text = "hello";
+    size_t size = BlockCompression::compressPayload(reinterpret_cast<const uint8_t*>(text), 5, payload);
+    ASSERT_EQ(size, 6u);
+    EXPECT_EQ(payload[0], 0x50);
+    EXPECT_EQ(std::string(reinterpret_cast<char*>(payload + 1), 5), "hello");
+
+    // One literal, an overlapping 8-byte match at offset 1, then five closing literals
+    const uint8_t block[] = {0x14, 'a', 0x01, 0x00, 0x50, 'b', 'c', 'd', 'e', 'f'};
+    uint8_t out[14];
+    ASSERT_TRUE(BlockCompression::decompressPayload(block, sizeof(block), out, sizeof(out)));
+    EXPECT_EQ(std::string(reinterpret_cast<char*>(out), sizeof(out)), "aaaaaaaaabcdef");
+    EXPECT_FALSE(BlockCompression::decompressPayload(block, sizeof(block), out, 13));
+
+    const uint8_t badOffset[] = {0x14, 'a', 0x02, 0x00, 0x50, 'b', 'c', 'd', 'e', 'f'};
+    EXPECT_FALSE(BlockCompression::decompressPayload(badOffset, sizeof(badOffset), out, sizeof(out)));
+}
+
+TEST(BlockCompression, RejectsMalformedStreams) {
+    std::string framed = BlockCompression::compress(TestData::prose(100000));
+    std::string out;
+    EXPECT_FALSE(BlockCompression::decompress(framed.substr(0, framed.size() - 1), out));
+    EXPECT_FALSE(BlockCompression::decompress(framed.substr(0, 5), out));
+    std::string corrupt = framed;
+    corrupt[0] = static_cast<char>(corrupt[0] + 1);  // Raw size no longer matches the payload
+    EXPECT_FALSE(BlockCompression::decompress(corrupt, out));
+}
+
+TEST(BlockCompression, DecoderAcceptsAnySplit) {
+    std::string data = TestData::prose(200000);
+    std::string framed = BlockCompression::compress(data);
+    std::mt19937 rng(163);
+    for (int round = 0; round < 5; ++round) {
+        BlockCompression::Decoder decoder;
+        std::string out;
+        for (size_t offset = 0; offset < framed.size();) {
+            size_t piece = std::min<size_t>(1 + rng() % 5000, framed.size() - offset);
+            ASSERT_TRUE(decoder.update(framed.data() + offset, piece, out));
+            offset += piece;
+        }
+        ASSERT_TRUE(decoder.finish());
+        ASSERT_EQ(out, data);
+    }
+    BlockCompression::Decoder truncated;
+    std::string out;
+    ASSERT_TRUE(truncated.update(framed.data(), framed.size() - 3, out));
+    EXPECT_FALSE(truncated.finish());
+}
+
+TEST(CompressedCipher, RoundTripsThroughInnerCipher) {
+    CompressedCipher cipher(std::unique_ptr<CipherAlgorithm>(new VigenereCipher(Alphabet::BYTES)));
+    cipher.setKey("compress me");
+    EXPECT_STREQ(cipher.getName(), "vigenere-bytes+lz");
+    EXPECT_TRUE(cipher.isLossless());
+    std::string prose = TestData::prose(100000);
+    std::string ciphertext = cipher.encrypt(prose);
+    EXPECT_LT(ciphertext.size(), prose.size() / 2);
+    EXPECT_EQ(cipher.decrypt(ciphertext), prose);
+}
+
+TEST(CompressedCipher, CommandLineRejectsLossyInnerCipher) {
+    std::string input = TestData::tempPath("lz_input");
+    std::string output = TestData::tempPath("lz_output");
+    TestData::writeFile(input, TestData::prose(1000));
+    setenv("ET_KEY", " ", 1);
+    auto run = [&](const char* algorithm) {
+        std::vector<std::string> args = {"EncryptionTool", "encrypt-file", algorithm, input, output};
+        std::vector<char*> argv;
+        for (std::string& arg : args) argv.push_back(&arg[0]);
+        testing::internal::CaptureStderr();
+        int status = CommandLine::run(static_cast<int>(argv.size()), argv.data());
+        std::string errors = testing::internal::GetCapturedStderr();
+        return std::make_pair(status, errors);
+    };
+    auto lossy = run("morse+lz");
+    EXPECT_NE(lossy.first, 0);
+    EXPECT_NE(lossy.second.find("not lossless"), std::string::npos) << lossy.second;
+    EXPECT_FALSE(TestData::exists(output));
+    EXPECT_NE(run("morse+lz+base64").first, 0);
+    EXPECT_EQ(run("vigenere-bytes+lz+hex").first, 0);
+    unsetenv("ET_KEY");
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+    std::remove((output + ".sum").c_str());
+}
+
+} // namespace
@@ -0,0 +1,202 @@
+#include "AeadCipher.h"
+#include "ChunkedContainer.h"
+#include "TestData.h"
+#include "VigenereCipher.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+
+namespace {
+
+const std::string AEAD_KEY = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f";
+
+class ChunkedContainerTest : public testing::Test {
+protected:
+    std::string input = TestData::tempPath("container.in");
+    std::string container = TestData::tempPath("container.etc");
+    std::string output = TestData::tempPath("container.out");
+    std::string plaintext = TestData::text(10000 + 123, 75, 59);
+
+    void SetUp() override { TestData::writeFile(input, plaintext); }
+    void TearDown() override {
+        std::remove(input.c_str());
+        std::remove(container.c_str());
+        std::remove(output.c_str());
+    }
+
+    // Overwrites 8 little-endian bytes at `offset` of the container
+    void patch64(size_t offset, uint64_t value) {
+        std::string bytes = TestData::readFile(container);
+        for (int i = 0; i < 8; ++i) bytes[offset + i] = static_cast<char>(value >> (8 * i));
+        TestData::writeFile(container, bytes);
+    }
+
+    // Offset of chunk entry `index` in the index at the end of the file
+    size_t entryOffset(uint64_t chunkCount, uint64_t index) {
+        return TestData::readFile(container).size() - 12 - chunkCount * 24 + index * 24;
+    }
+};
+
+TEST_F(ChunkedContainerTest, RoundTripsAndReadsRanges) {
+    VigenereCipher cipher;
+    cipher.setKey("CONTAINER");
+    ASSERT_TRUE(ChunkedContainer::encryptFile(cipher, input, container, 1000));
+    ASSERT_TRUE(ChunkedContainer::decryptFile(cipher, container, output));
+    EXPECT_EQ(TestData::readFile(output), plaintext);
+
+    ChunkedContainer::Info info;
+    ASSERT_TRUE(ChunkedContainer::readInfo(container, info));
+    EXPECT_EQ(info.algorithm, "vigenere");
+    EXPECT_EQ(info.chunkSize, 1000u);
+    EXPECT_EQ(info.chunkCount, 11u);
+    EXPECT_EQ(info.plaintextSize, plaintext.size());
+
+    std::string range;
+    for (uint64_t offset : {0u, 1u, 999u, 1000u, 4321u, 10100u}) {
+        for (uint64_t length : {0u, 1u, 1000u, 2500u, 100000u}) {
+            ASSERT_TRUE(ChunkedContainer::decryptRange(cipher, container, offset, length, range));
+            EXPECT_EQ(range, plaintext.substr(offset, length)) << offset << "+" << length;
+        }
+    }
+    ASSERT_TRUE(ChunkedContainer::decryptRange(cipher, container, 20000, 5, range));
+    EXPECT_EQ(range, "");
+}
+
+TEST_F(ChunkedContainerTest, AeadRoundTrip) {
+    AeadCipher cipher;
+    cipher.setKey(AEAD_KEY);
+    ASSERT_TRUE(ChunkedContainer::encryptFile(cipher, input, container, 4096));
+    ASSERT_TRUE(ChunkedContainer::decryptFile(cipher, container, output));
+    EXPECT_EQ(TestData::readFile(output), plaintext);
+    std::string range;
+    ASSERT_TRUE(ChunkedContainer::decryptRange(cipher, container, 4000, 200, range));
+    EXPECT_EQ(range, plaintext.substr(4000, 200));
+}
+
+TEST_F(ChunkedContainerTest, TamperedAeadChunkFailsWithoutOutput) {
+    AeadCipher cipher;
+    cipher.setKey(AEAD_KEY);
+    ASSERT_TRUE(ChunkedContainer::encryptFile(cipher, input, container, 4096));
+    std::string bytes = TestData::readFile(container);
+    bytes[bytes.size() / 2] ^= 1;  // Inside the second of three chunks
+    TestData::writeFile(container, bytes);
+
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(ChunkedContainer::decryptFile(cipher, container, output));
+    std::string range;
+    EXPECT_FALSE(ChunkedContainer::decryptRange(cipher, container, 5000, 10, range));
+    EXPECT_TRUE(ChunkedContainer::decryptRange(cipher, container, 0, 10, range));  // First chunk is intact
+    std::string errors = testing::internal::GetCapturedStderr();
+    EXPECT_FALSE(TestData::exists(output));
+    EXPECT_NE(errors.find("Chunk 1 of"), std::string::npos);
+}
+
+TEST_F(ChunkedContainerTest, AeadChunksAreBoundToTheirPlace) {
+    AeadCipher cipher;
+    cipher.setKey(AEAD_KEY);
+    ASSERT_TRUE(ChunkedContainer::encryptFile(cipher, input, container, 4096));
+    std::string original = TestData::readFile(container);
+    size_t entries = entryOffset(3, 0);
+    size_t index = entries - 16;
+    std::string range;
+    testing::internal::CaptureStderr();
+
+    // Swapping the first two chunks' index entries (both are full chunks)
+    std::string swapped = original;
+    swapped.replace(entries, 24, original, entries + 24, 24);
+    swapped.replace(entries + 24, 24, original, entries, 24);
+    TestData::writeFile(container, swapped);
+    EXPECT_FALSE(ChunkedContainer::decryptFile(cipher, container, output));
+    EXPECT_FALSE(ChunkedContainer::decryptRange(cipher, container, 0, 10, range));
+
+    // Cutting off the last chunk and rewriting the index to match
+    auto put64 = [](std::string& bytes, size_t offset, uint64_t value) {
+        for (int i = 0; i < 8; ++i) bytes[offset + i] = static_cast<char>(value >> (8 * i));
+    };
+    uint64_t lastChunk = 0;
+    for (int i = 7; i >= 0; --i) lastChunk = lastChunk << 8 | static_cast<unsigned char>(original[entries + 48 + i]);
+    std::string cut = original.substr(0, static_cast<size_t>(lastChunk)) + original.substr(index, 16 + 2 * 24) +
+                      std::string(8, '\0') + "ETCX";
+    put64(cut, static_cast<size_t>(lastChunk), 2);
+    put64(cut, static_cast<size_t>(lastChunk) + 8, 8192);
+    put64(cut, cut.size() - 12, lastChunk);
+    TestData::writeFile(container, cut);
+    ChunkedContainer::Info info;
+    ASSERT_TRUE(ChunkedContainer::readInfo(container, info));
+    EXPECT_EQ(info.chunkCount, 2u);
+    EXPECT_FALSE(ChunkedContainer::decryptFile(cipher, container, output));
+    EXPECT_FALSE(ChunkedContainer::decryptRange(cipher, container, 5000, 10, range));
+    EXPECT_FALSE(TestData::exists(output));
+
+    // Every chunk cut off
+    std::string none = original.substr(0, index) + std::string(24, '\0') + "ETCX";
+    put64(none, none.size() - 12, index);
+    TestData::writeFile(container, none);
+    ASSERT_TRUE(ChunkedContainer::readInfo(container, info));
+    EXPECT_EQ(info.chunkCount, 0u);
+    EXPECT_FALSE(ChunkedContainer::decryptFile(cipher, container, output));
+    testing::internal::GetCapturedStderr();
+    EXPECT_FALSE(TestData::exists(output));
+
+    // so empty input is stored as one empty chunk
+    TestData::writeFile(input, "");
+    ASSERT_TRUE(ChunkedContainer::encryptFile(cipher, input, container, 4096));
+    ASSERT_TRUE(ChunkedContainer::readInfo(container, info));
+    EXPECT_EQ(info.chunkCount, 1u);
+    ASSERT_TRUE(ChunkedContainer::decryptFile(cipher, container, output));
+    EXPECT_EQ(TestData::readFile(output), "");
+}
+
+TEST_F(ChunkedContainerTest, WrongKeyFails) {
+    AeadCipher cipher;
+    cipher.setKey(AEAD_KEY);
+    ASSERT_TRUE(ChunkedContainer::encryptFile(cipher, input, container));
+    AeadCipher other;
+    other.setKey(AeadCipher::generateKey());
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(ChunkedContainer::decryptFile(other, container, output));
+    testing::internal::GetCapturedStderr();
+}
+
+TEST_F(ChunkedContainerTest, RejectsOutOfBoundsEntries) {
+    VigenereCipher cipher;
+    ASSERT_TRUE(ChunkedContainer::encryptFile(cipher, input, container, 1000));
+    std::string original = TestData::readFile(container);
+    std::string range;
+
+    testing::internal::CaptureStderr();
+    patch64(entryOffset(11, 3) + 8, ~0ull >> 1);  // Size far past the end of the file
+    EXPECT_FALSE(ChunkedContainer::decryptFile(cipher, container, output));
+    EXPECT_FALSE(ChunkedContainer::decryptRange(cipher, container, 3500, 10, range));
+
+    TestData::writeFile(container, original);
+    patch64(entryOffset(11, 3), ~0ull - 10);  // Offset that wraps around
+    EXPECT_FALSE(ChunkedContainer::decryptRange(cipher, container, 3500, 10, range));
+
+    TestData::writeFile(container, original);
+    patch64(entryOffset(11, 0) - 8, plaintext.size() + 5000);  // Plaintext size disagrees with the chunk count
+    EXPECT_FALSE(ChunkedContainer::decryptFile(cipher, container, output));
+
+    TestData::writeFile(container, original.substr(0, original.size() - 1));
+    EXPECT_FALSE(ChunkedContainer::decryptFile(cipher, container, output));
+    testing::internal::GetCapturedStderr();
+}
+
+TEST_F(ChunkedContainerTest, RejectsAnotherAlgorithm) {
+    VigenereCipher cipher;
+    ASSERT_TRUE(ChunkedContainer::encryptFile(cipher, input, container));
+    AeadCipher aead;
+    aead.setKey(AEAD_KEY);
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(ChunkedContainer::decryptFile(aead, container, output));
+    EXPECT_NE(testing::internal::GetCapturedStderr().find("encrypted with vigenere"), std::string::npos);
+}
+
+TEST_F(ChunkedContainerTest, EmptyInput) {
+    TestData::writeFile(input, "");
+    VigenereCipher cipher;
+    ASSERT_TRUE(ChunkedContainer::encryptFile(cipher, input, container));
+    ASSERT_TRUE(ChunkedContainer::decryptFile(cipher, container, output));
+    EXPECT_EQ(TestData::readFile(output), "");
+}
+
+} // namespace
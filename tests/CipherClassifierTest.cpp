@@ -0,0 +1,103 @@
+#include "Ascii.h"
+#include "CaesarCipher.h"
+#include "CipherClassifier.h"
+#include "MorseCodeCipher.h"
+#include "ROT13Cipher.h"
+#include "SubstitutionCipher.h"
+#include "TestData.h"
+#include "VigenereCipher.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+namespace {
+
+std::string json(const std::string& file, uint64_t line, const CipherClassifier::Result& result) {
+    std::string out;
+    CipherClassifier::appendJson(out, file, line, result);
+    return out;
+}
+
+TEST(CipherClassifier, LabelsEachCipher) {
+    std::string plaintext = TestData::prose(2000);
+    ASSERT_FALSE(plaintext.empty());
+    EXPECT_EQ(CipherClassifier::classify(plaintext).label, CipherClassifier::Label::PLAINTEXT);
+
+    CaesarCipher caesar;
+    caesar.setKey("7");
+    CipherClassifier::Result result = CipherClassifier::classify(caesar.encrypt(plaintext));
+    EXPECT_EQ(result.label, CipherClassifier::Label::CAESAR);
+    EXPECT_EQ(result.shift, 7);
+    ROT13Cipher rot13;
+    EXPECT_EQ(CipherClassifier::classify(rot13.encrypt(plaintext)).shift, 13);
+
+    SubstitutionCipher substitution;
+    substitution.setKey("QWERTYUIOPASDFGHJKLZXCVBNM");
+    EXPECT_EQ(CipherClassifier::classify(substitution.encrypt(plaintext)).label,
+              CipherClassifier::Label::SUBSTITUTION);
+
+    VigenereCipher vigenere;
+    vigenere.setKey("LEMONS");
+    result = CipherClassifier::classify(vigenere.encrypt(plaintext));
+    EXPECT_EQ(result.label, CipherClassifier::Label::VIGENERE);
+    EXPECT_EQ(result.period, 6u);
+
+    MorseCodeCipher morse;
+    EXPECT_EQ(CipherClassifier::classify(morse.encrypt(plaintext.substr(0, 300))).label,
+              CipherClassifier::Label::MORSE);
+    EXPECT_EQ(CipherClassifier::classify(TestData::bytes(2000, 199)).label, CipherClassifier::Label::UNKNOWN);
+    EXPECT_EQ(CipherClassifier::classify("").label, CipherClassifier::Label::UNKNOWN);
+}
+
+TEST(CipherClassifier, JsonEscapesFileNames) {
+    CipherClassifier::Result result;
+    result.bytes = 3;
+    EXPECT_EQ(json("a.txt", 2, result),
+              "{\"file\":\"a.txt\",\"line\":2,\"label\":\"unknown\",\"confidence\":0.0000,\"bytes\":3,\"letters\":0}");
+    EXPECT_EQ(json("q\"b\\s\n\x01", 0, result).substr(0, 30), "{\"file\":\"q\\\"b\\\\s\\u000a\\u0001\",");
+
+    // Valid UTF-8 is kept as it is
+    std::string valid = "caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x94\x91.txt";
+    std::string out = json(valid, 0, result);
+    EXPECT_NE(out.find("\"file\":\"" + valid + "\""), std::string::npos) << out;
+    EXPECT_EQ(out.find("file_hex"), std::string::npos);
+
+    // Stray, truncated and overlong sequences become U+FFFD, with the raw bytes in hex
+    std::string invalid = "a\xff" "b\xc3" "c\xe2\x82" "d\xc0\xaf";
+    out = json(invalid, 0, result);
+    EXPECT_NE(out.find("\"file\":\"a\\ufffdb\\ufffdc\\ufffd\\ufffdd\\ufffd\\ufffd\""), std::string::npos) << out;
+    EXPECT_NE(out.find("\"file_hex\":\"61ff62c363e28264c0af\""), std::string::npos) << out;
+    EXPECT_TRUE(Ascii::isValidUtf8(out.data(), out.size()));
+}
+
+TEST(CipherClassifier, ClassifiesDirectoriesWithAnyFileNames) {
+    std::string directory = TestData::tempPath("classify_dir");
+    TestData::removeTree(directory);
+    ASSERT_EQ(system(("mkdir -p '" + directory + "'").c_str()), 0);
+    std::string plaintext = TestData::prose(1000);
+    TestData::writeFile(directory + "/plain.txt", plaintext);
+    TestData::writeFile(directory + "/bad\xff" "name.txt", plaintext);
+
+    std::ostringstream out;
+    CipherClassifier::Options options;
+    options.threads = 2;
+    CipherClassifier::Report report = CipherClassifier::classifyPath(directory, out, options);
+    TestData::removeTree(directory);
+    EXPECT_EQ(report.records, 2u);
+    EXPECT_EQ(report.counts[static_cast<int>(CipherClassifier::Label::PLAINTEXT)], 2u);
+    std::string lines = out.str();
+    EXPECT_TRUE(Ascii::isValidUtf8(lines.data(), lines.size()));
+    EXPECT_NE(lines.find("bad\\ufffdname.txt\",\"file_hex\":\""), std::string::npos) << lines;
+
+    // A records file gives one object per line, numbered from 1
+    std::string records = TestData::tempPath("classify_records.txt");
+    TestData::writeFile(records, plaintext.substr(0, 200) + "\r\n" + plaintext.substr(200, 200) + "\n");
+    std::ostringstream recordOut;
+    report = CipherClassifier::classifyPath(records, recordOut, options);
+    std::remove(records.c_str());
+    EXPECT_EQ(report.records, 2u);
+    EXPECT_NE(recordOut.str().find("\"line\":2,"), std::string::npos);
+}
+
+} // namespace
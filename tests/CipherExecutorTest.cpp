@@ -0,0 +1,179 @@
+#include "AeadCipher.h"
+#include "AsyncCipher.h"
+#include "CipherExecutor.h"
+#include "IntegrityManifest.h"
+#include "TestData.h"
+#include "VigenereCipher.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+TEST(CipherExecutor, SmallRequestsMatchDirectCalls) {
+    VigenereCipher cipher;
+    cipher.setKey("EXECUTOR");
+    std::vector<std::string> messages;
+    for (int i = 0; i < 2000; ++i) messages.push_back(TestData::text(1 + i % 300, 70, i));
+
+    std::vector<std::string> results(messages.size());
+    std::atomic<int> remaining(static_cast<int>(messages.size()));
+    std::promise<void> allDone;
+    CipherExecutor::Options options;
+    options.threads = 3;
+    {
+        CipherExecutor executor(options);
+        EXPECT_EQ(executor.size(), 3u);
+        // Several submitting threads, so requests pile up and get batched
+        std::vector<std::thread> submitters;
+        for (int t = 0; t < 4; ++t) {
+            submitters.emplace_back([&, t]() {
+                for (size_t i = t; i < messages.size(); i += 4) {
+                    executor.submit(cipher, true, messages[i], [&, i](std::string ciphertext) {
+                        results[i] = std::move(ciphertext);
+                        if (remaining.fetch_sub(1) == 1) allDone.set_value();
+                    });
+                }
+            });
+        }
+        for (std::thread& submitter : submitters) submitter.join();
+        allDone.get_future().wait();
+        CipherExecutor::Stats stats = executor.stats();
+        EXPECT_EQ(stats.requests, messages.size());
+        EXPECT_GE(stats.batches, 1u);
+        EXPECT_LE(stats.batches, stats.requests);
+    }
+    for (size_t i = 0; i < messages.size(); ++i) {
+        ASSERT_EQ(results[i], cipher.encrypt(messages[i])) << i;
+        ASSERT_EQ(cipher.decrypt(results[i]), messages[i]) << i;
+    }
+}
+
+TEST(CipherExecutor, DestructorFinishesPendingRequests) {
+    AeadCipher cipher;
+    cipher.setKey(AeadCipher::generateKey());
+    std::vector<std::string> ciphertexts;
+    std::mutex mutex;
+    {
+        CipherExecutor executor;
+        for (int i = 0; i < 200; ++i) {
+            executor.submit(cipher, true, "message " + std::to_string(i), [&](std::string ciphertext) {
+                std::lock_guard<std::mutex> lock(mutex);
+                ciphertexts.push_back(std::move(ciphertext));
+            });
+        }
+    }
+    ASSERT_EQ(ciphertexts.size(), 200u);
+    std::vector<bool> seen(200);
+    for (const std::string& ciphertext : ciphertexts) {
+        std::string plaintext = cipher.decrypt(ciphertext);
+        ASSERT_EQ(plaintext.compare(0, 8, "message "), 0) << plaintext;
+        seen[std::stoi(plaintext.substr(8))] = true;
+    }
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), true), 200);
+}
+
+class CipherExecutorFileTest : public testing::Test {
+protected:
+    std::string input = TestData::tempPath("executor_input");
+    std::string viaExecutor = TestData::tempPath("executor_output");
+    std::string viaProcessFile = TestData::tempPath("executor_reference");
+    std::string decrypted = TestData::tempPath("executor_decrypted");
+
+    void TearDown() override {
+        for (const std::string& path : {input, viaExecutor, viaProcessFile, decrypted}) {
+            std::remove(path.c_str());
+            std::remove(IntegrityManifest::pathFor(path).c_str());
+        }
+    }
+
+    static bool runFile(CipherExecutor& executor, CipherAlgorithm& cipher, const std::string& from,
+                        const std::string& to, bool isEncryption, Digest digest = Digest::CRC32C) {
+        std::promise<bool> done;
+        executor.submitFile(cipher, from, to, isEncryption, [&](bool ok) { done.set_value(ok); }, digest);
+        return done.get_future().get();
+    }
+};
+
+TEST_F(CipherExecutorFileTest, FilesMatchProcessFile) {
+    // Small chunks, so the stateful Vigenère key position is carried across many of them
+    CipherExecutor::Options options;
+    options.threads = 2;
+    options.fileChunkSize = 4099;
+    CipherExecutor executor(options);
+    std::string plaintext = TestData::text(100000, 75, 179);
+    TestData::writeFile(input, plaintext);
+
+    VigenereCipher vigenere;
+    vigenere.setKey("CHUNKED");
+    AeadCipher aead;
+    aead.setKey(AeadCipher::generateKey());
+    for (CipherAlgorithm* cipher : {static_cast<CipherAlgorithm*>(&vigenere), static_cast<CipherAlgorithm*>(&aead)}) {
+        ASSERT_TRUE(runFile(executor, *cipher, input, viaExecutor, true, Digest::XXH3)) << cipher->getName();
+        ASSERT_TRUE(cipher->processFile(input, viaProcessFile, true, Digest::XXH3));
+        if (cipher == &vigenere) {
+            EXPECT_EQ(TestData::readFile(viaExecutor), TestData::readFile(viaProcessFile));
+            EXPECT_EQ(TestData::readFile(IntegrityManifest::pathFor(viaExecutor)),
+                      TestData::readFile(IntegrityManifest::pathFor(viaProcessFile)));
+        }
+        ASSERT_TRUE(runFile(executor, *cipher, viaExecutor, decrypted, false)) << cipher->getName();
+        EXPECT_EQ(TestData::readFile(decrypted), plaintext) << cipher->getName();
+    }
+
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(runFile(executor, vigenere, TestData::tempPath("executor_missing"), decrypted, true));
+    VigenereCipher wrongKey;
+    wrongKey.setKey("WRONG");
+    std::remove(decrypted.c_str());
+    EXPECT_FALSE(runFile(executor, wrongKey, viaProcessFile, decrypted, false));
+    testing::internal::GetCapturedStderr();
+    EXPECT_FALSE(TestData::exists(decrypted));
+    EXPECT_EQ(executor.stats().files, 6u);
+}
+
+TEST_F(CipherExecutorFileTest, TamperedAeadFileFails) {
+    CipherExecutor executor;
+    TestData::writeFile(input, TestData::prose(20000));
+    AeadCipher aead;
+    aead.setKey(AeadCipher::generateKey());
+    ASSERT_TRUE(runFile(executor, aead, input, viaExecutor, true));
+
+    std::string ciphertext = TestData::readFile(viaExecutor);
+    ciphertext[ciphertext.size() / 3] ^= 0x10;
+    TestData::writeFile(viaExecutor, ciphertext);
+    testing::internal::CaptureStderr();
+    EXPECT_FALSE(runFile(executor, aead, viaExecutor, decrypted, false));
+    testing::internal::GetCapturedStderr();
+    EXPECT_FALSE(TestData::exists(decrypted));
+}
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+AsyncCipher::Task<std::string> roundTrip(CipherExecutor& executor, CipherAlgorithm& cipher, std::string message) {
+    std::string ciphertext = co_await AsyncCipher::encrypt(executor, cipher, message);
+    std::string plaintext = co_await AsyncCipher::decrypt(executor, cipher, std::move(ciphertext));
+    co_return plaintext;
+}
+
+TEST(AsyncCipher, WhenAllRunsTasksAndKeepsOrder) {
+    AeadCipher cipher;
+    cipher.setKey(AeadCipher::generateKey());
+    CipherExecutor executor;
+    std::vector<AsyncCipher::Task<std::string>> tasks;
+    std::vector<std::string> messages;
+    for (int i = 0; i < 100; ++i) {
+        messages.push_back(TestData::text(10 + i, 70, 181 + i));
+        tasks.push_back(roundTrip(executor, cipher, messages.back()));
+    }
+    EXPECT_EQ(AsyncCipher::syncWait(AsyncCipher::whenAll(std::move(tasks))), messages);
+    EXPECT_TRUE(AsyncCipher::syncWait(AsyncCipher::whenAll(std::vector<AsyncCipher::Task<std::string>>())).empty());
+}
+
+#endif // __cpp_impl_coroutine
+
+} // namespace
@@ -0,0 +1,64 @@
+#include "CaesarCipher.h"
+#include "CipherKernels.h"
+#include "ROT13Cipher.h"
+#include "TestData.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+std::string shiftReference(std::string text, int shift) {
+    for (char& c : text) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>('A' + (c - 'A' + shift) % 26);
+        else if (c >= 'a' && c <= 'z') c = static_cast<char>('a' + (c - 'a' + shift) % 26);
+    }
+    return text;
+}
+
+TEST(CipherKernels, ShiftLettersMatchesScalarReference) {
+    // Every size up to a few vector widths, so each clone's tail handling is covered
+    std::string text = TestData::bytes(300, 7) + TestData::text(300, 70, 7);
+    for (size_t size = 0; size <= text.size(); size += size < 200 ? 1 : 37) {
+        for (int shift = 0; shift < 26; shift += 5) {
+            std::string data = text.substr(0, size);
+            CipherKernels::shiftLetters(&data[0], data.size(), shift);
+            ASSERT_EQ(data, shiftReference(text.substr(0, size), shift)) << "size " << size << " shift " << shift;
+        }
+    }
+}
+
+TEST(CipherKernels, CountLetters) {
+    std::string text = TestData::text(1000, 60, 3);
+    size_t expected = 0;
+    for (char c : text) expected += (c | 0x20) >= 'a' && (c | 0x20) <= 'z';
+    EXPECT_EQ(CipherKernels::countLetters(text.data(), text.size()), expected);
+    EXPECT_EQ(CipherKernels::countLetters("", 0), 0u);
+    EXPECT_EQ(CipherKernels::countLetters("@[`{", 4), 0u);
+}
+
+TEST(CaesarCipher, KnownAnswer) {
+    CaesarCipher cipher;
+    cipher.setKey("3");
+    EXPECT_EQ(cipher.encrypt("Hello, World! xyz"), "Khoor, Zruog! abc");
+    EXPECT_EQ(cipher.decrypt("Khoor, Zruog! abc"), "Hello, World! xyz");
+}
+
+TEST(CaesarCipher, RoundTripsEveryShift) {
+    std::string text = TestData::text(4096, 75, 11);
+    CaesarCipher cipher;
+    for (int shift = -30; shift <= 30; ++shift) {
+        cipher.setKey(std::to_string(shift));
+        std::string ciphertext = cipher.encrypt(text);
+        ASSERT_EQ(ciphertext.size(), text.size());
+        ASSERT_EQ(cipher.decrypt(ciphertext), text) << "shift " << shift;
+    }
+}
+
+TEST(ROT13Cipher, IsItsOwnInverse) {
+    ROT13Cipher cipher;
+    EXPECT_EQ(cipher.encrypt("Why did the chicken cross the road?"), "Jul qvq gur puvpxra pebff gur ebnq?");
+    std::string text = TestData::text(5000, 80, 5);
+    EXPECT_EQ(cipher.encrypt(cipher.encrypt(text)), text);
+    EXPECT_EQ(cipher.decrypt(text), cipher.encrypt(text));
+}
+
+} // namespace
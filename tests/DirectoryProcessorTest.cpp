@@ -0,0 +1,174 @@
+#include "AeadCipher.h"
+#include "CaesarCipher.h"
+#include "DirectoryProcessor.h"
+#include "TestData.h"
+#include "VigenereCipher.h"
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+
+namespace {
+
+const std::string AEAD_KEY = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f";
+
+class DirectoryProcessorTest : public testing::Test {
+protected:
+    std::string input = TestData::tempPath("tree.in");
+    std::string encrypted = TestData::tempPath("tree.enc");
+    std::string decrypted = TestData::tempPath("tree.out");
+    std::string small = TestData::text(700, 75, 61);
+    std::string large = TestData::text(10000, 75, 67);  // Several chunk tasks at a 1000-byte chunk size
+    DirectoryProcessor::Options options;
+
+    void SetUp() override {
+        mkdir(input.c_str(), 0755);
+        mkdir((input + "/sub").c_str(), 0755);
+        TestData::writeFile(input + "/small.txt", small);
+        TestData::writeFile(input + "/sub/large.txt", large);
+        options.threads = 2;
+        options.chunkSize = 1000;
+    }
+    void TearDown() override {
+        TestData::removeTree(input);
+        TestData::removeTree(encrypted);
+        TestData::removeTree(decrypted);
+    }
+
+    DirectoryProcessor::Report run(CipherAlgorithm& cipher, const std::string& from, const std::string& to,
+                                   bool isEncryption) {
+        testing::internal::CaptureStderr();
+        DirectoryProcessor::Report report = DirectoryProcessor::process(cipher, from, to, isEncryption, options);
+        testing::internal::GetCapturedStderr();
+        return report;
+    }
+
+    void expectDecryptsTo(CipherAlgorithm& cipher) {
+        DirectoryProcessor::Report report = run(cipher, encrypted, decrypted, false);
+        EXPECT_EQ(report.failed, 0u);
+        EXPECT_EQ(TestData::readFile(decrypted + "/small.txt"), small);
+        EXPECT_EQ(TestData::readFile(decrypted + "/sub/large.txt"), large);
+    }
+};
+
+TEST_F(DirectoryProcessorTest, RoundTripsTreeInChunks) {
+    VigenereCipher cipher;
+    cipher.setKey("DIRECTORY");
+    DirectoryProcessor::Report report = run(cipher, input, encrypted, true);
+    EXPECT_EQ(report.files, 2u);
+    EXPECT_EQ(report.directories, 2u);
+    EXPECT_EQ(report.failed, 0u);
+    EXPECT_EQ(report.chunkTasks, 10u);
+    EXPECT_EQ(TestData::readFile(encrypted + "/small.txt"), cipher.encrypt(small));
+    EXPECT_EQ(TestData::readFile(encrypted + "/sub/large.txt"), cipher.encrypt(large));
+    expectDecryptsTo(cipher);
+}
+
+TEST_F(DirectoryProcessorTest, RerunWithSameSettingsSkipsFinishedFiles) {
+    VigenereCipher cipher;
+    cipher.setKey("DIRECTORY");
+    run(cipher, input, encrypted, true);
+    DirectoryProcessor::Report report = run(cipher, input, encrypted, true);
+    EXPECT_EQ(report.files, 0u);
+    EXPECT_EQ(report.skipped, 2u);
+}
+
+TEST_F(DirectoryProcessorTest, DifferentKeyRewritesEveryFile) {
+    VigenereCipher first, second;
+    first.setKey("FIRSTKEY");
+    second.setKey("SECONDKEY");
+    run(first, input, encrypted, true);
+    DirectoryProcessor::Report report = run(second, input, encrypted, true);
+    EXPECT_EQ(report.skipped, 0u);
+    EXPECT_EQ(report.files, 2u);
+    expectDecryptsTo(second);
+}
+
+TEST_F(DirectoryProcessorTest, DifferentCipherOrDirectionRewritesEveryFile) {
+    VigenereCipher vigenere;
+    vigenere.setKey("DIRECTORY");
+    CaesarCipher caesar;
+    caesar.setKey("3");
+    run(vigenere, input, encrypted, true);
+    EXPECT_EQ(run(caesar, input, encrypted, true).skipped, 0u);
+    EXPECT_EQ(run(caesar, input, encrypted, false).skipped, 0u);
+    EXPECT_EQ(TestData::readFile(encrypted + "/small.txt"), caesar.decrypt(small));
+}
+
+TEST_F(DirectoryProcessorTest, InterruptedChangeOfKeyIsNotResumed) {
+    VigenereCipher first, second;
+    first.setKey("FIRSTKEY");
+    second.setKey("SECONDKEY");
+    run(first, input, encrypted, true);
+
+    // What a run with the second key leaves when it is stopped before finishing: the
+    // outputs are still the first key's, with their inputs' times
+    run(second, input, decrypted, true);
+    std::string record = TestData::readFile(decrypted + "/.etresume");
+    size_t state = record.rfind("clean");
+    ASSERT_NE(state, std::string::npos);
+    TestData::writeFile(encrypted + "/.etresume", record.substr(0, state) + "mixed\n");
+
+    DirectoryProcessor::Report report = run(second, input, encrypted, true);
+    EXPECT_EQ(report.skipped, 0u);
+    EXPECT_EQ(report.files, 2u);
+    EXPECT_EQ(run(second, input, encrypted, true).skipped, 2u);  // Clean again after a full run
+}
+
+TEST_F(DirectoryProcessorTest, UnrecordedOutputTreeIsRewritten) {
+    VigenereCipher cipher;
+    cipher.setKey("DIRECTORY");
+    run(cipher, input, encrypted, true);
+    ASSERT_EQ(std::remove((encrypted + "/.etresume").c_str()), 0);
+    EXPECT_EQ(run(cipher, input, encrypted, true).skipped, 0u);
+}
+
+TEST_F(DirectoryProcessorTest, InputRecordIsNotProcessed) {
+    VigenereCipher cipher;
+    cipher.setKey("DIRECTORY");
+    run(cipher, input, encrypted, true);
+    expectDecryptsTo(cipher);
+    EXPECT_NE(TestData::readFile(decrypted + "/.etresume").find(" decrypt "), std::string::npos);
+}
+
+TEST_F(DirectoryProcessorTest, AeadTreeResumesWithTheSameKey) {
+    AeadCipher cipher;
+    cipher.setKey(AEAD_KEY);
+    run(cipher, input, encrypted, true);
+    EXPECT_EQ(run(cipher, input, encrypted, true).skipped, 2u);
+    expectDecryptsTo(cipher);
+}
+
+TEST_F(DirectoryProcessorTest, TamperedAeadFileFailsAndKeepsOldOutput) {
+    AeadCipher cipher;
+    cipher.setKey(AEAD_KEY);
+    run(cipher, input, encrypted, true);
+    expectDecryptsTo(cipher);
+
+    std::string ciphertext = TestData::readFile(encrypted + "/small.txt");
+    ciphertext[ciphertext.size() / 2] ^= 1;
+    TestData::writeFile(encrypted + "/small.txt", ciphertext);
+    options.resume = false;
+    DirectoryProcessor::Report report = run(cipher, encrypted, decrypted, false);
+    EXPECT_EQ(report.failed, 1u);
+    EXPECT_EQ(report.files, 1u);
+    EXPECT_EQ(TestData::readFile(decrypted + "/small.txt"), small);
+    EXPECT_FALSE(TestData::exists(decrypted + "/small.txt.etpart"));
+}
+
+TEST(KeyFingerprint, DependsOnKeyOnly) {
+    VigenereCipher a, b;
+    a.setKey("KEYONE");
+    b.setKey("KEYONE");
+    EXPECT_EQ(a.keyFingerprint(), b.keyFingerprint());
+    b.setKey("KEYTWO");
+    EXPECT_NE(a.keyFingerprint(), b.keyFingerprint());
+
+    AeadCipher aead, other;
+    aead.setKey(AEAD_KEY);
+    other.setKey(AEAD_KEY);
+    EXPECT_EQ(aead.keyFingerprint(), aead.keyFingerprint());  // Not randomized like encryption
+    EXPECT_EQ(aead.keyFingerprint(), other.keyFingerprint());
+    other.setKey(std::string(64, 'f'));
+    EXPECT_NE(aead.keyFingerprint(), other.keyFingerprint());
+}
+
+} // namespace
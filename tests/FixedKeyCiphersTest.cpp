@@ -0,0 +1,53 @@
+#include "CaesarCipher.h"
+#include "FixedKeyCiphers.h"
+#include "SubstitutionCipher.h"
+#include "TestData.h"
+#include <gtest/gtest.h>
+#include <cstring>
+
+namespace {
+
+template <int Shift>
+void expectMatchesCaesar(const std::string& text) {
+    FixedCaesarCipher<Shift> fixed;
+    CaesarCipher caesar;
+    caesar.setKey(std::to_string(Shift));
+    std::string ciphertext = fixed.encrypt(text);
+    EXPECT_EQ(ciphertext, caesar.encrypt(text)) << "shift " << Shift;
+    EXPECT_EQ(fixed.decrypt(ciphertext), text) << "shift " << Shift;
+}
+
+TEST(FixedCaesarCipher, MatchesCaesarCipher) {
+    std::string text = TestData::bytes(777, 23) + TestData::text(777, 70, 23);
+    expectMatchesCaesar<0>(text);
+    expectMatchesCaesar<1>(text);
+    expectMatchesCaesar<3>(text);
+    expectMatchesCaesar<13>(text);
+    expectMatchesCaesar<25>(text);
+}
+
+TEST(FixedCaesarCipher, NamesIncludeTheShift) {
+    EXPECT_STREQ(Caesar3Cipher().getName(), "caesar-fixed-3");
+    EXPECT_STREQ(FixedROT13Cipher().getName(), "caesar-fixed-13");
+    EXPECT_EQ(Caesar3Cipher().getName(), Caesar3Cipher().getName());  // Interned once
+}
+
+TEST(FixedCaesarCipher, IgnoresSetKey) {
+    FixedROT13Cipher cipher;
+    cipher.setKey("5");
+    EXPECT_EQ(cipher.encrypt("Hello"), "Uryyb");
+}
+
+TEST(FixedSubstitutionCipher, MatchesSubstitutionCipher) {
+    std::string text = TestData::bytes(1000, 29) + TestData::text(1000, 70, 29);
+    QwertySubstitutionCipher fixed;
+    SubstitutionCipher substitution;
+    substitution.setKey("QWERTYUIOPASDFGHJKLZXCVBNM");
+    std::string ciphertext = fixed.encrypt(text);
+    EXPECT_EQ(ciphertext, substitution.encrypt(text));
+    EXPECT_EQ(fixed.decrypt(ciphertext), text);
+    EXPECT_EQ(fixed.encrypt("Hello"), "Itssg");
+    EXPECT_STREQ(fixed.getName(), "substitution-qwerty");
+}
+
+} // namespace
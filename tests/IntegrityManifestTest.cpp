@@ -0,0 +1,159 @@
+#include "AeadCipher.h"
+#include "CipherExecutor.h"
+#include "IntegrityManifest.h"
+#include "MorseCodeCipher.h"
+#include "TestData.h"
+#include "VigenereCipher.h"
+#include <gtest/gtest.h>
+#include <cctype>
+#include <cstdio>
+#include <future>
+
+namespace {
+
+std::string pattern(size_t size) {
+    std::string data(size, '\0');
+    for (size_t i = 0; i < size; ++i) data[i] = static_cast<char>((i * 7 + 3) & 0xff);
+    return data;
+}
+
+TEST(Checksum, Crc32cKnownAnswers) {
+    // RFC 3720 appendix B.4
+    std::string ascending(32, '\0');
+    for (int i = 0; i < 32; ++i) ascending[i] = static_cast<char>(i);
+    EXPECT_EQ(Checksum::crc32c("123456789", 9), 0xE3069283u);
+    EXPECT_EQ(Checksum::crc32c(std::string(32, '\0').data(), 32), 0x8A9136AAu);
+    EXPECT_EQ(Checksum::crc32c(std::string(32, '\xff').data(), 32), 0x62A8AB43u);
+    EXPECT_EQ(Checksum::crc32c(ascending.data(), 32), 0x46DD794Eu);
+    EXPECT_EQ(Checksum::crc32c("", 0), 0u);
+}
+
+TEST(Checksum, Xxh3KnownAnswers) {
+    // Reference values from the xxHash library, one per input-length branch
+    const struct {
+        size_t size;
+        uint64_t hash;
+    } vectors[] = {{0, 0x2d06800538d394c2ull},    {1, 0x13e608bc156defedull},    {3, 0xa9088dda485b481cull},
+                   {4, 0x6d9253b16c8b1ed3ull},    {8, 0x60539db630471163ull},    {9, 0xfeff668361d723a8ull},
+                   {16, 0xb8c859b0f030b585ull},   {17, 0x714a04408e79b80full},   {128, 0x67425a03650261bfull},
+                   {129, 0xc664bf3311c6abc4ull},  {240, 0x64556dc6b462a6cfull},  {241, 0x8beadd3a8874fe17ull},
+                   {1000, 0x6c4f14bd97bd9e82ull}, {5000, 0x799aaddd7339581dull}};
+    for (const auto& vector : vectors) {
+        std::string data = pattern(vector.size);
+        EXPECT_EQ(Checksum::xxh3(data.data(), data.size()), vector.hash) << vector.size;
+        EXPECT_EQ(Checksum::xxh3Scalar(data.data(), data.size()), vector.hash) << vector.size;
+    }
+}
+
+TEST(Checksum, VectorPathsMatchScalar) {
+    std::string data = TestData::bytes(3000, 167);
+    for (size_t size = 0; size <= data.size(); size += size < 300 ? 1 : 97) {
+        ASSERT_EQ(Checksum::crc32c(data.data(), size), Checksum::crc32cScalar(data.data(), size)) << size;
+        ASSERT_EQ(Checksum::xxh3(data.data(), size), Checksum::xxh3Scalar(data.data(), size)) << size;
+    }
+}
+
+class IntegrityManifestTest : public testing::Test {
+protected:
+    std::string input = TestData::tempPath("manifest_input");
+    std::string encrypted = TestData::tempPath("manifest_encrypted");
+    std::string decrypted = TestData::tempPath("manifest_decrypted");
+
+    void SetUp() override { testing::internal::CaptureStderr(); }
+
+    void TearDown() override {
+        testing::internal::GetCapturedStderr();
+        for (const std::string& path : {input, encrypted, decrypted, IntegrityManifest::pathFor(encrypted)}) {
+            std::remove(path.c_str());
+        }
+    }
+};
+
+TEST_F(IntegrityManifestTest, CatchesWrongKeyAndDamage) {
+    std::string plaintext = TestData::text(3 << 20, 70, 173);
+    TestData::writeFile(input, plaintext);
+    VigenereCipher cipher;
+    cipher.setKey("LEMON");
+    for (Digest digest : {Digest::CRC32C, Digest::XXH3}) {
+        ASSERT_TRUE(cipher.processFile(input, encrypted, true, digest));
+        ASSERT_TRUE(TestData::exists(IntegrityManifest::pathFor(encrypted)));
+        ASSERT_TRUE(cipher.processFile(encrypted, decrypted, false));
+        EXPECT_EQ(TestData::readFile(decrypted), plaintext);
+
+        IntegrityManifest::Report report = IntegrityManifest::verify(cipher, encrypted, 2);
+        EXPECT_TRUE(report.ok);
+        EXPECT_EQ(report.chunks, 3u);
+        EXPECT_EQ(report.badChunks, 0u);
+    }
+
+    std::remove(decrypted.c_str());
+    VigenereCipher wrongKey;
+    wrongKey.setKey("LIME");
+    EXPECT_FALSE(wrongKey.processFile(encrypted, decrypted, false));
+    EXPECT_FALSE(TestData::exists(decrypted));
+
+    // Damage one letter in the second chunk
+    std::string ciphertext = TestData::readFile(encrypted);
+    size_t offset = (1 << 20) + 100;
+    while (!isalpha(static_cast<unsigned char>(ciphertext[offset]))) ++offset;
+    ciphertext[offset] = ciphertext[offset] == 'a' ? 'b' : 'a';
+    TestData::writeFile(encrypted, ciphertext);
+    IntegrityManifest::Report report = IntegrityManifest::verify(cipher, encrypted, 2);
+    EXPECT_FALSE(report.ok);
+    EXPECT_EQ(report.badChunks, 1u);
+    EXPECT_EQ(report.firstBadOffset, 1u << 20);
+    EXPECT_FALSE(cipher.processFile(encrypted, decrypted, false));
+}
+
+TEST_F(IntegrityManifestTest, LossyAndAuthenticatedCiphersSkipIt) {
+    std::string plaintext = "Meet me at the bridge, at noon.\nBring 2 maps!";
+    TestData::writeFile(input, plaintext);
+
+    MorseCodeCipher morse;
+    MorseCodeCipher binary(MorseFormat::BINARY);
+    AeadCipher aead;
+    aead.setKey(AeadCipher::generateKey());
+    CipherAlgorithm* ciphers[] = {&morse, &binary, &aead};
+    for (CipherAlgorithm* cipher : ciphers) {
+        EXPECT_FALSE(IntegrityManifest::appliesTo(*cipher)) << cipher->getName();
+        ASSERT_TRUE(cipher->processFile(input, encrypted, true)) << cipher->getName();
+        EXPECT_FALSE(TestData::exists(IntegrityManifest::pathFor(encrypted))) << cipher->getName();
+        ASSERT_TRUE(cipher->processFile(encrypted, decrypted, false)) << cipher->getName();
+        std::string expected = cipher == &aead ? plaintext : morse.decrypt(morse.encrypt(plaintext));
+        EXPECT_EQ(TestData::readFile(decrypted), expected) << cipher->getName();
+        EXPECT_FALSE(IntegrityManifest::verify(*cipher, encrypted).ok);
+
+        // The executor follows the same rule
+        CipherExecutor executor;
+        std::promise<bool> encryptedDone, decryptedDone;
+        executor.submitFile(*cipher, input, encrypted, true, [&](bool ok) { encryptedDone.set_value(ok); });
+        ASSERT_TRUE(encryptedDone.get_future().get());
+        EXPECT_FALSE(TestData::exists(IntegrityManifest::pathFor(encrypted)));
+        executor.submitFile(*cipher, encrypted, decrypted, false, [&](bool ok) { decryptedDone.set_value(ok); });
+        ASSERT_TRUE(decryptedDone.get_future().get());
+        EXPECT_EQ(TestData::readFile(decrypted), expected) << cipher->getName();
+    }
+    VigenereCipher vigenere;
+    EXPECT_TRUE(IntegrityManifest::appliesTo(vigenere));
+}
+
+// Without a manifest, a tampered or wrongly keyed AEAD file must still fail to decrypt
+TEST_F(IntegrityManifestTest, AuthenticatedCiphersFailWithoutIt) {
+    TestData::writeFile(input, TestData::prose(5000));
+    AeadCipher aead;
+    aead.setKey(AeadCipher::generateKey());
+    ASSERT_TRUE(aead.processFile(input, encrypted, true));
+
+    AeadCipher wrongKey;
+    wrongKey.setKey(AeadCipher::generateKey());
+    EXPECT_FALSE(wrongKey.processFile(encrypted, decrypted, false));
+    EXPECT_FALSE(TestData::exists(decrypted));
+
+    std::string ciphertext = TestData::readFile(encrypted);
+    ciphertext[ciphertext.size() / 2] ^= 0x40;
+    TestData::writeFile(encrypted, ciphertext);
+    EXPECT_FALSE(aead.processFile(encrypted, decrypted, false));
+    EXPECT_FALSE(TestData::exists(decrypted));
+}
+
+} // namespace
@@ -0,0 +1,128 @@
+#include "KeyDerivation.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string hex(const uint8_t* bytes, size_t size) {
+    static const char digits[] = "0123456789abcdef";
+    std::string text;
+    for (size_t i = 0; i < size; ++i) {
+        text += digits[bytes[i] >> 4];
+        text += digits[bytes[i] & 15];
+    }
+    return text;
+}
+
+std::string blake2b(const std::string& data, size_t outSize) {
+    std::vector<uint8_t> digest(outSize);
+    KeyDerivation::blake2b(data.data(), data.size(), digest.data(), outSize);
+    return hex(digest.data(), outSize);
+}
+
+std::string argon2id(const std::string& password, const std::string& salt, uint32_t passes, uint32_t memoryKiB,
+                     uint32_t lanes, size_t outSize, unsigned threads = 0) {
+    KeyDerivation::Params params;
+    params.passes = passes;
+    params.memoryKiB = memoryKiB;
+    params.lanes = lanes;
+    std::vector<uint8_t> tag(outSize);
+    EXPECT_TRUE(KeyDerivation::argon2id(password, reinterpret_cast<const uint8_t*>(salt.data()), salt.size(), params,
+                                        tag.data(), outSize, threads));
+    return hex(tag.data(), outSize);
+}
+
+TEST(KeyDerivation, Blake2bKnownAnswers) {
+    // RFC 7693 appendix A
+    EXPECT_EQ(blake2b("abc", 64), "ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdbffa2d1"
+                                  "7d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab92386edd4009923");
+    // Reference values from Python's hashlib, around the 128-byte block boundary
+    const struct {
+        size_t size;
+        const char* digest64;
+        const char* digest20;
+    } vectors[] = {
+        {0, "786a02f742015903c6c6fd852552d272912f4740e15847618a86e217f71f5419d25e1031afee585313896444934eb04b903a685b1448b755d56f701afe9be2ce",
+         "3345524abf6bbe1809449224b5972c41790b6cf2"},
+        {127, "930f453c4bb76e32b7f12a474d562055b31406fc5470efcc3cce21d75b2b44954b2d2fdab2b03c09b83a95a6d6dcf608564501cab69fffc2c505a0486cff1dc3",
+         "f7c9484af5bad55d0978cf13aef8995303126758"},
+        {128, "cbd4ce342f3806d816b58fd5e5bba5e530083670bbac7d87b62c83819ddccaf41a5855fd4f5d77d215f413278d61c8365d1ec2aa617c0ebb3980b97833db36ab",
+         "07e39a14b3b83e028eba7e9a99e0b7f06eabdeaa"},
+        {129, "d3c0f4d636fdb51ba3ca2961a1d166f8f9f87052ae08e8f978d1c3cb2f244e7ba8b4a46f08727d5b5df98c10cf176d55833bcef00685596513f579ab3f9e879a",
+         "b5edb1b421445876ea51b09c3b5f88cb67df48ff"},
+        {256, "3986ff4540021098da0a1854179f2105b9824e02e5af9ea4bd265f18ecb5c16211cc54090a0e5c0150f3ff2f7b1acb4e63a115d03edb5625da59f29bb776a1d9",
+         "867d54f548953b4b5e8c867f7b3fc39e1b147c1f"},
+        {1000, "dc19ee71657d34442b5b3f6e0cfa9217a65f6d55a094c3f9fdd0b2e2dff96efb66a848e03057c0647d2147e7af2efff1a1dc8bca796478cf91a723a5bff6de1b",
+         "df297c49de58cc66b6d5fdf8537583543979b626"},
+    };
+    for (const auto& vector : vectors) {
+        std::string data(vector.size, '\0');
+        for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<char>((i * 13 + 5) & 0xff);
+        EXPECT_EQ(blake2b(data, 64), vector.digest64) << vector.size;
+        EXPECT_EQ(blake2b(data, 20), vector.digest20) << vector.size;
+    }
+}
+
+TEST(KeyDerivation, Argon2idRfc9106) {
+    // RFC 9106 section 5.3, with one thread and with one per lane
+    std::string password(32, '\x01');
+    uint8_t salt[16], secret[8], associated[12], tag[32];
+    std::memset(salt, 0x02, sizeof(salt));
+    std::memset(secret, 0x03, sizeof(secret));
+    std::memset(associated, 0x04, sizeof(associated));
+    KeyDerivation::Params params;
+    params.memoryKiB = 32;
+    params.passes = 3;
+    params.lanes = 4;
+    for (unsigned threads : {1u, 4u}) {
+        ASSERT_TRUE(KeyDerivation::argon2id(password, salt, sizeof(salt), secret, sizeof(secret), associated,
+                                            sizeof(associated), params, tag, sizeof(tag), threads));
+        EXPECT_EQ(hex(tag, sizeof(tag)), "0d640df58d78766c08c037a34a8b53c9d01ef0452d75b65eb52520e96b01e659");
+    }
+    EXPECT_TRUE(KeyDerivation::selfTest());
+}
+
+TEST(KeyDerivation, Argon2idReferenceVectors) {
+    // From the reference implementation (argon2-cffi), without a secret or associated data
+    EXPECT_EQ(argon2id(std::string(32, '\x01'), std::string(16, '\x02'), 3, 32, 4, 32),
+              "03aab965c12001c9d7d0d2de33192c0494b684bb148196d73c1df1acaf6d0c2e");
+    EXPECT_EQ(argon2id("password", "somesalt", 2, 64, 1, 32),
+              "16a1a498734609dd01456da406de9f3d9da93e6c86c300a12fc1465214ce4922");
+    EXPECT_EQ(argon2id("password", "somesalt", 1, 256, 2, 32, 2),
+              "aa2e5f335ebd402999366293609997e1ca8d268c2e45414ae35458571ea76eb8");
+    EXPECT_EQ(argon2id("", "saltsaltsaltsalt", 3, 32, 4, 16), "9d74ff4926aae47d82bad6d60357f57a");
+    EXPECT_EQ(argon2id("correct horse", std::string(16, '\0'), 2, 128, 3, 64),
+              "d295bf6d9ad58a545e365abc404a0cdb60044af37d79e150c3ac9358b136ea71"
+              "e2f263241983d92ce6ca95c5917aed80b9b299d941923f87fac7064ca4f21c97");
+    EXPECT_EQ(argon2id(std::string(200, 'x'), "sixteen byte slt", 1, 8, 1, 4), "89cfdeca");
+    // Tags over 64 bytes come from the variable-length hash
+    EXPECT_EQ(argon2id("password", "somesalt", 2, 64, 1, 100),
+              "7712f6cfaea89a90b11559e10e234f92f892db147d4c3b6e628a51836a20dcd07537028d562157088d11c966eced974"
+              "30f53e747196cd7d99ddfb21b159e05ae131bd627e4a4b3452d5800c3351986221ec89db7698fcf4f91a1f5f4b73ef5e"
+              "692c2fbc1");
+}
+
+TEST(KeyDerivation, RejectsOutOfRangeParameters) {
+    KeyDerivation::Params params;
+    params.memoryKiB = 31;
+    params.passes = 1;
+    params.lanes = 4;
+    EXPECT_FALSE(KeyDerivation::validParams(params));
+    params.memoryKiB = 32;
+    EXPECT_TRUE(KeyDerivation::validParams(params));
+    params.passes = 0;
+    EXPECT_FALSE(KeyDerivation::validParams(params));
+    params.passes = 1;
+    params.lanes = 0;
+    EXPECT_FALSE(KeyDerivation::validParams(params));
+
+    params.lanes = 1;
+    uint8_t salt[16] = {}, tag[32];
+    EXPECT_FALSE(KeyDerivation::argon2id("pw", salt, 7, params, tag, sizeof(tag)));  // Salt under 8 bytes
+    EXPECT_FALSE(KeyDerivation::argon2id("pw", salt, sizeof(salt), params, tag, 3));  // Tag under 4 bytes
+    EXPECT_TRUE(KeyDerivation::argon2id("pw", salt, sizeof(salt), params, tag, sizeof(tag)));
+}
+
+} // namespace
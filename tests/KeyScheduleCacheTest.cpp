@@ -0,0 +1,84 @@
+#include "CaesarCipher.h"
+#include "KeyScheduleCache.h"
+#include "MorseCodeCipher.h"
+#include "TestData.h"
+#include "VigenereCipher.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+TEST(KeyScheduleCache, CachedKeysEncryptLikeSetKey) {
+    KeyScheduleCache cache;
+    std::string text = TestData::text(2000, 75, 17);
+    VigenereCipher cached, direct;
+    for (const char* key : {"LEMON", "KEY", "LEMON", "ENCRYPTIONTOOL", "KEY"}) {
+        cached.setKeyCached(key, cache);
+        direct.setKey(key);
+        ASSERT_EQ(cached.encrypt(text), direct.encrypt(text)) << key;
+    }
+    EXPECT_EQ(cache.misses(), 3u);
+    EXPECT_EQ(cache.hits(), 2u);
+    EXPECT_EQ(cache.size(), 3u);
+}
+
+TEST(KeyScheduleCache, KeysAreScopedByAlgorithm) {
+    KeyScheduleCache cache;
+    CaesarCipher caesar;
+    VigenereCipher vigenere;
+    caesar.setKeyCached("7", cache);
+    testing::internal::CaptureStderr();
+    vigenere.setKeyCached("7", cache);  // No letters: falls back to Vigenère's default key
+    testing::internal::GetCapturedStderr();
+    EXPECT_EQ(cache.misses(), 2u);
+    EXPECT_EQ(caesar.encrypt("abc"), "hij");
+}
+
+TEST(KeyScheduleCache, RejectedKeyKeepsThePreviousOne) {
+    KeyScheduleCache cache;
+    MorseCodeCipher cipher;
+    cipher.setKeyCached("|", cache);
+    cipher.setKeyCached("", cache);  // Rejected (nullptr), and cached as such
+    cipher.setKeyCached("", cache);
+    EXPECT_EQ(cipher.encrypt("SOS"), "...|---|...");
+    EXPECT_EQ(cache.hits(), 1u);
+    EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST(KeyScheduleCache, EvictsLeastRecentlyUsed) {
+    KeyScheduleCache cache(2);
+    CaesarCipher cipher;
+    cipher.setKeyCached("1", cache);
+    cipher.setKeyCached("2", cache);
+    cipher.setKeyCached("1", cache);  // 2 is now the oldest
+    cipher.setKeyCached("3", cache);
+    EXPECT_EQ(cache.size(), 2u);
+    cipher.setKeyCached("1", cache);
+    EXPECT_EQ(cache.hits(), 2u);
+    cipher.setKeyCached("2", cache);
+    EXPECT_EQ(cache.misses(), 4u);
+}
+
+TEST(KeyScheduleCache, SharedAcrossThreads) {
+    KeyScheduleCache cache(8);
+    std::string text = TestData::text(500, 80, 19);
+    std::vector<std::thread> threads;
+    std::vector<int> failures(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            VigenereCipher cached, direct;
+            for (int i = 0; i < 200; ++i) {
+                std::string key = TestData::text(3 + i % 13, 100, static_cast<unsigned int>(i % 13));
+                cached.setKeyCached(key, cache);
+                direct.setKey(key);
+                if (cached.encrypt(text) != direct.encrypt(text)) ++failures[t];
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (int failed : failures) EXPECT_EQ(failed, 0);
+    EXPECT_LE(cache.size(), 8u);
+}
+
+} // namespace
@@ -0,0 +1,135 @@
+#include "CaesarCipher.h"
+#include "MessageBatch.h"
+#include "SubstitutionCipher.h"
+#include "TestData.h"
+#include "VigenereCipher.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+
+namespace {
+
+const MessageBatch::Cipher CIPHERS[] = {MessageBatch::Cipher::CAESAR, MessageBatch::Cipher::VIGENERE,
+                                        MessageBatch::Cipher::SUBSTITUTION};
+
+std::string randomKey(MessageBatch::Cipher cipher, std::mt19937& rng) {
+    bool invalid = rng() % 10 == 0;  // Falls back to the cipher's default key
+    switch (cipher) {
+    case MessageBatch::Cipher::CAESAR:
+        return invalid ? "three" : std::to_string(static_cast<int>(rng() % 61) - 30);
+    case MessageBatch::Cipher::VIGENERE: {
+        if (invalid) return "12 34";
+        std::string key(1 + rng() % 20, 'A');  // Both sides of the 16-character vector limit
+        for (char& c : key) c = static_cast<char>((rng() & 1 ? 'A' : 'a') + rng() % 26);
+        return key;
+    }
+    case MessageBatch::Cipher::SUBSTITUTION: {
+        if (invalid) return "ABC";
+        std::string key = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+        std::shuffle(key.begin(), key.end(), rng);
+        return key;
+    }
+    }
+    return "";
+}
+
+std::unique_ptr<CipherAlgorithm> cipherFor(MessageBatch::Cipher cipher) {
+    switch (cipher) {
+    case MessageBatch::Cipher::CAESAR:
+        return std::unique_ptr<CipherAlgorithm>(new CaesarCipher());
+    case MessageBatch::Cipher::VIGENERE:
+        return std::unique_ptr<CipherAlgorithm>(new VigenereCipher());
+    case MessageBatch::Cipher::SUBSTITUTION:
+        return std::unique_ptr<CipherAlgorithm>(new SubstitutionCipher());
+    }
+    return nullptr;
+}
+
+// count messages of up to maxSize bytes, mostly text with some raw bytes
+MessageBatch randomBatch(MessageBatch::Cipher cipher, size_t count, size_t maxSize, unsigned seed,
+                         std::vector<std::string>& keys) {
+    std::mt19937 rng(seed);
+    MessageBatch batch;
+    keys.clear();
+    for (size_t i = 0; i < count; ++i) {
+        size_t size = rng() % (maxSize + 1);
+        std::string message = rng() % 8 ? TestData::text(size, 75, rng()) : TestData::bytes(size, rng());
+        keys.push_back(randomKey(cipher, rng));
+        batch.add(message, keys.back());
+    }
+    return batch;
+}
+
+TEST(MessageBatch, VectorPathMatchesScalar) {
+    // Group sizes around the 32-lane groups and the 8-message minimum, lengths past 256
+    std::vector<std::string> keys;
+    for (MessageBatch::Cipher cipher : CIPHERS) {
+        for (size_t count : {0, 1, 7, 8, 31, 32, 33, 100, 257}) {
+            for (size_t maxSize : {0, 5, 40, 300}) {
+                unsigned seed = static_cast<unsigned>(count * 1000 + maxSize);
+                MessageBatch batch = randomBatch(cipher, count, maxSize, seed, keys);
+                for (bool isEncryption : {true, false}) {
+                    std::string vector, scalar;
+                    batch.process(cipher, isEncryption, vector);
+                    batch.processScalar(cipher, isEncryption, scalar);
+                    ASSERT_EQ(vector.size(), batch.text().size());
+                    ASSERT_EQ(vector, scalar) << MessageBatch::name(cipher) << " count " << count << " max "
+                                              << maxSize << (isEncryption ? " encrypt" : " decrypt");
+                }
+            }
+        }
+    }
+}
+
+TEST(MessageBatch, MatchesTheCipherClassesAndRoundTrips) {
+    std::vector<std::string> keys;
+    for (MessageBatch::Cipher cipher : CIPHERS) {
+        MessageBatch batch = randomBatch(cipher, 200, 120, 197, keys);
+        std::string ciphertext;
+        batch.process(cipher, true, ciphertext);
+
+        const std::vector<size_t>& offsets = batch.messageOffsets();
+        ASSERT_EQ(offsets.size(), batch.size() + 1);
+        MessageBatch reverse;
+        testing::internal::CaptureStderr();  // Invalid keys are reported by the classes only
+        for (size_t i = 0; i < batch.size(); ++i) {
+            std::string message = batch.text().substr(offsets[i], offsets[i + 1] - offsets[i]);
+            std::string expected = ciphertext.substr(offsets[i], offsets[i + 1] - offsets[i]);
+            std::unique_ptr<CipherAlgorithm> single = cipherFor(cipher);
+            single->setKey(keys[i]);
+            ASSERT_EQ(single->encrypt(message), expected) << MessageBatch::name(cipher) << " key " << keys[i];
+            reverse.add(expected, keys[i]);
+        }
+        testing::internal::GetCapturedStderr();
+
+        std::string plaintext;
+        reverse.process(cipher, false, plaintext);
+        EXPECT_EQ(plaintext, batch.text()) << MessageBatch::name(cipher);
+    }
+}
+
+TEST(MessageBatch, NamesAndClear) {
+    for (MessageBatch::Cipher cipher : CIPHERS) {
+        MessageBatch::Cipher parsed = MessageBatch::Cipher::CAESAR;
+        ASSERT_TRUE(MessageBatch::parse(MessageBatch::name(cipher), parsed));
+        EXPECT_EQ(parsed, cipher);
+    }
+    MessageBatch::Cipher parsed;
+    EXPECT_FALSE(MessageBatch::parse("morse", parsed));
+
+    MessageBatch batch;
+    batch.add("Attack at dawn", "LEMON");
+    batch.add("", "LEMON");
+    EXPECT_EQ(batch.size(), 2u);
+    std::string output;
+    batch.process(MessageBatch::Cipher::VIGENERE, true, output);
+    EXPECT_EQ(output, "Lxfopv ef rnhr");
+    batch.clear();
+    EXPECT_EQ(batch.size(), 0u);
+    EXPECT_TRUE(batch.text().empty());
+    batch.process(MessageBatch::Cipher::VIGENERE, true, output);
+    EXPECT_TRUE(output.empty());
+}
+
+} // namespace
@@ -0,0 +1,89 @@
+#include "CaesarCipher.h"
+#include "Metrics.h"
+#include "TestData.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+
+namespace {
+
+TEST(LatencyHistogram, BucketsAreContiguousAndBounded) {
+    typedef Metrics::LatencyHistogram Histogram;
+    const int bucketCount = Histogram::BUCKET_COUNT;  // gtest binds by reference; no ODR use
+    for (uint64_t value : {0ull, 1ull, 31ull, 32ull, 33ull, 1000ull, 123456789ull, ~0ull}) {
+        int bucket = Histogram::bucketFor(value);
+        ASSERT_GE(bucket, 0);
+        ASSERT_LT(bucket, bucketCount);
+        EXPECT_LE(value, Histogram::bucketUpperBound(bucket));
+        if (bucket > 0) {
+            EXPECT_GT(value, Histogram::bucketUpperBound(bucket - 1));
+        }
+    }
+    for (int bucket = 1; bucket < bucketCount; ++bucket) {
+        ASSERT_EQ(Histogram::bucketFor(Histogram::bucketUpperBound(bucket - 1) + 1), bucket);
+    }
+    // ~6% relative error above the exact range
+    uint64_t bound = Histogram::bucketUpperBound(Histogram::bucketFor(1000000));
+    EXPECT_LT(bound, 1000000 * 1.07);
+}
+
+TEST(LatencyHistogram, Percentiles) {
+    Metrics::LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(0.5), 0u);
+    for (uint64_t i = 0; i < 100; ++i) histogram.record(i < 90 ? 10 : 5000);
+    EXPECT_EQ(histogram.count(), 100u);
+    EXPECT_EQ(histogram.sum(), 90u * 10 + 10u * 5000);
+    EXPECT_EQ(histogram.percentile(0.5), 10u);
+    EXPECT_GE(histogram.percentile(0.99), 5000u);
+    histogram.clear();
+    EXPECT_EQ(histogram.count(), 0u);
+}
+
+#if ET_ENABLE_METRICS
+TEST(Metrics, CountsCallsAndBytesOnlyWhenEnabled) {
+    Metrics::reset();
+    CaesarCipher cipher;
+    cipher.encrypt("not counted");
+
+    Metrics::setEnabled(true);
+    cipher.encrypt(std::string(1000, 'a'));
+    cipher.encrypt(std::string(24, 'b'));
+    Metrics::setEnabled(false);
+
+    Metrics::Series* series = Metrics::series(Metrics::ENCRYPT, "caesar");
+    ASSERT_NE(series, nullptr);
+    EXPECT_EQ(series->calls.load(), 2u);
+    EXPECT_EQ(series->bytes.load(), 1024u);
+    EXPECT_EQ(series->latency.count(), 2u);
+}
+
+TEST(Metrics, WritesPrometheusText) {
+    Metrics::reset();
+    Metrics::setEnabled(true);
+    CaesarCipher().decrypt("abc");
+    Metrics::setEnabled(false);
+
+    std::string path = TestData::tempPath("metrics.prom");
+    ASSERT_TRUE(Metrics::writePrometheus(path));
+    std::string text = TestData::readFile(path);
+    std::remove(path.c_str());
+    EXPECT_NE(text.find("# TYPE et_operation_calls_total counter"), std::string::npos);
+    EXPECT_NE(text.find("et_operation_calls_total{operation=\"decrypt\",algorithm=\"caesar\"} 1"), std::string::npos);
+    EXPECT_NE(text.find("le=\"+Inf\""), std::string::npos);
+}
+
+TEST(Metrics, WritesChromeTrace) {
+    Metrics::reset();
+    Metrics::setTracing(true);
+    CaesarCipher().encrypt("traced");
+    Metrics::setEnabled(false);
+
+    std::string path = TestData::tempPath("trace.json");
+    ASSERT_TRUE(Metrics::writeChromeTrace(path));
+    std::string text = TestData::readFile(path);
+    std::remove(path.c_str());
+    EXPECT_NE(text.find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(text.find("caesar"), std::string::npos);
+}
+#endif
+
+} // namespace
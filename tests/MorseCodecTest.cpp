@@ -0,0 +1,113 @@
+#include "MorseCodeCipher.h"
+#include "MorseCodec.h"
+#include "TestData.h"
+#include <gtest/gtest.h>
+#include <cctype>
+#include <random>
+
+namespace {
+
+std::string encodeText(const std::string& text, const std::string& separator = " ") {
+    std::string morse;
+    MorseCodec::encodeText(text.data(), text.size(), separator, morse);
+    return morse;
+}
+
+std::string decodeText(const std::string& morse) {
+    std::string text;
+    MorseCodec::decodeText(morse.data(), morse.size(), text);
+    return text;
+}
+
+std::string encodeBinary(const std::string& text) {
+    std::string packed;
+    MorseCodec::encodeBinary(text.data(), text.size(), packed);
+    return packed;
+}
+
+// What a lossless round trip gives: letters upper-cased, anything without a code dropped
+std::string canonical(const std::string& text) {
+    std::string result;
+    for (char c : text) {
+        if (isalnum(static_cast<unsigned char>(c)) || c == ' ') result += static_cast<char>(toupper(c));
+    }
+    return result;
+}
+
+TEST(MorseCodec, TextKnownAnswers) {
+    EXPECT_EQ(encodeText("SOS"), "... --- ...");
+    EXPECT_EQ(encodeText("Hi 5"), ".... .. / .....");
+    EXPECT_EQ(encodeText("Hi 5", "|"), "....|..|/|.....");
+    EXPECT_EQ(encodeText("a  b"), ".- / / -...");
+    EXPECT_EQ(encodeText("0 9"), "----- / ----.");
+    EXPECT_EQ(encodeText("\xc3\xa9!x"), "\xc3\xa9 -..-");  // é passes through, ! has no code
+    EXPECT_EQ(encodeText(""), "");
+
+    EXPECT_EQ(decodeText("... --- ..."), "SOS");
+    EXPECT_EQ(decodeText(" .-  -... //  -.-.   x ......"), "AB  C");  // Unknown tokens are dropped
+    EXPECT_EQ(decodeText("...|---"), "");                              // | is not a split point
+}
+
+TEST(MorseCodec, BinaryKnownAnswers) {
+    // S: length 3 (bits 1 1 0), dot dot dot (0 0 0); O: 1 1 0, dash dash dash (1 1 1); end: 1 1 1
+    EXPECT_EQ(encodeBinary("SOS"), "\xc3\x3e\x1c");
+    EXPECT_EQ(encodeBinary("sos"), "\xc3\x3e\x1c");
+    // E: length 1 (1 0 0), dot (0), end (1 1 1)
+    EXPECT_EQ(encodeBinary("E"), "\x71");
+    EXPECT_EQ(encodeBinary("!?"), "");
+
+    std::string text;
+    ASSERT_TRUE(MorseCodec::decodeBinary("\xc3\x3e\x1c", 3, text));
+    EXPECT_EQ(text, "SOS");
+    EXPECT_FALSE(MorseCodec::decodeBinary("\xc3\x3e", 2, text));  // No end marker
+}
+
+TEST(MorseCodec, RoundTripsBothFormats) {
+    std::string text = TestData::text(20000, 70, 191) + " \xc3\xa9t\xc3\xa9 \xe2\x82\xac 5";
+    std::string expected = canonical(TestData::text(20000, 70, 191)) + " \xc3\xa9T\xc3\xa9 \xe2\x82\xac 5";
+    EXPECT_EQ(decodeText(encodeText(text)), expected);
+    EXPECT_EQ(decodeText(encodeText(text, "  ")), expected);  // Empty tokens are skipped
+
+    std::string decoded;
+    std::string packed = encodeBinary(text);
+    ASSERT_TRUE(MorseCodec::decodeBinary(packed.data(), packed.size(), decoded));
+    EXPECT_EQ(decoded, expected);
+    EXPECT_LT(packed.size(), text.size());
+
+    // Every truncation of the stream is rejected rather than misread
+    std::string sample = encodeBinary("Morse 123 \xc3\xa9");
+    for (size_t size = 1; size < sample.size(); ++size) {
+        ASSERT_FALSE(MorseCodec::decodeBinary(sample.data(), size, decoded)) << size;
+    }
+}
+
+TEST(MorseCodec, VectorDecoderMatchesScalar) {
+    // Valid codes, noise tokens, runs of separators and UTF-8, at every size up to a few vector widths
+    static const char* const pieces[] = {".", "-", ".-", "-...", "....-", "------", " ", " ", "/", "  ",
+                                         "x", "\xc3\xa9", "\xe2\x82", "-.-.--", "...", "--", "//"};
+    std::mt19937 rng(193);
+    std::string morse;
+    while (morse.size() < 5000) morse += pieces[rng() % (sizeof(pieces) / sizeof(pieces[0]))];
+    for (size_t size = 0; size <= morse.size(); size += size < 300 ? 1 : 61) {
+        std::string vector, scalar;
+        MorseCodec::decodeText(morse.data(), size, vector);
+        MorseCodec::decodeTextScalar(morse.data(), size, scalar);
+        ASSERT_EQ(vector, scalar) << "size " << size;
+    }
+}
+
+TEST(MorseCodeCipher, KeyIsTheSeparator) {
+    MorseCodeCipher text;
+    text.setKey("|");
+    EXPECT_EQ(text.encrypt("SOS"), "...|---|...");
+    text.setKey(" ");
+    EXPECT_EQ(text.decrypt(text.encrypt("Hello World 42")), "HELLO WORLD 42");
+    EXPECT_FALSE(text.isLossless());
+
+    MorseCodeCipher binary(MorseFormat::BINARY);
+    EXPECT_STREQ(binary.getName(), "morse-binary");
+    EXPECT_EQ(binary.encrypt("SOS"), "\xc3\x3e\x1c");
+    EXPECT_EQ(binary.decrypt(binary.encrypt("Hello World 42")), "HELLO WORLD 42");
+}
+
+} // namespace
@@ -0,0 +1,125 @@
+#include "NameIndex.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+int editDistance(const std::string& a, const std::string& b) {
+    std::vector<int> row(b.size() + 1);
+    for (size_t j = 0; j <= b.size(); ++j) row[j] = static_cast<int>(j);
+    for (size_t i = 1; i <= a.size(); ++i) {
+        int diagonal = row[0];
+        row[0] = static_cast<int>(i);
+        for (size_t j = 1; j <= b.size(); ++j) {
+            int above = row[j];
+            row[j] = std::min({row[j] + 1, row[j - 1] + 1, diagonal + (a[i - 1] != b[j - 1])});
+            diagonal = above;
+        }
+    }
+    return row[b.size()];
+}
+
+// Ids and distances sorted by id, for comparing with a reference regardless of order
+std::map<uint32_t, int> byId(const std::vector<NameIndex::Match>& matches) {
+    std::map<uint32_t, int> result;
+    for (const NameIndex::Match& match : matches) result[match.id] = match.distance;
+    return result;
+}
+
+std::vector<std::string> randomNames(size_t count, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::vector<std::string> names;
+    for (size_t i = 0; i < count; ++i) {
+        std::string name(rng() % 9, ' ');
+        for (char& c : name) c = "abcde"[rng() % 5];  // A small alphabet, so names share prefixes
+        names.push_back(name);
+    }
+    return names;
+}
+
+TEST(NameIndex, PrefixMatchesInNameOrder) {
+    NameIndex index;
+    const std::vector<std::string> names = {"mail", "bank", "mailbox", "ma", "bankers", "zoo", "mail"};
+    for (size_t i = 0; i < names.size(); ++i) index.insert(names[i], static_cast<uint32_t>(i));
+    EXPECT_EQ(index.prefixMatches("ma", 10), (std::vector<uint32_t>{3, 6, 0, 2}));
+    EXPECT_EQ(index.prefixMatches("bank", 10), (std::vector<uint32_t>{1, 4}));
+    EXPECT_EQ(index.prefixMatches("", 3).size(), 3u);
+    EXPECT_TRUE(index.prefixMatches("x", 10).empty());
+}
+
+TEST(NameIndex, FuzzyMatchesAgreeWithEditDistance) {
+    std::vector<std::string> names = randomNames(400, 113);
+    NameIndex index;
+    for (size_t i = 0; i < names.size(); ++i) index.insert(names[i], static_cast<uint32_t>(i));
+
+    for (const std::string& query : randomNames(60, 127)) {
+        for (int maxDistance = 0; maxDistance <= 3; ++maxDistance) {
+            std::map<uint32_t, int> expected;
+            for (size_t i = 0; i < names.size(); ++i) {
+                int distance = editDistance(names[i], query);
+                if (distance <= maxDistance) expected[static_cast<uint32_t>(i)] = distance;
+            }
+            std::vector<NameIndex::Match> matches = index.fuzzyMatches(query, maxDistance, names.size());
+            ASSERT_EQ(byId(matches), expected) << "query '" << query << "' within " << maxDistance;
+            ASSERT_TRUE(std::is_sorted(matches.begin(), matches.end(),
+                                       [](const NameIndex::Match& a, const NameIndex::Match& b) {
+                                           return a.distance < b.distance;
+                                       }));
+        }
+    }
+}
+
+TEST(NameIndex, EmptyQueryAndEmptyName) {
+    NameIndex index;
+    index.insert("", 0);
+    index.insert("a", 1);
+    index.insert("ab", 2);
+    index.insert("abc", 3);
+    EXPECT_EQ(byId(index.fuzzyMatches("", 0, 10)), (std::map<uint32_t, int>{{0, 0}}));
+    EXPECT_EQ(byId(index.fuzzyMatches("", 2, 10)), (std::map<uint32_t, int>{{0, 0}, {1, 1}, {2, 2}}));
+    EXPECT_EQ(byId(index.fuzzyMatches("x", 1, 10)), (std::map<uint32_t, int>{{0, 1}, {1, 1}}));
+    EXPECT_EQ(byId(index.fuzzyMatches("ab", 1, 10)), (std::map<uint32_t, int>{{1, 1}, {2, 0}, {3, 1}}));
+    EXPECT_EQ(index.fuzzyMatches("", 3, 2).size(), 2u);
+    EXPECT_TRUE(index.fuzzyMatches("", -1, 10).empty());
+}
+
+TEST(NameIndex, LongestQueryFitsOneWord) {
+    NameIndex index;
+    std::string name(64, 'q');
+    index.insert(name, 7);
+    std::string query = name;
+    query[10] = 'r';
+    std::vector<NameIndex::Match> matches = index.fuzzyMatches(query, 1, 10);
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(matches[0].distance, 1);
+    EXPECT_TRUE(index.fuzzyMatches(query + "q", 5, 10).empty());  // Longer than MAX_FUZZY_LENGTH
+}
+
+TEST(NameIndex, RemoveRecyclesAndRenumbers) {
+    NameIndex index;
+    index.insert("alpha", 0);
+    index.insert("alps", 1);
+    index.insert("beta", 2);
+    index.remove("alps", 1);
+    index.remove("alps", 1);     // Already gone
+    index.remove("missing", 0);  // Never there
+    EXPECT_EQ(index.prefixMatches("al", 10), (std::vector<uint32_t>{0}));
+    index.renumberAfterErase(1);
+    EXPECT_EQ(index.prefixMatches("beta", 10), (std::vector<uint32_t>{1}));
+
+    index.insert("temporary", 9);
+    index.remove("temporary", 9);
+    size_t memory = index.memoryUsage();
+    for (int round = 0; round < 100; ++round) {
+        index.insert("temporary", 9);
+        index.remove("temporary", 9);
+    }
+    EXPECT_EQ(index.memoryUsage(), memory);  // Freed nodes and postings are reused
+    index.clear();
+    EXPECT_TRUE(index.prefixMatches("", 10).empty());
+}
+
+} // namespace
@@ -0,0 +1,125 @@
+#include "SecureMemory.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// The first allocation may warn that memory cannot be locked in this environment
+class SecureMemoryTest : public testing::Test {
+protected:
+    void SetUp() override { testing::internal::CaptureStderr(); }
+    void TearDown() override { testing::internal::GetCapturedStderr(); }
+};
+
+bool allZero(const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        if (bytes[i] != 0) return false;
+    }
+    return true;
+}
+
+TEST_F(SecureMemoryTest, BlocksAreUsableDistinctAndAligned) {
+    for (size_t size : {size_t(1), size_t(31), size_t(32), size_t(33), size_t(4095), size_t(4096), size_t(65536),
+                        size_t(65537), size_t(300000)}) {
+        std::vector<void*> blocks;
+        std::set<void*> distinct;
+        for (int i = 0; i < 40; ++i) {
+            void* block = SecureMemory::allocate(size);
+            ASSERT_NE(block, nullptr);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % 16, 0u) << size;
+            std::memset(block, 0x5A, size);  // Faults if any byte is not writable
+            blocks.push_back(block);
+            distinct.insert(block);
+        }
+        EXPECT_EQ(distinct.size(), blocks.size()) << size;
+        for (void* block : blocks) SecureMemory::release(block, size);
+    }
+    SecureMemory::release(nullptr, 10);  // Like free(nullptr)
+}
+
+TEST_F(SecureMemoryTest, ReleaseZeroesTheBlock) {
+    // The thread cache hands the block just released back first
+    unsigned char* block = static_cast<unsigned char*>(SecureMemory::allocate(100));
+    std::memset(block, 0xAA, 100);
+    SecureMemory::release(block, 100);
+    unsigned char* again = static_cast<unsigned char*>(SecureMemory::allocate(100));
+    ASSERT_EQ(again, block);
+    EXPECT_TRUE(allZero(again, 100));
+    SecureMemory::release(again, 100);
+}
+
+TEST_F(SecureMemoryTest, WipeClearsBuffersAndStrings) {
+    char buffer[64];
+    std::memset(buffer, 'k', sizeof(buffer));
+    SecureMemory::wipe(buffer, sizeof(buffer));
+    EXPECT_TRUE(allZero(buffer, sizeof(buffer)));
+
+    std::string secret(100, 's');
+    secret.resize(10);  // Bytes past the size still hold the secret
+    const char* data = secret.data();
+    size_t capacity = secret.capacity();
+    SecureMemory::wipe(secret);
+    EXPECT_TRUE(secret.empty());
+    EXPECT_EQ(secret.data(), data);
+    EXPECT_TRUE(allZero(data, capacity));
+}
+
+TEST_F(SecureMemoryTest, StatsCoverThePool) {
+    void* large = SecureMemory::allocate(200000);
+    SecureMemory::Stats during = SecureMemory::stats();
+    EXPECT_GE(during.slabBytes, 200000u);
+    EXPECT_LE(during.lockedBytes, during.slabBytes);
+    SecureMemory::release(large, 200000);
+    EXPECT_LE(SecureMemory::stats().slabBytes, during.slabBytes - 200000);  // Own mappings are returned
+}
+
+TEST_F(SecureMemoryTest, ContainersAndSharedObjects) {
+    SecureVector<uint8_t> bytes(1000, 7);
+    bytes.resize(5000, 9);
+    EXPECT_EQ(bytes[999], 7);
+    EXPECT_EQ(bytes[4999], 9);
+
+    SecureString text;
+    text.reserve(SECURE_STRING_MINIMUM);
+    text = "correct horse battery staple";
+    EXPECT_EQ(SecureStringHash()(text), SecureStringHash()(SecureString("correct horse battery staple")));
+    EXPECT_NE(SecureStringHash()(text), SecureStringHash()(SecureString("correct horse battery stapler")));
+
+    struct Key {
+        uint8_t bytes[32];
+    };
+    std::shared_ptr<Key> key = makeSecureShared<Key>();
+    std::memset(key->bytes, 1, sizeof(key->bytes));
+    std::weak_ptr<Key> observer = key;
+    key.reset();
+    EXPECT_TRUE(observer.expired());
+}
+
+TEST_F(SecureMemoryTest, ThreadsAllocateAndReleaseConcurrently) {
+    // Blocks allocated on one thread and released on another move through the shared pool
+    std::vector<void*> handedOver(4 * 500);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t, &handedOver]() {
+            std::vector<void*> own;
+            for (int i = 0; i < 500; ++i) {
+                size_t size = 16u << (i % 8);
+                void* block = SecureMemory::allocate(size);
+                std::memset(block, t + 1, size);
+                own.push_back(block);
+                handedOver[t * 500 + i] = SecureMemory::allocate(48);
+            }
+            for (int i = 0; i < 500; ++i) SecureMemory::release(own[i], 16u << (i % 8));
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    std::set<void*> distinct(handedOver.begin(), handedOver.end());
+    EXPECT_EQ(distinct.size(), handedOver.size());
+    for (void* block : handedOver) SecureMemory::release(block, 48);
+}
+
+} // namespace
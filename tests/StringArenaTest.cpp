@@ -0,0 +1,157 @@
+#include "PasswordManager.h"
+#include "StringArena.h"
+#include "TestData.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+TEST(StringArena, AppendsAndReadsBack) {
+    StringArena arena;
+    StringArena::Ref empty = arena.append("");
+    StringArena::Ref hello = arena.append("hello");
+    StringArena::Ref binary = arena.append(std::string("a\0b\n", 4));
+    EXPECT_EQ(arena.get(empty), "");
+    EXPECT_EQ(arena.get(hello), "hello");
+    EXPECT_EQ(arena.get(binary), std::string("a\0b\n", 4));
+    EXPECT_TRUE(arena.equals(hello, "hello"));
+    EXPECT_FALSE(arena.equals(hello, "hell"));
+    EXPECT_FALSE(arena.equals(hello, "hellO"));
+    EXPECT_EQ(arena.bytes(), 9u);
+    EXPECT_TRUE(arena.canHold(1000));
+    EXPECT_FALSE(arena.canHold(UINT32_MAX));
+}
+
+TEST(StringArena, InternStoresEachValueOnce) {
+    StringArena arena;
+    std::vector<StringArena::Ref> refs;
+    // Enough distinct values to grow the intern table several times
+    for (int i = 0; i < 1000; ++i) refs.push_back(arena.intern("value-" + std::to_string(i)));
+    size_t bytes = arena.bytes();
+    for (int i = 0; i < 1000; ++i) {
+        StringArena::Ref again = arena.intern("value-" + std::to_string(i));
+        ASSERT_EQ(again.offset, refs[i].offset);
+        ASSERT_EQ(arena.get(again), "value-" + std::to_string(i));
+    }
+    EXPECT_EQ(arena.bytes(), bytes);
+    arena.append("value-0");  // Appending does not intern
+    EXPECT_EQ(arena.intern("value-0").offset, refs[0].offset);
+    EXPECT_EQ(arena.intern("").length, 0u);
+}
+
+TEST(StringArena, ClearAndSwap) {
+    StringArena a, b;
+    StringArena::Ref ref = a.intern("shared");
+    b.append("other");
+    a.swap(b);
+    EXPECT_EQ(b.get(ref), "shared");
+    EXPECT_EQ(b.intern("shared").offset, ref.offset);
+    EXPECT_EQ(a.bytes(), 5u);
+    b.clear();
+    EXPECT_EQ(b.bytes(), 0u);
+    EXPECT_EQ(b.get(b.intern("fresh")), "fresh");
+}
+
+TEST(StringArena, ClearZeroesTheContents) {
+    StringArena arena;
+    StringArena::Ref secret = arena.append("hunter2-secret-key");
+    const char* bytes = arena.data(secret);
+    arena.clear();  // Keeps the buffer, so the old bytes can still be looked at
+    EXPECT_EQ(std::string(bytes, secret.length), std::string(secret.length, '\0'));
+}
+
+class VaultArenaTest : public testing::Test {
+protected:
+    std::string path = TestData::tempPath("arena_vault.txt");
+
+    void TearDown() override { std::remove(path.c_str()); }
+
+    static std::string service(int i) { return "service-" + std::to_string(i); }
+};
+
+TEST_F(VaultArenaTest, EntriesSurviveDeletesCompactionAndReload) {
+    testing::internal::CaptureStdout();
+    testing::internal::CaptureStderr();
+    {
+        PasswordManager vault(path);
+        for (int i = 0; i < 200; ++i) {
+            vault.addPassword(service(i), "user" + std::to_string(i), "secret" + std::to_string(i), "caesar",
+                              i % 2 ? "3" : "7");
+        }
+        // Deleting three quarters compacts the arena at least once
+        for (int i = 0; i < 200; ++i) {
+            if (i % 4 != 0) vault.deletePassword(service(i));
+        }
+        EXPECT_EQ(vault.size(), 50u);
+    }
+    PasswordManager reloaded(path);
+    testing::internal::GetCapturedStdout();
+    testing::internal::GetCapturedStderr();
+
+    ASSERT_EQ(reloaded.size(), 50u);
+    for (int i = 0; i < 200; ++i) {
+        std::string password, algorithm, key;
+        bool found = reloaded.getPassword(service(i), password, algorithm, key);
+        ASSERT_EQ(found, i % 4 == 0) << service(i);
+        if (!found) continue;
+        EXPECT_EQ(password, "secret" + std::to_string(i));
+        EXPECT_EQ(algorithm, "caesar");
+        EXPECT_EQ(key, i % 2 ? "3" : "7");
+    }
+}
+
+TEST_F(VaultArenaTest, LoadKeepsGetlineSemantics) {
+    // The last line has no newline, and a trailing record of three lines is incomplete
+    TestData::writeFile(path, "mail\nalice\nc1\ncaesar\n3\nbank\nbob\nc2\nvigenere\nKEY\nshop\ncarol\nc3");
+    testing::internal::CaptureStdout();
+    testing::internal::CaptureStderr();
+    PasswordManager vault(path);
+    testing::internal::GetCapturedStdout();
+    testing::internal::GetCapturedStderr();
+    EXPECT_EQ(vault.size(), 2u);
+    std::string password, algorithm, key;
+    ASSERT_TRUE(vault.getPassword("bank", password, algorithm, key));
+    EXPECT_EQ(password, "c2");
+    EXPECT_EQ(algorithm, "vigenere");
+    EXPECT_EQ(key, "KEY");
+    EXPECT_FALSE(vault.getPassword("shop", password, algorithm, key));
+
+    TestData::writeFile(path, "mail\nalice\nc1\ncaesar\n3");
+    vault.loadFromFile(path);
+    ASSERT_TRUE(vault.getPassword("mail", password, algorithm, key));
+    EXPECT_EQ(key, "3");
+}
+
+TEST_F(VaultArenaTest, ProtectSealsKeysAndUnlocks) {
+    KeyDerivation::Params params;
+    params.memoryKiB = 64;
+    params.passes = 1;
+    params.lanes = 2;
+    testing::internal::CaptureStdout();
+    testing::internal::CaptureStderr();
+    {
+        PasswordManager vault(path);
+        for (int i = 0; i < 20; ++i) {
+            vault.addPassword(service(i), "user", "secret", "vigenere", "PLAINKEY" + std::to_string(i));
+        }
+        ASSERT_TRUE(vault.protect("master", params));
+    }
+    EXPECT_EQ(TestData::readFile(path).find("PLAINKEY"), std::string::npos);
+
+    PasswordManager::lockSession();
+    PasswordManager reloaded(path);
+    std::string password, algorithm, key;
+    EXPECT_TRUE(reloaded.isProtected());
+    EXPECT_FALSE(reloaded.isUnlocked());
+    EXPECT_FALSE(reloaded.getPassword(service(3), password, algorithm, key));
+    EXPECT_FALSE(reloaded.unlock("wrong"));
+    ASSERT_TRUE(reloaded.unlock("master"));
+    testing::internal::GetCapturedStdout();
+    testing::internal::GetCapturedStderr();
+    ASSERT_TRUE(reloaded.getPassword(service(3), password, algorithm, key));
+    EXPECT_EQ(key, "PLAINKEY3");
+    PasswordManager::lockSession();
+}
+
+} // namespace
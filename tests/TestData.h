@@ -0,0 +1,84 @@
+#ifndef TESTDATA_H
+#define TESTDATA_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+#ifndef TEST_DATA_DIR
+#define TEST_DATA_DIR "bench"
+#endif
+
+namespace TestData {
+
+// Deterministic printable text where letterPercent of the bytes are mixed-case letters
+inline std::string text(size_t size, int letterPercent, unsigned int seed = 1) {
+    static const char others[] = "0123456789 .,;:!?-'\"()\n";
+    std::mt19937 rng(seed);
+    std::string result(size, ' ');
+    for (size_t i = 0; i < size; ++i) {
+        if (static_cast<int>(rng() % 100) < letterPercent) {
+            result[i] = static_cast<char>((rng() & 1 ? 'A' : 'a') + rng() % 26);
+        } else {
+            result[i] = others[rng() % (sizeof(others) - 1)];
+        }
+    }
+    return result;
+}
+
+inline std::string bytes(size_t size, unsigned int seed = 1) {
+    std::mt19937 rng(seed);
+    std::string result(size, '\0');
+    for (char& c : result) c = static_cast<char>(rng());
+    return result;
+}
+
+// English prose from the Vigenère corpus (bench/vigenere_corpus.txt), repeated to size
+inline std::string prose(size_t size) {
+    std::string corpus;
+    std::ifstream file(TEST_DATA_DIR "/vigenere_corpus.txt");
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t bar = line.find('|');
+        if (!line.empty() && line[0] != '#' && bar != std::string::npos) corpus += line.substr(bar + 1) + " ";
+    }
+    std::string result;
+    while (!corpus.empty() && result.size() < size) result += corpus;
+    result.resize(std::min(result.size(), size));
+    return result;
+}
+
+// A path under $TMPDIR that is unique to this process
+inline std::string tempPath(const std::string& name) {
+    const char* dir = std::getenv("TMPDIR");
+    return std::string(dir ? dir : "/tmp") + "/et_test_" + std::to_string(getpid()) + "_" + name;
+}
+
+inline void writeFile(const std::string& path, const std::string& contents) {
+    std::ofstream file(path, std::ios::binary);
+    file << contents;
+}
+
+inline std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+inline bool exists(const std::string& path) {
+    return access(path.c_str(), F_OK) == 0;
+}
+
+inline void removeTree(const std::string& path) {
+    std::string command = "rm -rf '" + path + "'";
+    if (std::system(command.c_str()) != 0) std::cerr << "Unable to remove " << path << std::endl;
+}
+
+} // namespace TestData
+
+#endif // TESTDATA_H
@@ -0,0 +1,150 @@
+#include "ArmoredCipher.h"
+#include "TestData.h"
+#include "TextArmor.h"
+#include "VigenereCipher.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+namespace {
+
+std::string decoded(Armor armor, const std::string& text) {
+    std::string data;
+    EXPECT_TRUE(TextArmor::decode(armor, text, data)) << text;
+    return data;
+}
+
+bool decodes(Armor armor, const std::string& text) {
+    std::string data;
+    return TextArmor::decode(armor, text, data);
+}
+
+TEST(TextArmor, Rfc4648KnownAnswers) {
+    const char* const vectors[][2] = {{"", ""},          {"f", "Zg=="},         {"fo", "Zm8="},
+                                      {"foo", "Zm9v"},   {"foob", "Zm9vYg=="},  {"fooba", "Zm9vYmE="},
+                                      {"foobar", "Zm9vYmFy"}};
+    for (const auto& vector : vectors) {
+        EXPECT_EQ(TextArmor::encode(Armor::BASE64, vector[0]), vector[1]);
+        EXPECT_EQ(decoded(Armor::BASE64, vector[1]), vector[0]);
+    }
+    EXPECT_EQ(TextArmor::encode(Armor::HEX, "foobar"), "666f6f626172");
+    EXPECT_EQ(TextArmor::encode(Armor::HEX, std::string("\x00\xff\x10", 3)), "00ff10");
+    EXPECT_EQ(decoded(Armor::HEX, "00FFaB"), std::string("\x00\xff\xab", 3));
+    EXPECT_EQ(TextArmor::encode(Armor::BASE64, "\xfb\xff"), "+/8=");
+}
+
+TEST(TextArmor, VectorKernelsMatchScalarAtEverySize) {
+    std::string data = TestData::bytes(300, 131);
+    for (size_t size = 0; size <= data.size(); ++size) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.data());
+        std::string hex(2 * size, '\0'), hexScalar(2 * size, '\0');
+        TextArmor::hexEncode(bytes, size, &hex[0]);
+        TextArmor::hexEncodeScalar(bytes, size, &hexScalar[0]);
+        ASSERT_EQ(hex, hexScalar) << size;
+
+        size_t encodedSize = TextArmor::encodedSize(Armor::BASE64, size);
+        std::string base64(encodedSize, '\0'), base64Scalar(encodedSize, '\0');
+        TextArmor::base64Encode(bytes, size, &base64[0]);
+        TextArmor::base64EncodeScalar(bytes, size, &base64Scalar[0]);
+        ASSERT_EQ(base64, base64Scalar) << size;
+
+        std::string back(size, '\0'), backScalar(size, '\0');
+        ASSERT_TRUE(TextArmor::hexDecode(hex.data(), hex.size(), reinterpret_cast<uint8_t*>(&back[0])));
+        ASSERT_TRUE(TextArmor::hexDecodeScalar(hex.data(), hex.size(), reinterpret_cast<uint8_t*>(&backScalar[0])));
+        ASSERT_EQ(back, data.substr(0, size));
+        ASSERT_EQ(backScalar, back);
+
+        size_t decodedSize = 0, decodedSizeScalar = 0;
+        std::string out(size + 3, '\0'), outScalar(size + 3, '\0');
+        ASSERT_TRUE(TextArmor::base64Decode(base64.data(), base64.size(), reinterpret_cast<uint8_t*>(&out[0]),
+                                            decodedSize));
+        ASSERT_TRUE(TextArmor::base64DecodeScalar(base64.data(), base64.size(),
+                                                  reinterpret_cast<uint8_t*>(&outScalar[0]), decodedSizeScalar));
+        ASSERT_EQ(decodedSize, size);
+        ASSERT_EQ(decodedSizeScalar, size);
+        ASSERT_EQ(out.substr(0, size), data.substr(0, size));
+        ASSERT_EQ(outScalar.substr(0, size), data.substr(0, size));
+    }
+}
+
+TEST(TextArmor, RejectsMalformedText) {
+    EXPECT_FALSE(decodes(Armor::HEX, "abc"));       // Odd length
+    EXPECT_FALSE(decodes(Armor::HEX, "0g"));
+    EXPECT_FALSE(decodes(Armor::BASE64, "Zm9"));     // Not a whole group
+    EXPECT_FALSE(decodes(Armor::BASE64, "Zm9v!A=="));
+    EXPECT_FALSE(decodes(Armor::BASE64, "Z==="));
+    EXPECT_FALSE(decodes(Armor::BASE64, "Zg==Zg=="));  // Data after padding
+    EXPECT_FALSE(decodes(Armor::BASE64, "=Zg="));
+
+    // A bad character anywhere in a long run, so the vector paths see it too
+    std::string hex = TextArmor::encode(Armor::HEX, TestData::bytes(200, 137));
+    std::string base64 = TextArmor::encode(Armor::BASE64, TestData::bytes(200, 137));
+    for (size_t i = 0; i < hex.size(); i += 7) {
+        std::string bad = hex;
+        bad[i] = 'x';
+        ASSERT_FALSE(decodes(Armor::HEX, bad)) << i;
+    }
+    for (size_t i = 0; i + 4 < base64.size(); i += 5) {
+        std::string bad = base64;
+        bad[i] = '*';
+        ASSERT_FALSE(decodes(Armor::BASE64, bad)) << i;
+    }
+}
+
+TEST(TextArmor, SkipsLineBreaksAndSpaces) {
+    EXPECT_EQ(decoded(Armor::BASE64, "Zm9v\nYmFy\r\n"), "foobar");
+    EXPECT_EQ(decoded(Armor::BASE64, " Zm 9v Yg = = "), "foob");
+    EXPECT_EQ(decoded(Armor::HEX, "66 6f\n6f"), "foo");
+}
+
+TEST(TextArmor, StreamingMatchesWholeForAnySplit) {
+    std::mt19937 rng(139);
+    std::string data = TestData::bytes(1000, 139);
+    for (Armor armor : {Armor::HEX, Armor::BASE64}) {
+        std::string whole = TextArmor::encode(armor, data);
+        for (int round = 0; round < 20; ++round) {
+            TextArmor::Encoder encoder(armor);
+            std::string text;
+            for (size_t offset = 0; offset < data.size();) {
+                size_t piece = std::min<size_t>(rng() % 8, data.size() - offset);
+                encoder.update(data.data() + offset, piece, text);
+                offset += piece;
+            }
+            encoder.finish(text);
+            ASSERT_EQ(text, whole);
+
+            TextArmor::Decoder decoder(armor);
+            std::string back;
+            for (size_t offset = 0; offset < whole.size();) {
+                size_t piece = std::min<size_t>(rng() % 9, whole.size() - offset);
+                ASSERT_TRUE(decoder.update(whole.data() + offset, piece, back));
+                offset += piece;
+            }
+            ASSERT_TRUE(decoder.finish(back));
+            ASSERT_EQ(back, data);
+        }
+        TextArmor::Decoder truncated(armor);
+        std::string back;
+        ASSERT_TRUE(truncated.update(whole.data(), whole.size() - 1, back));
+        EXPECT_FALSE(truncated.finish(back));
+    }
+}
+
+TEST(TextArmor, NamesAndArmoredCipher) {
+    Armor armor = Armor::NONE;
+    ASSERT_TRUE(TextArmor::parse("base64", armor));
+    EXPECT_EQ(armor, Armor::BASE64);
+    EXPECT_STREQ(TextArmor::name(Armor::HEX), "hex");
+    EXPECT_FALSE(TextArmor::parse("base32", armor));
+
+    ArmoredCipher cipher(std::unique_ptr<CipherAlgorithm>(new VigenereCipher(Alphabet::BYTES)), Armor::HEX);
+    cipher.setKey("KEY");
+    EXPECT_STREQ(cipher.getName(), "vigenere-bytes+hex");
+    std::string data = TestData::bytes(500, 149);
+    std::string text = cipher.encrypt(data);
+    EXPECT_EQ(text.size(), 1000u);
+    EXPECT_EQ(text.find_first_not_of("0123456789abcdef"), std::string::npos);
+    EXPECT_EQ(cipher.decrypt(text), data);
+}
+
+} // namespace
@@ -0,0 +1,205 @@
+#include "CommandLine.h"
+#include "PasswordManager.h"
+#include "TestData.h"
+#include "VaultShards.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <set>
+#include <vector>
+
+namespace {
+
+uint64_t digest(int i) {
+    std::string record = "record-" + std::to_string(i);
+    const char* fields[] = {record.data()};
+    size_t lengths[] = {record.size()};
+    return VaultShards::recordDigest(fields, lengths, 1);
+}
+
+uint32_t bucket(int i) {
+    std::string service = "service-" + std::to_string(i);
+    return VaultShards::bucketFor(service.data(), service.size());
+}
+
+TEST(VaultShards, RootIgnoresOrderAndTracksEdits) {
+    VaultShards forward, backward;
+    std::vector<uint32_t> buckets;
+    std::vector<uint64_t> digests;
+    forward.assign(buckets, digests);  // Built empty, then appended to
+    for (int i = 0; i < 500; ++i) {
+        forward.append(bucket(i), digest(i));
+        buckets.insert(buckets.begin(), bucket(i));
+        digests.insert(digests.begin(), digest(i));
+    }
+    backward.assign(buckets, digests);
+    EXPECT_EQ(forward.root(), backward.root());
+    uint64_t nodes = 0;
+    EXPECT_TRUE(VaultShards::differingBuckets(forward, backward, nodes).empty());
+    EXPECT_EQ(nodes, 1u);  // Equal roots end the walk
+
+    // Change record 7 in one tree only: exactly its bucket differs
+    forward.replace(7, digest(10007));
+    std::vector<uint32_t> differing = VaultShards::differingBuckets(forward, backward, nodes);
+    ASSERT_EQ(differing.size(), 1u);
+    EXPECT_EQ(differing[0], bucket(7));
+
+    // Removing the same record from both, by either method, brings them back in line
+    forward.replace(7, digest(7));
+    forward.swapRemove(7);
+    backward.erase(500 - 1 - 7);
+    EXPECT_EQ(forward.root(), backward.root());
+    EXPECT_EQ(forward.size(), 499u);
+    for (uint32_t id = 0; id < forward.size(); ++id) {
+        size_t count = 0;
+        for (uint32_t other = forward.firstIn(forward.bucketOf(id)); other != VaultShards::NONE;
+             other = forward.nextInBucket(other)) {
+            count += other == id;
+        }
+        ASSERT_EQ(count, 1u) << id;
+    }
+}
+
+class VaultSyncTest : public testing::Test {
+protected:
+    std::string sourcePath = TestData::tempPath("sync_source.txt");
+    std::string replicaPath = TestData::tempPath("sync_replica.txt");
+    std::string directoryPath = TestData::tempPath("sync_replica_dir/");
+
+    void SetUp() override {
+        testing::internal::CaptureStdout();
+        testing::internal::CaptureStderr();
+    }
+
+    void TearDown() override {
+        testing::internal::GetCapturedStdout();
+        testing::internal::GetCapturedStderr();
+        std::remove(sourcePath.c_str());
+        std::remove(replicaPath.c_str());
+        TestData::removeTree(directoryPath);
+    }
+
+    static std::string service(int i) { return "service-" + std::to_string(i); }
+
+    static void fill(PasswordManager& vault, int from, int to, const std::string& secret) {
+        for (int i = from; i < to; ++i) vault.addPassword(service(i), "user", secret + std::to_string(i), "caesar", "3");
+    }
+
+    static int run(std::vector<std::string> args) {
+        args.insert(args.begin(), "EncryptionTool");
+        std::vector<char*> argv;
+        for (std::string& arg : args) argv.push_back(&arg[0]);
+        return CommandLine::run(static_cast<int>(argv.size()), argv.data());
+    }
+
+    static std::set<std::string> contents(PasswordManager& vault, int upTo) {
+        std::set<std::string> records;
+        std::string password, algorithm, key;
+        for (int i = 0; i < upTo; ++i) {
+            if (vault.getPassword(service(i), password, algorithm, key)) records.insert(service(i) + "=" + password);
+        }
+        return records;
+    }
+};
+
+TEST_F(VaultSyncTest, DiffAndSyncBringReplicaInLine) {
+    for (const std::string& path : {replicaPath, directoryPath}) {
+        std::remove(sourcePath.c_str());
+        {
+            PasswordManager source(sourcePath);
+            fill(source, 0, 300, "s");
+            PasswordManager replica(path);
+            fill(replica, 100, 400, "s");     // 0..99 missing, 300..399 extra
+            replica.deletePassword(service(150));
+            replica.addPassword(service(150), "user", "changed", "caesar", "3");
+
+            std::vector<PasswordManager::Difference> differences = source.diff(replica);
+            size_t added = 0, removed = 0, changed = 0;
+            for (const PasswordManager::Difference& difference : differences) {
+                added += difference.change == PasswordManager::Change::ADDED;
+                removed += difference.change == PasswordManager::Change::REMOVED;
+                if (difference.change == PasswordManager::Change::CHANGED) {
+                    ++changed;
+                    EXPECT_EQ(difference.service, service(150));
+                }
+            }
+            EXPECT_EQ(added, 100u);
+            EXPECT_EQ(removed, 100u);
+            EXPECT_EQ(changed, 1u);
+
+            PasswordManager::SyncReport report = source.syncTo(replica);
+            EXPECT_EQ(report.recordsSent, 101u);
+            EXPECT_EQ(report.recordsRemoved, 100u);
+            EXPECT_TRUE(source.diff(replica).empty());
+        }
+        PasswordManager source(sourcePath);
+        PasswordManager reloaded(path);
+        EXPECT_EQ(reloaded.size(), 300u);
+        EXPECT_EQ(contents(reloaded, 400), contents(source, 400));
+    }
+}
+
+TEST_F(VaultSyncTest, DiffWritesNothing) {
+    // Neither file is in the form a save would write (no trailing newline)
+    TestData::writeFile(sourcePath, "mail\nalice\nc1\ncaesar\n3");
+    TestData::writeFile(replicaPath, "bank\nbob\nc2\nvigenere\nKEY");
+    EXPECT_EQ(run({"vault-diff", sourcePath, replicaPath}), 1);
+    EXPECT_EQ(TestData::readFile(sourcePath), "mail\nalice\nc1\ncaesar\n3");
+    EXPECT_EQ(TestData::readFile(replicaPath), "bank\nbob\nc2\nvigenere\nKEY");
+
+    std::string missing = TestData::tempPath("sync_missing.txt");
+    EXPECT_EQ(run({"vault-diff", sourcePath, missing}), 2);
+    EXPECT_FALSE(TestData::exists(missing));
+    EXPECT_EQ(run({"vault-diff", missing, sourcePath}), 2);
+    EXPECT_FALSE(TestData::exists(missing));
+    EXPECT_EQ(run({"vault-diff", sourcePath, sourcePath}), 0);
+}
+
+TEST_F(VaultSyncTest, SyncRefusesMissingOrEmptySource) {
+    {
+        PasswordManager replica(replicaPath);
+        fill(replica, 0, 20, "r");
+    }
+    std::string before = TestData::readFile(replicaPath);
+
+    std::string missing = TestData::tempPath("sync_missing.txt");
+    EXPECT_EQ(run({"vault-sync", missing, replicaPath}), 1);
+    EXPECT_FALSE(TestData::exists(missing));
+    EXPECT_EQ(TestData::readFile(replicaPath), before);
+
+    TestData::writeFile(sourcePath, "");
+    EXPECT_EQ(run({"vault-sync", sourcePath, replicaPath}), 1);
+    EXPECT_EQ(TestData::readFile(replicaPath), before);
+    EXPECT_EQ(run({"vault-sync", sourcePath, replicaPath, "--yes"}), 2);
+
+    EXPECT_EQ(run({"vault-sync", sourcePath, replicaPath, "--force"}), 0);
+    EXPECT_EQ(TestData::readFile(replicaPath), "");
+    EXPECT_EQ(TestData::readFile(sourcePath), "");
+
+    // A source with records syncs without --force and is left as it was
+    TestData::writeFile(sourcePath, "mail\nalice\nc1\ncaesar\n3");
+    EXPECT_EQ(run({"vault-sync", sourcePath, replicaPath}), 0);
+    EXPECT_EQ(TestData::readFile(sourcePath), "mail\nalice\nc1\ncaesar\n3");
+    EXPECT_EQ(TestData::readFile(replicaPath), "mail\nalice\nc1\ncaesar\n3\n");
+}
+
+TEST_F(VaultSyncTest, ReadOnlyVaultIsNeverSaved) {
+    TestData::writeFile(sourcePath, "mail\nalice\nc1\ncaesar\n3");
+    {
+        PasswordManager vault(sourcePath, PasswordManager::Access::READ_ONLY);
+        EXPECT_TRUE(vault.exists());
+        vault.saveToFile(sourcePath);
+        vault.saveToFile(replicaPath);  // Other paths can still be written
+    }
+    EXPECT_EQ(TestData::readFile(sourcePath), "mail\nalice\nc1\ncaesar\n3");
+    EXPECT_EQ(TestData::readFile(replicaPath), "mail\nalice\nc1\ncaesar\n3\n");
+
+    std::string missing = TestData::tempPath("sync_missing.txt");
+    {
+        PasswordManager vault(missing, PasswordManager::Access::READ_ONLY);
+        EXPECT_FALSE(vault.exists());
+    }
+    EXPECT_FALSE(TestData::exists(missing));
+}
+
+} // namespace
@@ -0,0 +1,72 @@
+#include "CryptanalysisEngine.h"
+#include "TestData.h"
+#include "VigenereCipher.h"
+#include <gtest/gtest.h>
+#include <fstream>
+
+namespace {
+
+struct CorpusEntry {
+    std::string key;
+    std::string plaintext;
+};
+
+// bench/vigenere_corpus.txt: one "KEY|plaintext" entry per line
+std::vector<CorpusEntry> vigenereCorpus() {
+    std::vector<CorpusEntry> entries;
+    std::ifstream file(TEST_DATA_DIR "/vigenere_corpus.txt");
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t bar = line.find('|');
+        if (line.empty() || line[0] == '#' || bar == std::string::npos) continue;
+        entries.push_back({line.substr(0, bar), line.substr(bar + 1)});
+    }
+    return entries;
+}
+
+TEST(VigenereCipher, KnownAnswer) {
+    VigenereCipher cipher;
+    cipher.setKey("LEMON");
+    EXPECT_EQ(cipher.encrypt("Attack at dawn!"), "Lxfopv ef rnhr!");
+    EXPECT_EQ(cipher.decrypt("Lxfopv ef rnhr!"), "Attack at dawn!");
+}
+
+TEST(VigenereCipher, RoundTripsAcrossKeyLengths) {
+    std::string text = TestData::text(10000, 75, 13);
+    VigenereCipher cipher;
+    for (size_t length : {1, 2, 5, 16, 63, 64, 65, 200}) {
+        std::string key;
+        for (size_t i = 0; i < length; ++i) key += static_cast<char>('A' + (i * 7 + 3) % 26);
+        cipher.setKey(key);
+        ASSERT_EQ(cipher.decrypt(cipher.encrypt(text)), text) << "key length " << length;
+    }
+}
+
+TEST(CryptanalysisEngine, RecoversCorpusVigenereKeys) {
+    std::vector<CorpusEntry> corpus = vigenereCorpus();
+    ASSERT_FALSE(corpus.empty());
+    VigenereCipher cipher;
+    for (const auto& entry : corpus) {
+        cipher.setKey(entry.key);
+        CryptanalysisEngine::VigenereResult result = CryptanalysisEngine::breakVigenere(cipher.encrypt(entry.plaintext));
+        EXPECT_EQ(result.key, entry.key);
+        EXPECT_EQ(result.plaintext, entry.plaintext);
+    }
+}
+
+TEST(CryptanalysisEngine, EstimatesVigenerePeriod) {
+    std::string plaintext = TestData::prose(4000);
+    VigenereCipher cipher;
+    cipher.setKey("NEWTON");
+    std::vector<CryptanalysisEngine::PeriodCandidate> periods =
+        CryptanalysisEngine::estimateVigenerePeriods(cipher.encrypt(plaintext), 20);
+    ASSERT_FALSE(periods.empty());
+    const CryptanalysisEngine::PeriodCandidate* best = &periods[0];
+    for (const auto& candidate : periods) {
+        if (candidate.indexOfCoincidence > best->indexOfCoincidence) best = &candidate;
+    }
+    EXPECT_EQ(best->period % 6, 0u);
+    EXPECT_GT(periods[5].indexOfCoincidence, 0.055);
+}
+
+} // namespace